@@ -0,0 +1,145 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/arena_allocator.h"
+
+#include <algorithm>
+#include <new>
+
+#include "pw_allocator/hardening.h"
+#include "pw_assert/check.h"
+#include "pw_bytes/alignment.h"
+#include "pw_numeric/checked_arithmetic.h"
+
+namespace pw::allocator {
+
+/// Header at the start of every chunk allocated from the parent.
+struct ArenaAllocator::Chunk {
+  Chunk* prev = nullptr;
+  size_t size = 0;
+
+  std::byte* begin() { return reinterpret_cast<std::byte*>(this + 1); }
+  std::byte* end() { return reinterpret_cast<std::byte*>(this) + size; }
+};
+
+ArenaAllocator::~ArenaAllocator() {
+  Reset();
+  if (chunk_ != nullptr) {
+    RemoveChunk();
+  }
+}
+
+ArenaAllocator::Checkpoint ArenaAllocator::Mark() {
+  // Growing an allocation made before the checkpoint would extend it into
+  // memory that is reused after rewinding, so only allocations made after the
+  // checkpoint may be resized.
+  last_ = nullptr;
+  Checkpoint checkpoint;
+  checkpoint.chunk_ = chunk_;
+  checkpoint.cursor_ = cursor_;
+  checkpoint.destructors_ = destructors_;
+  checkpoint.allocated_ = allocated_;
+  return checkpoint;
+}
+
+void ArenaAllocator::Rewind(const Checkpoint& checkpoint) {
+  // Run destructors in the reverse order that objects were constructed.
+  while (destructors_ != checkpoint.destructors_) {
+    if constexpr (Hardening::kIncludesRobustChecks) {
+      PW_CHECK_NOTNULL(destructors_, "checkpoint is not from this arena");
+    }
+    Destructor* destructor = destructors_;
+    destructors_ = destructor->next;
+    destructor->destroy(destructor->object);
+  }
+
+  if (checkpoint.chunk_ == nullptr) {
+    // Keep the first chunk for reuse, unless it was sized for a single large
+    // request.
+    while (chunk_ != nullptr && chunk_->prev != nullptr) {
+      RemoveChunk();
+    }
+    if (chunk_ != nullptr && chunk_->size != chunk_size_) {
+      RemoveChunk();
+    }
+    cursor_ = chunk_ != nullptr ? chunk_->begin() : nullptr;
+  } else {
+    while (chunk_ != checkpoint.chunk_) {
+      if constexpr (Hardening::kIncludesRobustChecks) {
+        PW_CHECK_NOTNULL(chunk_, "checkpoint is not from this arena");
+      }
+      RemoveChunk();
+    }
+    cursor_ = checkpoint.cursor_;
+  }
+  end_ = chunk_ != nullptr ? chunk_->end() : nullptr;
+  last_ = nullptr;
+  allocated_ = checkpoint.allocated_;
+}
+
+void* ArenaAllocator::DoAllocate(Layout layout) {
+  std::byte* ptr = AlignUp(cursor_, layout.alignment());
+  if (chunk_ == nullptr || ptr > end_ ||
+      layout.size() > static_cast<size_t>(end_ - ptr)) {
+    if (!AddChunk(layout)) {
+      return nullptr;
+    }
+    ptr = AlignUp(cursor_, layout.alignment());
+  }
+  std::byte* cursor = ptr + layout.size();
+  allocated_ += static_cast<size_t>(cursor - cursor_);
+  cursor_ = cursor;
+  last_ = ptr;
+  return ptr;
+}
+
+bool ArenaAllocator::DoResize(void* ptr, size_t new_size) {
+  if (ptr == nullptr || ptr != last_ ||
+      new_size > static_cast<size_t>(end_ - last_)) {
+    return false;
+  }
+  allocated_ -= static_cast<size_t>(cursor_ - last_);
+  allocated_ += new_size;
+  cursor_ = last_ + new_size;
+  return true;
+}
+
+bool ArenaAllocator::AddChunk(Layout layout) {
+  size_t size = sizeof(Chunk) + layout.alignment() - 1;
+  if (!CheckedIncrement(size, layout.size())) {
+    return false;
+  }
+  size = std::max(size, chunk_size_);
+  void* ptr = parent_.Allocate(Layout(size, alignof(std::max_align_t)));
+  if (ptr == nullptr) {
+    return false;
+  }
+  auto* chunk = new (ptr) Chunk();
+  chunk->prev = chunk_;
+  chunk->size = size;
+  chunk_ = chunk;
+  cursor_ = chunk->begin();
+  end_ = chunk->end();
+  ++num_chunks_;
+  return true;
+}
+
+void ArenaAllocator::RemoveChunk() {
+  Chunk* chunk = chunk_;
+  chunk_ = chunk->prev;
+  parent_.Deallocate(chunk);
+  --num_chunks_;
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,287 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/arena_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/testing.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 0x4000;
+static constexpr size_t kChunkSize = 256;
+
+using ::pw::allocator::ArenaAllocator;
+using ::pw::allocator::Layout;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
+
+class DestroyCounter final {
+ public:
+  DestroyCounter(size_t* counter) : counter_(counter) {}
+  ~DestroyCounter() { *counter_ += 1; }
+
+ private:
+  size_t* counter_;
+};
+
+/// Records the order in which objects are destroyed.
+class DestroyRecorder final {
+ public:
+  DestroyRecorder(uint32_t* log, uint32_t id) : log_(log), id_(id) {}
+  ~DestroyRecorder() { *log_ = (*log_ * 10) + id_; }
+
+ private:
+  uint32_t* log_;
+  uint32_t id_;
+};
+
+// Unit tests.
+
+TEST(ArenaAllocatorTest, AllocatesChunksLazily) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  EXPECT_EQ(arena.num_chunks(), 0u);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 0u);
+
+  void* ptr = arena.Allocate(Layout(16));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(arena.num_chunks(), 1u);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 1u);
+}
+
+TEST(ArenaAllocatorTest, AllocateAligned) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  void* ptr = arena.Allocate(Layout(1, 1));
+  ASSERT_NE(ptr, nullptr);
+
+  // Last pointer was aligned, so next won't automatically be.
+  ptr = arena.Allocate(Layout(8, 32));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(cpp20::bit_cast<uintptr_t>(ptr) % 32, 0U);
+}
+
+TEST(ArenaAllocatorTest, GrowsWhenChunkIsFull) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  for (size_t i = 0; i < 16; ++i) {
+    ASSERT_NE(arena.Allocate(Layout(64)), nullptr);
+  }
+  EXPECT_GT(arena.num_chunks(), 4u);
+  EXPECT_EQ(arena.GetAllocated(), 16u * 64u);
+}
+
+TEST(ArenaAllocatorTest, AllocatesLargeRequestsFromDedicatedChunk) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  void* ptr = arena.Allocate(Layout(kChunkSize * 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(arena.num_chunks(), 1u);
+}
+
+TEST(ArenaAllocatorTest, FailsWhenParentIsExhausted) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  parent.Exhaust();
+  EXPECT_EQ(arena.Allocate(Layout(16)), nullptr);
+  EXPECT_EQ(arena.num_chunks(), 0u);
+}
+
+TEST(ArenaAllocatorTest, DeallocateDoesNothing) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  void* ptr1 = arena.Allocate(Layout(16));
+  ASSERT_NE(ptr1, nullptr);
+  arena.Deallocate(ptr1);
+  void* ptr2 = arena.Allocate(Layout(16));
+  EXPECT_NE(ptr1, ptr2);
+}
+
+TEST(ArenaAllocatorTest, ResizeLastAllocation) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  void* ptr1 = arena.Allocate(Layout(16));
+  void* ptr2 = arena.Allocate(Layout(16));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_FALSE(arena.Resize(ptr1, 32));
+  EXPECT_TRUE(arena.Resize(ptr2, 64));
+  EXPECT_EQ(arena.GetAllocated(), 16u + 64u);
+  EXPECT_TRUE(arena.Resize(ptr2, 8));
+  EXPECT_EQ(arena.GetAllocated(), 16u + 8u);
+  EXPECT_FALSE(arena.Resize(ptr2, kChunkSize));
+}
+
+TEST(ArenaAllocatorTest, RewindReusesMemory) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  ASSERT_NE(arena.Allocate(Layout(16)), nullptr);
+  ArenaAllocator::Checkpoint checkpoint = arena.Mark();
+  void* ptr1 = arena.Allocate(Layout(32));
+  ASSERT_NE(ptr1, nullptr);
+  arena.Rewind(checkpoint);
+  EXPECT_EQ(arena.GetAllocated(), 16u);
+  void* ptr2 = arena.Allocate(Layout(32));
+  EXPECT_EQ(ptr1, ptr2);
+}
+
+TEST(ArenaAllocatorTest, RewindReturnsNewerChunks) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  ASSERT_NE(arena.Allocate(Layout(16)), nullptr);
+  ArenaAllocator::Checkpoint checkpoint = arena.Mark();
+  for (size_t i = 0; i < 16; ++i) {
+    ASSERT_NE(arena.Allocate(Layout(64)), nullptr);
+  }
+  size_t num_chunks = arena.num_chunks();
+  EXPECT_GT(num_chunks, 1u);
+  arena.Rewind(checkpoint);
+  EXPECT_EQ(arena.num_chunks(), 1u);
+  EXPECT_EQ(parent.metrics().num_deallocations.value(), num_chunks - 1);
+}
+
+TEST(ArenaAllocatorTest, NestedCheckpoints) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  ArenaAllocator::Checkpoint outer = arena.Mark();
+  ASSERT_NE(arena.Allocate(Layout(100)), nullptr);
+  ArenaAllocator::Checkpoint inner = arena.Mark();
+  ASSERT_NE(arena.Allocate(Layout(200)), nullptr);
+  ASSERT_NE(arena.Allocate(Layout(200)), nullptr);
+  EXPECT_EQ(arena.num_chunks(), 3u);
+
+  arena.Rewind(inner);
+  EXPECT_EQ(arena.num_chunks(), 1u);
+  EXPECT_EQ(arena.GetAllocated(), 100u);
+
+  arena.Rewind(outer);
+  EXPECT_EQ(arena.num_chunks(), 1u);
+  EXPECT_EQ(arena.GetAllocated(), 0u);
+}
+
+TEST(ArenaAllocatorTest, ResizeCannotGrowAcrossCheckpoint) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  auto* before = cpp20::bit_cast<std::byte*>(arena.Allocate(Layout(16)));
+  ASSERT_NE(before, nullptr);
+  ArenaAllocator::Checkpoint checkpoint = arena.Mark();
+  EXPECT_FALSE(arena.Resize(before, 64));
+
+  // Allocations made after the checkpoint can still be resized.
+  void* after = arena.Allocate(Layout(16));
+  ASSERT_NE(after, nullptr);
+  EXPECT_TRUE(arena.Resize(after, 32));
+
+  arena.Rewind(checkpoint);
+  EXPECT_EQ(arena.GetAllocated(), 16u);
+  auto* reused = cpp20::bit_cast<std::byte*>(arena.Allocate(Layout(16)));
+  ASSERT_NE(reused, nullptr);
+  EXPECT_GE(reused, before + 16);
+}
+
+TEST(ArenaAllocatorTest, ResetKeepsFirstChunk) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  for (size_t i = 0; i < 10; ++i) {
+    void* ptr = arena.Allocate(Layout(64));
+    ASSERT_NE(ptr, nullptr);
+    arena.Reset();
+  }
+  EXPECT_EQ(arena.num_chunks(), 1u);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 1u);
+  EXPECT_EQ(arena.GetAllocated(), 0u);
+}
+
+TEST(ArenaAllocatorTest, ResetReturnsLargeFirstChunk) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  ASSERT_NE(arena.Allocate(Layout(kChunkSize * 4)), nullptr);
+  arena.Reset();
+  EXPECT_EQ(arena.num_chunks(), 0u);
+}
+
+TEST(ArenaAllocatorTest, ScopeRewinds) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  ASSERT_NE(arena.Allocate(Layout(16)), nullptr);
+  {
+    ArenaAllocator::Scope scope(arena);
+    for (size_t i = 0; i < 16; ++i) {
+      ASSERT_NE(arena.Allocate(Layout(64)), nullptr);
+    }
+  }
+  EXPECT_EQ(arena.num_chunks(), 1u);
+  EXPECT_EQ(arena.GetAllocated(), 16u);
+}
+
+TEST(ArenaAllocatorTest, NewOwnedIsDestroyedOnRewind) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  size_t count = 0;
+  ASSERT_NE(arena.NewOwned<DestroyCounter>(&count), nullptr);
+  {
+    ArenaAllocator::Scope scope(arena);
+    ASSERT_NE(arena.NewOwned<DestroyCounter>(&count), nullptr);
+    ASSERT_NE(arena.New<DestroyCounter>(&count), nullptr);
+  }
+  EXPECT_EQ(count, 1u);
+  arena.Reset();
+  EXPECT_EQ(count, 2u);
+}
+
+TEST(ArenaAllocatorTest, NewOwnedIsDestroyedInReverseOrder) {
+  AllocatorForTest parent;
+  uint32_t log = 0;
+  {
+    ArenaAllocator arena(parent, kChunkSize);
+    for (uint32_t id = 1; id <= 3; ++id) {
+      ASSERT_NE(arena.NewOwned<DestroyRecorder>(&log, id), nullptr);
+    }
+  }
+  EXPECT_EQ(log, 321u);
+}
+
+TEST(ArenaAllocatorTest, MakeUniqueOwnedIsDestroyedOnReset) {
+  AllocatorForTest parent;
+  ArenaAllocator arena(parent, kChunkSize);
+  size_t count = 0;
+  {
+    auto ptr = arena.MakeUniqueOwned<DestroyCounter>(&count);
+    ASSERT_NE(ptr, nullptr);
+  }
+  // The arena skips destroying objects when `UniquePtr`s go out of scope.
+  EXPECT_EQ(count, 0u);
+  arena.Reset();
+  EXPECT_EQ(count, 1u);
+}
+
+TEST(ArenaAllocatorTest, DestructorReturnsAllChunks) {
+  AllocatorForTest parent;
+  {
+    ArenaAllocator arena(parent, kChunkSize);
+    for (size_t i = 0; i < 16; ++i) {
+      ASSERT_NE(arena.Allocate(Layout(64)), nullptr);
+    }
+  }
+  EXPECT_EQ(parent.metrics().num_allocations.value(),
+            parent.metrics().num_deallocations.value());
+}
+
+}  // namespace
@@ -0,0 +1,125 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the cost of handling simulated requests that each make a number of
+// short-lived allocations, using either a TlsfAllocator directly or an
+// ArenaAllocator that is rewound at the end of each request.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/arena_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_random/xor_shift.h"
+
+namespace pw::allocator {
+namespace {
+
+constexpr size_t kCapacity = 0x100000;  // 1 MiB
+constexpr size_t kNumRequests = 20000;
+constexpr size_t kMaxAllocationsPerRequest = 64;
+constexpr size_t kMinSize = 8;
+constexpr size_t kMaxSize = 256;
+
+std::array<std::byte, kCapacity> buffer;
+
+/// Simulates a request by making a number of allocations, all of which are
+/// live until the request completes.
+class RequestGenerator {
+ public:
+  explicit RequestGenerator(uint64_t seed) : prng_(seed) {}
+
+  size_t Generate() {
+    size_t num_allocations;
+    prng_.GetInt(num_allocations, kMaxAllocationsPerRequest);
+    num_allocations += 1;
+    for (size_t i = 0; i < num_allocations; ++i) {
+      size_t size;
+      prng_.GetInt(size, kMaxSize - kMinSize + 1);
+      sizes_[i] = size + kMinSize;
+    }
+    return num_allocations;
+  }
+
+  size_t size(size_t index) const { return sizes_[index]; }
+
+ private:
+  random::XorShiftStarRng64 prng_;
+  std::array<size_t, kMaxAllocationsPerRequest> sizes_{};
+};
+
+/// Returns the average number of nanoseconds taken to handle a request by
+/// allocating from the given allocator and freeing each allocation.
+uint64_t MeasureIndividualFrees(Allocator& allocator) {
+  RequestGenerator generator(1);
+  std::array<void*, kMaxAllocationsPerRequest> ptrs{};
+  auto begin = chrono::SystemClock::now();
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    size_t num_allocations = generator.Generate();
+    for (size_t j = 0; j < num_allocations; ++j) {
+      ptrs[j] = allocator.Allocate(Layout(generator.size(j)));
+    }
+    for (size_t j = 0; j < num_allocations; ++j) {
+      allocator.Deallocate(ptrs[j]);
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      chrono::SystemClock::now() - begin);
+  return static_cast<uint64_t>(elapsed.count()) / kNumRequests;
+}
+
+/// Returns the average number of nanoseconds taken to handle a request by
+/// allocating from the given arena and rewinding it at the end of the request.
+uint64_t MeasureArena(ArenaAllocator& arena) {
+  RequestGenerator generator(1);
+  auto begin = chrono::SystemClock::now();
+  for (size_t i = 0; i < kNumRequests; ++i) {
+    ArenaAllocator::Scope scope(arena);
+    size_t num_allocations = generator.Generate();
+    for (size_t j = 0; j < num_allocations; ++j) {
+      arena.Allocate(Layout(generator.size(j)));
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      chrono::SystemClock::now() - begin);
+  return static_cast<uint64_t>(elapsed.count()) / kNumRequests;
+}
+
+void DoArenaBenchmark() {
+  TlsfAllocator<> tlsf(buffer);
+  uint64_t tlsf_ns = MeasureIndividualFrees(tlsf);
+  PW_LOG_INFO("TlsfAllocator:                %6u ns/request",
+              static_cast<unsigned>(tlsf_ns));
+
+  for (size_t chunk_size : {1024u, 4096u, 16384u}) {
+    ArenaAllocator arena(tlsf, chunk_size);
+    uint64_t arena_ns = MeasureArena(arena);
+    PW_LOG_INFO("ArenaAllocator, %5u B chunks: %6u ns/request",
+                static_cast<unsigned>(chunk_size),
+                static_cast<unsigned>(arena_ns));
+  }
+}
+
+}  // namespace
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoArenaBenchmark();
+  return 0;
+}
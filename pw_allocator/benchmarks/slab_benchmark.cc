@@ -0,0 +1,100 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/benchmarks/benchmark.h"
+#include "pw_allocator/benchmarks/config.h"
+#include "pw_allocator/slab_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_metric/metric.h"
+
+namespace pw::allocator {
+
+constexpr metric::Token kSlabBenchmark =
+    PW_METRIC_TOKEN("slab allocator benchmark");
+
+std::array<std::byte, benchmarks::kCapacity> buffer;
+
+// Power-of-two size classes up to the benchmark's maximum request size.
+constexpr std::array<size_t, 10> kObjectSizes = {
+    16, 32, 64, 128, 256, 512, 1024, 2048, 4096, benchmarks::kMaxSize};
+
+constexpr size_t kSlabSize = 0x10000;  // 64 KiB
+
+class SlabAllocatorForBenchmark
+    : public SlabAllocator<kSlabSize, kObjectSizes.size()> {
+ public:
+  using SlabAllocator::GetUsableLayout;
+  using SlabAllocator::SlabAllocator;
+};
+
+/// Benchmark for a slab allocator that gets its slabs from a TLSF allocator.
+///
+/// The slab allocator has no blocks of its own, so block-related measurements
+/// are taken from the parent allocator.
+class SlabAllocatorBenchmark : public internal::GenericBlockAllocatorBenchmark {
+ public:
+  SlabAllocatorBenchmark(TlsfAllocator<>& parent,
+                         SlabAllocatorForBenchmark& allocator)
+      : internal::GenericBlockAllocatorBenchmark(measurements_),
+        parent_(parent),
+        allocator_(allocator),
+        measurements_(kSlabBenchmark) {
+    set_allocator(&allocator);
+  }
+
+ private:
+  size_t GetBlockInnerSize(const void* ptr) const override {
+    return allocator_.GetUsableLayout(ptr)->size();
+  }
+
+  void IterateOverBlocks(internal::BenchmarkSample& data) const override {
+    data.largest = 0;
+    for (const auto* block : parent_.blocks()) {
+      if (block->IsFree()) {
+        data.largest = std::max(data.largest, block->InnerSize());
+      }
+    }
+    data.largest = std::min(data.largest, kObjectSizes.back());
+  }
+
+  Fragmentation GetBlockFragmentation() const override {
+    return parent_.MeasureFragmentation().value();
+  }
+
+  TlsfAllocator<>& parent_;
+  SlabAllocatorForBenchmark& allocator_;
+  DefaultMeasurements measurements_;
+};
+
+void DoSlabBenchmark() {
+  TlsfAllocator parent(buffer);
+  SlabAllocatorForBenchmark allocator(parent, kObjectSizes);
+  SlabAllocatorBenchmark benchmark(parent, allocator);
+  benchmark.set_prng_seed(1);
+  benchmark.set_available(benchmarks::kCapacity);
+  benchmark.GenerateRequests(benchmarks::kMaxSize, benchmarks::kNumRequests);
+  benchmark.metrics().Dump();
+}
+
+}  // namespace pw::allocator
+
+int main() {
+  pw::allocator::DoSlabBenchmark();
+  return 0;
+}
@@ -0,0 +1,148 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the throughput of small allocations made concurrently by multiple
+// threads, using a shared allocator wrapped either by a SynchronizedAllocator
+// or by a ThreadCachingAllocator with a ThreadCache per thread.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/best_fit.h"
+#include "pw_allocator/synchronized_allocator.h"
+#include "pw_allocator/thread_caching_allocator.h"
+#include "pw_allocator/tlsf_allocator.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_random/xor_shift.h"
+#include "pw_sync/mutex.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_thread_stl/options.h"
+
+namespace pw::allocator {
+namespace {
+
+constexpr size_t kCapacity = 0x1000000;  // 16 MiB
+constexpr size_t kMaxThreads = 16;
+constexpr size_t kNumOpsPerThread = 200000;
+constexpr size_t kNumLiveAllocations = 64;
+constexpr size_t kMinSize = 8;
+constexpr size_t kMaxSize = 256;
+
+std::array<std::byte, kCapacity> buffer;
+
+/// Repeatedly replaces random allocations in a fixed-size working set.
+class Worker {
+ public:
+  void Init(Allocator& allocator,
+            internal::GenericThreadCachingAllocator* caching,
+            const std::atomic<bool>& start,
+            uint64_t seed) {
+    allocator_ = &allocator;
+    caching_ = caching;
+    start_ = &start;
+    prng_.emplace(seed);
+  }
+
+  void Run() {
+    while (!start_->load(std::memory_order_acquire)) {
+      this_thread::yield();
+    }
+    if (caching_ == nullptr) {
+      Exercise(*allocator_);
+      return;
+    }
+    ThreadCache<> cache(*caching_);
+    Exercise(cache);
+  }
+
+ private:
+  void Exercise(Allocator& allocator) {
+    std::array<void*, kNumLiveAllocations> ptrs{};
+    for (size_t i = 0; i < kNumOpsPerThread; ++i) {
+      size_t index;
+      size_t size;
+      prng_->GetInt(index, kNumLiveAllocations);
+      prng_->GetInt(size, kMaxSize - kMinSize + 1);
+      allocator.Deallocate(ptrs[index]);
+      ptrs[index] = allocator.Allocate(Layout(size + kMinSize));
+    }
+    for (void* ptr : ptrs) {
+      allocator.Deallocate(ptr);
+    }
+  }
+
+  Allocator* allocator_ = nullptr;
+  internal::GenericThreadCachingAllocator* caching_ = nullptr;
+  const std::atomic<bool>* start_ = nullptr;
+  std::optional<random::XorShiftStarRng64> prng_;
+};
+
+/// Runs `num_threads` workers concurrently, and returns the combined number of
+/// allocations and deallocations per second.
+uint64_t MeasureOpsPerSec(Allocator& allocator,
+                          internal::GenericThreadCachingAllocator* caching,
+                          size_t num_threads) {
+  std::array<Worker, kMaxThreads> workers;
+  std::array<Thread, kMaxThreads> threads;
+  std::atomic<bool> start(false);
+  for (size_t i = 0; i < num_threads; ++i) {
+    Worker& worker = workers[i];
+    worker.Init(allocator, caching, start, i + 1);
+    threads[i] = Thread(thread::stl::Options(), [&worker] { worker.Run(); });
+  }
+  auto begin = chrono::SystemClock::now();
+  start.store(true, std::memory_order_release);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads[i].join();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      chrono::SystemClock::now() - begin);
+  uint64_t num_ops = num_threads * kNumOpsPerThread * 2;
+  return num_ops * 1000000000u / static_cast<uint64_t>(elapsed.count());
+}
+
+template <typename BlockAllocatorType>
+void DoThreadCachingBenchmark(const char* name) {
+  for (size_t num_threads = 1; num_threads <= kMaxThreads; num_threads *= 2) {
+    BlockAllocatorType block_allocator(buffer);
+    SynchronizedAllocator<sync::Mutex> synchronized(block_allocator);
+    uint64_t locked = MeasureOpsPerSec(synchronized, nullptr, num_threads);
+
+    ThreadCachingAllocator<sync::Mutex> caching(block_allocator);
+    uint64_t cached = MeasureOpsPerSec(caching, &caching, num_threads);
+
+    PW_LOG_INFO("%s, %2u thread(s): synchronized %9u ops/s, cached %9u ops/s",
+                name,
+                static_cast<unsigned>(num_threads),
+                static_cast<unsigned>(locked),
+                static_cast<unsigned>(cached));
+  }
+}
+
+}  // namespace
+}  // namespace pw::allocator
+
+int main() {
+  using namespace pw::allocator;
+  DoThreadCachingBenchmark<BestFitAllocator<>>("BestFitAllocator");
+  DoThreadCachingBenchmark<TlsfAllocator<>>("TlsfAllocator");
+  return 0;
+}
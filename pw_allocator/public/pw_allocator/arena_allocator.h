@@ -0,0 +1,216 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "pw_allocator/abstract_allocator.h"
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+
+namespace pw::allocator {
+
+/// @submodule{pw_allocator,concrete}
+
+/// Growable allocator that frees all of its memory at once.
+///
+/// Like a `BumpAllocator`, this allocator provides memory by incrementing a
+/// pointer, and does nothing on deallocation. Unlike a `BumpAllocator`, it
+/// obtains memory in chunks from a parent allocator as needed, and can release
+/// memory without being destroyed:
+///
+/// * `Mark` returns a `Checkpoint`, and `Rewind` frees everything allocated
+///   after that checkpoint. Checkpoints may be nested, and must be rewound in
+///   the reverse order they were marked. `Scope` does this automatically.
+/// * `Reset` frees everything allocated by the arena.
+///
+/// Objects constructed using `NewOwned` or `MakeUniqueOwned` have their
+/// destructors invoked, in reverse order of construction, when the memory
+/// holding them is freed.
+///
+/// Rewinding and resetting return chunks to the parent allocator, except for
+/// the first one, which is kept for reuse. As a result, freeing everything
+/// allocated while handling a request that fits in the first chunk takes
+/// constant time, aside from running any registered destructors.
+///
+/// This allocator is well suited to request-scoped work such as handling an
+/// RPC, decoding a protobuf message, or building a JSON document.
+class ArenaAllocator : public AbstractAllocator {
+ private:
+  struct Chunk;
+  struct Destructor;
+
+ public:
+  static constexpr Capabilities kCapabilities = kSkipsDestroy;
+
+  /// Default size of the chunks obtained from the parent allocator.
+  static constexpr size_t kDefaultChunkSize = 4096;
+
+  /// Opaque position in an arena, as returned by `Mark`.
+  class Checkpoint {
+   private:
+    friend class ArenaAllocator;
+
+    Chunk* chunk_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    Destructor* destructors_ = nullptr;
+    size_t allocated_ = 0;
+  };
+
+  /// Marks the arena on construction, and rewinds it on destruction.
+  class Scope {
+   public:
+    explicit Scope(ArenaAllocator& arena)
+        : arena_(arena), checkpoint_(arena.Mark()) {}
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() { arena_.Rewind(checkpoint_); }
+
+   private:
+    ArenaAllocator& arena_;
+    const Checkpoint checkpoint_;
+  };
+
+  /// Constructs an arena.
+  ///
+  /// @param[in]  parent      Allocator used to allocate chunks.
+  /// @param[in]  chunk_size  Size of chunks to allocate from the parent.
+  ///                         Requests too large for a chunk of this size are
+  ///                         satisfied from a dedicated, larger chunk.
+  constexpr explicit ArenaAllocator(Allocator& parent,
+                                    size_t chunk_size = kDefaultChunkSize)
+      : AbstractAllocator(kCapabilities),
+        parent_(parent),
+        chunk_size_(chunk_size) {}
+
+  ~ArenaAllocator() override;
+
+  /// Number of chunks currently allocated from the parent allocator.
+  size_t num_chunks() const { return num_chunks_; }
+
+  /// Returns the current position of the arena.
+  ///
+  /// Allocations made before the checkpoint can no longer be resized in
+  /// place, since growing them would claim memory that `Rewind` frees.
+  Checkpoint Mark();
+
+  /// Frees everything allocated after the given checkpoint was marked.
+  ///
+  /// Any checkpoints marked after the given one become invalid.
+  void Rewind(const Checkpoint& checkpoint);
+
+  /// Frees everything allocated by the arena.
+  void Reset() { Rewind(Checkpoint()); }
+
+  /// Constructs an "owned" object of type `T` from the given `args`.
+  ///
+  /// Owned objects will have their destructors invoked when the arena is
+  /// rewound past them, reset, or destroyed.
+  ///
+  /// The return value is nullable, as allocating memory for the object may
+  /// fail. Callers must check for this error before using the resulting
+  /// pointer.
+  ///
+  /// @param[in]  args        Arguments passed to the object constructor.
+  template <typename T, int&... kExplicitGuard, typename... Args>
+  T* NewOwned(Args&&... args);
+
+  /// Constructs and object of type `T` from the given `args`, and wraps it in a
+  /// `UniquePtr`.
+  ///
+  /// Owned objects will have their destructors invoked when the arena is
+  /// rewound past them, reset, or destroyed.
+  ///
+  /// The returned value may contain null if allocating memory for the object
+  /// fails. Callers must check for null before using the `UniquePtr`.
+  ///
+  /// @param[in]  args        Arguments passed to the object constructor.
+  template <typename T, int&... kExplicitGuard, typename... Args>
+  [[nodiscard]] UniquePtr<T> MakeUniqueOwned(Args&&... args);
+
+ private:
+  /// Node in the list of destructors to run when rewinding.
+  struct Destructor {
+    Destructor* next;
+    void (*destroy)(void*);
+    void* object;
+  };
+
+  template <typename T>
+  static void Destroy(void* object) {
+    std::destroy_at(static_cast<T*>(object));
+  }
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void*) override {}
+
+  /// @copydoc Allocator::Resize
+  ///
+  /// Only the most recent allocation can be resized.
+  bool DoResize(void* ptr, size_t new_size) override;
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocated_; }
+
+  /// Allocates a chunk from the parent large enough to satisfy `layout`.
+  bool AddChunk(Layout layout);
+
+  /// Returns the most recently allocated chunk to the parent allocator.
+  void RemoveChunk();
+
+  Allocator& parent_;
+  const size_t chunk_size_;
+  Chunk* chunk_ = nullptr;
+  std::byte* cursor_ = nullptr;
+  std::byte* end_ = nullptr;
+  std::byte* last_ = nullptr;
+  Destructor* destructors_ = nullptr;
+  size_t num_chunks_ = 0;
+  size_t allocated_ = 0;
+};
+
+/// @}
+
+// Template method implementations.
+
+template <typename T, int&... kExplicitGuard, typename... Args>
+T* ArenaAllocator::NewOwned(Args&&... args) {
+  // Reserve the destructor node first, so that the object is never left
+  // without one.
+  auto* destructor = New<Destructor>();
+  if (destructor == nullptr) {
+    return nullptr;
+  }
+  T* ptr = New<T>(std::forward<Args>(args)...);
+  if (ptr != nullptr) {
+    *destructor = Destructor{destructors_, &Destroy<T>, ptr};
+    destructors_ = destructor;
+  }
+  return ptr;
+}
+
+template <typename T, int&... kExplicitGuard, typename... Args>
+UniquePtr<T> ArenaAllocator::MakeUniqueOwned(Args&&... args) {
+  return UniquePtr<T>(NewOwned<T>(std::forward<Args>(args)...), *this);
+}
+
+}  // namespace pw::allocator
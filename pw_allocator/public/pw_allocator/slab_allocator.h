@@ -0,0 +1,190 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_allocator/abstract_allocator.h"
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/capability.h"
+#include "pw_allocator/layout.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+
+namespace pw::allocator {
+namespace internal {
+
+/// Size-agnostic base class of a `SlabAllocator`.
+///
+/// A slab is a region of `slab_size` bytes that is allocated from the parent
+/// allocator, and is aligned to its size. It begins with a header and a bitmap
+/// of free objects, followed by equally-sized objects of a single size class.
+/// Since slabs are aligned to their size, the slab containing an object can be
+/// found from the object's address, and no per-object header is needed.
+///
+/// Each size class keeps a list of slabs with free objects, and a list of full
+/// slabs. The number of words in a slab's bitmap depends only on the slab size
+/// and object size, so allocating and deallocating take constant time.
+class GenericSlabAllocator : public AbstractAllocator {
+ public:
+  static constexpr Capabilities kCapabilities =
+      kImplementsGetUsableLayout | kImplementsGetAllocatedLayout;
+
+  /// Size of the slabs allocated from the parent allocator.
+  size_t slab_size() const { return slab_size_; }
+
+  /// Number of slabs currently allocated from the parent allocator.
+  size_t num_slabs() const { return num_slabs_; }
+
+ protected:
+  struct Slab;
+
+  /// Describes the objects of a single size class.
+  struct SizeClass {
+    /// Slabs with at least one free object.
+    Slab* partial = nullptr;
+
+    /// Slabs with no free objects.
+    Slab* full = nullptr;
+
+    size_t object_size = 0;
+    size_t object_alignment = 0;
+    size_t num_objects = 0;
+    size_t bitmap_words = 0;
+
+    /// Offset from the start of a slab to its first object.
+    size_t objects_offset = 0;
+  };
+
+  constexpr GenericSlabAllocator(Allocator& parent, size_t slab_size)
+      : AbstractAllocator(kCapabilities),
+        parent_(parent),
+        slab_size_(slab_size) {}
+
+  /// Sets up the size classes for a slab allocator.
+  ///
+  /// @param[in] size_classes   Storage for the size classes.
+  /// @param[in] object_sizes   Object sizes, in increasing order. Must be
+  ///                           non-empty, fit in `size_classes`, and be small
+  ///                           enough for at least one object to fit in a
+  ///                           slab.
+  void Init(span<SizeClass> size_classes, span<const size_t> object_sizes);
+
+  /// Returns all slabs to the parent allocator. Crashes with a diagnostic
+  /// message if any objects remain allocated.
+  void Reset();
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Deallocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override;
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocated_; }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override;
+
+  /// Returns the slab that contains the given object.
+  Slab* GetSlab(const void* ptr) const;
+
+  /// Allocates a new slab from the parent allocator, and adds it to the given
+  /// size class's list of partial slabs.
+  Slab* AddSlab(SizeClass& size_class, size_t index);
+
+  /// Adds a slab to the front of a list.
+  static void Push(Slab*& head, Slab* slab);
+
+  /// Removes a slab from a list.
+  static void Unlink(Slab*& head, Slab* slab);
+
+  Allocator& parent_;
+  const size_t slab_size_;
+  span<SizeClass> size_classes_;
+  size_t num_slabs_ = 0;
+  size_t allocated_ = 0;
+};
+
+}  // namespace internal
+
+/// @submodule{pw_allocator,concrete}
+
+/// Allocator for objects of a small number of fixed sizes.
+///
+/// This allocator groups objects by size class, and allocates them from
+/// "slabs" of `kSlabSize` bytes that are themselves allocated from a parent
+/// allocator. Each slab holds objects of a single size class, and tracks free
+/// objects with a bitmap.
+///
+/// Compared to block allocators, this allocator:
+///
+/// * Allocates and deallocates in constant time, without splitting or merging
+///   blocks.
+/// * Adds no header to individual objects.
+/// * Rounds requests up to the next size class. Requests larger than the
+///   largest size class fail.
+/// * Aligns objects to the largest power of two that divides their size.
+///   Requests are rounded up to the first size class that is both large enough
+///   and sufficiently aligned.
+///
+/// Slabs are returned to the parent allocator when they become empty, except
+/// for the last partially used slab of each size class. This avoids repeatedly
+/// allocating and freeing a slab when a single object is allocated and freed
+/// in a loop.
+///
+/// Use this allocator when most objects have one of a handful of known sizes,
+/// such as RPC call objects or container nodes.
+///
+/// @tparam   kSlabSize           Size of each slab. Must be a power of two.
+///                               The parent allocator must be able to allocate
+///                               memory with this size and alignment.
+/// @tparam   kMaxNumSizeClasses  Maximum number of size classes.
+template <size_t kSlabSize = 4096, size_t kMaxNumSizeClasses = 8>
+class SlabAllocator : public internal::GenericSlabAllocator {
+ private:
+  using Base = internal::GenericSlabAllocator;
+
+ public:
+  static_assert((kSlabSize & (kSlabSize - 1)) == 0,
+                "kSlabSize must be a power of 2");
+  static_assert(kMaxNumSizeClasses != 0,
+                "SlabAllocator must have at least one size class");
+
+  /// Constructs an allocator.
+  ///
+  /// @param[in]  parent        Allocator used to allocate slabs.
+  /// @param[in]  object_sizes  Sizes of objects to allocate, in increasing
+  ///                           order. There must be at most
+  ///                           `kMaxNumSizeClasses` sizes.
+  SlabAllocator(Allocator& parent, span<const size_t> object_sizes)
+      : Base(parent, kSlabSize) {
+    Base::Init(size_classes_, object_sizes);
+  }
+
+  ~SlabAllocator() override { Base::Reset(); }
+
+ private:
+  std::array<SizeClass, kMaxNumSizeClasses> size_classes_;
+};
+
+/// @}
+
+}  // namespace pw::allocator
@@ -0,0 +1,462 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <optional>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/allocator.h"
+#include "pw_allocator/layout.h"
+#include "pw_preprocessor/compiler.h"
+#include "pw_result/result.h"
+#include "pw_span/span.h"
+#include "pw_sync/lock_annotations.h"
+
+namespace pw::allocator {
+
+template <size_t kMagazineCapacity>
+class ThreadCache;
+
+namespace internal {
+
+/// Generic base class for a `ThreadCachingAllocator`.
+///
+/// Small allocations are rounded up to one of a fixed number of power-of-two
+/// size classes, so that a block freed by one thread can be reused by any
+/// other thread for any request of the same class.
+///
+/// Since `Deallocate` is not given a layout, every allocation is preceded by a
+/// small prefix that records its size class and the offset from the start of
+/// the block allocated from the underlying allocator:
+///
+///   [padding...] | offset, size_class | usable_space...
+///
+/// This class is not templated on the lock type, and contains the methods
+/// that only deal with size classes and prefixes.
+class GenericThreadCachingAllocator : public pw::Allocator {
+ public:
+  /// Size of the smallest size class.
+  static constexpr size_t kMinCachedSize = 16;
+
+  /// Number of size classes. Each is twice the size of the previous one.
+  static constexpr size_t kNumSizeClasses = 8;
+
+  /// Largest request that is served from a thread cache. Larger requests, or
+  /// those with alignments greater than `alignof(std::max_align_t)`, always go
+  /// to the underlying allocator.
+  static constexpr size_t kMaxCachedSize = kMinCachedSize
+                                           << (kNumSizeClasses - 1);
+
+  /// Size class value of allocations that are not cached.
+  static constexpr size_t kUncached = kNumSizeClasses;
+
+ protected:
+  template <size_t>
+  friend class ::pw::allocator::ThreadCache;
+
+  /// Bytes reserved before the usable space of every allocation.
+  static constexpr size_t kPrefixSize = alignof(std::max_align_t);
+
+  struct Prefix {
+    uint32_t offset;
+    uint32_t size_class;
+  };
+  static_assert(sizeof(Prefix) <= kPrefixSize);
+
+  constexpr explicit GenericThreadCachingAllocator(
+      const Capabilities& capabilities)
+      : Allocator(capabilities) {}
+
+  /// Returns the capabilities of a thread caching allocator that wraps the
+  /// given allocator.
+  ///
+  /// The requested size of cached allocations is not recorded, so this
+  /// allocator does not implement `GetRequestedLayout`.
+  static constexpr Capabilities GetCapabilities(const Allocator& allocator) {
+    return Capabilities(allocator.capabilities().get() &
+                        ~uint32_t{kImplementsGetRequestedLayout});
+  }
+
+  /// Returns the size class of a layout, or `kUncached`.
+  static constexpr size_t GetSizeClass(Layout layout) {
+    if (layout.size() > kMaxCachedSize ||
+        layout.alignment() > alignof(std::max_align_t)) {
+      return kUncached;
+    }
+    size_t size = layout.size() < kMinCachedSize ? kMinCachedSize
+                                                 : layout.size();
+    return static_cast<size_t>(cpp20::bit_width(size - 1) -
+                               cpp20::bit_width(kMinCachedSize - 1));
+  }
+
+  /// Returns the size class recorded in the prefix of an allocation.
+  static size_t GetSizeClass(const void* ptr) {
+    return GetPrefix(ptr).size_class;
+  }
+
+  /// Returns the usable size of allocations of the given size class.
+  static constexpr size_t GetClassSize(size_t size_class) {
+    return kMinCachedSize << size_class;
+  }
+
+  /// Returns the layout to request from the underlying allocator for the
+  /// given layout and size class, including space for the prefix.
+  ///
+  /// Returns `ResourceExhausted` if the adjusted size overflows.
+  static Result<Layout> AdjustLayout(Layout layout, size_t size_class);
+
+  /// Adds a prefix to an allocation from the underlying allocator, and returns
+  /// a pointer to the usable space following it.
+  static void* AddPrefix(void* ptr, size_t alignment, size_t size_class);
+
+  /// Takes a pointer to usable space and returns the pointer to the original
+  /// allocation from the underlying allocator.
+  static void* GetOriginal(void* ptr);
+
+  /// Modifies the new size of a `Resize` request to account for the prefix.
+  static size_t AdjustSize(const void* ptr, size_t new_size);
+
+  /// Adjusts the usable layout of an original allocation to exclude the
+  /// prefix.
+  static Layout AdjustUsableLayout(const void* ptr, Layout layout);
+
+  /// Allocates up to `ptrs.size()` allocations of the given size class while
+  /// holding the lock once.
+  ///
+  /// @returns The number of allocations written to `ptrs`.
+  size_t Refill(size_t size_class, span<void*> ptrs) {
+    return DoRefill(size_class, ptrs);
+  }
+
+  /// Deallocates all of `ptrs` while holding the lock once.
+  void Flush(span<void*> ptrs) { DoFlush(ptrs); }
+
+ private:
+  static const Prefix& GetPrefix(const void* ptr) {
+    return *std::launder(reinterpret_cast<const Prefix*>(
+        static_cast<const std::byte*>(ptr) - sizeof(Prefix)));
+  }
+
+  /// @copydoc Refill
+  virtual size_t DoRefill(size_t size_class, span<void*> ptrs) = 0;
+
+  /// @copydoc Flush
+  virtual void DoFlush(span<void*> ptrs) = 0;
+};
+
+}  // namespace internal
+
+/// @submodule{pw_allocator,forwarding}
+
+/// Wraps an `Allocator` with a lock, and lets threads cache small blocks in
+/// order to avoid contending on that lock.
+///
+/// A `ThreadCachingAllocator` may be used directly in the same way as a
+/// `SynchronizedAllocator`. In addition, each thread that allocates
+/// frequently can create its own `ThreadCache` that refers to the shared
+/// allocator, and use it instead. Memory allocated from the shared allocator
+/// or any of its thread caches may be deallocated using any of the others.
+///
+/// Small requests are rounded up to a power-of-two size class. Blocks of each
+/// class are moved between the thread caches and the underlying allocator in
+/// batches, so that the lock is acquired at most once per batch. Each
+/// allocation also includes a prefix of `alignof(std::max_align_t)` bytes
+/// that records its size class.
+///
+/// Blocks held in thread caches are counted as allocated by the underlying
+/// allocator, and are only returned to it when a cache fills up, is flushed,
+/// or is destroyed.
+///
+/// Example:
+/// @code{.cpp}
+///   pw::allocator::TlsfAllocator tlsf(heap);
+///   pw::allocator::ThreadCachingAllocator<pw::sync::Mutex> shared(tlsf);
+///
+///   // On each worker thread:
+///   pw::allocator::ThreadCache<> cache(shared);
+///   pw::Allocator& allocator = cache;
+/// @endcode
+///
+/// @tparam LockType  The type of the lock used to synchronize access to the
+///                   underlying allocator. Must be default-constructible.
+template <typename LockType>
+class ThreadCachingAllocator : public internal::GenericThreadCachingAllocator {
+ private:
+  using Base = internal::GenericThreadCachingAllocator;
+
+ public:
+  explicit ThreadCachingAllocator(Allocator& allocator) noexcept
+      : Base(Base::GetCapabilities(allocator)), allocator_(allocator) {}
+
+ private:
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override;
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override {
+    std::lock_guard lock(lock_);
+    return allocator_.GetAllocated();
+  }
+
+  /// @copydoc Allocator::MeasureFragmentation
+  std::optional<Fragmentation> DoMeasureFragmentation() const override {
+    std::lock_guard lock(lock_);
+    return allocator_.MeasureFragmentation();
+  }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override;
+
+  /// @copydoc GenericThreadCachingAllocator::Refill
+  size_t DoRefill(size_t size_class, span<void*> ptrs) override;
+
+  /// @copydoc GenericThreadCachingAllocator::Flush
+  void DoFlush(span<void*> ptrs) override;
+
+  Allocator& allocator_ PW_GUARDED_BY(lock_);
+  mutable LockType lock_;
+};
+
+/// Per-thread front end for a `ThreadCachingAllocator`.
+///
+/// Each thread cache holds a magazine of free blocks for each size class.
+/// Allocating and deallocating small blocks only touches these magazines,
+/// and does not acquire any lock. When a magazine is empty, it is refilled
+/// with half its capacity from the shared allocator. When it is full, half of
+/// it is flushed back.
+///
+/// A thread cache is NOT thread-safe, and must only be used by the thread
+/// that owns it. The shared allocator must outlive all of its thread caches.
+///
+/// @tparam kMagazineCapacity   Maximum number of free blocks cached for each
+///                             size class.
+template <size_t kMagazineCapacity = 16>
+class ThreadCache : public pw::Allocator {
+ private:
+  using Generic = internal::GenericThreadCachingAllocator;
+  static_assert(kMagazineCapacity >= 2,
+                "Magazines must have room for at least two blocks");
+  static constexpr size_t kBatchSize = kMagazineCapacity / 2;
+
+ public:
+  explicit ThreadCache(Generic& allocator)
+      : Allocator(allocator.capabilities()), allocator_(allocator) {}
+
+  ~ThreadCache() override { Flush(); }
+
+  ThreadCache(const ThreadCache&) = delete;
+  ThreadCache& operator=(const ThreadCache&) = delete;
+
+  /// Returns all cached blocks to the shared allocator.
+  void Flush();
+
+ private:
+  struct Magazine {
+    std::array<void*, kMagazineCapacity> ptrs;
+    size_t count = 0;
+  };
+
+  /// @copydoc Allocator::Allocate
+  void* DoAllocate(Layout layout) override;
+
+  /// @copydoc Allocator::Deallocate
+  void DoDeallocate(void* ptr) override;
+
+  /// @copydoc Allocator::Resize
+  bool DoResize(void* ptr, size_t new_size) override {
+    return allocator_.Resize(ptr, new_size);
+  }
+
+  /// @copydoc Allocator::GetAllocated
+  size_t DoGetAllocated() const override { return allocator_.GetAllocated(); }
+
+  /// @copydoc Allocator::MeasureFragmentation
+  std::optional<Fragmentation> DoMeasureFragmentation() const override {
+    return allocator_.MeasureFragmentation();
+  }
+
+  /// @copydoc Deallocator::GetInfo
+  Result<Layout> DoGetInfo(InfoType info_type, const void* ptr) const override {
+    return GetInfo(allocator_, info_type, ptr);
+  }
+
+  Generic& allocator_;
+  std::array<Magazine, Generic::kNumSizeClasses> magazines_;
+};
+
+/// @}
+
+// Template method implementations.
+
+template <typename LockType>
+void* ThreadCachingAllocator<LockType>::DoAllocate(Layout layout) {
+  size_t size_class = Base::GetSizeClass(layout);
+  Result<Layout> adjusted = Base::AdjustLayout(layout, size_class);
+  if (!adjusted.ok()) {
+    return nullptr;
+  }
+  void* ptr;
+  {
+    std::lock_guard lock(lock_);
+    ptr = allocator_.Allocate(*adjusted);
+  }
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  return Base::AddPrefix(ptr, layout.alignment(), size_class);
+}
+
+template <typename LockType>
+void ThreadCachingAllocator<LockType>::DoDeallocate(void* ptr) {
+  ptr = Base::GetOriginal(ptr);
+  std::lock_guard lock(lock_);
+  allocator_.Deallocate(ptr);
+}
+
+template <typename LockType>
+bool ThreadCachingAllocator<LockType>::DoResize(void* ptr, size_t new_size) {
+  size_t size_class = Base::GetSizeClass(ptr);
+  if (size_class != kUncached) {
+    return new_size <= Base::GetClassSize(size_class);
+  }
+  new_size = Base::AdjustSize(ptr, new_size);
+  ptr = Base::GetOriginal(ptr);
+  std::lock_guard lock(lock_);
+  return allocator_.Resize(ptr, new_size);
+}
+
+template <typename LockType>
+Result<Layout> ThreadCachingAllocator<LockType>::DoGetInfo(
+    InfoType info_type, const void* ptr) const {
+  switch (info_type) {
+    case InfoType::kRequestedLayoutOf:
+      return Status::Unimplemented();
+    case InfoType::kUsableLayoutOf: {
+      size_t size_class = Base::GetSizeClass(ptr);
+      if (size_class != kUncached) {
+        return Layout(Base::GetClassSize(size_class),
+                      alignof(std::max_align_t));
+      }
+      const void* original = Base::GetOriginal(const_cast<void*>(ptr));
+      Result<Layout> usable;
+      {
+        std::lock_guard lock(lock_);
+        usable = GetInfo(allocator_, info_type, original);
+      }
+      if (!usable.ok()) {
+        return usable;
+      }
+      return Base::AdjustUsableLayout(ptr, *usable);
+    }
+    case InfoType::kAllocatedLayoutOf: {
+      const void* original = Base::GetOriginal(const_cast<void*>(ptr));
+      std::lock_guard lock(lock_);
+      return GetInfo(allocator_, info_type, original);
+    }
+    case InfoType::kCapacity:
+    case InfoType::kRecognizes: {
+      std::lock_guard lock(lock_);
+      return GetInfo(allocator_, info_type, ptr);
+    }
+  }
+  PW_UNREACHABLE;
+}
+
+template <typename LockType>
+size_t ThreadCachingAllocator<LockType>::DoRefill(size_t size_class,
+                                                  span<void*> ptrs) {
+  Layout layout(Base::GetClassSize(size_class), alignof(std::max_align_t));
+  Result<Layout> adjusted = Base::AdjustLayout(layout, size_class);
+  if (!adjusted.ok()) {
+    return 0;
+  }
+  size_t count = 0;
+  {
+    std::lock_guard lock(lock_);
+    for (; count < ptrs.size(); ++count) {
+      ptrs[count] = allocator_.Allocate(*adjusted);
+      if (ptrs[count] == nullptr) {
+        break;
+      }
+    }
+  }
+  for (size_t i = 0; i < count; ++i) {
+    ptrs[i] = Base::AddPrefix(ptrs[i], layout.alignment(), size_class);
+  }
+  return count;
+}
+
+template <typename LockType>
+void ThreadCachingAllocator<LockType>::DoFlush(span<void*> ptrs) {
+  for (void*& ptr : ptrs) {
+    ptr = Base::GetOriginal(ptr);
+  }
+  std::lock_guard lock(lock_);
+  for (void* ptr : ptrs) {
+    allocator_.Deallocate(ptr);
+  }
+}
+
+template <size_t kMagazineCapacity>
+void ThreadCache<kMagazineCapacity>::Flush() {
+  for (Magazine& magazine : magazines_) {
+    allocator_.Flush(span(magazine.ptrs).first(magazine.count));
+    magazine.count = 0;
+  }
+}
+
+template <size_t kMagazineCapacity>
+void* ThreadCache<kMagazineCapacity>::DoAllocate(Layout layout) {
+  size_t size_class = Generic::GetSizeClass(layout);
+  if (size_class == Generic::kUncached) {
+    return allocator_.Allocate(layout);
+  }
+  Magazine& magazine = magazines_[size_class];
+  if (magazine.count == 0) {
+    magazine.count =
+        allocator_.Refill(size_class, span(magazine.ptrs).first(kBatchSize));
+    if (magazine.count == 0) {
+      return nullptr;
+    }
+  }
+  return magazine.ptrs[--magazine.count];
+}
+
+template <size_t kMagazineCapacity>
+void ThreadCache<kMagazineCapacity>::DoDeallocate(void* ptr) {
+  size_t size_class = Generic::GetSizeClass(ptr);
+  if (size_class == Generic::kUncached) {
+    allocator_.Deallocate(ptr);
+    return;
+  }
+  Magazine& magazine = magazines_[size_class];
+  if (magazine.count == kMagazineCapacity) {
+    magazine.count -= kBatchSize;
+    allocator_.Flush(span(magazine.ptrs).subspan(magazine.count));
+  }
+  magazine.ptrs[magazine.count++] = ptr;
+}
+
+}  // namespace pw::allocator
@@ -0,0 +1,259 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/slab_allocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_allocator/hardening.h"
+#include "pw_assert/check.h"
+#include "pw_bytes/alignment.h"
+
+namespace pw::allocator::internal {
+
+/// Header at the start of every slab. It is followed by a bitmap with one set
+/// bit for each free object.
+struct GenericSlabAllocator::Slab {
+  Slab* prev = nullptr;
+  Slab* next = nullptr;
+  size_t size_class = 0;
+  size_t num_free = 0;
+
+  uintptr_t* bitmap() { return reinterpret_cast<uintptr_t*>(this + 1); }
+
+  std::byte* objects(size_t offset) {
+    return reinterpret_cast<std::byte*>(this) + offset;
+  }
+};
+
+namespace {
+
+constexpr size_t kBitsPerWord = std::numeric_limits<uintptr_t>::digits;
+
+}  // namespace
+
+void GenericSlabAllocator::Push(Slab*& head, Slab* slab) {
+  slab->prev = nullptr;
+  slab->next = head;
+  if (head != nullptr) {
+    head->prev = slab;
+  }
+  head = slab;
+}
+
+void GenericSlabAllocator::Unlink(Slab*& head, Slab* slab) {
+  if (slab->prev == nullptr) {
+    head = slab->next;
+  } else {
+    slab->prev->next = slab->next;
+  }
+  if (slab->next != nullptr) {
+    slab->next->prev = slab->prev;
+  }
+  slab->prev = nullptr;
+  slab->next = nullptr;
+}
+
+void GenericSlabAllocator::Init(span<SizeClass> size_classes,
+                                span<const size_t> object_sizes) {
+  PW_CHECK(!object_sizes.empty(), "a slab allocator needs a size class");
+  PW_CHECK_UINT_LE(object_sizes.size(),
+                   size_classes.size(),
+                   "too many object sizes for slab allocator");
+  size_classes_ = size_classes.first(object_sizes.size());
+  size_t prev_size = 0;
+  for (size_t i = 0; i < object_sizes.size(); ++i) {
+    size_t size = object_sizes[i];
+    PW_CHECK_UINT_GT(size, prev_size, "object sizes must be increasing");
+    prev_size = size;
+
+    // Objects are packed back-to-back, so align them to the largest power of
+    // two that divides their size. Slabs are aligned to their size, so objects
+    // whose size is a power of two are naturally aligned.
+    size_t alignment = size & (~size + 1);
+
+    // Find the largest number of objects that fit in a slab along with the
+    // header and bitmap.
+    size_t num_objects = (slab_size_ - sizeof(Slab)) / size;
+    size_t bitmap_words = 0;
+    size_t objects_offset = 0;
+    for (; num_objects != 0; --num_objects) {
+      bitmap_words = (num_objects + kBitsPerWord - 1) / kBitsPerWord;
+      objects_offset =
+          AlignUp(sizeof(Slab) + bitmap_words * sizeof(uintptr_t), alignment);
+      if (objects_offset + num_objects * size <= slab_size_) {
+        break;
+      }
+    }
+    PW_CHECK_UINT_NE(num_objects,
+                     0,
+                     "objects of %zu bytes do not fit in a %zu byte slab",
+                     size,
+                     slab_size_);
+
+    SizeClass& size_class = size_classes_[i];
+    size_class.object_size = size;
+    size_class.object_alignment = alignment;
+    size_class.num_objects = num_objects;
+    size_class.bitmap_words = bitmap_words;
+    size_class.objects_offset = objects_offset;
+  }
+}
+
+void GenericSlabAllocator::Reset() {
+  if constexpr (Hardening::kIncludesRobustChecks) {
+    PW_CHECK_INT_EQ(allocated_,
+                    0,
+                    "%zu bytes were still in use when an allocator was "
+                    "destroyed. All memory allocated by an allocator must be "
+                    "released before the allocator goes out of scope.",
+                    allocated_);
+  }
+  for (SizeClass& size_class : size_classes_) {
+    for (Slab** list : {&size_class.partial, &size_class.full}) {
+      while (*list != nullptr) {
+        Slab* slab = *list;
+        Unlink(*list, slab);
+        parent_.Deallocate(slab);
+        --num_slabs_;
+      }
+    }
+  }
+  allocated_ = 0;
+}
+
+void* GenericSlabAllocator::DoAllocate(Layout layout) {
+  size_t index = 0;
+  for (; index < size_classes_.size(); ++index) {
+    const SizeClass& size_class = size_classes_[index];
+    if (layout.size() <= size_class.object_size &&
+        layout.alignment() <= size_class.object_alignment) {
+      break;
+    }
+  }
+  if (index == size_classes_.size()) {
+    return nullptr;
+  }
+  SizeClass& size_class = size_classes_[index];
+  Slab* slab = size_class.partial;
+  if (slab == nullptr) {
+    slab = AddSlab(size_class, index);
+    if (slab == nullptr) {
+      return nullptr;
+    }
+  }
+
+  // A partial slab has at least one set bit.
+  uintptr_t* bitmap = slab->bitmap();
+  size_t word = 0;
+  while (bitmap[word] == 0) {
+    ++word;
+  }
+  auto bit = static_cast<size_t>(cpp20::countr_zero(bitmap[word]));
+  bitmap[word] &= bitmap[word] - 1;
+
+  if (--slab->num_free == 0) {
+    Unlink(size_class.partial, slab);
+    Push(size_class.full, slab);
+  }
+  allocated_ += size_class.object_size;
+  return slab->objects(size_class.objects_offset) +
+         (word * kBitsPerWord + bit) * size_class.object_size;
+}
+
+void GenericSlabAllocator::DoDeallocate(void* ptr) {
+  Slab* slab = GetSlab(ptr);
+  SizeClass& size_class = size_classes_[slab->size_class];
+  auto offset = static_cast<size_t>(static_cast<std::byte*>(ptr) -
+                                    slab->objects(size_class.objects_offset));
+  size_t index = offset / size_class.object_size;
+  size_t word = index / kBitsPerWord;
+  uintptr_t mask = uintptr_t{1} << (index % kBitsPerWord);
+  uintptr_t* bitmap = slab->bitmap();
+  if constexpr (Hardening::kIncludesDebugChecks) {
+    size_t misalignment = offset % size_class.object_size;
+    PW_CHECK_UINT_EQ(misalignment, 0, "pointer does not point to an object");
+    PW_CHECK_UINT_LT(index, size_class.num_objects);
+    PW_CHECK((bitmap[word] & mask) == 0, "object was already freed");
+  }
+  bitmap[word] |= mask;
+
+  if (slab->num_free++ == 0) {
+    Unlink(size_class.full, slab);
+    Push(size_class.partial, slab);
+  }
+  allocated_ -= size_class.object_size;
+
+  // Return empty slabs to the parent, unless it is the only partial slab.
+  if (slab->num_free == size_class.num_objects &&
+      (slab->prev != nullptr || slab->next != nullptr)) {
+    Unlink(size_class.partial, slab);
+    parent_.Deallocate(slab);
+    --num_slabs_;
+  }
+}
+
+bool GenericSlabAllocator::DoResize(void* ptr, size_t new_size) {
+  const Slab* slab = GetSlab(ptr);
+  return new_size <= size_classes_[slab->size_class].object_size;
+}
+
+Result<Layout> GenericSlabAllocator::DoGetInfo(InfoType info_type,
+                                               const void* ptr) const {
+  switch (info_type) {
+    case InfoType::kUsableLayoutOf:
+    case InfoType::kAllocatedLayoutOf: {
+      const SizeClass& size_class = size_classes_[GetSlab(ptr)->size_class];
+      return Layout(size_class.object_size, size_class.object_alignment);
+    }
+    case InfoType::kRequestedLayoutOf:
+    case InfoType::kCapacity:
+    case InfoType::kRecognizes:
+    default:
+      return Status::Unimplemented();
+  }
+}
+
+GenericSlabAllocator::Slab* GenericSlabAllocator::GetSlab(
+    const void* ptr) const {
+  auto addr = cpp20::bit_cast<uintptr_t>(ptr);
+  return cpp20::bit_cast<Slab*>(addr & ~static_cast<uintptr_t>(slab_size_ - 1));
+}
+
+GenericSlabAllocator::Slab* GenericSlabAllocator::AddSlab(
+    SizeClass& size_class, size_t index) {
+  void* ptr = parent_.Allocate(Layout(slab_size_, slab_size_));
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  auto* slab = new (ptr) Slab();
+  slab->size_class = index;
+  slab->num_free = size_class.num_objects;
+  uintptr_t* bitmap = slab->bitmap();
+  size_t remaining = size_class.num_objects;
+  for (size_t i = 0; i < size_class.bitmap_words; ++i) {
+    bitmap[i] = remaining >= kBitsPerWord
+                    ? std::numeric_limits<uintptr_t>::max()
+                    : (uintptr_t{1} << remaining) - 1;
+    remaining -= std::min(remaining, kBitsPerWord);
+  }
+  Push(size_class.partial, slab);
+  ++num_slabs_;
+  return slab;
+}
+
+}  // namespace pw::allocator::internal
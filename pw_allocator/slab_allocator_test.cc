@@ -0,0 +1,274 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/slab_allocator.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_allocator/testing.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 0x4000;
+static constexpr size_t kSlabSize = 1024;
+
+using ::pw::allocator::Layout;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
+using SlabAllocator = ::pw::allocator::SlabAllocator<kSlabSize, 4>;
+
+class SlabAllocatorForTest : public SlabAllocator {
+ public:
+  using SlabAllocator::GetUsableLayout;
+  using SlabAllocator::SlabAllocator;
+};
+
+constexpr std::array<size_t, 3> kObjectSizes = {16, 48, 256};
+
+/// Returns the number of `object_size`-byte objects that fit in a slab.
+size_t CountObjectsPerSlab(SlabAllocatorForTest& allocator,
+                           size_t object_size) {
+  size_t num_objects = 0;
+  size_t num_slabs = allocator.num_slabs();
+  std::array<void*, kSlabSize / 16> ptrs{};
+  while (true) {
+    void* ptr = allocator.Allocate(Layout(object_size));
+    if (allocator.num_slabs() != num_slabs + 1) {
+      allocator.Deallocate(ptr);
+      break;
+    }
+    ptrs[num_objects++] = ptr;
+  }
+  for (size_t i = 0; i < num_objects; ++i) {
+    allocator.Deallocate(ptrs[i]);
+  }
+  return num_objects;
+}
+
+// Unit tests.
+
+TEST(SlabAllocatorTest, AllocatesFromParentLazily) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  EXPECT_EQ(allocator.slab_size(), kSlabSize);
+  EXPECT_EQ(allocator.num_slabs(), 0u);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 0u);
+
+  void* ptr = allocator.Allocate(Layout(8));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator.num_slabs(), 1u);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 1u);
+  allocator.Deallocate(ptr);
+}
+
+TEST(SlabAllocatorTest, SelectsSmallestSizeClass) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  for (size_t size : {1u, 16u, 17u, 48u, 49u, 256u}) {
+    void* ptr = allocator.Allocate(Layout(size));
+    ASSERT_NE(ptr, nullptr);
+    pw::Result<Layout> layout = allocator.GetUsableLayout(ptr);
+    ASSERT_EQ(layout.status(), pw::OkStatus());
+    size_t expected = size <= 16 ? 16 : size <= 48 ? 48 : 256;
+    EXPECT_EQ(layout->size(), expected);
+    allocator.Deallocate(ptr);
+  }
+}
+
+TEST(SlabAllocatorTest, RejectsOversizedRequests) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  EXPECT_EQ(allocator.Allocate(Layout(257)), nullptr);
+  EXPECT_EQ(allocator.num_slabs(), 0u);
+}
+
+TEST(SlabAllocatorTest, RejectsOverAlignedRequests) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  EXPECT_EQ(allocator.Allocate(Layout(16, 512)), nullptr);
+}
+
+TEST(SlabAllocatorTest, AlignsObjectsToSizeClass) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  void* ptr = allocator.Allocate(Layout(16, 256));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 256, 0u);
+  pw::Result<Layout> layout = allocator.GetUsableLayout(ptr);
+  ASSERT_EQ(layout.status(), pw::OkStatus());
+  EXPECT_EQ(layout->size(), 256u);
+  allocator.Deallocate(ptr);
+}
+
+TEST(SlabAllocatorTest, AlignsObjects) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  std::array<void*, 8> ptrs{};
+  for (void*& ptr : ptrs) {
+    ptr = allocator.Allocate(Layout(48, 16));
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, 0u);
+  }
+  for (void* ptr : ptrs) {
+    allocator.Deallocate(ptr);
+  }
+}
+
+TEST(SlabAllocatorTest, ObjectsDoNotOverlap) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  std::array<std::byte*, 32> ptrs{};
+  for (size_t i = 0; i < ptrs.size(); ++i) {
+    ptrs[i] = static_cast<std::byte*>(allocator.Allocate(Layout(48)));
+    ASSERT_NE(ptrs[i], nullptr);
+    std::memset(ptrs[i], static_cast<int>(i), 48);
+  }
+  for (size_t i = 0; i < ptrs.size(); ++i) {
+    for (size_t j = 0; j < 48; ++j) {
+      EXPECT_EQ(ptrs[i][j], static_cast<std::byte>(i));
+    }
+    allocator.Deallocate(ptrs[i]);
+  }
+}
+
+TEST(SlabAllocatorTest, ReusesFreedObjects) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  void* ptr1 = allocator.Allocate(Layout(16));
+  void* ptr2 = allocator.Allocate(Layout(16));
+  ASSERT_NE(ptr1, nullptr);
+  ASSERT_NE(ptr2, nullptr);
+  allocator.Deallocate(ptr1);
+  void* ptr3 = allocator.Allocate(Layout(16));
+  EXPECT_EQ(ptr3, ptr1);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 1u);
+  allocator.Deallocate(ptr2);
+  allocator.Deallocate(ptr3);
+}
+
+TEST(SlabAllocatorTest, KeepsLastPartialSlab) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  for (size_t i = 0; i < 10; ++i) {
+    void* ptr = allocator.Allocate(Layout(16));
+    ASSERT_NE(ptr, nullptr);
+    allocator.Deallocate(ptr);
+  }
+  EXPECT_EQ(allocator.num_slabs(), 1u);
+  EXPECT_EQ(parent.metrics().num_allocations.value(), 1u);
+  EXPECT_EQ(parent.metrics().num_deallocations.value(), 0u);
+}
+
+TEST(SlabAllocatorTest, AllocatesNewSlabWhenFull) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  size_t num_objects = CountObjectsPerSlab(allocator, 256);
+  EXPECT_EQ(num_objects, 3u);
+  EXPECT_EQ(allocator.num_slabs(), 1u);
+
+  std::array<void*, 4> ptrs{};
+  for (void*& ptr : ptrs) {
+    ptr = allocator.Allocate(Layout(256));
+    ASSERT_NE(ptr, nullptr);
+  }
+  EXPECT_EQ(allocator.num_slabs(), 2u);
+
+  // Freeing an object in the full slab makes it partial again.
+  allocator.Deallocate(ptrs[0]);
+  void* ptr = allocator.Allocate(Layout(256));
+  EXPECT_EQ(ptr, ptrs[0]);
+  EXPECT_EQ(allocator.num_slabs(), 2u);
+  ptrs[0] = ptr;
+
+  for (void* p : ptrs) {
+    allocator.Deallocate(p);
+  }
+  EXPECT_EQ(allocator.num_slabs(), 1u);
+}
+
+TEST(SlabAllocatorTest, ReturnsEmptySlabsToParent) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  size_t per_slab = CountObjectsPerSlab(allocator, 48);
+  ASSERT_GT(per_slab, 0u);
+  size_t num_deallocations = parent.metrics().num_deallocations.value();
+
+  constexpr size_t kNumSlabs = 3;
+  std::array<void*, kSlabSize / 48 * kNumSlabs> ptrs{};
+  size_t num_ptrs = per_slab * kNumSlabs;
+  ASSERT_LE(num_ptrs, ptrs.size());
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    ptrs[i] = allocator.Allocate(Layout(48));
+    ASSERT_NE(ptrs[i], nullptr);
+  }
+  EXPECT_EQ(allocator.num_slabs(), kNumSlabs);
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    allocator.Deallocate(ptrs[i]);
+  }
+  EXPECT_EQ(allocator.num_slabs(), 1u);
+  EXPECT_EQ(parent.metrics().num_deallocations.value(),
+            num_deallocations + kNumSlabs - 1);
+}
+
+TEST(SlabAllocatorTest, FailsWhenParentIsExhausted) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  parent.Exhaust();
+  EXPECT_EQ(allocator.Allocate(Layout(16)), nullptr);
+  EXPECT_EQ(allocator.num_slabs(), 0u);
+}
+
+TEST(SlabAllocatorTest, ResizeWithinSizeClass) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  void* ptr = allocator.Allocate(Layout(20));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(allocator.Resize(ptr, 48));
+  EXPECT_TRUE(allocator.Resize(ptr, 1));
+  EXPECT_FALSE(allocator.Resize(ptr, 49));
+  allocator.Deallocate(ptr);
+}
+
+TEST(SlabAllocatorTest, GetAllocated) {
+  AllocatorForTest parent;
+  SlabAllocatorForTest allocator(parent, kObjectSizes);
+  void* ptr1 = allocator.Allocate(Layout(10));
+  void* ptr2 = allocator.Allocate(Layout(100));
+  EXPECT_EQ(allocator.GetAllocated(), 16u + 256u);
+  allocator.Deallocate(ptr1);
+  EXPECT_EQ(allocator.GetAllocated(), 256u);
+  allocator.Deallocate(ptr2);
+  EXPECT_EQ(allocator.GetAllocated(), 0u);
+}
+
+TEST(SlabAllocatorTest, DestructorReturnsSlabs) {
+  AllocatorForTest parent;
+  {
+    SlabAllocatorForTest allocator(parent, kObjectSizes);
+    for (size_t size : kObjectSizes) {
+      void* ptr = allocator.Allocate(Layout(size));
+      ASSERT_NE(ptr, nullptr);
+      allocator.Deallocate(ptr);
+    }
+    EXPECT_EQ(allocator.num_slabs(), kObjectSizes.size());
+  }
+  EXPECT_EQ(parent.metrics().num_deallocations.value(), kObjectSizes.size());
+}
+
+}  // namespace
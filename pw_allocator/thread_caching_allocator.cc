@@ -0,0 +1,85 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/thread_caching_allocator.h"
+
+#include <algorithm>
+
+#include "pw_assert/check.h"
+#include "pw_numeric/checked_arithmetic.h"
+
+namespace pw::allocator::internal {
+namespace {
+
+// Returns the distance from the start of an allocation from the underlying
+// allocator to the usable space that follows the prefix.
+size_t GetOffset(size_t alignment, size_t size_class, size_t prefix_size) {
+  if (size_class != GenericThreadCachingAllocator::kUncached) {
+    return prefix_size;
+  }
+  // Both values are powers of two, so the offset preserves the alignment.
+  return std::max(alignment, prefix_size);
+}
+
+}  // namespace
+
+Result<Layout> GenericThreadCachingAllocator::AdjustLayout(Layout layout,
+                                                           size_t size_class) {
+  if (size_class != kUncached) {
+    return Layout(kPrefixSize + GetClassSize(size_class),
+                  alignof(std::max_align_t));
+  }
+  size_t offset = GetOffset(layout.alignment(), size_class, kPrefixSize);
+  size_t size;
+  if (!CheckedAdd(layout.size(), offset, size)) {
+    return Status::ResourceExhausted();
+  }
+  return Layout(size, std::max(layout.alignment(), alignof(Prefix)));
+}
+
+void* GenericThreadCachingAllocator::AddPrefix(void* ptr,
+                                               size_t alignment,
+                                               size_t size_class) {
+  size_t offset = GetOffset(alignment, size_class, kPrefixSize);
+  auto* usable = static_cast<std::byte*>(ptr) + offset;
+  new (usable - sizeof(Prefix)) Prefix{
+      static_cast<uint32_t>(offset),
+      static_cast<uint32_t>(size_class),
+  };
+  return usable;
+}
+
+void* GenericThreadCachingAllocator::GetOriginal(void* ptr) {
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  return static_cast<std::byte*>(ptr) - GetPrefix(ptr).offset;
+}
+
+size_t GenericThreadCachingAllocator::AdjustSize(const void* ptr,
+                                                 size_t new_size) {
+  size_t offset = GetPrefix(ptr).offset;
+  PW_CHECK(CheckedIncrement(new_size, offset),
+           "size overflow when adding prefix");
+  return new_size;
+}
+
+Layout GenericThreadCachingAllocator::AdjustUsableLayout(const void* ptr,
+                                                         Layout layout) {
+  size_t offset = GetPrefix(ptr).offset;
+  PW_CHECK_UINT_GE(layout.size(), offset);
+  return Layout(layout.size() - offset, layout.alignment());
+}
+
+}  // namespace pw::allocator::internal
@@ -0,0 +1,326 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_allocator/thread_caching_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_allocator/sync_allocator_testing.h"
+#include "pw_allocator/test_harness.h"
+#include "pw_allocator/testing.h"
+#include "pw_sync/mutex.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+// Test fixtures.
+
+static constexpr size_t kCapacity = 8192;
+static constexpr size_t kMagazineCapacity = 4;
+
+using ::pw::allocator::Layout;
+using ::pw::allocator::ThreadCache;
+using ::pw::allocator::ThreadCachingAllocator;
+using AllocatorForTest = ::pw::allocator::test::AllocatorForTest<kCapacity>;
+using ThreadCacheForTest = ThreadCache<kMagazineCapacity>;
+using ThreadCachingAllocatorForTest = ThreadCachingAllocator<pw::sync::Mutex>;
+using Generic = ::pw::allocator::internal::GenericThreadCachingAllocator;
+
+class ThreadCachingAllocatorTest : public ::testing::Test {
+ protected:
+  ThreadCachingAllocatorTest() : shared_(allocator_) {}
+
+  size_t num_allocations() const {
+    return allocator_.metrics().num_allocations.value();
+  }
+
+  size_t num_deallocations() const {
+    return allocator_.metrics().num_deallocations.value();
+  }
+
+  AllocatorForTest allocator_;
+  ThreadCachingAllocatorForTest shared_;
+};
+
+// Unit tests.
+
+TEST_F(ThreadCachingAllocatorTest, RequestedLayoutIsNotImplemented) {
+  EXPECT_FALSE(shared_.HasCapability(
+      pw::allocator::Capability::kImplementsGetRequestedLayout));
+  EXPECT_TRUE(shared_.HasCapability(
+      pw::allocator::Capability::kImplementsGetCapacity));
+  ThreadCacheForTest cache(shared_);
+  EXPECT_EQ(cache.capabilities(), shared_.capabilities());
+}
+
+TEST_F(ThreadCachingAllocatorTest, GetCapacity) {
+  ThreadCacheForTest cache(shared_);
+  pw::StatusWithSize capacity = cache.GetCapacity();
+  EXPECT_EQ(capacity.status(), pw::OkStatus());
+  EXPECT_EQ(capacity.size(), kCapacity);
+}
+
+TEST_F(ThreadCachingAllocatorTest, AllocateFromSharedAllocator) {
+  void* ptr = shared_.Allocate(Layout(20, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(num_allocations(), 1u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t), 0u);
+  shared_.Deallocate(ptr);
+  EXPECT_EQ(num_deallocations(), 1u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, RefillsInBatches) {
+  ThreadCacheForTest cache(shared_);
+
+  // The first allocation refills half of the magazine.
+  void* ptr1 = cache.Allocate(Layout(20, 4));
+  ASSERT_NE(ptr1, nullptr);
+  EXPECT_EQ(num_allocations(), kMagazineCapacity / 2);
+
+  // The next one is served from the cache.
+  void* ptr2 = cache.Allocate(Layout(32, 8));
+  ASSERT_NE(ptr2, nullptr);
+  EXPECT_EQ(num_allocations(), kMagazineCapacity / 2);
+
+  // Requests of a different size class refill a different magazine.
+  void* ptr3 = cache.Allocate(Layout(33, 8));
+  ASSERT_NE(ptr3, nullptr);
+  EXPECT_EQ(num_allocations(), kMagazineCapacity);
+
+  cache.Deallocate(ptr1);
+  cache.Deallocate(ptr2);
+  cache.Deallocate(ptr3);
+  EXPECT_EQ(num_deallocations(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ReusesCachedBlocks) {
+  ThreadCacheForTest cache(shared_);
+  void* ptr1 = cache.Allocate(Layout(24, 8));
+  ASSERT_NE(ptr1, nullptr);
+  cache.Deallocate(ptr1);
+  void* ptr2 = cache.Allocate(Layout(30, 2));
+  EXPECT_EQ(ptr1, ptr2);
+  cache.Deallocate(ptr2);
+  EXPECT_EQ(num_allocations(), kMagazineCapacity / 2);
+}
+
+TEST_F(ThreadCachingAllocatorTest, FlushesInBatches) {
+  ThreadCacheForTest cache(shared_);
+  std::array<void*, kMagazineCapacity + 1> ptrs;
+  for (void*& ptr : ptrs) {
+    ptr = shared_.Allocate(Layout(16, 1));
+    ASSERT_NE(ptr, nullptr);
+  }
+
+  // Fill the magazine.
+  for (size_t i = 0; i < kMagazineCapacity; ++i) {
+    cache.Deallocate(ptrs[i]);
+  }
+  EXPECT_EQ(num_deallocations(), 0u);
+
+  // Overflowing the magazine flushes half of it.
+  cache.Deallocate(ptrs[kMagazineCapacity]);
+  EXPECT_EQ(num_deallocations(), kMagazineCapacity / 2);
+}
+
+TEST_F(ThreadCachingAllocatorTest, FlushReturnsAllCachedBlocks) {
+  ThreadCacheForTest cache(shared_);
+  void* ptr = cache.Allocate(Layout(64, 8));
+  ASSERT_NE(ptr, nullptr);
+  cache.Deallocate(ptr);
+  EXPECT_NE(shared_.GetAllocated(), 0u);
+  cache.Flush();
+  EXPECT_EQ(num_deallocations(), num_allocations());
+  EXPECT_EQ(shared_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, DestructorFlushesCache) {
+  {
+    ThreadCacheForTest cache(shared_);
+    void* ptr = cache.Allocate(Layout(64, 8));
+    ASSERT_NE(ptr, nullptr);
+    cache.Deallocate(ptr);
+  }
+  EXPECT_EQ(num_deallocations(), num_allocations());
+  EXPECT_EQ(shared_.GetAllocated(), 0u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, DeallocateFromAnotherCache) {
+  ThreadCacheForTest cache1(shared_);
+  ThreadCacheForTest cache2(shared_);
+  void* ptr1 = cache1.Allocate(Layout(100, 4));
+  ASSERT_NE(ptr1, nullptr);
+  cache2.Deallocate(ptr1);
+
+  // The block is now cached by the second cache.
+  void* ptr2 = cache2.Allocate(Layout(128, 4));
+  EXPECT_EQ(ptr1, ptr2);
+  cache1.Deallocate(ptr2);
+}
+
+TEST_F(ThreadCachingAllocatorTest, LargeRequestsAreNotCached) {
+  ThreadCacheForTest cache(shared_);
+  void* ptr = cache.Allocate(Layout(Generic::kMaxCachedSize + 1, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(num_allocations(), 1u);
+  cache.Deallocate(ptr);
+  EXPECT_EQ(num_deallocations(), 1u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, OveralignedRequestsAreNotCached) {
+  ThreadCacheForTest cache(shared_);
+  constexpr size_t kAlignment = alignof(std::max_align_t) * 4;
+  void* ptr = cache.Allocate(Layout(16, kAlignment));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % kAlignment, 0u);
+  EXPECT_EQ(num_allocations(), 1u);
+  cache.Deallocate(ptr);
+  EXPECT_EQ(num_deallocations(), 1u);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ResizeWithinSizeClass) {
+  ThreadCacheForTest cache(shared_);
+  void* ptr = cache.Allocate(Layout(40, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(cache.Resize(ptr, 64));
+  EXPECT_TRUE(cache.Resize(ptr, 1));
+  EXPECT_FALSE(cache.Resize(ptr, 65));
+  cache.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, ResizeUncached) {
+  ThreadCacheForTest cache(shared_);
+  void* ptr = cache.Allocate(Layout(Generic::kMaxCachedSize * 2, 4));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(cache.Resize(ptr, Generic::kMaxCachedSize + 1));
+  EXPECT_EQ(allocator_.resize_new_size(),
+            Generic::kMaxCachedSize + 1 + alignof(std::max_align_t));
+  cache.Deallocate(ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, GetUsableLayout) {
+  ThreadCacheForTest cache(shared_);
+  void* ptr = cache.Allocate(Layout(40, 4));
+  ASSERT_NE(ptr, nullptr);
+
+  // Reallocating uses the usable layout to copy data.
+  auto* bytes = static_cast<std::byte*>(ptr);
+  bytes[63] = std::byte{0x5A};
+  void* new_ptr = cache.Reallocate(ptr, Layout(128, 4));
+  ASSERT_NE(new_ptr, nullptr);
+  EXPECT_EQ(static_cast<std::byte*>(new_ptr)[63], std::byte{0x5A});
+  cache.Deallocate(new_ptr);
+}
+
+TEST_F(ThreadCachingAllocatorTest, AllocateFailsWhenExhausted) {
+  ThreadCacheForTest cache(shared_);
+  allocator_.Exhaust();
+  EXPECT_EQ(cache.Allocate(Layout(16, 1)), nullptr);
+  EXPECT_EQ(cache.Allocate(Layout(Generic::kMaxCachedSize * 2, 1)), nullptr);
+}
+
+// TODO: https://pwbug.dev/365161669 - Express joinability as a build-system
+// constraint.
+#if PW_THREAD_JOINING_ENABLED
+
+using ::pw::allocator::test::Background;
+using ::pw::allocator::test::BackgroundThreadCore;
+using ::pw::allocator::test::SyncAllocatorTest;
+using ::pw::allocator::test::TestHarness;
+
+static constexpr size_t kMaxSize = 512;
+static constexpr size_t kBackgroundRequests = 8;
+
+/// Thread body that uses a test harness to perform random sequences of
+/// allocations through its own thread cache.
+class ThreadCachingAllocatorTestThreadCore : public BackgroundThreadCore {
+ public:
+  ThreadCachingAllocatorTestThreadCore(ThreadCachingAllocatorForTest& shared,
+                                       uint64_t seed,
+                                       size_t num_iterations)
+      : cache_(shared), num_iterations_(num_iterations) {
+    test_harness_.set_allocator(&cache_);
+    test_harness_.set_prng_seed(seed);
+  }
+
+  ~ThreadCachingAllocatorTestThreadCore() override {
+    test_harness_.Reset();
+    cache_.Flush();
+  }
+
+ private:
+  bool RunOnce() override {
+    if (iteration_ >= num_iterations_) {
+      iteration_ = 0;
+      return false;
+    }
+    test_harness_.GenerateRequests(kMaxSize, kBackgroundRequests);
+    iteration_++;
+    return true;
+  }
+
+  ThreadCacheForTest cache_;
+  TestHarness test_harness_;
+  size_t iteration_ = 0;
+  size_t num_iterations_;
+};
+
+/// Test fixture that uses a thread cache on the test thread while a
+/// background thread uses another cache of the same shared allocator.
+class ThreadCacheSyncTest : public SyncAllocatorTest {
+ protected:
+  ThreadCacheSyncTest()
+      : shared_(allocator_),
+        cache_(shared_),
+        core_(shared_, 1, std::numeric_limits<size_t>::max()) {}
+
+  pw::Allocator& GetAllocator() override { return cache_; }
+
+  BackgroundThreadCore& GetCore() override { return core_; }
+
+ private:
+  AllocatorForTest allocator_;
+  ThreadCachingAllocatorForTest shared_;
+  ThreadCacheForTest cache_;
+  ThreadCachingAllocatorTestThreadCore core_;
+};
+
+TEST_F(ThreadCacheSyncTest, GetCapacity) { TestGetCapacity(kCapacity); }
+
+TEST_F(ThreadCacheSyncTest, AllocateDeallocate) { TestAllocate(); }
+
+TEST_F(ThreadCacheSyncTest, Resize) { TestResize(); }
+
+TEST_F(ThreadCacheSyncTest, Reallocate) { TestReallocate(); }
+
+TEST(ThreadCachingAllocatorSyncTest, GenerateRequests) {
+  constexpr size_t kNumIterations = 1000;
+  AllocatorForTest allocator;
+  ThreadCachingAllocatorForTest shared(allocator);
+  {
+    ThreadCachingAllocatorTestThreadCore core1(shared, 1, kNumIterations);
+    ThreadCachingAllocatorTestThreadCore core2(shared, 2, kNumIterations);
+    Background background1(core1);
+    Background background2(core2);
+    background1.Await();
+    background2.Await();
+  }
+  EXPECT_EQ(shared.GetAllocated(), 0u);
+}
+
+#endif  // PW_THREAD_JOINING_ENABLED
+
+}  // namespace
@@ -16,7 +16,6 @@
 // logging.h must be included first
 
 #include <iterator>
-#include <mutex>
 
 #include "pw_assert/check.h"
 #include "pw_async2/dispatcher.h"
@@ -29,7 +28,7 @@
 namespace pw::async2 {
 
 Dispatcher::~Dispatcher() {
-  std::lock_guard lock(internal::lock());
+  internal::ShardLock lock(lock_shard());
   PW_CHECK(!has_tasks(),
            "Tasks are still registered when the Dispatcher is being "
            "destroyed. Call Terminate() before destruction to deregister all "
@@ -39,7 +38,7 @@ Dispatcher::~Dispatcher() {
 void Dispatcher::Terminate() {
   while (true) {
     {
-      std::lock_guard lock(internal::lock());
+      internal::ShardLock lock(lock_shard());
       terminated_ = true;
       UnpostTaskList(woken_);
       UnpostTaskList(sleeping_);
@@ -53,7 +52,7 @@ void Dispatcher::Terminate() {
 }
 
 void Dispatcher::Post(Task& task) {
-  internal::lock().lock();
+  task.LockAndMoveToShard(lock_shard());
   PW_DCHECK(!terminated_,
             "Tasks cannot be posted to a Dispatcher that has been Terminated.");
   task.PostTo(*this);
@@ -93,6 +92,20 @@ Task* Dispatcher::PopTaskToRunLocked() {
   return &task;
 }
 
+size_t Dispatcher::PopTasksToRun(span<Task*> tasks, bool& has_posted_tasks) {
+  internal::ShardLock lock(lock_shard());
+  size_t count = 0;
+  while (count < tasks.size()) {
+    Task* task = PopTaskToRunLocked();
+    if (task == nullptr) {
+      break;
+    }
+    tasks[count++] = task;
+  }
+  has_posted_tasks = count != 0 || !sleeping_.empty();
+  return count;
+}
+
 bool Dispatcher::PopAndRunAllReadyTasks() {
   bool has_posted_tasks;
   Task* task;
@@ -114,7 +127,7 @@ void Dispatcher::UnpostTaskList(IntrusiveQueue<Task>& list) {
 //     to use it.
 void Dispatcher::LogRegisteredTasks() {
   PW_LOG_INFO("pw::async2::Dispatcher");
-  std::lock_guard lock(internal::lock());
+  internal::ShardLock lock(lock_shard());
 
   PW_LOG_INFO("Woken tasks:");
   for (const Task& task : woken_) {
@@ -157,7 +170,7 @@ void Dispatcher::Wake(Task* task_to_release) {
   }
 
   if (task_to_release == nullptr) {
-    internal::lock().unlock();
+    internal::Unlock(lock_shard());
   } else {
     task_to_release->UnpostAndReleaseRef();
   }
@@ -0,0 +1,300 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how independent dispatchers running on separate threads contend for
+// the pw_async2 lock. Each dispatcher runs tasks that wake themselves after
+// every run, which acquires the lock to create the waker, wake the task, and
+// pop it from the dispatcher's queue. The test logs wakes per second for 2 to 8
+// dispatchers; with PW_ASYNC2_LOCK_SHARDS greater than 1, dispatchers on
+// different shards do not contend. It does not assert on the results, since
+// they depend on the number of cores available.
+
+#define PW_LOG_MODULE_NAME "pw_async2 test"
+#define PW_LOG_LEVEL PW_LOG_LEVEL_INFO
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "pw_async2/basic_dispatcher.h"
+#include "pw_async2/internal/config.h"
+#include "pw_async2/internal/lock.h"
+#include "pw_async2/task.h"
+#include "pw_async2/waker.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::async2::BasicDispatcher;
+using pw::async2::Context;
+using pw::async2::Pending;
+using pw::async2::Poll;
+using pw::async2::Ready;
+using pw::async2::Task;
+using pw::async2::Waker;
+using pw::chrono::SystemClock;
+
+constexpr size_t kTasksPerDispatcher = 4;
+constexpr uint32_t kWakesPerTask = 20000;
+
+// Wakes itself after each run until it has run a fixed number of times.
+class SelfWakingTask : public Task {
+ public:
+  SelfWakingTask() : Task(PW_ASYNC_TASK_NAME("SelfWakingTask")) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (++runs_ > kWakesPerTask) {
+      return Ready();
+    }
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  uint32_t runs_ = 0;
+};
+
+struct Runner {
+  BasicDispatcher dispatcher;
+  std::array<SelfWakingTask, kTasksPerDispatcher> tasks;
+  pw::thread::test::TestThreadContext context;
+  pw::Thread thread;
+};
+
+template <size_t kNumDispatchers>
+void MeasureContention() {
+  std::array<Runner, kNumDispatchers> runners;
+  for (Runner& runner : runners) {
+    for (SelfWakingTask& task : runner.tasks) {
+      runner.dispatcher.Post(task);
+    }
+  }
+
+  const SystemClock::time_point start = SystemClock::now();
+  for (Runner& runner : runners) {
+    runner.thread = pw::Thread(runner.context.options(), [&runner] {
+      runner.dispatcher.RunToCompletion();
+    });
+  }
+  for (Runner& runner : runners) {
+    runner.thread.join();
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      SystemClock::now() - start);
+
+  for (Runner& runner : runners) {
+    for (SelfWakingTask& task : runner.tasks) {
+      EXPECT_FALSE(task.IsRegistered());
+    }
+  }
+
+  const uint64_t wakes =
+      uint64_t{kNumDispatchers} * kTasksPerDispatcher * kWakesPerTask;
+  const uint64_t micros = elapsed.count() > 0 ? elapsed.count() : 1;
+  PW_LOG_INFO("%u dispatchers, %u lock shards: %u wakes in %u us (%u wakes/s)",
+              static_cast<unsigned>(kNumDispatchers),
+              static_cast<unsigned>(PW_ASYNC2_LOCK_SHARDS),
+              static_cast<unsigned>(wakes),
+              static_cast<unsigned>(micros),
+              static_cast<unsigned>(wakes * 1'000'000 / micros));
+}
+
+TEST(DispatcherContention, IndependentDispatchersOnSeparateThreads) {
+  MeasureContention<2>();
+  MeasureContention<4>();
+  MeasureContention<8>();
+}
+
+// Stores a waker on its first run and completes when woken.
+class WaitingTask : public Task {
+ public:
+  WaitingTask() : Task(PW_ASYNC_TASK_NAME("WaitingTask")) {}
+
+  bool waiting() const { return waiting_.load(); }
+
+  // Allows the task to be posted again after it was deregistered.
+  void Reset() { waiting_.store(false); }
+
+  Waker& waker() { return waker_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (waiting_.load()) {
+      waiting_.store(false);
+      return Ready();
+    }
+    PW_ASYNC_STORE_WAKER(cx, waker_, "WaitingTask");
+    waiting_.store(true);
+    return Pending();
+  }
+
+  std::atomic<bool> waiting_ = false;
+  Waker waker_;
+};
+
+TEST(DispatcherContention, WakersWakeTasksOnOtherDispatchers) {
+  std::array<BasicDispatcher, 4> dispatchers;
+  std::array<WaitingTask, 4> tasks;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    dispatchers[i].Post(tasks[i]);
+    EXPECT_TRUE(dispatchers[i].RunUntilStalled());
+    ASSERT_TRUE(tasks[i].waiting());
+  }
+
+  // Move the wakers into other wakers, then wake them from another thread.
+  std::array<Waker, 4> moved;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    moved[(i + 1) % moved.size()] = std::move(tasks[i].waker());
+  }
+
+  pw::thread::test::TestThreadContext context;
+  pw::Thread thread(context.options(), [&moved] {
+    for (Waker& waker : moved) {
+      waker.Wake();
+    }
+  });
+  thread.join();
+
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    EXPECT_FALSE(dispatchers[i].RunUntilStalled());
+    EXPECT_FALSE(tasks[i].IsRegistered());
+  }
+}
+
+TEST(DispatcherContention, TaskMovesBetweenDispatchers) {
+  std::array<BasicDispatcher, 4> dispatchers;
+  WaitingTask task;
+  for (BasicDispatcher& dispatcher : dispatchers) {
+    dispatcher.Post(task);
+    EXPECT_TRUE(dispatcher.RunUntilStalled());
+    ASSERT_TRUE(task.waiting());
+
+    Waker clone;
+    ASSERT_TRUE(PW_ASYNC_TRY_CLONE_WAKER(task.waker(), clone, "clone"));
+    task.waker().Clear();
+    clone.Wake();
+    EXPECT_FALSE(dispatcher.RunUntilStalled());
+    EXPECT_FALSE(task.IsRegistered());
+  }
+}
+
+// Returns the indices of two dispatchers that are guarded by different lock
+// shards. With a single shard, returns the first two dispatchers.
+template <size_t kSize>
+std::pair<size_t, size_t> DispatchersOnDifferentShards(
+    const std::array<BasicDispatcher, kSize>& dispatchers) {
+  for (size_t i = 1; i < kSize; ++i) {
+    if (&pw::async2::internal::LockShardFor(&dispatchers[0]) !=
+        &pw::async2::internal::LockShardFor(&dispatchers[i])) {
+      return {0, i};
+    }
+  }
+  EXPECT_EQ(pw::async2::internal::kLockShards, 1u);
+  return {0, 1};
+}
+
+TEST(DispatcherContention, TaskAndWakerMoveBetweenShards) {
+  std::array<BasicDispatcher, 8> dispatchers;
+  const auto [first, second] = DispatchersOnDifferentShards(dispatchers);
+
+  // Run the task on the first shard, then post it to the second one.
+  WaitingTask task;
+  dispatchers[first].Post(task);
+  EXPECT_TRUE(dispatchers[first].RunUntilStalled());
+  ASSERT_TRUE(task.waiting());
+  task.Deregister();
+  EXPECT_FALSE(task.IsRegistered());
+
+  WaitingTask other;
+  dispatchers[first].Post(other);
+  EXPECT_TRUE(dispatchers[first].RunUntilStalled());
+  ASSERT_TRUE(other.waiting());
+
+  task.Reset();
+  dispatchers[second].Post(task);
+  EXPECT_TRUE(dispatchers[second].RunUntilStalled());
+  ASSERT_TRUE(task.waiting());
+
+  // Replace the waker for the task on the second shard with the waker for the
+  // task on the first shard, which holds both shards.
+  task.waker() = std::move(other.waker());
+  task.waker().Wake();
+  EXPECT_FALSE(dispatchers[first].RunUntilStalled());
+  EXPECT_FALSE(other.IsRegistered());
+
+  // The task on the second shard no longer has a waker.
+  EXPECT_TRUE(dispatchers[second].RunUntilStalled());
+  EXPECT_TRUE(task.IsRegistered());
+  task.Deregister();
+}
+
+// Wakes its peer every time it runs, and stores a waker that its peer wakes.
+class PeerWakingTask : public Task {
+ public:
+  static constexpr uint32_t kRuns = 10000;
+
+  PeerWakingTask() : Task(PW_ASYNC_TASK_NAME("PeerWakingTask")) {}
+
+  void set_peer(PeerWakingTask& peer) { peer_ = &peer; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    peer_->waker_.Wake();
+    if (++runs_ >= kRuns) {
+      return Ready();
+    }
+    PW_ASYNC_STORE_WAKER(cx, waker_, "PeerWakingTask");
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  PeerWakingTask* peer_ = nullptr;
+  uint32_t runs_ = 0;
+  Waker waker_;
+};
+
+TEST(DispatcherContention, TasksOnDifferentShardsWakeEachOther) {
+  std::array<BasicDispatcher, 8> dispatchers;
+  const auto [first, second] = DispatchersOnDifferentShards(dispatchers);
+
+  BasicDispatcher& first_dispatcher = dispatchers[first];
+  BasicDispatcher& second_dispatcher = dispatchers[second];
+
+  std::array<PeerWakingTask, 2> tasks;
+  tasks[0].set_peer(tasks[1]);
+  tasks[1].set_peer(tasks[0]);
+  first_dispatcher.Post(tasks[0]);
+  second_dispatcher.Post(tasks[1]);
+
+  std::array<pw::thread::test::TestThreadContext, 2> contexts;
+  pw::Thread first_thread(contexts[0].options(), [&first_dispatcher] {
+    first_dispatcher.RunToCompletion();
+  });
+  pw::Thread second_thread(contexts[1].options(), [&second_dispatcher] {
+    second_dispatcher.RunToCompletion();
+  });
+  first_thread.join();
+  second_thread.join();
+
+  EXPECT_FALSE(tasks[0].IsRegistered());
+  EXPECT_FALSE(tasks[1].IsRegistered());
+}
+
+}  // namespace
@@ -0,0 +1,487 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/io_uring_dispatcher.h"
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#include "pw_assert/check.h"
+#include "pw_log/log.h"
+
+namespace pw::async2 {
+namespace {
+
+static_assert(sizeof(__kernel_timespec) == 16);
+
+// user_data values for completions that are not tied to an operation slot.
+constexpr uint64_t kWakeUserData = ~uint64_t{0};
+constexpr uint64_t kIgnoredUserData = ~uint64_t{0} - 1;
+
+// Each operation may need a second entry to cancel it, plus one entry for the
+// wake read.
+constexpr uint32_t kRingEntries =
+    static_cast<uint32_t>(2 * IoUringDispatcher::kMaxOperations + 1);
+
+constexpr uint64_t UserData(uint32_t generation, uint16_t operation) {
+  return (uint64_t{generation} << 32) | operation;
+}
+
+int IoUringSetup(uint32_t entries, io_uring_params& params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int IoUringEnter(int ring_fd,
+                 uint32_t to_submit,
+                 uint32_t min_complete,
+                 uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter,
+                                  ring_fd,
+                                  to_submit,
+                                  min_complete,
+                                  flags,
+                                  nullptr,
+                                  size_t{0}));
+}
+
+}  // namespace
+
+namespace internal {
+
+Status IoUringErrorToStatus(int result) {
+  switch (-result) {
+    case 0:
+      return OkStatus();
+    case EAGAIN:
+    case EINTR:
+      return Status::Unavailable();
+    case ECANCELED:
+      return Status::Cancelled();
+    case ETIME:
+    case ETIMEDOUT:
+      return Status::DeadlineExceeded();
+    case EBADF:
+    case EFAULT:
+    case EINVAL:
+    case ENOTSOCK:
+      return Status::InvalidArgument();
+    case ECONNRESET:
+    case ENOTCONN:
+    case EPIPE:
+      return Status::FailedPrecondition();
+    case EMFILE:
+    case ENFILE:
+    case ENOBUFS:
+    case ENOMEM:
+      return Status::ResourceExhausted();
+    case EACCES:
+    case EPERM:
+      return Status::PermissionDenied();
+    case ENOSYS:
+    case EOPNOTSUPP:
+      return Status::Unimplemented();
+    default:
+      return Status::Internal();
+  }
+}
+
+IoUringFutureBase& IoUringFutureBase::operator=(
+    IoUringFutureBase&& other) noexcept {
+  if (this != &other) {
+    Release();
+    dispatcher_ = std::exchange(other.dispatcher_, nullptr);
+    operation_ = other.operation_;
+    result_ = other.result_;
+    state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+Poll<int> IoUringFutureBase::PendResult(Context& cx) {
+  PW_ASSERT(is_pendable());
+  if (dispatcher_ != nullptr) {
+    Poll<int> result = dispatcher_->PendOperation(operation_, cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    dispatcher_ = nullptr;
+    result_ = *result;
+  }
+  state_.MarkComplete();
+  return result_;
+}
+
+void IoUringFutureBase::Release() {
+  if (dispatcher_ != nullptr) {
+    std::exchange(dispatcher_, nullptr)->CancelOperation(operation_);
+  }
+}
+
+}  // namespace internal
+
+Poll<StatusWithSize> IoUringTransferFuture::Pend(Context& cx) {
+  Poll<int> result = PendResult(cx);
+  if (result.IsPending()) {
+    return Pending();
+  }
+  if (*result < 0) {
+    return StatusWithSize(internal::IoUringErrorToStatus(*result), 0);
+  }
+  return StatusWithSize(static_cast<size_t>(*result));
+}
+
+Poll<Result<int>> IoUringAcceptFuture::Pend(Context& cx) {
+  Poll<int> result = PendResult(cx);
+  if (result.IsPending()) {
+    return Pending();
+  }
+  if (*result < 0) {
+    return Result<int>(internal::IoUringErrorToStatus(*result));
+  }
+  return Result<int>(*result);
+}
+
+Poll<> IoUringTimerFuture::Pend(Context& cx) {
+  if (PendResult(cx).IsPending()) {
+    return Pending();
+  }
+  return Ready();
+}
+
+IoUringDispatcher::~IoUringDispatcher() {
+  Terminate();
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (ring_ != nullptr) {
+    munmap(ring_, ring_size_);
+  }
+  if (ring_fd_ != -1) {
+    close(ring_fd_);
+  }
+  if (wake_fd_ != -1) {
+    close(wake_fd_);
+  }
+}
+
+Status IoUringDispatcher::NativeInit() {
+  {
+    std::lock_guard lock(lock_);
+    for (size_t i = 0; i < kMaxOperations; ++i) {
+      free_operations_[i] = static_cast<uint16_t>(kMaxOperations - 1 - i);
+    }
+    free_count_ = kMaxOperations;
+  }
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  ring_fd_ = IoUringSetup(kRingEntries, params);
+  if (ring_fd_ < 0) {
+    PW_LOG_ERROR("Failed to set up io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+  if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0) {
+    PW_LOG_ERROR("io_uring is too old; IORING_FEAT_SINGLE_MMAP is required");
+    return Status::Unimplemented();
+  }
+
+  ring_size_ =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring_ = mmap(nullptr,
+               ring_size_,
+               PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE,
+               ring_fd_,
+               IORING_OFF_SQ_RING);
+  if (ring_ == MAP_FAILED) {
+    ring_ = nullptr;
+    PW_LOG_ERROR("Failed to map io_uring: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr,
+                    sqes_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd_,
+                    IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    PW_LOG_ERROR("Failed to map io_uring entries: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  std::byte* const ring = static_cast<std::byte*>(ring_);
+  sq_head_ = reinterpret_cast<uint32_t*>(ring + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(ring + params.sq_off.tail);
+  sq_array_ = reinterpret_cast<uint32_t*>(ring + params.sq_off.array);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(ring + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  cq_head_ = reinterpret_cast<uint32_t*>(ring + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(ring + params.cq_off.tail);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(ring + params.cq_off.cqes);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(ring + params.cq_off.ring_mask);
+
+  // The wake eventfd must be blocking so that io_uring waits for it to be
+  // written rather than failing the read with EAGAIN.
+  wake_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (wake_fd_ == -1) {
+    PW_LOG_ERROR("Failed to create eventfd: %s", std::strerror(errno));
+    return Status::Internal();
+  }
+
+  std::lock_guard lock(lock_);
+  ArmWakeReadLocked();
+  return OkStatus();
+}
+
+IoUringReadFuture IoUringDispatcher::Read(int fd, ByteSpan buffer) {
+  std::lock_guard lock(lock_);
+  uint16_t operation;
+  io_uring_sqe* sqe = StartOperationLocked(IORING_OP_READ, fd, operation);
+  if (sqe == nullptr) {
+    return IoUringReadFuture(-ENOBUFS);
+  }
+  sqe->addr = reinterpret_cast<uintptr_t>(buffer.data());
+  sqe->len = static_cast<uint32_t>(buffer.size());
+  sqe->off = ~uint64_t{0};  // Use the current file position, if any.
+  return IoUringReadFuture(*this, operation);
+}
+
+IoUringWriteFuture IoUringDispatcher::Write(int fd, ConstByteSpan data) {
+  std::lock_guard lock(lock_);
+  uint16_t operation;
+  io_uring_sqe* sqe = StartOperationLocked(IORING_OP_WRITE, fd, operation);
+  if (sqe == nullptr) {
+    return IoUringWriteFuture(-ENOBUFS);
+  }
+  sqe->addr = reinterpret_cast<uintptr_t>(data.data());
+  sqe->len = static_cast<uint32_t>(data.size());
+  sqe->off = ~uint64_t{0};
+  return IoUringWriteFuture(*this, operation);
+}
+
+IoUringAcceptFuture IoUringDispatcher::Accept(int fd) {
+  std::lock_guard lock(lock_);
+  uint16_t operation;
+  io_uring_sqe* sqe = StartOperationLocked(IORING_OP_ACCEPT, fd, operation);
+  if (sqe == nullptr) {
+    return IoUringAcceptFuture(-ENOBUFS);
+  }
+  sqe->accept_flags = SOCK_CLOEXEC;
+  return IoUringAcceptFuture(*this, operation);
+}
+
+IoUringTimerFuture IoUringDispatcher::WaitFor(
+    chrono::SystemClock::duration delay) {
+  const auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count();
+
+  std::lock_guard lock(lock_);
+  uint16_t operation;
+  io_uring_sqe* sqe = StartOperationLocked(IORING_OP_TIMEOUT, -1, operation);
+  if (sqe == nullptr) {
+    return IoUringTimerFuture(-ENOBUFS);
+  }
+  KernelTimespec& timeout = operations_[operation].timeout;
+  timeout.tv_sec = std::max<int64_t>(nanoseconds, 0) / 1'000'000'000;
+  timeout.tv_nsec = std::max<int64_t>(nanoseconds, 0) % 1'000'000'000;
+  sqe->addr = reinterpret_cast<uintptr_t>(&timeout);
+  sqe->len = 1;
+  sqe->off = 0;  // Complete only when the timeout expires.
+  return IoUringTimerFuture(*this, operation);
+}
+
+bool IoUringDispatcher::DoRunUntilStalled() {
+  PW_CHECK_OK(NativeSubmitAndProcessCompletions(/*wait=*/false));
+  return PopAndRunAllReadyTasks();
+}
+
+void IoUringDispatcher::DoWake() {
+  // Complete the pending read of the eventfd to unblock the dispatcher.
+  const uint64_t value = 1;
+  [[maybe_unused]] ssize_t result = write(wake_fd_, &value, sizeof(value));
+}
+
+void IoUringDispatcher::DoWaitForWake() {
+  PW_CHECK_OK(NativeSubmitAndProcessCompletions(/*wait=*/true));
+}
+
+Status IoUringDispatcher::NativeSubmitAndProcessCompletions(bool wait) {
+  uint32_t to_submit;
+  {
+    std::lock_guard lock(lock_);
+    to_submit = std::exchange(unsubmitted_, 0u);
+  }
+
+  if (to_submit != 0 || wait) {
+    const int result = IoUringEnter(
+        ring_fd_, to_submit, wait ? 1 : 0, wait ? IORING_ENTER_GETEVENTS : 0);
+    // EINTR, EAGAIN, and EBUSY are transient, and nothing was submitted.
+    if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      PW_LOG_ERROR("Dispatcher failed to submit io_uring operations: %s",
+                   std::strerror(errno));
+      return Status::Internal();
+    }
+    const auto submitted = static_cast<uint32_t>(std::max(result, 0));
+
+    // The kernel stops submitting at an entry it rejects, leaving the entries
+    // after it in the submission queue. Count them so the next call submits
+    // them.
+    if (submitted < to_submit) {
+      std::lock_guard lock(lock_);
+      unsubmitted_ += to_submit - submitted;
+    }
+  }
+
+  // The completion queue is only consumed by the thread running the
+  // dispatcher.
+  uint32_t head = __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+  const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  while (head != tail) {
+    const io_uring_cqe cqe = cqes_[head & cq_mask_];
+    head += 1;
+    // Release the entry before processing it so the kernel can reuse it.
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    ProcessCompletion(cqe);
+  }
+  return OkStatus();
+}
+
+void IoUringDispatcher::ProcessCompletion(const io_uring_cqe& cqe) {
+  if (cqe.user_data == kIgnoredUserData) {
+    return;
+  }
+  if (cqe.user_data == kWakeUserData) {
+    std::lock_guard lock(lock_);
+    ArmWakeReadLocked();
+    return;
+  }
+
+  const auto operation = static_cast<uint16_t>(cqe.user_data);
+  Waker waker;
+  {
+    std::lock_guard lock(lock_);
+    Operation& op = operations_[operation];
+    if (UserData(op.generation, operation) != cqe.user_data) {
+      return;  // Stale completion for a recycled slot.
+    }
+    if (op.state == OperationState::kOrphaned) {
+      FreeOperationLocked(operation);
+      return;
+    }
+    PW_DCHECK(op.state == OperationState::kSubmitted);
+    op.result = cqe.res;
+    op.state = OperationState::kComplete;
+    waker = std::move(op.waker);
+  }
+  waker.Wake();
+}
+
+io_uring_sqe* IoUringDispatcher::StartOperationLocked(uint8_t opcode,
+                                                      int fd,
+                                                      uint16_t& operation) {
+  if (free_count_ == 0) {
+    PW_LOG_WARN("IoUringDispatcher has no free operation slots");
+    return nullptr;
+  }
+  operation = free_operations_[--free_count_];
+  Operation& op = operations_[operation];
+  op.generation += 1;
+  op.state = OperationState::kSubmitted;
+
+  io_uring_sqe* sqe = NextSqeLocked();
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->user_data = UserData(op.generation, operation);
+  return sqe;
+}
+
+io_uring_sqe* IoUringDispatcher::NextSqeLocked() {
+  // The ring has room for every operation, its cancellation, and the wake
+  // read, so it never fills.
+  const uint32_t tail = *sq_tail_;
+  PW_DCHECK_UINT_LT(tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE),
+                    sq_entries_);
+
+  const uint32_t index = tail & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  // The kernel only reads entries when they are submitted, which happens after
+  // the caller fills in the entry and releases the lock.
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  unsubmitted_ += 1;
+  return sqe;
+}
+
+void IoUringDispatcher::ArmWakeReadLocked() {
+  io_uring_sqe* sqe = NextSqeLocked();
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = wake_fd_;
+  sqe->addr = reinterpret_cast<uintptr_t>(&wake_buffer_);
+  sqe->len = sizeof(wake_buffer_);
+  sqe->user_data = kWakeUserData;
+}
+
+Poll<int> IoUringDispatcher::PendOperation(uint16_t operation, Context& cx) {
+  std::lock_guard lock(lock_);
+  Operation& op = operations_[operation];
+  if (op.state != OperationState::kComplete) {
+    PW_ASYNC_STORE_WAKER(cx, op.waker, "waiting for io_uring completion");
+    return Pending();
+  }
+  const int result = op.result;
+  FreeOperationLocked(operation);
+  return result;
+}
+
+void IoUringDispatcher::CancelOperation(uint16_t operation) {
+  std::lock_guard lock(lock_);
+  Operation& op = operations_[operation];
+  if (op.state == OperationState::kComplete) {
+    FreeOperationLocked(operation);
+    return;
+  }
+
+  // The slot is freed when the operation's completion arrives.
+  op.state = OperationState::kOrphaned;
+  op.waker.Clear();
+
+  io_uring_sqe* sqe = NextSqeLocked();
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = UserData(op.generation, operation);
+  sqe->user_data = kIgnoredUserData;
+}
+
+void IoUringDispatcher::FreeOperationLocked(uint16_t operation) {
+  operations_[operation].state = OperationState::kFree;
+  free_operations_[free_count_++] = operation;
+}
+
+}  // namespace pw::async2
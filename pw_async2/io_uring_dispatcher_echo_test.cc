@@ -0,0 +1,341 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Compares IoUringDispatcher with EpollDispatcher on a loopback TCP echo
+// workload. Each connection has a client task that sends a message and waits
+// for it to be echoed back, and a server task that echoes everything it reads.
+// All tasks run on a single dispatcher thread. The test logs round trips per
+// second for each dispatcher; it does not assert on the results, since they
+// depend on the host.
+
+#define PW_LOG_MODULE_NAME "pw_async2 test"
+#define PW_LOG_LEVEL PW_LOG_LEVEL_INFO
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "pw_async2/epoll_dispatcher.h"
+#include "pw_async2/io_uring_dispatcher.h"
+#include "pw_async2/task.h"
+#include "pw_bytes/span.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::ByteSpan;
+using pw::ConstByteSpan;
+using pw::StatusWithSize;
+using pw::async2::Context;
+using pw::async2::EpollDispatcher;
+using pw::async2::IoUringDispatcher;
+using pw::async2::IoUringReadFuture;
+using pw::async2::IoUringWriteFuture;
+using pw::async2::Pending;
+using pw::async2::Poll;
+using pw::async2::Ready;
+using pw::async2::Task;
+using pw::chrono::SystemClock;
+
+constexpr size_t kConnections = 16;
+constexpr size_t kRoundTrips = 500;
+constexpr size_t kMessageSize = 64;
+
+// Performs I/O through IoUringDispatcher futures.
+class IoUringIo {
+ public:
+  IoUringIo(IoUringDispatcher& dispatcher, int fd)
+      : dispatcher_(dispatcher), fd_(fd) {}
+
+  Poll<StatusWithSize> PendRead(Context& cx, ByteSpan buffer) {
+    if (!read_.is_pendable()) {
+      read_ = dispatcher_.Read(fd_, buffer);
+    }
+    return read_.Pend(cx);
+  }
+
+  Poll<StatusWithSize> PendWrite(Context& cx, ConstByteSpan data) {
+    if (!write_.is_pendable()) {
+      write_ = dispatcher_.Write(fd_, data);
+    }
+    return write_.Pend(cx);
+  }
+
+ private:
+  IoUringDispatcher& dispatcher_;
+  int fd_;
+  IoUringReadFuture read_;
+  IoUringWriteFuture write_;
+};
+
+// Performs non-blocking I/O when EpollDispatcher reports readiness.
+class EpollIo {
+ public:
+  EpollIo(EpollDispatcher& dispatcher, int fd)
+      : dispatcher_(dispatcher), fd_(fd) {}
+
+  Poll<StatusWithSize> PendRead(Context& cx, ByteSpan buffer) {
+    const ssize_t result = read(fd_, buffer.data(), buffer.size());
+    if (result < 0 && errno == EAGAIN) {
+      PW_ASYNC_STORE_WAKER(
+          cx, dispatcher_.NativeAddReadWakerForFileDescriptor(fd_), "read");
+      return Pending();
+    }
+    return ToStatusWithSize(result);
+  }
+
+  Poll<StatusWithSize> PendWrite(Context& cx, ConstByteSpan data) {
+    const ssize_t result = write(fd_, data.data(), data.size());
+    if (result < 0 && errno == EAGAIN) {
+      PW_ASYNC_STORE_WAKER(
+          cx, dispatcher_.NativeAddWriteWakerForFileDescriptor(fd_), "write");
+      return Pending();
+    }
+    return ToStatusWithSize(result);
+  }
+
+ private:
+  static StatusWithSize ToStatusWithSize(ssize_t result) {
+    return result < 0 ? StatusWithSize::Internal()
+                      : StatusWithSize(static_cast<size_t>(result));
+  }
+
+  EpollDispatcher& dispatcher_;
+  int fd_;
+};
+
+// Echoes everything it reads until the peer shuts down the connection.
+template <typename Io>
+class EchoServer : public Task {
+ public:
+  explicit EchoServer(Io io)
+      : Task(PW_ASYNC_TASK_NAME("EchoServer")), io_(std::move(io)) {}
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    while (true) {
+      if (written_ == received_) {
+        Poll<StatusWithSize> read = io_.PendRead(cx, buffer_);
+        if (read.IsPending()) {
+          return Pending();
+        }
+        if (!read->ok() || read->size() == 0) {
+          return Ready();
+        }
+        received_ = read->size();
+        written_ = 0;
+      }
+
+      Poll<StatusWithSize> write = io_.PendWrite(
+          cx, ConstByteSpan(buffer_).subspan(written_, received_ - written_));
+      if (write.IsPending()) {
+        return Pending();
+      }
+      PW_ASSERT(write->ok());
+      written_ += write->size();
+    }
+  }
+
+  Io io_;
+  std::array<std::byte, kMessageSize> buffer_;
+  size_t received_ = 0;
+  size_t written_ = 0;
+};
+
+// Sends a message, waits for the echo, and repeats. Shuts down its side of the
+// connection when done.
+template <typename Io>
+class EchoClient : public Task {
+ public:
+  EchoClient(Io io, int fd)
+      : Task(PW_ASYNC_TASK_NAME("EchoClient")), io_(std::move(io)), fd_(fd) {
+    for (size_t i = 0; i < message_.size(); ++i) {
+      message_[i] = static_cast<std::byte>(i);
+    }
+  }
+
+  size_t round_trips() const { return round_trips_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    while (round_trips_ < kRoundTrips) {
+      if (sent_ < message_.size()) {
+        Poll<StatusWithSize> write =
+            io_.PendWrite(cx, ConstByteSpan(message_).subspan(sent_));
+        if (write.IsPending()) {
+          return Pending();
+        }
+        PW_ASSERT(write->ok());
+        sent_ += write->size();
+        continue;
+      }
+
+      Poll<StatusWithSize> read =
+          io_.PendRead(cx, ByteSpan(reply_).subspan(received_));
+      if (read.IsPending()) {
+        return Pending();
+      }
+      PW_ASSERT(read->ok() && read->size() > 0);
+      received_ += read->size();
+      if (received_ == reply_.size()) {
+        round_trips_ += 1;
+        sent_ = 0;
+        received_ = 0;
+      }
+    }
+    shutdown(fd_, SHUT_WR);
+    return Ready();
+  }
+
+  Io io_;
+  int fd_;
+  std::array<std::byte, kMessageSize> message_;
+  std::array<std::byte, kMessageSize> reply_;
+  size_t sent_ = 0;
+  size_t received_ = 0;
+  size_t round_trips_ = 0;
+};
+
+// Connected loopback TCP sockets.
+struct Connection {
+  int client = -1;
+  int server = -1;
+};
+
+std::array<Connection, kConnections> Connect(bool nonblocking) {
+  const int listener = socket(AF_INET, SOCK_STREAM, 0);
+  PW_ASSERT(listener >= 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  PW_ASSERT(bind(listener,
+                 reinterpret_cast<sockaddr*>(&address),
+                 sizeof(address)) == 0);
+  PW_ASSERT(listen(listener, kConnections) == 0);
+  socklen_t length = sizeof(address);
+  PW_ASSERT(getsockname(listener,
+                        reinterpret_cast<sockaddr*>(&address),
+                        &length) == 0);
+
+  std::array<Connection, kConnections> connections;
+  for (Connection& connection : connections) {
+    connection.client = socket(AF_INET, SOCK_STREAM, 0);
+    PW_ASSERT(connect(connection.client,
+                      reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address)) == 0);
+    connection.server = accept(listener, nullptr, nullptr);
+    PW_ASSERT(connection.server >= 0);
+
+    for (int fd : {connection.client, connection.server}) {
+      const int enable = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+      if (nonblocking) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+      }
+    }
+  }
+  close(listener);
+  return connections;
+}
+
+void Close(std::array<Connection, kConnections>& connections) {
+  for (Connection& connection : connections) {
+    close(connection.client);
+    close(connection.server);
+  }
+}
+
+void LogResult(const char* name, SystemClock::duration elapsed) {
+  const uint64_t round_trips = uint64_t{kConnections} * kRoundTrips;
+  const auto micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  const uint64_t safe_micros = micros > 0 ? static_cast<uint64_t>(micros) : 1;
+  PW_LOG_INFO("%s: %u round trips in %u us (%u round trips/s)",
+              name,
+              static_cast<unsigned>(round_trips),
+              static_cast<unsigned>(safe_micros),
+              static_cast<unsigned>(round_trips * 1'000'000 / safe_micros));
+}
+
+TEST(IoUringDispatcherEcho, IoUring) {
+  IoUringDispatcher dispatcher;
+  std::array<Connection, kConnections> connections = Connect(false);
+
+  std::array<std::optional<EchoServer<IoUringIo>>, kConnections> servers;
+  std::array<std::optional<EchoClient<IoUringIo>>, kConnections> clients;
+  for (size_t i = 0; i < kConnections; ++i) {
+    servers[i].emplace(IoUringIo(dispatcher, connections[i].server));
+    clients[i].emplace(IoUringIo(dispatcher, connections[i].client),
+                       connections[i].client);
+    dispatcher.Post(*servers[i]);
+    dispatcher.Post(*clients[i]);
+  }
+
+  const SystemClock::time_point start = SystemClock::now();
+  dispatcher.RunToCompletion();
+  LogResult("IoUringDispatcher", SystemClock::now() - start);
+
+  for (const auto& client : clients) {
+    EXPECT_EQ(client->round_trips(), kRoundTrips);
+  }
+  Close(connections);
+}
+
+TEST(IoUringDispatcherEcho, Epoll) {
+  EpollDispatcher dispatcher;
+  std::array<Connection, kConnections> connections = Connect(true);
+
+  std::array<std::optional<EchoServer<EpollIo>>, kConnections> servers;
+  std::array<std::optional<EchoClient<EpollIo>>, kConnections> clients;
+  for (size_t i = 0; i < kConnections; ++i) {
+    for (int fd : {connections[i].client, connections[i].server}) {
+      ASSERT_EQ(dispatcher.NativeRegisterFileDescriptor(
+                    fd, EpollDispatcher::kReadWrite),
+                pw::OkStatus());
+    }
+    servers[i].emplace(EpollIo(dispatcher, connections[i].server));
+    clients[i].emplace(EpollIo(dispatcher, connections[i].client),
+                       connections[i].client);
+    dispatcher.Post(*servers[i]);
+    dispatcher.Post(*clients[i]);
+  }
+
+  const SystemClock::time_point start = SystemClock::now();
+  dispatcher.RunToCompletion();
+  LogResult("EpollDispatcher", SystemClock::now() - start);
+
+  for (const auto& client : clients) {
+    EXPECT_EQ(client->round_trips(), kRoundTrips);
+  }
+  for (const Connection& connection : connections) {
+    ASSERT_EQ(dispatcher.NativeUnregisterFileDescriptor(connection.client),
+              pw::OkStatus());
+    ASSERT_EQ(dispatcher.NativeUnregisterFileDescriptor(connection.server),
+              pw::OkStatus());
+  }
+  Close(connections);
+}
+
+}  // namespace
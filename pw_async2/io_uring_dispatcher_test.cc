@@ -0,0 +1,309 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/io_uring_dispatcher.h"
+
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <optional>
+
+#include "pw_async2/func_task.h"
+#include "pw_bytes/array.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::async2 {
+
+class IoUringDispatcherTestPeer {
+ public:
+  // Queues an entry with an invalid opcode. The kernel rejects it and stops
+  // submitting, so entries queued after it stay in the submission queue.
+  static void QueueInvalidEntry(IoUringDispatcher& dispatcher) {
+    std::lock_guard lock(dispatcher.lock_);
+    io_uring_sqe* sqe = dispatcher.NextSqeLocked();
+    sqe->opcode = 0xFF;
+    sqe->fd = -1;
+    sqe->user_data = ~uint64_t{0} - 1;  // Ignored by the dispatcher.
+  }
+
+  static uint32_t unsubmitted(IoUringDispatcher& dispatcher) {
+    std::lock_guard lock(dispatcher.lock_);
+    return dispatcher.unsubmitted_;
+  }
+
+  // Returns the number of entries the kernel has not consumed yet.
+  static uint32_t queued(IoUringDispatcher& dispatcher) {
+    std::lock_guard lock(dispatcher.lock_);
+    return *dispatcher.sq_tail_ -
+           __atomic_load_n(dispatcher.sq_head_, __ATOMIC_ACQUIRE);
+  }
+};
+
+}  // namespace pw::async2
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using pw::ConstByteSpan;
+using pw::Result;
+using pw::Status;
+using pw::StatusWithSize;
+using pw::async2::Context;
+using pw::async2::FuncTask;
+using pw::async2::IoUringAcceptFuture;
+using pw::async2::IoUringDispatcher;
+using pw::async2::IoUringDispatcherTestPeer;
+using pw::async2::IoUringReadFuture;
+using pw::async2::IoUringTimerFuture;
+using pw::async2::IoUringWriteFuture;
+using pw::async2::Pending;
+using pw::async2::Poll;
+using pw::async2::Ready;
+using pw::chrono::SystemClock;
+
+class Pipe {
+ public:
+  Pipe() { PW_ASSERT(pipe(fds_) == 0); }
+  ~Pipe() {
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+
+  int read_fd() const { return fds_[0]; }
+  int write_fd() const { return fds_[1]; }
+
+ private:
+  int fds_[2];
+};
+
+TEST(IoUringDispatcher, WriteThenReadPipe) {
+  IoUringDispatcher dispatcher;
+  Pipe pipe;
+  constexpr auto kMessage = pw::bytes::Array<'h', 'e', 'l', 'l', 'o'>();
+  std::array<std::byte, 16> buffer{};
+
+  IoUringWriteFuture write;
+  IoUringReadFuture read;
+  std::optional<StatusWithSize> written;
+  std::optional<StatusWithSize> read_result;
+
+  FuncTask task([&](Context& cx) -> Poll<> {
+    if (!written.has_value()) {
+      if (!write.is_pendable()) {
+        write = dispatcher.Write(pipe.write_fd(), kMessage);
+      }
+      Poll<StatusWithSize> poll = write.Pend(cx);
+      if (poll.IsPending()) {
+        return Pending();
+      }
+      written = *poll;
+      read = dispatcher.Read(pipe.read_fd(), buffer);
+    }
+    Poll<StatusWithSize> poll = read.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    read_result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+
+  ASSERT_TRUE(written.has_value());
+  EXPECT_EQ(written->status(), pw::OkStatus());
+  EXPECT_EQ(written->size(), kMessage.size());
+  ASSERT_TRUE(read_result.has_value());
+  EXPECT_EQ(read_result->status(), pw::OkStatus());
+  ASSERT_EQ(read_result->size(), kMessage.size());
+  EXPECT_EQ(std::memcmp(buffer.data(), kMessage.data(), kMessage.size()), 0);
+}
+
+TEST(IoUringDispatcher, ReadWaitsForData) {
+  IoUringDispatcher dispatcher;
+  Pipe pipe;
+  std::array<std::byte, 4> buffer{};
+  IoUringReadFuture read = dispatcher.Read(pipe.read_fd(), buffer);
+  std::optional<StatusWithSize> result;
+
+  FuncTask task([&](Context& cx) -> Poll<> {
+    Poll<StatusWithSize> poll = read.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+  EXPECT_FALSE(result.has_value());
+
+  ASSERT_EQ(write(pipe.write_fd(), "ab", 2), 2);
+  dispatcher.RunToCompletion();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->size(), 2u);
+}
+
+TEST(IoUringDispatcher, EntriesLeftByShortSubmitAreSubmittedLater) {
+  IoUringDispatcher dispatcher;
+  Pipe pipe;
+  ASSERT_EQ(write(pipe.write_fd(), "x", 1), 1);
+
+  IoUringDispatcherTestPeer::QueueInvalidEntry(dispatcher);
+  std::array<std::byte, 1> buffer{};
+  IoUringReadFuture read = dispatcher.Read(pipe.read_fd(), buffer);
+  std::optional<StatusWithSize> result;
+
+  FuncTask task([&](Context& cx) -> Poll<> {
+    Poll<StatusWithSize> poll = read.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+
+  // The kernel stops at the rejected entry, so the read is left in the
+  // submission queue. It must still be counted for the next submit.
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+  EXPECT_FALSE(result.has_value());
+  ASSERT_GE(IoUringDispatcherTestPeer::queued(dispatcher), 1u);
+  ASSERT_EQ(IoUringDispatcherTestPeer::unsubmitted(dispatcher),
+            IoUringDispatcherTestPeer::queued(dispatcher));
+
+  dispatcher.RunToCompletion();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->status(), pw::OkStatus());
+  EXPECT_EQ(result->size(), 1u);
+}
+
+TEST(IoUringDispatcher, TimerExpires) {
+  IoUringDispatcher dispatcher;
+  IoUringTimerFuture timer = dispatcher.WaitFor(5ms);
+  const SystemClock::time_point start = SystemClock::now();
+
+  FuncTask task([&](Context& cx) -> Poll<> { return timer.Pend(cx); });
+  dispatcher.Post(task);
+  dispatcher.RunToCompletion();
+
+  EXPECT_TRUE(timer.is_complete());
+  EXPECT_GE(SystemClock::now() - start, SystemClock::for_at_least(5ms));
+}
+
+TEST(IoUringDispatcher, AcceptLoopbackConnection) {
+  IoUringDispatcher dispatcher;
+
+  const int listener = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(listener, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  ASSERT_EQ(
+      bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)),
+      0);
+  ASSERT_EQ(listen(listener, 1), 0);
+  socklen_t length = sizeof(address);
+  ASSERT_EQ(
+      getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length),
+      0);
+
+  IoUringAcceptFuture accept = dispatcher.Accept(listener);
+  std::optional<Result<int>> accepted;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    Poll<Result<int>> poll = accept.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    accepted = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+
+  const int client = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_EQ(
+      connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)),
+      0);
+  dispatcher.RunToCompletion();
+
+  ASSERT_TRUE(accepted.has_value());
+  ASSERT_EQ(accepted->status(), pw::OkStatus());
+  EXPECT_GE(accepted->value(), 0);
+
+  close(accepted->value());
+  close(client);
+  close(listener);
+}
+
+TEST(IoUringDispatcher, OperationsBeyondLimitAreResourceExhausted) {
+  IoUringDispatcher dispatcher;
+  Pipe pipe;
+  std::array<std::byte, 1> buffer{};
+
+  {
+    std::array<IoUringReadFuture, IoUringDispatcher::kMaxOperations> reads;
+    for (IoUringReadFuture& read : reads) {
+      read = dispatcher.Read(pipe.read_fd(), buffer);
+    }
+    IoUringReadFuture extra = dispatcher.Read(pipe.read_fd(), buffer);
+
+    std::optional<StatusWithSize> result;
+    FuncTask task([&](Context& cx) -> Poll<> {
+      Poll<StatusWithSize> poll = extra.Pend(cx);
+      PW_ASSERT(poll.IsReady());
+      result = *poll;
+      return Ready();
+    });
+    dispatcher.Post(task);
+    dispatcher.RunToCompletion();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->status(), Status::ResourceExhausted());
+
+    // Destroying the pending reads cancels them.
+  }
+  EXPECT_FALSE(dispatcher.RunUntilStalled());
+
+  // The cancelled operations' slots are reusable.
+  IoUringReadFuture read = dispatcher.Read(pipe.read_fd(), buffer);
+  std::optional<StatusWithSize> result;
+  FuncTask task([&](Context& cx) -> Poll<> {
+    Poll<StatusWithSize> poll = read.Pend(cx);
+    if (poll.IsPending()) {
+      return Pending();
+    }
+    result = *poll;
+    return Ready();
+  });
+  dispatcher.Post(task);
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+  ASSERT_EQ(write(pipe.write_fd(), "x", 1), 1);
+  dispatcher.RunToCompletion();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->status(), pw::OkStatus());
+  EXPECT_EQ(result->size(), 1u);
+}
+
+}  // namespace
@@ -26,6 +26,7 @@
 #include "pw_async2/task.h"
 #include "pw_async2/waker.h"
 #include "pw_containers/intrusive_queue.h"
+#include "pw_span/span.h"
 #include "pw_sync/lock_annotations.h"
 
 // Coroutines are supported if the build target depends on //pw_async2:coro.
@@ -271,7 +272,7 @@ class Dispatcher {
   /// `PopTaskToRun` MUST be called repeatedly until it returns `nullptr`, at
   /// which point the dispatcher will request a wake.
   Task* PopTaskToRun() PW_LOCKS_EXCLUDED(internal::lock()) {
-    std::lock_guard lock(internal::lock());
+    internal::ShardLock lock(lock_shard());
     return PopTaskToRunLocked();
   }
 
@@ -289,17 +290,32 @@ class Dispatcher {
   ///     are no ready tasks.
   Task* PopTaskToRun(bool& has_posted_tasks)
       PW_LOCKS_EXCLUDED(internal::lock()) {
-    std::lock_guard lock(internal::lock());
+    internal::ShardLock lock(lock_shard());
     Task* task = PopTaskToRunLocked();
     has_posted_tasks = task != nullptr || !sleeping_.empty();
     return task;
   }
 
+  /// Pops up to `tasks.size()` tasks and marks them as running. Each popped
+  /// task must be passed to `RunTask`. This allows dispatchers that run tasks
+  /// on multiple threads to claim several tasks while acquiring the lock once.
+  ///
+  /// Like `PopTaskToRun`, `PopTasksToRun` MUST be called repeatedly until it
+  /// returns fewer tasks than requested, at which point the dispatcher will
+  /// request a wake.
+  ///
+  /// @param[out] tasks Filled with pointers to tasks that are ready to run.
+  /// @param[out] has_posted_tasks Set to `true` if the dispatcher has at least
+  ///     one task posted, potentially including the tasks that were popped.
+  /// @returns The number of tasks written to `tasks`.
+  size_t PopTasksToRun(span<Task*> tasks, bool& has_posted_tasks)
+      PW_LOCKS_EXCLUDED(internal::lock());
+
   /// Pop a single task to run. Each call to `PopSingleTaskForThisWake` can
   /// result in up to one `DoWake()` call, so use `PopTaskToRun` or
   /// `PopAndRunAllReadyTasks` to run multiple tasks.
   Task* PopSingleTaskForThisWake() PW_LOCKS_EXCLUDED(internal::lock()) {
-    std::lock_guard lock(internal::lock());
+    internal::ShardLock lock(lock_shard());
     wants_wake_ = true;
     return PopTaskToRunLocked();
   }
@@ -334,9 +350,9 @@ class Dispatcher {
   /// - `PopTaskToRun()` returns `nullptr`, or
   /// - `PopSingleTaskForThisWake()` is called.
   ///
-  /// @note The `internal::lock()` may or may not be held here, so it
-  /// must not be acquired by `DoWake`, nor may `DoWake` assume that it has been
-  /// acquired.
+  /// @note The dispatcher's `internal::lock()` shard may or may not be held
+  /// here, so it must not be acquired by `DoWake`, nor may `DoWake` assume that
+  /// it has been acquired.
   virtual void DoWake() PW_LOCKS_EXCLUDED(internal::lock()) = 0;
 
   void Wake(Task* task_to_release = nullptr)
@@ -351,6 +367,11 @@ class Dispatcher {
     }
   }
 
+  // Returns the lock shard that guards this dispatcher and its tasks.
+  sync::InterruptSpinLock& lock_shard() const {
+    return internal::LockShardFor(this);
+  }
+
   Task* PopTaskToRunLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(internal::lock());
 
   static void UnpostTaskList(IntrusiveQueue<Task>& list)
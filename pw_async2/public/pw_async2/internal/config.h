@@ -40,4 +40,30 @@
 #define PW_ASYNC2_LOG_LEVEL PW_LOG_LEVEL_INFO
 #endif  // PW_ASYNC2_LOG_LEVEL
 
+/// The capacity of each worker's local run queue in a
+/// `pw::async2::WorkStealingDispatcher`. Must be a power of two. Workers claim
+/// up to half this many tasks from the dispatcher at once.
+#ifndef PW_ASYNC2_WORK_STEALING_QUEUE_CAPACITY
+#define PW_ASYNC2_WORK_STEALING_QUEUE_CAPACITY 32
+#endif  // PW_ASYNC2_WORK_STEALING_QUEUE_CAPACITY
+
+/// The maximum number of operations that a `pw::async2::IoUringDispatcher` can
+/// have in flight at once. The dispatcher's submission ring is sized to hold
+/// this many operations plus their cancellations.
+#ifndef PW_ASYNC2_IO_URING_MAX_OPERATIONS
+#define PW_ASYNC2_IO_URING_MAX_OPERATIONS 64
+#endif  // PW_ASYNC2_IO_URING_MAX_OPERATIONS
+
+/// The number of locks that guard `pw_async2` dispatchers, tasks, and wakers.
+///
+/// Each dispatcher is assigned one lock by hashing its address. Dispatchers
+/// that are assigned different locks can post, wake, and run tasks on separate
+/// threads without contending with each other. Tasks and wakers store a pointer
+/// to their lock when this is greater than 1.
+///
+/// Defaults to 1, which guards all dispatchers with a single lock.
+#ifndef PW_ASYNC2_LOCK_SHARDS
+#define PW_ASYNC2_LOCK_SHARDS 1
+#endif  // PW_ASYNC2_LOCK_SHARDS
+
 /// @endsubmodule
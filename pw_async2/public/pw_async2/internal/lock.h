@@ -13,25 +13,199 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_async2/internal/config.h"
 #include "pw_memory/no_destructor.h"
 #include "pw_polyfill/language_feature_macros.h"
 #include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
 
 namespace pw::async2::internal {
 
-// A lock guarding `Task` queue and `Waker` lists for all `Dispatcher`s. This is
-// an internal implementation detail. Do not use it directly.
+// Locks guarding `Task` queues and `Waker` lists. This is an internal
+// implementation detail. Do not use it directly.
 //
-// This is an `InterruptSpinLock` in order to allow posting work from ISR
+// The locks are `InterruptSpinLock`s in order to allow posting work from ISR
 // contexts.
 //
-// This lock is global rather than per-dispatcher in order to allow `Task` and
-// `Waker` to take out the lock without dereferencing their `Dispatcher*`
-// fields, which are themselves guarded by the lock in order to allow the
-// `Dispatcher` to `Deregister` itself upon destruction.
-inline pw::sync::InterruptSpinLock& lock() {
-  PW_CONSTINIT static NoDestructor<pw::sync::InterruptSpinLock> lock;
-  return *lock;
+// There are `PW_ASYNC2_LOCK_SHARDS` locks. Each `Dispatcher` maps to one
+// shard, which guards its queues, the tasks posted to it, and the wakers that
+// reference those tasks. Dispatchers that map to different shards never
+// contend with each other.
+//
+// `Task`s and `Waker`s record which shard guards them in a `ShardRef`. This
+// allows them to take out the lock without dereferencing their `Dispatcher*` or
+// `Task*` fields, which are themselves guarded by the lock in order to allow
+// the `Dispatcher` to `Deregister` itself upon destruction. An object only
+// moves to a different shard while both the old and new shards are held.
+
+inline constexpr size_t kLockShards = PW_ASYNC2_LOCK_SHARDS;
+static_assert(kLockShards > 0, "PW_ASYNC2_LOCK_SHARDS must be at least 1");
+
+// Thread safety analysis cannot track which shard guards an object, so all
+// shards are represented by this one capability for the analysis. Use the
+// functions and classes below to acquire and release shards.
+class PW_LOCKABLE("pw::async2::internal::lock") LockCapability {};
+
+inline LockCapability& lock() {
+  PW_CONSTINIT static LockCapability capability;
+  return capability;
+}
+
+// Returns the lock shard with the given index.
+inline sync::InterruptSpinLock& LockShard(size_t index) {
+  PW_CONSTINIT static NoDestructor<
+      std::array<sync::InterruptSpinLock, kLockShards>>
+      shards;
+  return (*shards)[index];
+}
+
+// Returns the lock shard for an object, such as a `Dispatcher`, by hashing its
+// address.
+inline sync::InterruptSpinLock& LockShardFor(const void* object) {
+  if constexpr (kLockShards == 1) {
+    static_cast<void>(object);
+    return LockShard(0);
+  } else {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(object);
+    return LockShard(((address >> 4) ^ (address >> 12)) % kLockShards);
+  }
+}
+
+inline void Lock(sync::InterruptSpinLock& shard)
+    PW_EXCLUSIVE_LOCK_FUNCTION(lock()) PW_NO_LOCK_SAFETY_ANALYSIS {
+  shard.lock();
+}
+
+inline void Unlock(sync::InterruptSpinLock& shard) PW_UNLOCK_FUNCTION(lock())
+    PW_NO_LOCK_SAFETY_ANALYSIS {
+  shard.unlock();
 }
 
+// Records which lock shard guards a `Task` or `Waker`. Objects start out
+// guarded by shard 0.
+class ShardRef {
+ public:
+  constexpr ShardRef() = default;
+
+  ShardRef(const ShardRef&) = delete;
+  ShardRef& operator=(const ShardRef&) = delete;
+
+  // Returns the shard that currently guards the object. The result is only
+  // stable while that shard is held.
+  sync::InterruptSpinLock& current() const {
+#if PW_ASYNC2_LOCK_SHARDS > 1
+    sync::InterruptSpinLock* shard = shard_.load(std::memory_order_acquire);
+    return shard != nullptr ? *shard : LockShard(0);
+#else
+    return LockShard(0);
+#endif  // PW_ASYNC2_LOCK_SHARDS > 1
+  }
+
+  // Acquires the shard that guards the object and returns it.
+  sync::InterruptSpinLock& Lock() const PW_EXCLUSIVE_LOCK_FUNCTION(lock())
+      PW_NO_LOCK_SAFETY_ANALYSIS {
+    while (true) {
+      sync::InterruptSpinLock& shard = current();
+      shard.lock();
+      if (&shard == &current()) {
+        return shard;
+      }
+      shard.unlock();  // The object moved to another shard; try again.
+    }
+  }
+
+  // Moves the object to a different shard. Both the current shard and `shard`
+  // must be held.
+  void set([[maybe_unused]] sync::InterruptSpinLock& shard)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock()) {
+#if PW_ASYNC2_LOCK_SHARDS > 1
+    shard_.store(&shard, std::memory_order_release);
+#endif  // PW_ASYNC2_LOCK_SHARDS > 1
+  }
+
+ private:
+#if PW_ASYNC2_LOCK_SHARDS > 1
+  std::atomic<sync::InterruptSpinLock*> shard_ = nullptr;
+#endif  // PW_ASYNC2_LOCK_SHARDS > 1
+};
+
+// Holds a lock shard for the duration of a scope.
+class PW_SCOPED_LOCKABLE ShardLock {
+ public:
+  explicit ShardLock(sync::InterruptSpinLock& shard)
+      PW_EXCLUSIVE_LOCK_FUNCTION(lock()) PW_NO_LOCK_SAFETY_ANALYSIS
+      : shard_(shard) {
+    shard_.lock();
+  }
+
+  // Acquires the shard that guards the object referred to by `ref`.
+  explicit ShardLock(const ShardRef& ref) PW_EXCLUSIVE_LOCK_FUNCTION(lock())
+      : shard_(ref.Lock()) {}
+
+  ShardLock(const ShardLock&) = delete;
+  ShardLock& operator=(const ShardLock&) = delete;
+
+  ~ShardLock() PW_UNLOCK_FUNCTION() PW_NO_LOCK_SAFETY_ANALYSIS {
+    shard_.unlock();
+  }
+
+ private:
+  sync::InterruptSpinLock& shard_;
+};
+
+// Holds the shards guarding two objects for the duration of a scope. The
+// objects may share a shard. Shards are always acquired in address order to
+// avoid deadlock.
+class PW_SCOPED_LOCKABLE ShardPairLock {
+ public:
+  ShardPairLock(const ShardRef& a, const ShardRef& b)
+      PW_EXCLUSIVE_LOCK_FUNCTION(lock()) PW_NO_LOCK_SAFETY_ANALYSIS {
+    while (true) {
+      first_ = &a.current();
+      second_ = &b.current();
+      if (first_ == second_) {
+        second_ = nullptr;
+      } else if (second_ < first_) {
+        std::swap(first_, second_);
+      }
+
+      first_->lock();
+      if (second_ != nullptr) {
+        second_->lock();
+      }
+      if (Holds(a.current()) && Holds(b.current())) {
+        return;
+      }
+      Release();  // An object moved to another shard; try again.
+    }
+  }
+
+  ShardPairLock(const ShardPairLock&) = delete;
+  ShardPairLock& operator=(const ShardPairLock&) = delete;
+
+  ~ShardPairLock() PW_UNLOCK_FUNCTION() PW_NO_LOCK_SAFETY_ANALYSIS {
+    Release();
+  }
+
+ private:
+  bool Holds(const sync::InterruptSpinLock& shard) const {
+    return &shard == first_ || &shard == second_;
+  }
+
+  void Release() PW_NO_LOCK_SAFETY_ANALYSIS {
+    if (second_ != nullptr) {
+      second_->unlock();
+    }
+    first_->unlock();
+  }
+
+  sync::InterruptSpinLock* first_;
+  sync::InterruptSpinLock* second_;
+};
+
 }  // namespace pw::async2::internal
@@ -0,0 +1,129 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace pw::async2::internal {
+
+// A fixed-capacity, lock-free, single-owner / multi-thief deque of pointers.
+//
+// This is the bounded variant of the Chase-Lev work-stealing deque, using the
+// C11 memory orderings from "Correct and Efficient Work-Stealing for Weak
+// Memory Models" (Lê et al., PPoPP 2013). The owning thread pushes and pops at
+// the bottom; any other thread may steal from the top.
+//
+// Indices increase monotonically and are allowed to wrap around; they are
+// compared using their signed difference.
+template <typename T, size_t kCapacity>
+class WorkStealingQueue {
+ public:
+  static_assert(kCapacity > 1 && (kCapacity & (kCapacity - 1)) == 0,
+                "The capacity must be a power of two");
+
+  constexpr WorkStealingQueue() = default;
+
+  WorkStealingQueue(const WorkStealingQueue&) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+  static constexpr size_t capacity() { return kCapacity; }
+
+  // Adds an item to the bottom of the queue. Returns false if the queue is
+  // full. May only be called by the owning thread.
+  bool Push(T* item) {
+    const size_t bottom = bottom_.load(std::memory_order_relaxed);
+    const size_t top = top_.load(std::memory_order_acquire);
+    if (Distance(top, bottom) >= static_cast<Diff>(kCapacity)) {
+      return false;
+    }
+    Slot(bottom).store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Removes an item from the bottom of the queue, or returns `nullptr` if the
+  // queue is empty. May only be called by the owning thread.
+  T* Pop() {
+    const size_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    size_t top = top_.load(std::memory_order_relaxed);
+
+    if (Distance(top, bottom) < 0) {  // The queue is empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T* item = Slot(bottom).load(std::memory_order_relaxed);
+    if (top == bottom) {  // Last item; race against thieves for it.
+      if (!top_.compare_exchange_strong(top,
+                                        top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Removes an item from the top of the queue, or returns `nullptr` if the
+  // queue is empty. May be called from any thread.
+  T* Steal() {
+    size_t top = top_.load(std::memory_order_acquire);
+    while (true) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const size_t bottom = bottom_.load(std::memory_order_acquire);
+      if (Distance(top, bottom) <= 0) {
+        return nullptr;
+      }
+      T* item = Slot(top).load(std::memory_order_relaxed);
+      // On failure, `top` is updated to the current value, so retry.
+      if (top_.compare_exchange_strong(top,
+                                       top + 1,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+        return item;
+      }
+    }
+  }
+
+  // Returns true if the queue appeared empty at some point during the call.
+  bool empty() const {
+    const size_t top = top_.load(std::memory_order_acquire);
+    const size_t bottom = bottom_.load(std::memory_order_acquire);
+    return Distance(top, bottom) <= 0;
+  }
+
+ private:
+  using Diff = std::make_signed_t<size_t>;
+
+  static constexpr Diff Distance(size_t top, size_t bottom) {
+    return static_cast<Diff>(bottom - top);
+  }
+
+  std::atomic<T*>& Slot(size_t index) {
+    return items_[index & (kCapacity - 1)];
+  }
+
+  std::atomic<size_t> top_ = 0;
+  std::atomic<size_t> bottom_ = 0;
+  std::array<std::atomic<T*>, kCapacity> items_ = {};
+};
+
+}  // namespace pw::async2::internal
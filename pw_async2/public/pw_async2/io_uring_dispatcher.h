@@ -0,0 +1,277 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_async2/future.h"
+#include "pw_async2/internal/config.h"
+#include "pw_async2/poll.h"
+#include "pw_async2/runnable_dispatcher.h"
+#include "pw_async2/waker.h"
+#include "pw_bytes/span.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_result/result.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_sync/interrupt_spin_lock.h"
+#include "pw_sync/lock_annotations.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace pw::async2 {
+
+class IoUringDispatcher;
+
+namespace internal {
+
+// Converts a negated errno, as reported in an io_uring completion, to a status.
+Status IoUringErrorToStatus(int result);
+
+// Common implementation of the futures vended by `IoUringDispatcher`. Each
+// future owns one of the dispatcher's operation slots until it completes.
+class IoUringFutureBase {
+ public:
+  IoUringFutureBase(const IoUringFutureBase&) = delete;
+  IoUringFutureBase& operator=(const IoUringFutureBase&) = delete;
+
+  IoUringFutureBase(IoUringFutureBase&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  IoUringFutureBase& operator=(IoUringFutureBase&& other) noexcept;
+
+  ~IoUringFutureBase() { Release(); }
+
+  [[nodiscard]] bool is_pendable() const { return state_.is_pendable(); }
+  [[nodiscard]] bool is_complete() const { return state_.is_complete(); }
+
+ protected:
+  constexpr IoUringFutureBase() = default;
+
+  // Returns the result of the operation: a non-negative value on success or a
+  // negated errno on failure.
+  Poll<int> PendResult(Context& cx);
+
+ private:
+  friend class ::pw::async2::IoUringDispatcher;
+
+  // Creates a future for an operation that failed to start.
+  explicit IoUringFutureBase(int result)
+      : result_(result), state_(FutureState::kReadyForCompletion) {}
+
+  IoUringFutureBase(IoUringDispatcher& dispatcher, uint16_t operation)
+      : dispatcher_(&dispatcher),
+        operation_(operation),
+        state_(FutureState::kPending) {}
+
+  // Cancels the operation if it is still in flight.
+  void Release();
+
+  IoUringDispatcher* dispatcher_ = nullptr;
+  uint16_t operation_ = 0;
+  int result_ = 0;
+  FutureState state_;
+};
+
+}  // namespace internal
+
+/// @submodule{pw_async2,dispatchers}
+
+/// Future for an `IoUringDispatcher` read or write. Resolves to the number of
+/// bytes transferred, or an error status.
+class IoUringTransferFuture final : public internal::IoUringFutureBase {
+ public:
+  using value_type = StatusWithSize;
+
+  constexpr IoUringTransferFuture() = default;
+
+  Poll<StatusWithSize> Pend(Context& cx);
+
+ private:
+  friend class IoUringDispatcher;
+  using IoUringFutureBase::IoUringFutureBase;
+};
+
+using IoUringReadFuture = IoUringTransferFuture;
+using IoUringWriteFuture = IoUringTransferFuture;
+
+/// Future for an `IoUringDispatcher` accept. Resolves to the file descriptor
+/// of the accepted connection, or an error status.
+class IoUringAcceptFuture final : public internal::IoUringFutureBase {
+ public:
+  using value_type = Result<int>;
+
+  constexpr IoUringAcceptFuture() = default;
+
+  Poll<Result<int>> Pend(Context& cx);
+
+ private:
+  friend class IoUringDispatcher;
+  using IoUringFutureBase::IoUringFutureBase;
+};
+
+/// Future for an `IoUringDispatcher` timer. Resolves when the timer expires.
+class IoUringTimerFuture final : public internal::IoUringFutureBase {
+ public:
+  using value_type = void;
+
+  constexpr IoUringTimerFuture() = default;
+
+  Poll<> Pend(Context& cx);
+
+ private:
+  friend class IoUringDispatcher;
+  using IoUringFutureBase::IoUringFutureBase;
+};
+
+/// A `RunnableDispatcher` backed by Linux's `io_uring` interface.
+///
+/// Unlike `EpollDispatcher`, which reports that a file descriptor is ready and
+/// leaves the I/O to the task, `IoUringDispatcher` performs reads, writes,
+/// accepts, and timeouts itself. Operations started by tasks are queued on a
+/// submission ring shared by all tasks and submitted together with a single
+/// system call when the dispatcher next waits for work, so a dispatcher that
+/// drives many sockets batches its system calls.
+///
+/// Operations complete into futures. Pend them from tasks running on this
+/// dispatcher. Operations started from other threads are not submitted until
+/// the dispatcher next runs.
+///
+/// File descriptors should be in blocking mode; `io_uring` reports `EAGAIN`
+/// for non-blocking file descriptors instead of waiting for them.
+///
+/// Buffers passed to `Read` and `Write` must remain valid until the operation
+/// completes. Destroying a pending future requests cancellation of its
+/// operation, but the kernel may still access the buffer until the dispatcher
+/// processes the cancellation.
+class IoUringDispatcher final : public RunnableDispatcher {
+ public:
+  /// The maximum number of operations that may be in flight at once. Futures
+  /// for operations started beyond this limit resolve to
+  /// `RESOURCE_EXHAUSTED`.
+  static constexpr size_t kMaxOperations = PW_ASYNC2_IO_URING_MAX_OPERATIONS;
+
+  IoUringDispatcher() { PW_ASSERT_OK(NativeInit()); }
+  ~IoUringDispatcher() override;
+
+  Status NativeInit();
+
+  /// Reads up to `buffer.size()` bytes from `fd`. Resolves to 0 bytes at the
+  /// end of the file or stream.
+  IoUringReadFuture Read(int fd, ByteSpan buffer);
+
+  /// Writes up to `data.size()` bytes to `fd`.
+  IoUringWriteFuture Write(int fd, ConstByteSpan data);
+
+  /// Accepts a connection on the listening socket `fd`. The accepted socket is
+  /// created with `SOCK_CLOEXEC`.
+  IoUringAcceptFuture Accept(int fd);
+
+  /// Returns a future that resolves after `delay`.
+  IoUringTimerFuture WaitFor(chrono::SystemClock::duration delay);
+
+ private:
+  friend class internal::IoUringFutureBase;
+  friend class IoUringDispatcherTestPeer;
+
+  enum class OperationState : uint8_t {
+    kFree,
+    kSubmitted,
+    kComplete,
+    // The future was destroyed before the operation completed.
+    kOrphaned,
+  };
+
+  struct KernelTimespec {
+    int64_t tv_sec;
+    int64_t tv_nsec;
+  };
+
+  struct Operation {
+    Waker waker;
+    KernelTimespec timeout;
+    uint32_t generation = 0;
+    int32_t result = 0;
+    OperationState state = OperationState::kFree;
+  };
+
+  bool DoRunUntilStalled() override;
+  void DoWake() override;
+  void DoWaitForWake() override;
+
+  // Submits queued operations and processes completions. Blocks until at least
+  // one completion arrives if `wait` is true.
+  Status NativeSubmitAndProcessCompletions(bool wait);
+  void ProcessCompletion(const io_uring_cqe& cqe);
+
+  // Claims an operation slot and a submission queue entry for it. Returns
+  // `nullptr` if no slot is free.
+  io_uring_sqe* StartOperationLocked(uint8_t opcode,
+                                     int fd,
+                                     uint16_t& operation)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the next free submission queue entry. The ring is sized so that it
+  // cannot fill: it has room for every operation, its cancellation, and the
+  // wake read.
+  io_uring_sqe* NextSqeLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  void ArmWakeReadLocked() PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  Poll<int> PendOperation(uint16_t operation, Context& cx);
+  void CancelOperation(uint16_t operation);
+  void FreeOperationLocked(uint16_t operation)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  int ring_fd_ = -1;
+  int wake_fd_ = -1;
+
+  void* ring_ = nullptr;
+  size_t ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // Pointers into the shared submission and completion rings.
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+  uint32_t cq_mask_ = 0;
+
+  // Buffer for the read that waits on `wake_fd_`. Only accessed by the kernel.
+  uint64_t wake_buffer_ = 0;
+
+  sync::InterruptSpinLock lock_;
+
+  // Number of entries added to the submission queue since the last submit.
+  uint32_t unsubmitted_ PW_GUARDED_BY(lock_) = 0;
+
+  std::array<Operation, kMaxOperations> operations_ PW_GUARDED_BY(lock_);
+  std::array<uint16_t, kMaxOperations> free_operations_ PW_GUARDED_BY(lock_);
+  size_t free_count_ PW_GUARDED_BY(lock_) = 0;
+};
+
+/// @endsubmodule
+
+}  // namespace pw::async2
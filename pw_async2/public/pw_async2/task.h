@@ -245,6 +245,11 @@ class Task : public IntrusiveQueue<Task>::Item, private Context {
     dispatcher_ = &dispatcher;
   }
 
+  // Acquires the task's lock shard and moves the task and its wakers to
+  // `shard`. Returns with only `shard` held.
+  void LockAndMoveToShard(sync::InterruptSpinLock& shard)
+      PW_EXCLUSIVE_LOCK_FUNCTION(internal::lock()) PW_NO_LOCK_SAFETY_ANALYSIS;
+
   // Removes the task from the dispatcher. Returns the ControlBlock* if the
   // dispatcher has a shared reference to this task.
   allocator::internal::ControlBlock* Unpost()
@@ -339,6 +344,10 @@ class Task : public IntrusiveQueue<Task>::Item, private Context {
   // Linked list of `Waker` s that may awaken this `Task`.
   IntrusiveForwardList<Waker> wakers_ PW_GUARDED_BY(internal::lock());
 
+  // The lock shard that guards this task. While posted, this is the
+  // dispatcher's shard.
+  internal::ShardRef lock_shard_;
+
   // Optional user-facing name for the task. If set, it will be included in
   // debug logs.
   log::Token name_;
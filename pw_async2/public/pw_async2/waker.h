@@ -241,6 +241,10 @@ class Waker : public pw::IntrusiveForwardList<Waker>::Item {
   // The `Task` to poll when awoken.
   Task* task_ PW_GUARDED_BY(internal::lock()) = nullptr;
 
+  // The lock shard that guards this waker. While `task_` is set, this is the
+  // task's shard.
+  internal::ShardRef lock_shard_;
+
 #if PW_ASYNC2_DEBUG_WAIT_REASON
   log::Token wait_reason_ PW_GUARDED_BY(internal::lock()) = log::kDefaultToken;
 #endif  // PW_ASYNC2_DEBUG_WAIT_REASON
@@ -0,0 +1,174 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_async2/internal/config.h"
+#include "pw_async2/internal/work_stealing_queue.h"
+#include "pw_async2/runnable_dispatcher.h"
+#include "pw_span/span.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/options.h"
+#include "pw_thread/thread.h"
+
+namespace pw::async2 {
+namespace internal {
+
+/// Non-templated base of `WorkStealingDispatcher`. Do not use directly.
+class WorkStealingDispatcherBase : public RunnableDispatcher {
+ public:
+  /// The maximum number of worker threads a dispatcher may have.
+  static constexpr size_t kMaxWorkers = 32;
+
+  /// Starts one thread per worker. Each worker claims batches of woken tasks
+  /// into its local run queue, runs them, and steals from other workers' run
+  /// queues when it runs out of work.
+  ///
+  /// The same `options` are used to create every worker thread, so they must
+  /// be valid for creating multiple threads.
+  ///
+  /// @pre The workers must not already be running.
+  void Start(const thread::Options& options);
+
+  /// Stops and joins all worker threads. Tasks that a worker already claimed
+  /// are run once more before it exits. Tasks that remain posted stay
+  /// registered with the dispatcher, and may be run with `RunUntilStalled` or
+  /// after calling `Start` again.
+  ///
+  /// @pre Must not be called from a task running on this dispatcher.
+  void Stop();
+
+  /// Returns the number of worker threads this dispatcher runs.
+  size_t num_workers() const { return workers_.size(); }
+
+ protected:
+  static constexpr size_t kLocalQueueCapacity =
+      PW_ASYNC2_WORK_STEALING_QUEUE_CAPACITY;
+
+  class Worker {
+   public:
+    Worker() = default;
+
+   private:
+    friend class WorkStealingDispatcherBase;
+
+    WorkStealingDispatcherBase* dispatcher_ = nullptr;
+    uint32_t index_ = 0;
+    WorkStealingQueue<Task, kLocalQueueCapacity> queue_;
+    sync::ThreadNotification notification_;
+    Thread thread_;
+  };
+
+  explicit WorkStealingDispatcherBase(span<Worker> workers)
+      : workers_(workers) {}
+
+ private:
+  // Claim at most half of the local queue so that thieves have room to steal
+  // while the owner still has work queued.
+  static constexpr size_t kClaimBatchSize = kLocalQueueCapacity / 2;
+
+  // Runs ready tasks on the calling thread in addition to any started workers.
+  // Returns true while tasks are posted or running on a worker.
+  bool DoRunUntilStalled() override;
+
+  void DoWake() override;
+
+  void DoWaitForWake() override { runner_notification_.acquire(); }
+
+  // Thread body for a worker.
+  void RunWorker(Worker& worker);
+
+  // Returns a task to run from the worker's local queue, the dispatcher's
+  // woken queue, or another worker's local queue, in that order.
+  Task* FindTask(Worker& worker);
+
+  // Claims a batch of woken tasks from the dispatcher into the worker's local
+  // queue. Returns one of the claimed tasks, or `nullptr` if none were woken.
+  Task* ClaimTasks(Worker& worker);
+
+  Task* StealTask(Worker& worker);
+
+  // Marks the worker as idle and blocks until it is woken. Returns a task if
+  // one was found after marking the worker idle.
+  Task* Park(Worker& worker);
+
+  // Wakes one idle worker, if there is one.
+  void WakeIdleWorker();
+
+  void RunClaimedTask(Task& task);
+
+  // Releases a claim on a task. Notifies threads blocked in
+  // `RunToCompletion` when no claimed tasks remain.
+  void ReleaseClaim();
+
+  span<Worker> workers_;
+
+  // Bitmask of parked workers.
+  std::atomic<uint32_t> idle_workers_ = 0;
+
+  // Number of tasks claimed by workers that have not finished running. Claimed
+  // tasks are neither woken nor sleeping, so they are not reflected in
+  // `PopTaskToRun`'s `has_posted_tasks`.
+  std::atomic<uint32_t> claimed_tasks_ = 0;
+
+  std::atomic<bool> stopping_ = false;
+
+  // Notifies threads that run the dispatcher through the `RunnableDispatcher`
+  // interface.
+  sync::ThreadNotification runner_notification_;
+};
+
+}  // namespace internal
+
+/// @submodule{pw_async2,dispatchers}
+
+/// A `RunnableDispatcher` that runs tasks on `kNumWorkers` worker threads.
+///
+/// Each worker owns a fixed-size, lock-free run queue. Idle workers claim
+/// batches of woken tasks from the dispatcher and steal from the run queues of
+/// busy workers, so CPU-bound tasks scale with the number of workers. A task
+/// never runs on more than one worker at a time.
+///
+/// Call `Start()` to launch the worker threads. Any thread may also call the
+/// `RunnableDispatcher` functions: `RunUntilStalled()` runs ready tasks on the
+/// calling thread, and `RunToCompletion()` blocks until no tasks remain posted.
+/// If `Start()` is never called, `WorkStealingDispatcher` behaves like a
+/// `BasicDispatcher`.
+///
+/// The worker threads are stopped and joined when the dispatcher is destroyed.
+template <size_t kNumWorkers>
+class WorkStealingDispatcher final
+    : public internal::WorkStealingDispatcherBase {
+ public:
+  static_assert(kNumWorkers > 0, "A dispatcher needs at least one worker");
+  static_assert(kNumWorkers <= kMaxWorkers, "Too many workers");
+
+  WorkStealingDispatcher() : internal::WorkStealingDispatcherBase(workers_) {}
+
+  ~WorkStealingDispatcher() override {
+    Stop();
+    Terminate();
+  }
+
+ private:
+  std::array<Worker, kNumWorkers> workers_;
+};
+
+/// @endsubmodule
+
+}  // namespace pw::async2
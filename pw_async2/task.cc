@@ -15,8 +15,6 @@
 #include "pw_async2/internal/logging.h"
 // logging.h must be included first
 
-#include <mutex>
-
 #include "pw_allocator/allocator.h"
 #include "pw_allocator/internal/control_block.h"
 #include "pw_assert/check.h"
@@ -50,7 +48,7 @@ void Task::RemoveAllWakersLocked() {
 }
 
 bool Task::IsRegistered() const {
-  std::lock_guard lock(internal::lock());
+  internal::ShardLock lock(lock_shard_);
   return state_ != State::kUnposted;
 }
 
@@ -64,25 +62,23 @@ bool Task::TryDeregister() {
   // This function does not use std::lock_guard since the UnpostAndReleaseRef
   // function releases the lock. Lock correctness is ensured by Clang's
   // thread safety annotations.
-  internal::lock().lock();
+  sync::InterruptSpinLock& shard = lock_shard_.Lock();
 
   switch (state_) {
     case State::kUnposted:
-      internal::lock().unlock();
+      internal::Unlock(shard);
       return true;
     case State::kSleeping:
       dispatcher_->RemoveSleepingTaskLocked(*this);
       break;
     case State::kWokenWhileRunning:
-      dispatcher_->RemoveWokenTaskLocked(*this);
-      [[fallthrough]];
     case State::kRunning:
       // Mark the task as deregistered. The dispatcher thread running the task
       // completes deregistration and moves the task to the unposted state.
       state_ = State::kDeregisteredButRunning;
       [[fallthrough]];
     case State::kDeregisteredButRunning:
-      internal::lock().unlock();
+      internal::Unlock(shard);
       return false;
     case State::kWoken:
       dispatcher_->RemoveWokenTaskLocked(*this);
@@ -96,7 +92,7 @@ bool Task::TryDeregister() {
 void Task::Join() {
   while (true) {
     {
-      std::lock_guard lock(internal::lock());
+      internal::ShardLock lock(lock_shard_);
       if (state_ == State::kUnposted) {
         return;
       }
@@ -105,6 +101,38 @@ void Task::Join() {
   }
 }
 
+void Task::LockAndMoveToShard(sync::InterruptSpinLock& shard) {
+  while (true) {
+    sync::InterruptSpinLock& current = lock_shard_.current();
+    if (&current == &shard) {
+      shard.lock();
+      if (&lock_shard_.current() == &shard) {
+        return;
+      }
+      shard.unlock();
+      continue;
+    }
+
+    // Acquire both shards in address order to avoid deadlock.
+    sync::InterruptSpinLock& first = &current < &shard ? current : shard;
+    sync::InterruptSpinLock& second = &current < &shard ? shard : current;
+    first.lock();
+    second.lock();
+    if (&lock_shard_.current() != &current) {
+      second.unlock();
+      first.unlock();
+      continue;
+    }
+
+    lock_shard_.set(shard);
+    for (Waker& waker : wakers_) {
+      waker.lock_shard_.set(shard);
+    }
+    current.unlock();
+    return;
+  }
+}
+
 allocator::internal::ControlBlock* Task::Unpost() {
   state_ = State::kUnposted;
   dispatcher_ = nullptr;
@@ -113,8 +141,9 @@ allocator::internal::ControlBlock* Task::Unpost() {
 }
 
 void Task::UnpostAndReleaseRef() {
+  sync::InterruptSpinLock& shard = lock_shard_.current();
   allocator::internal::ControlBlock* const control_block = Unpost();
-  internal::lock().unlock();
+  internal::Unlock(shard);
 
   if (control_block != nullptr) {
     ReleaseSharedRef(control_block);
@@ -124,9 +153,11 @@ void Task::UnpostAndReleaseRef() {
 void Task::UnpostAndReleaseRefFromDispatcherDestructor() {
   allocator::internal::ControlBlock* const control_block = Unpost();
   if (control_block != nullptr) {
-    internal::lock().unlock();
+    // The task may be destroyed, so keep a reference to its shard.
+    sync::InterruptSpinLock& shard = lock_shard_.current();
+    internal::Unlock(shard);
     ReleaseSharedRef(control_block);
-    internal::lock().lock();
+    internal::Lock(shard);
   }
 }
 
@@ -145,7 +176,7 @@ RunTaskResult Task::RunInDispatcher() {
   // This function does not use std::lock_guard since the UnpostAndReleaseRef
   // function releases the lock. Lock correctness is ensured by Clang's
   // thread safety annotations.
-  internal::lock().lock();
+  sync::InterruptSpinLock& shard = lock_shard_.Lock();
 
   if (complete || state_ == State::kDeregisteredButRunning) {
     switch (state_) {
@@ -159,8 +190,8 @@ RunTaskResult Task::RunInDispatcher() {
         PW_UNREACHABLE;
       case State::kRunning:
       case State::kDeregisteredButRunning:
-        break;
       case State::kWokenWhileRunning:
+        break;
       case State::kWoken:
         dispatcher_->RemoveWokenTaskLocked(*this);
         break;
@@ -192,9 +223,19 @@ RunTaskResult Task::RunInDispatcher() {
       dispatcher_ = nullptr;
     }
   } else if (state_ == State::kWokenWhileRunning) {
+    // The task was woken while it was running. It is only queued now that it
+    // has finished running, so that no other thread running this dispatcher
+    // can pop and run it concurrently.
+    PW_LOG_DEBUG(
+        "Task " PW_TASK_NAME_FMT() ":%p was woken while running; requeueing",
+        name_,
+        static_cast<const void*>(this));
     state_ = State::kWoken;
+    dispatcher_->AddWokenTaskLocked(*this);
+    dispatcher_->Wake();
+    return RunTaskResult::kActive;
   }
-  internal::lock().unlock();
+  internal::Unlock(shard);
 
   PW_LOG_DEBUG(
       "Task " PW_TASK_NAME_FMT() ":%p finished its run and is still pending",
@@ -219,16 +260,17 @@ void Task::Wake() {
     case State::kRunning:
       // Wake again to indicate that this task should be run once more,
       // as the state of the world may have changed since the task
-      // started running.
+      // started running. The task is queued when it finishes running.
       state_ = State::kWokenWhileRunning;
-      break;
+      internal::Unlock(lock_shard_.current());
+      return;
     case State::kDeregisteredButRunning:
-      internal::lock().unlock();
+      internal::Unlock(lock_shard_.current());
       return;  // Do nothing: will be deregistered when the run finishes
     case State::kWokenWhileRunning:
     case State::kWoken:
       // Do nothing: this has already been woken.
-      internal::lock().unlock();
+      internal::Unlock(lock_shard_.current());
       return;
   }
   dispatcher_->AddWokenTaskLocked(*this);
@@ -14,25 +14,27 @@
 
 #include "pw_async2/waker.h"
 
-#include <mutex>
-
 #include "pw_async2/task.h"
 
 namespace pw::async2 {
 
 Waker::Waker(Task& task, log::Token wait_reason) : task_(&task) {
+  internal::ShardLock lock(task.lock_shard_);
   set_wait_reason(wait_reason);
-  std::lock_guard lock(internal::lock());
+  // This waker is not yet shared, so it can move to the task's shard without
+  // holding its current shard.
+  lock_shard_.set(task.lock_shard_.current());
   task_->AddWakerLocked(*this);
 }
 
 Waker& Waker::operator=(Waker&& other) noexcept {
-  std::lock_guard lock(internal::lock());
+  internal::ShardPairLock lock(lock_shard_, other.lock_shard_);
   RemoveTaskIfSet();
   if (other.task_ == nullptr) {
     return *this;
   }
   task_ = other.task_;
+  lock_shard_.set(other.lock_shard_.current());
   set_wait_reason(other.wait_reason_);
   other.RemoveTask();
   task_->AddWakerLocked(*this);
@@ -40,9 +42,9 @@ Waker& Waker::operator=(Waker&& other) noexcept {
 }
 
 void Waker::Wake() {
-  internal::lock().lock();
+  sync::InterruptSpinLock& shard = lock_shard_.Lock();
   if (task_ == nullptr) {
-    internal::lock().unlock();
+    internal::Unlock(shard);
   } else {
     Task& task = *task_;
     RemoveTask();
@@ -53,7 +55,7 @@ void Waker::Wake() {
 bool Waker::TrySetTask(Context& context, log::Token wait_reason) {
   Task* const new_task = static_cast<Task*>(&context);
 
-  std::lock_guard lock(internal::lock());
+  internal::ShardPairLock lock(lock_shard_, new_task->lock_shard_);
   if (task_ != nullptr && task_ != new_task) {
     return false;
   }
@@ -65,13 +67,14 @@ bool Waker::TrySetTask(Context& context, log::Token wait_reason) {
       task_->RemoveWakerLocked(*this);
     }
     task_ = new_task;
+    lock_shard_.set(new_task->lock_shard_.current());
     task_->AddWakerLocked(*this);
   }
   return true;
 }
 
 bool Waker::CloneInto(Waker& out, log::Token wait_reason) {
-  std::lock_guard lock(internal::lock());
+  internal::ShardPairLock lock(lock_shard_, out.lock_shard_);
   if (out.task_ != nullptr && out.task_ != task_) {
     return false;
   }
@@ -82,6 +85,7 @@ bool Waker::CloneInto(Waker& out, log::Token wait_reason) {
   // Remove the output waker from its existing task's list.
   out.RemoveTaskIfSet();
   out.task_ = task_;
+  out.lock_shard_.set(lock_shard_.current());
 
   out.set_wait_reason(wait_reason);
 
@@ -92,12 +96,12 @@ bool Waker::CloneInto(Waker& out, log::Token wait_reason) {
 }
 
 bool Waker::IsEmpty() const {
-  std::lock_guard lock(internal::lock());
+  internal::ShardLock lock(lock_shard_);
   return task_ == nullptr;
 }
 
 void Waker::Clear() {
-  std::lock_guard lock(internal::lock());
+  internal::ShardLock lock(lock_shard_);
   RemoveTaskIfSet();
 }
 
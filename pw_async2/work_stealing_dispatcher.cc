@@ -0,0 +1,169 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/work_stealing_dispatcher.h"
+
+#include "pw_assert/check.h"
+
+namespace pw::async2::internal {
+
+void WorkStealingDispatcherBase::Start(const thread::Options& options) {
+  PW_CHECK_UINT_LE(workers_.size(), kMaxWorkers);
+  stopping_.store(false, std::memory_order_relaxed);
+
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    Worker& worker = workers_[i];
+    PW_CHECK(!worker.thread_.joinable(), "Workers are already running");
+    worker.dispatcher_ = this;
+    worker.index_ = static_cast<uint32_t>(i);
+    worker.thread_ =
+        Thread(options, [&worker] { worker.dispatcher_->RunWorker(worker); });
+  }
+}
+
+void WorkStealingDispatcherBase::Stop() {
+  stopping_.store(true, std::memory_order_seq_cst);
+  for (Worker& worker : workers_) {
+    worker.notification_.release();
+  }
+  for (Worker& worker : workers_) {
+    if (worker.thread_.joinable()) {
+      worker.thread_.join();
+    }
+  }
+  idle_workers_.store(0, std::memory_order_relaxed);
+}
+
+bool WorkStealingDispatcherBase::DoRunUntilStalled() {
+  const bool has_posted_tasks = PopAndRunAllReadyTasks();
+  // Workers claim tasks before popping them, so a task that was not seen as
+  // posted above is reflected in the claim count.
+  return has_posted_tasks ||
+         claimed_tasks_.load(std::memory_order_seq_cst) != 0;
+}
+
+void WorkStealingDispatcherBase::DoWake() {
+  WakeIdleWorker();
+  runner_notification_.release();
+}
+
+void WorkStealingDispatcherBase::RunWorker(Worker& worker) {
+  while (!stopping_.load(std::memory_order_acquire)) {
+    Task* task = FindTask(worker);
+    if (task == nullptr) {
+      task = Park(worker);
+    }
+    if (task != nullptr) {
+      RunClaimedTask(*task);
+    }
+  }
+
+  // Tasks in the local queue are already marked as running, so they must be
+  // run before the worker exits.
+  while (Task* task = worker.queue_.Pop()) {
+    RunClaimedTask(*task);
+  }
+}
+
+Task* WorkStealingDispatcherBase::FindTask(Worker& worker) {
+  if (Task* task = worker.queue_.Pop(); task != nullptr) {
+    return task;
+  }
+  if (Task* task = ClaimTasks(worker); task != nullptr) {
+    return task;
+  }
+  return StealTask(worker);
+}
+
+Task* WorkStealingDispatcherBase::ClaimTasks(Worker& worker) {
+  // Claim before popping so that `DoRunUntilStalled` never observes a task
+  // that is neither posted nor claimed.
+  claimed_tasks_.fetch_add(1, std::memory_order_seq_cst);
+
+  std::array<Task*, kClaimBatchSize> tasks;
+  bool has_posted_tasks;
+  const size_t count = PopTasksToRun(tasks, has_posted_tasks);
+  if (count == 0) {
+    ReleaseClaim();
+    return nullptr;
+  }
+
+  if (count > 1) {
+    claimed_tasks_.fetch_add(static_cast<uint32_t>(count - 1),
+                             std::memory_order_relaxed);
+    // The local queue was empty, so there is room for the whole batch.
+    for (size_t i = 1; i < count; ++i) {
+      PW_CHECK(worker.queue_.Push(tasks[i]));
+    }
+    // Let an idle worker steal part of the batch.
+    WakeIdleWorker();
+  }
+  return tasks[0];
+}
+
+Task* WorkStealingDispatcherBase::StealTask(Worker& worker) {
+  const size_t num_workers = workers_.size();
+  for (size_t i = 1; i < num_workers; ++i) {
+    Worker& victim = workers_[(worker.index_ + i) % num_workers];
+    if (Task* task = victim.queue_.Steal(); task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+Task* WorkStealingDispatcherBase::Park(Worker& worker) {
+  const uint32_t bit = 1u << worker.index_;
+  idle_workers_.fetch_or(bit, std::memory_order_seq_cst);
+
+  // Look for work again after advertising as idle. Work that arrives after
+  // this check sees the idle bit and wakes this worker.
+  Task* task = FindTask(worker);
+  if (task != nullptr || stopping_.load(std::memory_order_seq_cst)) {
+    idle_workers_.fetch_and(~bit, std::memory_order_relaxed);
+    return task;
+  }
+
+  worker.notification_.acquire();
+  return nullptr;
+}
+
+void WorkStealingDispatcherBase::WakeIdleWorker() {
+  uint32_t idle = idle_workers_.load(std::memory_order_seq_cst);
+  while (idle != 0) {
+    const uint32_t bit = idle & (~idle + 1);  // Lowest set bit
+    if (idle_workers_.compare_exchange_weak(
+            idle, idle & ~bit, std::memory_order_seq_cst)) {
+      uint32_t index = 0;
+      while ((bit >> index) != 1u) {
+        index += 1;
+      }
+      workers_[index].notification_.release();
+      return;
+    }
+  }
+}
+
+void WorkStealingDispatcherBase::RunClaimedTask(Task& task) {
+  RunTask(task);
+  ReleaseClaim();
+}
+
+void WorkStealingDispatcherBase::ReleaseClaim() {
+  if (claimed_tasks_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+    runner_notification_.release();
+  }
+}
+
+}  // namespace pw::async2::internal
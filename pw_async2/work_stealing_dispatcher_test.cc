@@ -0,0 +1,277 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_async2/work_stealing_dispatcher.h"
+
+#include <array>
+#include <atomic>
+
+#include "pw_allocator/libc_allocator.h"
+#include "pw_async2/internal/work_stealing_queue.h"
+#include "pw_async2/task.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::allocator::LibCAllocator;
+using pw::async2::Context;
+using pw::async2::Pending;
+using pw::async2::Poll;
+using pw::async2::Ready;
+using pw::async2::Task;
+using pw::async2::Waker;
+using pw::async2::WorkStealingDispatcher;
+using pw::async2::internal::WorkStealingQueue;
+
+TEST(WorkStealingQueue, PopIsLastInFirstOut) {
+  WorkStealingQueue<int, 4> queue;
+  std::array<int, 3> items = {1, 2, 3};
+  for (int& item : items) {
+    ASSERT_TRUE(queue.Push(&item));
+  }
+  EXPECT_EQ(queue.Pop(), &items[2]);
+  EXPECT_EQ(queue.Pop(), &items[1]);
+  EXPECT_EQ(queue.Pop(), &items[0]);
+  EXPECT_EQ(queue.Pop(), nullptr);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(WorkStealingQueue, StealIsFirstInFirstOut) {
+  WorkStealingQueue<int, 4> queue;
+  std::array<int, 3> items = {1, 2, 3};
+  for (int& item : items) {
+    ASSERT_TRUE(queue.Push(&item));
+  }
+  EXPECT_EQ(queue.Steal(), &items[0]);
+  EXPECT_EQ(queue.Steal(), &items[1]);
+  EXPECT_EQ(queue.Pop(), &items[2]);
+  EXPECT_EQ(queue.Steal(), nullptr);
+}
+
+TEST(WorkStealingQueue, PushFailsWhenFull) {
+  WorkStealingQueue<int, 2> queue;
+  int a = 0;
+  int b = 0;
+  int c = 0;
+  EXPECT_TRUE(queue.Push(&a));
+  EXPECT_TRUE(queue.Push(&b));
+  EXPECT_FALSE(queue.Push(&c));
+  EXPECT_EQ(queue.Steal(), &a);
+  EXPECT_TRUE(queue.Push(&c));
+  EXPECT_EQ(queue.Pop(), &c);
+  EXPECT_EQ(queue.Pop(), &b);
+}
+
+TEST(WorkStealingQueue, ConcurrentStealsTakeEachItemOnce) {
+  constexpr size_t kItems = 4096;
+  static std::array<std::atomic<int>, kItems> taken_count{};
+  static std::array<int, kItems> items{};
+  WorkStealingQueue<int, 64> queue;
+  std::atomic<bool> done = false;
+
+  auto take = [](int* item) {
+    taken_count[static_cast<size_t>(item - items.data())].fetch_add(1);
+  };
+
+  struct Thief {
+    WorkStealingQueue<int, 64>* queue;
+    std::atomic<bool>* done;
+    void (*take)(int*);
+  } thief{&queue, &done, take};
+
+  pw::thread::test::TestThreadContext context;
+  pw::Thread thread(context.options(), [&thief] {
+    while (!thief.done->load()) {
+      if (int* item = thief.queue->Steal(); item != nullptr) {
+        thief.take(item);
+      }
+    }
+  });
+
+  size_t next = 0;
+  while (next < kItems) {
+    while (next < kItems && queue.Push(&items[next])) {
+      next += 1;
+    }
+    if (int* item = queue.Pop(); item != nullptr) {
+      take(item);
+    }
+  }
+  while (int* item = queue.Pop()) {
+    take(item);
+  }
+  done.store(true);
+  thread.join();
+
+  for (const std::atomic<int>& count : taken_count) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+// Counts its runs and completes after a number of runs, re-enqueueing itself
+// in between. Fails the test if it is ever run on two threads at once.
+class CountingTask : public Task {
+ public:
+  explicit CountingTask(int runs_to_complete = 1)
+      : Task(PW_ASYNC_TASK_NAME("CountingTask")),
+        runs_to_complete_(runs_to_complete) {}
+
+  int runs() const { return runs_.load(); }
+  bool overlapped() const { return overlapped_.load(); }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (running_.exchange(true)) {
+      overlapped_.store(true);
+    }
+    const int runs = runs_.fetch_add(1) + 1;
+    running_.store(false);
+
+    if (runs >= runs_to_complete_) {
+      return Ready();
+    }
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  const int runs_to_complete_;
+  std::atomic<int> runs_ = 0;
+  std::atomic<bool> running_ = false;
+  std::atomic<bool> overlapped_ = false;
+};
+
+class ReEnqueueingTask : public CountingTask {
+ public:
+  static constexpr int kRuns = 500;
+
+  ReEnqueueingTask() : CountingTask(kRuns) {}
+};
+
+class SleepingTask : public Task {
+ public:
+  SleepingTask() : Task(PW_ASYNC_TASK_NAME("SleepingTask")) {}
+
+  bool sleeping() const { return sleeping_.load(); }
+
+  void Wake() { waker_.Wake(); }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    if (sleeping_.load()) {
+      return Ready();
+    }
+    PW_ASYNC_STORE_WAKER(cx, waker_, "SleepingTask::Wake()");
+    sleeping_.store(true);
+    return Pending();
+  }
+
+  std::atomic<bool> sleeping_ = false;
+  Waker waker_;
+};
+
+TEST(WorkStealingDispatcher, RunsWithoutWorkersLikeBasicDispatcher) {
+  WorkStealingDispatcher<2> dispatcher;
+  std::array<CountingTask, 4> tasks;
+  for (CountingTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+
+  EXPECT_FALSE(dispatcher.RunUntilStalled());
+  for (CountingTask& task : tasks) {
+    EXPECT_EQ(task.runs(), 1);
+  }
+}
+
+TEST(WorkStealingDispatcher, WorkersRunPostedTasks) {
+  WorkStealingDispatcher<4> dispatcher;
+  pw::thread::test::TestThreadContext context;
+  dispatcher.Start(context.options());
+
+  std::array<CountingTask, 64> tasks;
+  for (CountingTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+  for (CountingTask& task : tasks) {
+    task.Join();
+    EXPECT_EQ(task.runs(), 1);
+  }
+  dispatcher.Stop();
+}
+
+TEST(WorkStealingDispatcher, TaskNeverRunsOnTwoWorkersAtOnce) {
+  WorkStealingDispatcher<4> dispatcher;
+  pw::thread::test::TestThreadContext context;
+  dispatcher.Start(context.options());
+
+  std::array<ReEnqueueingTask, 16> tasks;
+  for (ReEnqueueingTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+  for (ReEnqueueingTask& task : tasks) {
+    task.Join();
+    EXPECT_EQ(task.runs(), ReEnqueueingTask::kRuns);
+    EXPECT_FALSE(task.overlapped());
+  }
+}
+
+TEST(WorkStealingDispatcher, RunToCompletionWaitsForWorkers) {
+  WorkStealingDispatcher<2> dispatcher;
+  pw::thread::test::TestThreadContext context;
+  dispatcher.Start(context.options());
+
+  LibCAllocator allocator;
+  std::atomic<int> completed = 0;
+  for (int i = 0; i < 32; ++i) {
+    auto task = dispatcher.Post(allocator, [&completed](Context&) -> Poll<> {
+      completed.fetch_add(1);
+      return Ready();
+    });
+    ASSERT_NE(task, nullptr);
+  }
+
+  dispatcher.RunToCompletion();
+  EXPECT_EQ(completed.load(), 32);
+}
+
+TEST(WorkStealingDispatcher, SleepingTasksSurviveRestart) {
+  WorkStealingDispatcher<2> dispatcher;
+  pw::thread::test::TestThreadContext context;
+  dispatcher.Start(context.options());
+
+  std::array<SleepingTask, 3> tasks;
+  for (SleepingTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+  for (SleepingTask& task : tasks) {
+    while (!task.sleeping()) {
+      pw::this_thread::yield();
+    }
+  }
+  dispatcher.Stop();
+
+  for (SleepingTask& task : tasks) {
+    EXPECT_TRUE(task.IsRegistered());
+    task.Wake();
+  }
+
+  dispatcher.Start(context.options());
+  for (SleepingTask& task : tasks) {
+    task.Join();
+  }
+}
+
+}  // namespace
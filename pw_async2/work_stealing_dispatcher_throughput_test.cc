@@ -0,0 +1,117 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how task throughput of WorkStealingDispatcher scales with its number
+// of worker threads. Each task performs a fixed amount of CPU-bound work per
+// run and re-enqueues itself until it has run a fixed number of times. The test
+// logs the task runs per second for 1 to 16 workers; it does not assert on
+// the results, since they depend on the number of cores available.
+
+#define PW_LOG_MODULE_NAME "pw_async2 test"
+#define PW_LOG_LEVEL PW_LOG_LEVEL_INFO
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "pw_async2/task.h"
+#include "pw_async2/work_stealing_dispatcher.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::async2::Context;
+using pw::async2::Pending;
+using pw::async2::Poll;
+using pw::async2::Ready;
+using pw::async2::Task;
+using pw::async2::WorkStealingDispatcher;
+using pw::chrono::SystemClock;
+
+constexpr size_t kNumTasks = 64;
+constexpr uint32_t kRunsPerTask = 200;
+constexpr uint32_t kWorkPerRun = 2000;
+
+// A CPU-bound task that re-enqueues itself after each run.
+class BusyTask : public Task {
+ public:
+  BusyTask() : Task(PW_ASYNC_TASK_NAME("BusyTask")) {}
+
+  uint32_t result() const { return state_; }
+
+ private:
+  Poll<> DoPend(Context& cx) override {
+    for (uint32_t i = 0; i < kWorkPerRun; ++i) {
+      // xorshift32
+      state_ ^= state_ << 13;
+      state_ ^= state_ >> 17;
+      state_ ^= state_ << 5;
+    }
+    if (++runs_ == kRunsPerTask) {
+      return Ready();
+    }
+    cx.ReEnqueue();
+    return Pending();
+  }
+
+  uint32_t runs_ = 0;
+  uint32_t state_ = 2463534242u;
+};
+
+template <size_t kNumWorkers>
+void MeasureThroughput() {
+  WorkStealingDispatcher<kNumWorkers> dispatcher;
+  std::array<BusyTask, kNumTasks> tasks;
+
+  const SystemClock::time_point start = SystemClock::now();
+
+  pw::thread::test::TestThreadContext context;
+  dispatcher.Start(context.options());
+  for (BusyTask& task : tasks) {
+    dispatcher.Post(task);
+  }
+  for (BusyTask& task : tasks) {
+    task.Join();
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      SystemClock::now() - start);
+  dispatcher.Stop();
+
+  // Check the work was done to keep it from being optimized out.
+  for (const BusyTask& task : tasks) {
+    EXPECT_EQ(task.result(), tasks.front().result());
+  }
+
+  const uint64_t runs = uint64_t{kNumTasks} * kRunsPerTask;
+  const uint64_t micros = elapsed.count() > 0 ? elapsed.count() : 1;
+  PW_LOG_INFO("%2u workers: %u task runs in %u us (%u runs/s)",
+              static_cast<unsigned>(kNumWorkers),
+              static_cast<unsigned>(runs),
+              static_cast<unsigned>(micros),
+              static_cast<unsigned>(runs * 1'000'000 / micros));
+}
+
+TEST(WorkStealingDispatcherThroughput, ScalesWithWorkers) {
+  MeasureThroughput<1>();
+  MeasureThroughput<2>();
+  MeasureThroughput<4>();
+  MeasureThroughput<8>();
+  MeasureThroughput<16>();
+}
+
+}  // namespace
@@ -0,0 +1,152 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how quickly the proxy delivers SDUs received from the controller to
+// an L2CAP connection-oriented channel. SDUs that do not fit in a single ACL
+// packet are split into fragments, which the proxy must recombine.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bluetooth/hci_common.emb.h"
+#include "pw_bluetooth/l2cap_frames.emb.h"
+#include "pw_bluetooth_proxy/h4_packet.h"
+#include "pw_bluetooth_proxy/l2cap_coc.h"
+#include "pw_bluetooth_proxy/proxy_host.h"
+#include "pw_bluetooth_proxy_private/test_utils.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_span/span.h"
+#include "pw_unit_test/framework.h"
+#include "pw_unit_test/status_macros.h"
+
+namespace pw::bluetooth::proxy {
+namespace {
+
+constexpr uint16_t kHandle = 123;
+constexpr uint16_t kLocalCid = 234;
+constexpr uint16_t kMaxAclDataLength = 251;
+constexpr uint16_t kMaxSduSize = 1000;
+constexpr uint16_t kRxCredits = 100;
+constexpr size_t kSdusPerRun = 2000;
+
+class AclThroughputBenchmark : public ProxyHostTest {
+ protected:
+  // Sends `sdu` from the controller in a single K-frame, split into as few ACL
+  // fragments as the controller's maximum ACL data length allows.
+  void SendSdu(ProxyHost& proxy, span<const uint8_t> sdu) {
+    std::array<uint8_t, kSduLengthFieldSize + kMaxSduSize> kframe_payload;
+    kframe_payload[0] = static_cast<uint8_t>(sdu.size() & 0xFF);
+    kframe_payload[1] = static_cast<uint8_t>(sdu.size() >> 8);
+    std::copy(sdu.begin(), sdu.end(), kframe_payload.begin() + 2);
+
+    span<const uint8_t> remaining =
+        span(kframe_payload).first(kSduLengthFieldSize + sdu.size());
+    const size_t first_size =
+        std::min<size_t>(remaining.size(),
+                         kMaxAclDataLength -
+                             emboss::BasicL2capHeader::IntrinsicSizeInBytes());
+    SendL2capBFrame(proxy,
+                    kHandle,
+                    remaining.first(first_size),
+                    remaining.size(),
+                    kLocalCid);
+    remaining = remaining.subspan(first_size);
+
+    while (!remaining.empty()) {
+      const size_t fragment_size =
+          std::min<size_t>(remaining.size(), kMaxAclDataLength);
+      SendAclContinuingFrag(proxy, kHandle, remaining.first(fragment_size));
+      remaining = remaining.subspan(fragment_size);
+    }
+  }
+};
+
+TEST_F(AclThroughputBenchmark, ReceiveCocSdus) {
+  uint16_t packets_to_controller = 0;
+  ProxyHost proxy(
+      []([[maybe_unused]] H4PacketWithHci&& packet) {},
+      [&packets_to_controller]([[maybe_unused]] H4PacketWithH4&& packet) {
+        ++packets_to_controller;
+      },
+      /*le_acl_credits_to_reserve=*/2,
+      /*br_edr_acl_credits_to_reserve=*/0,
+      GetProxyHostAllocator());
+  StartDispatcherOnCurrentThread(proxy);
+  PW_TEST_ASSERT_OK(
+      SendLeReadBufferResponseFromController(proxy, 2, kMaxAclDataLength));
+  PW_TEST_ASSERT_OK(SendLeConnectionCompleteEvent(
+      proxy, kHandle, emboss::StatusCode::SUCCESS));
+
+  size_t sdus_received = 0;
+  size_t bytes_received = 0;
+  L2capCoc channel = BuildCoc(
+      proxy,
+      CocParameters{.handle = kHandle,
+                    .local_cid = kLocalCid,
+                    .rx_mtu = kMaxSduSize,
+                    .rx_mps = kMaxSduSize,
+                    .rx_credits = kRxCredits,
+                    .receive_fn = [&](multibuf::MultiBuf&& payload) {
+                      ++sdus_received;
+                      bytes_received += payload.size();
+                    }});
+
+  std::array<uint8_t, kMaxSduSize> sdu;
+  for (size_t i = 0; i < sdu.size(); ++i) {
+    sdu[i] = static_cast<uint8_t>(i);
+  }
+
+  constexpr std::array<uint16_t, 4> kSduSizes = {64, 240, 512, kMaxSduSize};
+  for (uint16_t sdu_size : kSduSizes) {
+    sdus_received = 0;
+    bytes_received = 0;
+
+    auto begin = chrono::SystemClock::now();
+    for (size_t i = 0; i < kSdusPerRun; ++i) {
+      SendSdu(proxy, span(sdu).first(sdu_size));
+      if (packets_to_controller > 0) {
+        // The proxy periodically sends credits to the remote device. Complete
+        // those packets so that it does not run out of ACL credits.
+        PW_TEST_ASSERT_OK(SendNumberOfCompletedPackets(
+            proxy, {{kHandle, packets_to_controller}}));
+        packets_to_controller = 0;
+      }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        chrono::SystemClock::now() - begin);
+
+    EXPECT_EQ(sdus_received, kSdusPerRun);
+    EXPECT_EQ(bytes_received, kSdusPerRun * sdu_size);
+
+    const size_t pdu_size = emboss::BasicL2capHeader::IntrinsicSizeInBytes() +
+                            kSduLengthFieldSize + sdu_size;
+    const size_t num_fragments =
+        (pdu_size + kMaxAclDataLength - 1) / kMaxAclDataLength;
+    const auto ns = static_cast<uint64_t>(elapsed.count());
+    PW_LOG_INFO("%4u-byte SDUs in %u ACL fragment(s): %6u ns/SDU, %7u KiB/s",
+                static_cast<unsigned>(sdu_size),
+                static_cast<unsigned>(num_fragments),
+                static_cast<unsigned>(ns / kSdusPerRun),
+                static_cast<unsigned>((bytes_received * 1000000000ull) /
+                                      (ns * 1024)));
+  }
+}
+
+}  // namespace
+}  // namespace pw::bluetooth::proxy
@@ -30,9 +30,7 @@ const float kRxCreditReplenishThreshold = 0.30f;
 
 }  // namespace
 
-RxEngine::HandlePduFromControllerReturnValue
-CreditBasedFlowControlRxEngine::HandlePduFromController(
-    pw::span<uint8_t> frame) {
+void CreditBasedFlowControlRxEngine::ConsumeRxCredit() {
   rx_remaining_credits_--;
 
   uint16_t rx_credits_used = rx_total_credits_ - rx_remaining_credits_;
@@ -54,6 +52,12 @@ CreditBasedFlowControlRxEngine::HandlePduFromController(
       rx_remaining_credits_ += rx_credits_used;
     }
   }
+}
+
+RxEngine::HandlePduFromControllerReturnValue
+CreditBasedFlowControlRxEngine::HandlePduFromController(
+    pw::span<uint8_t> frame) {
+  ConsumeRxCredit();
 
   ConstByteSpan kframe_payload;
   if (rx_sdu_bytes_remaining_ > 0) {
@@ -158,6 +162,41 @@ CreditBasedFlowControlRxEngine::HandlePduFromController(
   return std::monostate();
 }
 
+RxEngine::HandlePduFromControllerReturnValue
+CreditBasedFlowControlRxEngine::HandleRecombinedPduFromController(
+    multibuf::MultiBuf& pdu, pw::span<uint8_t> frame) {
+  if (rx_sdu_bytes_remaining_ > 0) {
+    // Subsequent K-frames are appended to the SDU being assembled.
+    return HandlePduFromController(frame);
+  }
+
+  Result<emboss::FirstKFrameView> first_kframe_view =
+      MakeEmbossView<emboss::FirstKFrameView>(frame);
+  if (!first_kframe_view.ok()) {
+    // Let the copying path report the error.
+    return HandlePduFromController(frame);
+  }
+
+  const uint16_t sdu_length =
+      static_cast<uint16_t>(first_kframe_view->sdu_length().Read());
+  const uint16_t payload_size =
+      static_cast<uint16_t>(first_kframe_view->payload_size().Read());
+  if (sdu_length == 0 || payload_size != sdu_length || sdu_length > rx_mtu_ ||
+      payload_size > rx_mps_) {
+    // Segmented SDUs are assembled in a separate buffer, and invalid frames
+    // are reported by the copying path.
+    return HandlePduFromController(frame);
+  }
+
+  ConsumeRxCredit();
+
+  // The recombined PDU holds the entire SDU, so strip the K-frame header and
+  // give the recombination buffer to the client instead of copying it.
+  pdu.DiscardPrefix(emboss::FirstKFrame::MinSizeInBytes());
+  pdu.Truncate(payload_size);
+  return std::move(pdu);
+}
+
 Status CreditBasedFlowControlRxEngine::AddRxCredits(
     uint16_t additional_rx_credits) {
   // We treat additional bumps from the client as bumping the total allowed
@@ -334,6 +334,65 @@ TEST_F(CreditBasedFlowControlRxEngineTest, Reset) {
       sdu.begin(), sdu.end(), kExpectedSdu.begin(), kExpectedSdu.end()));
 }
 
+TEST_F(CreditBasedFlowControlRxEngineTest, RecombinedCompleteSduIsNotCopied) {
+  const std::array<uint8_t, 9> kPdu = {// L2cap K-Frame:
+                                       0x05,
+                                       0x00,  // PDU length
+                                       0x60,
+                                       0x00,  // Local Channel ID
+                                       0x03,
+                                       0x00,  // SDU length
+                                              // Payload:
+                                       0x07,
+                                       0x08,
+                                       0x09};
+  std::optional<multibuf::MultiBuf> pdu =
+      multibuf_allocator().AllocateContiguous(kPdu.size());
+  ASSERT_TRUE(pdu.has_value());
+  pw::span<uint8_t> frame = span_cast<uint8_t>(*pdu->ContiguousSpan());
+  std::copy(kPdu.begin(), kPdu.end(), frame.begin());
+
+  RxEngine::HandlePduFromControllerReturnValue result =
+      engine().HandleRecombinedPduFromController(*pdu, frame);
+  ASSERT_TRUE(std::holds_alternative<multibuf::MultiBuf>(result));
+  EXPECT_TRUE(pdu->empty());
+
+  // The SDU refers to the payload within the recombined PDU's buffer.
+  auto contiguous = std::get<multibuf::MultiBuf>(result).ContiguousSpan();
+  ASSERT_TRUE(contiguous.has_value());
+  pw::span<uint8_t> sdu = span_cast<uint8_t>(*contiguous);
+  EXPECT_EQ(sdu.data(), frame.data() + 6);
+  ASSERT_EQ(sdu.size(), 3u);
+  EXPECT_EQ(sdu[0], 0x07);
+  EXPECT_EQ(sdu[2], 0x09);
+}
+
+TEST_F(CreditBasedFlowControlRxEngineTest, RecombinedSegmentedSduIsCopied) {
+  const std::array<uint8_t, 9> kPdu = {// L2cap K-Frame:
+                                       0x05,
+                                       0x00,  // PDU length
+                                       0x60,
+                                       0x00,  // Local Channel ID
+                                       0x07,
+                                       0x00,  // SDU length
+                                              // Payload:
+                                       0x00,
+                                       0x01,
+                                       0x02};
+  std::optional<multibuf::MultiBuf> pdu =
+      multibuf_allocator().AllocateContiguous(kPdu.size());
+  ASSERT_TRUE(pdu.has_value());
+  pw::span<uint8_t> frame = span_cast<uint8_t>(*pdu->ContiguousSpan());
+  std::copy(kPdu.begin(), kPdu.end(), frame.begin());
+
+  // The SDU continues in later K-frames, so the payload is copied into a
+  // separate SDU buffer and the PDU is left alone.
+  RxEngine::HandlePduFromControllerReturnValue result =
+      engine().HandleRecombinedPduFromController(*pdu, frame);
+  EXPECT_TRUE(std::holds_alternative<std::monostate>(result));
+  EXPECT_EQ(pdu->size(), kPdu.size());
+}
+
 }  // namespace
 
 }  // namespace pw::bluetooth::proxy::internal
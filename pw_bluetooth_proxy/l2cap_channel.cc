@@ -139,7 +139,8 @@ StatusWithMultiBuf L2capChannel::Write(multibuf::MultiBuf&& payload) {
   return result;
 }
 
-bool L2capChannel::HandlePduFromController(pw::span<uint8_t> l2cap_pdu) {
+bool L2capChannel::HandlePduFromController(
+    pw::span<uint8_t> l2cap_pdu, multibuf::MultiBuf* recombined_pdu) {
   if (state() != State::kRunning) {
     PW_LOG_ERROR(
         "btproxy: L2capChannel::OnPduReceivedFromController on non-running "
@@ -154,7 +155,10 @@ bool L2capChannel::HandlePduFromController(pw::span<uint8_t> l2cap_pdu) {
   internal::RxEngine::HandlePduFromControllerReturnValue result;
   {
     std::lock_guard rx_lock(rx_mutex_);
-    result = rx_engine().HandlePduFromController(l2cap_pdu);
+    result = recombined_pdu != nullptr
+                 ? rx_engine().HandleRecombinedPduFromController(
+                       *recombined_pdu, l2cap_pdu)
+                 : rx_engine().HandlePduFromController(l2cap_pdu);
   }
 
   return std::visit(
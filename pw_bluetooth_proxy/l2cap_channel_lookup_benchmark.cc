@@ -0,0 +1,243 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how quickly the proxy routes ACL packets for L2CAP channels on
+// several links while packets flow in both directions at once. One thread
+// passes K-frames from the controller, which are routed by local CID, while
+// another passes B-frames from the host, which are routed by remote CID.
+//
+// Each run is repeated with two sets of CIDs to compare routing with and
+// without the channel lookup caches in L2capChannelManager. The caches are
+// direct-mapped. In the first set, each channel's CIDs use their own cache
+// entries, so lookups hit once the caches are warm. In the second set, every
+// CID uses the same entry and packets alternate between channels, so every
+// lookup misses and searches the channel maps, as it would without the caches.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pw_bluetooth/emboss_util.h"
+#include "pw_bluetooth/hci_common.emb.h"
+#include "pw_bluetooth/hci_data.emb.h"
+#include "pw_bluetooth/l2cap_frames.emb.h"
+#include "pw_bluetooth_proxy/h4_packet.h"
+#include "pw_bluetooth_proxy/internal/l2cap_channel_manager.h"
+#include "pw_bluetooth_proxy/l2cap_coc.h"
+#include "pw_bluetooth_proxy/proxy_host.h"
+#include "pw_bluetooth_proxy_private/test_utils.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_span/span.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/yield.h"
+#include "pw_unit_test/framework.h"
+#include "pw_unit_test/status_macros.h"
+
+namespace pw::bluetooth::proxy {
+namespace {
+
+constexpr uint16_t kBaseHandle = 0x10;
+constexpr size_t kLinks = 4;
+constexpr size_t kChannelsPerLink = 2;
+constexpr size_t kChannels = kLinks * kChannelsPerLink;
+constexpr uint16_t kFirstCid = 0x40;
+constexpr uint16_t kPayloadSize = 16;
+constexpr uint16_t kRxCredits = 100;
+constexpr size_t kPacketsPerDirection = 20000;
+
+static_assert(kChannels <= L2capChannelManager::kChannelCacheSize,
+              "Each channel must be able to have its own cache entries");
+
+constexpr uint16_t HandleForLink(size_t link) {
+  return static_cast<uint16_t>(kBaseHandle + link);
+}
+
+struct ChannelIds {
+  uint16_t handle;
+  uint16_t local_cid;
+  uint16_t remote_cid;
+};
+
+// Returns the connection handles and CIDs of kChannels channels. If
+// `share_cache_entry` is true, all of the CIDs use the same cache entry.
+// Otherwise, each channel's local and remote CIDs use their own entries.
+std::array<ChannelIds, kChannels> ChooseChannelIds(bool share_cache_entry) {
+  std::array<bool, L2capChannelManager::kChannelCacheSize> local_entries{};
+  std::array<bool, L2capChannelManager::kChannelCacheSize> remote_entries{};
+  uint16_t next_cid = kFirstCid;
+
+  const auto choose_cid = [&next_cid, share_cache_entry](
+                              uint16_t handle, auto& entries_used) {
+    while (true) {
+      const uint16_t cid = next_cid++;
+      const size_t entry = L2capChannelManager::ChannelCacheIndex(handle, cid);
+      if (share_cache_entry ? entry == 0 : !entries_used[entry]) {
+        entries_used[entry] = true;
+        return cid;
+      }
+    }
+  };
+
+  std::array<ChannelIds, kChannels> ids;
+  for (size_t i = 0; i < kChannels; ++i) {
+    const uint16_t handle = HandleForLink(i / kChannelsPerLink);
+    ids[i].handle = handle;
+    ids[i].local_cid = choose_cid(handle, local_entries);
+    ids[i].remote_cid = choose_cid(handle, remote_entries);
+  }
+  return ids;
+}
+
+class L2capChannelLookupBenchmark : public ProxyHostTest {
+ protected:
+  // Routes kPacketsPerDirection packets in each direction across the channels
+  // in `ids`, and logs the time taken.
+  void MeasureRouting(const char* name,
+                      const std::array<ChannelIds, kChannels>& ids) {
+    // Packets the proxy sends to the controller, by link. They are completed
+    // by the thread passing packets from the controller.
+    std::array<std::atomic<uint16_t>, kLinks> packets_to_controller{};
+    ProxyHost proxy(
+        []([[maybe_unused]] H4PacketWithHci&& packet) {},
+        [links = &packets_to_controller](H4PacketWithH4&& packet) {
+          Result<emboss::AclDataFrameHeaderView> acl =
+              MakeEmbossView<emboss::AclDataFrameHeaderView>(
+                  packet.GetHciSpan());
+          if (acl.ok()) {
+            const auto link =
+                static_cast<size_t>(acl->handle().Read() - kBaseHandle);
+            (*links)[link].fetch_add(1);
+          }
+        },
+        /*le_acl_credits_to_reserve=*/2,
+        /*br_edr_acl_credits_to_reserve=*/0,
+        GetProxyHostAllocator());
+    StartDispatcherOnCurrentThread(proxy);
+    PW_TEST_ASSERT_OK(SendLeReadBufferResponseFromController(proxy, 10));
+    for (size_t link = 0; link < kLinks; ++link) {
+      PW_TEST_ASSERT_OK(SendLeConnectionCompleteEvent(
+          proxy, HandleForLink(link), emboss::StatusCode::SUCCESS));
+    }
+
+    std::array<uint8_t, kPayloadSize> payload{};
+    std::array<size_t, kChannels> received{};
+    std::vector<L2capCoc> channels;
+    std::vector<KFrameWithStorage> from_controller;
+    std::vector<BFrameWithStorage> from_host;
+    channels.reserve(kChannels);
+    for (size_t i = 0; i < kChannels; ++i) {
+      channels.push_back(BuildCoc(
+          proxy,
+          CocParameters{.handle = ids[i].handle,
+                        .local_cid = ids[i].local_cid,
+                        .remote_cid = ids[i].remote_cid,
+                        .rx_credits = kRxCredits,
+                        .receive_fn =
+                            [count = &received[i]](multibuf::MultiBuf&&) {
+                              ++*count;
+                            }}));
+
+      PW_TEST_ASSERT_OK_AND_ASSIGN(KFrameWithStorage kframe,
+                                   SetupKFrame(ids[i].handle,
+                                               ids[i].local_cid,
+                                               /*mps=*/kPayloadSize +
+                                                   kSduLengthFieldSize,
+                                               /*segment_no=*/0,
+                                               payload));
+      from_controller.push_back(std::move(kframe));
+      PW_TEST_ASSERT_OK_AND_ASSIGN(
+          BFrameWithStorage bframe,
+          SetupBFrame(ids[i].handle, ids[i].remote_cid, kPayloadSize));
+      from_host.push_back(std::move(bframe));
+    }
+
+    std::atomic<bool> start = false;
+    thread::test::TestThreadContext controller_context;
+    Thread controller_thread(controller_context.options(), [&]() {
+      while (!start.load()) {
+        this_thread::yield();
+      }
+      std::vector<uint8_t> buffer;
+      for (size_t i = 0; i < kPacketsPerDirection; ++i) {
+        // The packet may be modified, so send a copy.
+        const std::vector<uint8_t>& storage =
+            from_controller[i % kChannels].acl.storage;
+        buffer.assign(storage.begin(), storage.end());
+        proxy.HandleH4HciFromController(H4PacketWithHci(
+            emboss::H4PacketType::ACL_DATA,
+            span(buffer).subspan(AclFrameWithStorage::kH4HeaderSize)));
+
+        if (i % kChannels == kChannels - 1) {
+          // Complete the packets sent to the controller, so that the proxy does
+          // not run out of ACL credits for returning credits to the remote
+          // device.
+          for (size_t link = 0; link < kLinks; ++link) {
+            const uint16_t completed = packets_to_controller[link].exchange(0);
+            if (completed > 0) {
+              PW_TEST_ASSERT_OK(SendNumberOfCompletedPackets(
+                  proxy, {{HandleForLink(link), completed}}));
+            }
+          }
+        }
+      }
+    });
+
+    thread::test::TestThreadContext host_context;
+    Thread host_thread(host_context.options(), [&]() {
+      while (!start.load()) {
+        this_thread::yield();
+      }
+      std::vector<uint8_t> buffer;
+      for (size_t i = 0; i < kPacketsPerDirection; ++i) {
+        const std::vector<uint8_t>& storage =
+            from_host[i % kChannels].acl.storage;
+        buffer.assign(storage.begin(), storage.end());
+        proxy.HandleH4HciFromHost(H4PacketWithH4(span(buffer)));
+      }
+    });
+
+    const auto begin = chrono::SystemClock::now();
+    start.store(true);
+    controller_thread.join();
+    host_thread.join();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        chrono::SystemClock::now() - begin);
+
+    for (size_t count : received) {
+      EXPECT_EQ(count, kPacketsPerDirection / kChannels);
+    }
+
+    const auto ns = static_cast<uint64_t>(elapsed.count());
+    PW_LOG_INFO("%s: %u packets on %u channels in %u us, %u ns/packet",
+                name,
+                static_cast<unsigned>(2 * kPacketsPerDirection),
+                static_cast<unsigned>(kChannels),
+                static_cast<unsigned>(ns / 1000),
+                static_cast<unsigned>(ns / (2 * kPacketsPerDirection)));
+  }
+};
+
+TEST_F(L2capChannelLookupBenchmark, RoutePacketsOnMultipleLinks) {
+  MeasureRouting("Cache hits", ChooseChannelIds(/*share_cache_entry=*/false));
+  MeasureRouting("Cache misses", ChooseChannelIds(/*share_cache_entry=*/true));
+}
+
+}  // namespace
+}  // namespace pw::bluetooth::proxy
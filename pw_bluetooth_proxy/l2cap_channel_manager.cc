@@ -302,6 +302,7 @@ L2capChannelManager::DeregisterChannelLocked(L2capChannel& channel) {
   uint32_t remote_key =
       L2capChannel::MakeKey(channel.connection_handle(), channel.remote_cid());
 
+  EvictFromChannelCachesLocked(channel);
   auto node = channels_by_local_cid_.take(local_key);
   channels_by_remote_cid_.erase(remote_key);
 
@@ -315,6 +316,8 @@ void L2capChannelManager::DeregisterAndCloseChannels(L2capChannelEvent event) {
   ResetLogicalLinksLocked();
   {
     std::lock_guard channels_lock(channels_mutex());
+    local_cid_cache_.fill(nullptr);
+    remote_cid_cache_.fill(nullptr);
     channels_by_remote_cid_.clear();
     for (auto iter = channels_by_local_cid_.begin();
          iter != channels_by_local_cid_.end();) {
@@ -399,22 +402,49 @@ std::optional<LockedL2capChannel> L2capChannelManager::FindChannelByRemoteCid(
 L2capChannel* L2capChannelManager::FindChannelByLocalCidLocked(
     uint16_t connection_handle, uint16_t local_cid) PW_NO_LOCK_SAFETY_ANALYSIS {
   uint32_t key = L2capChannel::MakeKey(connection_handle, local_cid);
-  auto it = channels_by_local_cid_.find(key);
-  if (it == channels_by_local_cid_.end() || it->second.IsStale()) {
-    return nullptr;
+  L2capChannel*& cached =
+      local_cid_cache_[ChannelCacheIndex(connection_handle, local_cid)];
+  if (cached == nullptr || cached->connection_handle() != connection_handle ||
+      cached->local_cid() != local_cid) {
+    auto it = channels_by_local_cid_.find(key);
+    if (it == channels_by_local_cid_.end()) {
+      return nullptr;
+    }
+    cached = &it->second;
   }
-  return &it->second;
+  return cached->IsStale() ? nullptr : cached;
 }
 
 L2capChannel* L2capChannelManager::FindChannelByRemoteCidLocked(
     uint16_t connection_handle,
     uint16_t remote_cid) PW_NO_LOCK_SAFETY_ANALYSIS {
   uint32_t key = L2capChannel::MakeKey(connection_handle, remote_cid);
-  auto it = channels_by_remote_cid_.find(key);
-  if (it == channels_by_remote_cid_.end() || it->second->IsStale()) {
-    return nullptr;
+  L2capChannel*& cached =
+      remote_cid_cache_[ChannelCacheIndex(connection_handle, remote_cid)];
+  if (cached == nullptr || cached->connection_handle() != connection_handle ||
+      cached->remote_cid() != remote_cid) {
+    auto it = channels_by_remote_cid_.find(key);
+    if (it == channels_by_remote_cid_.end()) {
+      return nullptr;
+    }
+    cached = it->second;
+  }
+  return cached->IsStale() ? nullptr : cached;
+}
+
+void L2capChannelManager::EvictFromChannelCachesLocked(
+    const L2capChannel& channel) {
+  const uint16_t handle = channel.connection_handle();
+  L2capChannel*& local =
+      local_cid_cache_[ChannelCacheIndex(handle, channel.local_cid())];
+  if (local == &channel) {
+    local = nullptr;
+  }
+  L2capChannel*& remote =
+      remote_cid_cache_[ChannelCacheIndex(handle, channel.remote_cid())];
+  if (remote == &channel) {
+    remote = nullptr;
   }
-  return it->second;
 }
 
 void L2capChannelManager::Advance(L2capChannelIterator& it) {
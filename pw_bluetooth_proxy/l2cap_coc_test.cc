@@ -12,8 +12,10 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <array>
 #include <cstdint>
 #include <mutex>
+#include <optional>
 
 #include "pw_allocator/libc_allocator.h"
 #include "pw_allocator/testing.h"
@@ -867,6 +869,141 @@ TEST_F(L2capCocWriteTest, MultithreadedWrite) {
     }
   }
 }
+
+// Have threads write to L2capCoc channels on several ACL connections at once.
+// Channels on different connections share CIDs, so lookups must distinguish
+// them by connection handle. Verify all resulting ACL packets are sent towards
+// controller in the correct order per channel.
+TEST_F(L2capCocWriteTest, MultithreadedWriteOnMultipleLinks) {
+  constexpr unsigned int kNumLinks = 4;
+  constexpr unsigned int kChannelsPerLink = 4;
+  constexpr unsigned int kNumThreads = kNumLinks * kChannelsPerLink;
+  constexpr unsigned int kPacketsPerThread = L2capChannel::QueueCapacity() - 1;
+  constexpr uint16_t kBaseHandle = 0x10;
+  constexpr uint16_t kBaseLocalCid = 0xb000;
+  constexpr uint16_t kBaseRemoteCid = 0xc000;
+  constexpr uint16_t kPayloadSize = 10;
+
+  struct {
+    sync::Mutex sends_by_channel_mutex;
+    std::array<unsigned int, kNumThreads> sends_by_channel
+        PW_GUARDED_BY(sends_by_channel_mutex){};
+  } capture;
+
+  pw::Function<void(H4PacketWithHci && packet)> send_to_host_fn(
+      []([[maybe_unused]] H4PacketWithHci&& packet) {});
+  pw::Function<void(H4PacketWithH4 && packet)> send_to_controller_fn(
+      [&capture](H4PacketWithH4&& packet) {
+        PW_TEST_ASSERT_OK_AND_ASSIGN(
+            auto acl,
+            MakeEmbossView<emboss::AclDataFrameView>(packet.GetHciSpan()));
+        PW_TEST_ASSERT_OK_AND_ASSIGN(
+            emboss::FirstKFrameView kframe,
+            MakeEmbossView<emboss::FirstKFrameView>(
+                acl.payload().BackingStorage().data(), acl.SizeInBytes()));
+        EXPECT_EQ(kframe.sdu_length().Read(), uint16_t{kPayloadSize});
+
+        // Each thread writes to a distinct (link, remote cid) pair.
+        auto link = static_cast<unsigned int>(acl.header().handle().Read() -
+                                              kBaseHandle);
+        auto channel = static_cast<unsigned int>(kframe.channel_id().Read() -
+                                                 kBaseRemoteCid);
+        ASSERT_TRUE(link < kNumLinks);
+        ASSERT_TRUE(channel < kChannelsPerLink);
+        unsigned int thread_id = link * kChannelsPerLink + channel;
+        {
+          std::lock_guard lock(capture.sends_by_channel_mutex);
+
+          // Each payload byte should match the send count (to verify ordering).
+          for (size_t i = 0; i < kPayloadSize; ++i) {
+            EXPECT_EQ(kframe.payload()[i].Read(),
+                      capture.sends_by_channel[thread_id]);
+          }
+          capture.sends_by_channel[thread_id]++;
+        }
+      });
+
+  allocator::test::AllocatorForTest<65536> allocator;
+  // Use libc allocators so msan can detect use after frees.
+  std::array<std::byte, 200 * 1024> packet_buffer{};
+  pw::multibuf::SimpleAllocator multibuf_allocator{
+      /*data_area=*/packet_buffer,
+      /*metadata_alloc=*/allocator::GetLibCAllocator()};
+
+  ProxyHost proxy =
+      ProxyHost(std::move(send_to_host_fn),
+                std::move(send_to_controller_fn),
+                /*le_acl_credits_to_reserve=*/kNumThreads * kPacketsPerThread,
+                /*br_edr_acl_credits_to_reserve=*/0,
+                &allocator);
+
+  // If using async, start a dispatcher thread.
+  StartDispatcherOnNewThread(proxy);
+
+  PW_TEST_EXPECT_OK(SendLeReadBufferResponseFromController(
+      proxy, kNumThreads * kPacketsPerThread));
+  for (unsigned int link = 0; link < kNumLinks; ++link) {
+    PW_TEST_ASSERT_OK(SendLeConnectionCompleteEvent(
+        proxy, kBaseHandle + link, emboss::StatusCode::SUCCESS));
+  }
+  RunDispatcher();
+
+  struct ThreadCapture {
+    L2capCoc channel;
+    multibuf::MultiBufAllocator& packet_allocator;
+  };
+
+  pw::Vector<ThreadCapture, kNumThreads> captures;
+  pw::thread::test::TestThreadContext context;
+  pw::Vector<pw::Thread, kNumThreads> threads;
+
+  for (unsigned int link = 0; link < kNumLinks; ++link) {
+    for (unsigned int channel = 0; channel < kChannelsPerLink; ++channel) {
+      auto handle = static_cast<uint16_t>(kBaseHandle + link);
+      auto local_cid = static_cast<uint16_t>(kBaseLocalCid + channel);
+      auto remote_cid = static_cast<uint16_t>(kBaseRemoteCid + channel);
+      ThreadCapture thread_capture{
+          BuildCoc(proxy,
+                   CocParameters{.handle = handle,
+                                 .local_cid = local_cid,
+                                 .remote_cid = remote_cid,
+                                 .tx_credits = kPacketsPerThread}),
+          multibuf_allocator,
+      };
+      captures.emplace_back(std::move(thread_capture));
+    }
+  }
+
+  for (ThreadCapture& thread_capture : captures) {
+    threads.emplace_back(context.options(), [&thread_capture]() {
+      for (unsigned int packet_numb = 0; packet_numb < kPacketsPerThread;
+           ++packet_numb) {
+        auto mbuf_result =
+            thread_capture.packet_allocator.AllocateContiguous(kPayloadSize);
+        ASSERT_TRUE(mbuf_result.has_value());
+        multibuf::MultiBuf mbuf = std::move(*mbuf_result);
+        std::fill(
+            mbuf.begin(), mbuf.end(), static_cast<std::byte>(packet_numb));
+        PW_TEST_EXPECT_OK(thread_capture.channel.Write(std::move(mbuf)).status);
+      }
+    });
+  }
+
+  // Ensure the writer threads complete, drop the channels, and ensure the
+  // dispatcher thread completes.
+  for (auto& t : threads) {
+    t.join();
+  }
+  captures.clear();
+  JoinDispatcherThread();
+
+  {
+    std::lock_guard lock(capture.sends_by_channel_mutex);
+    for (unsigned int i = 0; i < kNumThreads; ++i) {
+      EXPECT_EQ(capture.sends_by_channel[i], kPacketsPerThread);
+    }
+  }
+}
 #endif  // PW_THREAD_JOINING_ENABLED
 
 // ########## L2capCocReadTest
@@ -1663,6 +1800,91 @@ TEST_F(L2capCocReadTest, MultipleReadsMultipleChannels) {
   EXPECT_EQ(capture.sends_called, kNumChannels);
 }
 
+TEST_F(L2capCocReadTest, ReadsOnSameCidRoutedByConnectionHandle) {
+  struct {
+    int acl_sent_to_host = 0;
+    std::array<int, 2> reads_by_link{};
+  } capture;
+
+  pw::Function<void(H4PacketWithHci && packet)>&& send_to_host_fn(
+      [&capture](H4PacketWithHci&& packet) {
+        if (packet.GetH4Type() == emboss::H4PacketType::ACL_DATA) {
+          ++capture.acl_sent_to_host;
+        }
+      });
+  pw::Function<void(H4PacketWithH4 && packet)>&& send_to_controller_fn(
+      []([[maybe_unused]] H4PacketWithH4&& packet) {});
+  auto* allocator = GetProxyHostAllocator();
+  ProxyHost proxy = ProxyHost(std::move(send_to_host_fn),
+                              std::move(send_to_controller_fn),
+                              /*le_acl_credits_to_reserve=*/0,
+                              /*br_edr_acl_credits_to_reserve=*/0,
+                              allocator);
+  StartDispatcherOnCurrentThread(proxy);
+
+  constexpr std::array<uint16_t, 2> kHandles = {kConnectionHandle,
+                                                kConnectionHandle + 1};
+  constexpr uint16_t kLocalCid = 234;
+  for (uint16_t handle : kHandles) {
+    PW_TEST_ASSERT_OK(SendLeConnectionCompleteEvent(
+        proxy, handle, emboss::StatusCode::SUCCESS));
+  }
+
+  auto build_channel = [&](size_t link) {
+    return BuildCoc(
+        proxy,
+        CocParameters{.handle = kHandles[link],
+                      .local_cid = kLocalCid,
+                      .rx_credits = 10,
+                      .receive_fn = [&capture, link](multibuf::MultiBuf&&) {
+                        ++capture.reads_by_link[link];
+                      }});
+  };
+  L2capCoc channel0 = build_channel(0);
+  std::optional<L2capCoc> channel1 = build_channel(1);
+
+  auto send_to_link = [&proxy, &kHandles](size_t link) {
+    std::array<uint8_t, kFirstKFrameOverAclMinSize + 1> hci_arr{};
+    Result<emboss::AclDataFrameWriter> acl =
+        MakeEmbossWriter<emboss::AclDataFrameWriter>(hci_arr);
+    acl->header().handle().Write(kHandles[link]);
+    acl->data_total_length().Write(emboss::FirstKFrame::MinSizeInBytes() + 1);
+
+    emboss::FirstKFrameWriter kframe =
+        emboss::MakeFirstKFrameView(acl->payload().BackingStorage().data(),
+                                    acl->data_total_length().Read());
+    kframe.pdu_length().Write(kSduLengthFieldSize + 1);
+    kframe.channel_id().Write(kLocalCid);
+    kframe.sdu_length().Write(1);
+
+    H4PacketWithHci h4_packet{emboss::H4PacketType::ACL_DATA, hci_arr};
+    proxy.HandleH4HciFromController(std::move(h4_packet));
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    send_to_link(0);
+    send_to_link(1);
+  }
+  EXPECT_EQ(capture.reads_by_link[0], 3);
+  EXPECT_EQ(capture.reads_by_link[1], 3);
+
+  // Once the channel on the second link is gone, its packets are passed on to
+  // the host, while the first link is unaffected.
+  channel1.reset();
+  RunDispatcher();
+  send_to_link(1);
+  send_to_link(0);
+  EXPECT_EQ(capture.acl_sent_to_host, 1);
+  EXPECT_EQ(capture.reads_by_link[0], 4);
+  EXPECT_EQ(capture.reads_by_link[1], 3);
+
+  // A new channel with the same CID on the second link receives its packets.
+  channel1 = build_channel(1);
+  send_to_link(1);
+  EXPECT_EQ(capture.acl_sent_to_host, 1);
+  EXPECT_EQ(capture.reads_by_link[1], 4);
+}
+
 TEST_F(L2capCocReadTest, ChannelStoppageDoNotAffectOtherChannels) {
   pw::Function<void(H4PacketWithHci && packet)>&& send_to_host_fn(
       []([[maybe_unused]] H4PacketWithHci&& packet) {});
@@ -418,9 +418,14 @@ L2capLogicalLink::HandleAclData(Direction direction,
 #endif
   channel.reset();
 
+  // A recombined PDU from the controller may be taken by the channel, in which
+  // case the PDU is handled and `recombined_mbuf` is not used again.
   const bool handled =
       (direction == Direction::kFromController)
-          ? temp_channel->HandlePduFromController(send_l2cap_pdu)
+          ? temp_channel->HandlePduFromController(
+                send_l2cap_pdu,
+                recombined_mbuf.has_value() ? &recombined_mbuf.value()
+                                            : nullptr)
           : temp_channel->HandlePduFromHost(send_l2cap_pdu);
 
   if (!handled && recombined_mbuf.has_value()) {
@@ -46,11 +46,19 @@ class CreditBasedFlowControlRxEngine final : public RxEngine {
   HandlePduFromControllerReturnValue HandlePduFromController(
       pw::span<uint8_t> frame) override;
 
+  // If `pdu` holds an entire SDU, it is passed to the client without copying.
+  HandlePduFromControllerReturnValue HandleRecombinedPduFromController(
+      multibuf::MultiBuf& pdu, pw::span<uint8_t> frame) override;
+
   Status AddRxCredits(uint16_t additional_rx_credits) override;
 
   void Reset() override;
 
  private:
+  // Accounts for a received PDU, and replenishes the remote's credits once
+  // enough have been used.
+  void ConsumeRxCredit();
+
   uint16_t local_cid_;
   uint16_t rx_mtu_;
   uint16_t rx_mps_;
@@ -224,7 +224,14 @@ class L2capChannel final : public internal::TxEngine::Delegate {
   // `kRunning`, returns `HandlePduFromController(l2cap_pdu)`. If channel is not
   // `State::kRunning`, sends `kRxWhileStopped` event to client and drops PDU.
   // This function will call DoHandlePduFromController on its subclass.
-  [[nodiscard]] bool HandlePduFromController(pw::span<uint8_t> l2cap_pdu);
+  //
+  // If the PDU was recombined from multiple ACL fragments, `recombined_pdu`
+  // should hold it, with `l2cap_pdu` referring to its contents. The channel
+  // may then take the buffer instead of copying the PDU, in which case
+  // `recombined_pdu` is moved from.
+  [[nodiscard]] bool HandlePduFromController(
+      pw::span<uint8_t> l2cap_pdu,
+      multibuf::MultiBuf* recombined_pdu = nullptr);
 
   //--------------
   //  Accessors:
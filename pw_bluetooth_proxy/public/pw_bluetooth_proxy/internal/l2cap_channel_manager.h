@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <optional>
 
 #include "pw_allocator/allocator.h"
@@ -206,6 +208,18 @@ class L2capChannelManager final : public L2capChannelManagerInterface {
   // event was received.
   Result<uint16_t> MaxL2capPayloadSize(AclTransportType transport) const;
 
+  // Number of entries in each channel lookup cache. Must be a power of two.
+  static constexpr size_t kChannelCacheSize = 8;
+  static_assert((kChannelCacheSize & (kChannelCacheSize - 1)) == 0);
+
+  // Returns the channel lookup cache entry to use for a channel's CID.
+  static constexpr size_t ChannelCacheIndex(uint16_t connection_handle,
+                                            uint16_t cid) {
+    // Mix the connection handle into the CID, since both tend to be small.
+    return static_cast<size_t>(connection_handle ^ cid) &
+           (kChannelCacheSize - 1);
+  }
+
   constexpr internal::L2capChannelManagerImpl& impl() { return impl_; }
   constexpr const internal::L2capChannelManagerImpl& impl() const {
     return impl_;
@@ -224,6 +238,10 @@ class L2capChannelManager final : public L2capChannelManagerInterface {
     return internal::L2capChannelManagerImpl::channels_mutex();
   }
 
+  // Clears the channel lookup cache entries that refer to `channel`.
+  void EvictFromChannelCachesLocked(const L2capChannel& channel)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(channels_mutex());
+
   // Circularly advance `it`, wrapping around to front if `it` reaches the
   // end.
   void Advance(L2capChannelIterator& it)
@@ -300,6 +318,16 @@ class L2capChannelManager final : public L2capChannelManagerInterface {
   // Secondary L2CAP channel lookup mapped by remote CID (non-owning).
   L2capChannelRefMap channels_by_remote_cid_ PW_GUARDED_BY(channels_mutex());
 
+  // Channels recently found by local CID and by remote CID, indexed by
+  // `ChannelCacheIndex` of their connection handles and CIDs. Lookups for the
+  // channels carrying the most traffic usually hit these caches, and skip
+  // searching the maps above. Entries are cleared when their channels are
+  // deregistered.
+  std::array<L2capChannel*, kChannelCacheSize> local_cid_cache_
+      PW_GUARDED_BY(channels_mutex()){};
+  std::array<L2capChannel*, kChannelCacheSize> remote_cid_cache_
+      PW_GUARDED_BY(channels_mutex()){};
+
   // Stale L2CAP channels awaiting deletion.
   L2capChannelMap stale_ PW_GUARDED_BY(channels_mutex());
 
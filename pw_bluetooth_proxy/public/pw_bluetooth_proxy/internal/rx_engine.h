@@ -43,6 +43,18 @@ class RxEngine {
   virtual HandlePduFromControllerReturnValue HandlePduFromController(
       pw::span<uint8_t> frame) = 0;
 
+  /// Process a PDU received from the controller that was recombined from
+  /// multiple ACL fragments into `pdu`. `frame` is the contiguous contents of
+  /// `pdu`.
+  ///
+  /// Engines that send MultiBufs to the client may move `pdu` into the return
+  /// value instead of copying `frame`. By default, `frame` is processed as
+  /// with `HandlePduFromController` and `pdu` is left untouched.
+  virtual HandlePduFromControllerReturnValue HandleRecombinedPduFromController(
+      [[maybe_unused]] multibuf::MultiBuf& pdu, pw::span<uint8_t> frame) {
+    return HandlePduFromController(frame);
+  }
+
   virtual Status AddRxCredits(uint16_t additional_rx_credits) = 0;
 
   virtual void Reset() {}
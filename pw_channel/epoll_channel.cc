@@ -0,0 +1,229 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/epoll_channel.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "pw_async2/waker.h"
+#include "pw_log/log.h"
+#include "pw_status/try.h"
+
+namespace pw::channel {
+
+using pw::OkStatus;
+using pw::Status;
+using pw::async2::Context;
+using pw::async2::Pending;
+using pw::async2::Poll;
+using pw::async2::PollOptional;
+using pw::async2::PollResult;
+using pw::multibuf::MultiBuf;
+using pw::multibuf::MultiBufAllocator;
+
+namespace {
+
+// Read buffer sizes match those used by `StreamChannel`.
+constexpr size_t kMinimumReadSize = 64;
+constexpr size_t kDesiredReadSize = 1024;
+
+// Maximum number of chunks passed to a single `readv` or `sendmsg` call. Larger
+// buffers are transferred using multiple calls.
+constexpr size_t kMaxIovecs = 16;
+
+using Iovecs = std::array<iovec, kMaxIovecs>;
+
+// Fills `iov` with the non-empty chunks at the front of `buf` and returns the
+// number of entries used.
+size_t FillIovecs(MultiBuf& buf, Iovecs& iov) {
+  size_t count = 0;
+  for (auto& chunk : buf.Chunks()) {
+    if (count == iov.size()) {
+      break;
+    }
+    if (chunk.empty()) {
+      continue;
+    }
+    iov[count].iov_base = chunk.data();
+    iov[count].iov_len = chunk.size();
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+EpollChannel::EpollChannel(int fd,
+                           async2::EpollDispatcher& dispatcher,
+                           MultiBufAllocator& read_allocator,
+                           MultiBufAllocator& write_allocator)
+    : fd_(fd),
+      dispatcher_(dispatcher),
+      read_alloc_future_(read_allocator),
+      write_alloc_future_(write_allocator) {
+  struct stat stat_buf;
+  is_socket_ = fstat(fd_, &stat_buf) == 0 && S_ISSOCK(stat_buf.st_mode);
+
+  int flags = fcntl(fd_, F_GETFL, 0);
+  if (flags == -1 || fcntl(fd_, F_SETFL, flags | O_NONBLOCK) == -1) {
+    PW_LOG_ERROR("Failed to make fd %d non-blocking: %s",
+                 fd_,
+                 std::strerror(errno));
+    set_read_closed();
+    set_write_closed();
+    return;
+  }
+
+  Status status = dispatcher_.NativeRegisterFileDescriptor(
+      fd_, async2::EpollDispatcher::FileDescriptorType::kReadWrite);
+  if (!status.ok()) {
+    PW_LOG_ERROR("Failed to register fd %d with the dispatcher: %s",
+                 fd_,
+                 status.str());
+    set_read_closed();
+    set_write_closed();
+  }
+}
+
+void EpollChannel::Cleanup() {
+  if (fd_ < 0) {
+    return;
+  }
+  dispatcher_.NativeUnregisterFileDescriptor(fd_).IgnoreError();
+  close(fd_);
+  fd_ = -1;
+  read_buffer_.Release();
+  write_buffer_.Release();
+}
+
+PollResult<MultiBuf> EpollChannel::DoPendRead(Context& cx) {
+  if (read_buffer_.empty()) {
+    read_alloc_future_.SetDesiredSizes(kMinimumReadSize,
+                                       kDesiredReadSize,
+                                       multibuf::v1::kAllowDiscontiguous);
+    PollOptional<MultiBuf> maybe_multibuf = read_alloc_future_.Pend(cx);
+    if (maybe_multibuf.IsPending()) {
+      return Pending();
+    }
+    if (!maybe_multibuf->has_value()) {
+      PW_LOG_ERROR("Failed to allocate multibuf for reading");
+      return Status::ResourceExhausted();
+    }
+    read_buffer_ = std::move(**maybe_multibuf);
+  }
+
+  Iovecs iov;
+  int iovcnt = static_cast<int>(FillIovecs(read_buffer_, iov));
+  ssize_t bytes_read;
+  do {
+    bytes_read = readv(fd_, iov.data(), iovcnt);
+  } while (bytes_read < 0 && errno == EINTR);
+
+  if (bytes_read < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      PW_ASYNC_STORE_WAKER(
+          cx,
+          dispatcher_.NativeAddReadWakerForFileDescriptor(fd_),
+          "EpollChannel is waiting for the fd to be readable");
+      return Pending();
+    }
+    PW_LOG_ERROR("Failed to read from fd %d: %s", fd_, std::strerror(errno));
+    return Status::Internal();
+  }
+
+  if (bytes_read == 0) {
+    // The peer has closed its write side; no more data will arrive.
+    read_buffer_.Release();
+    return Status::OutOfRange();
+  }
+
+  MultiBuf filled = std::move(read_buffer_);
+  filled.Truncate(static_cast<size_t>(bytes_read));
+  return filled;
+}
+
+Poll<Status> EpollChannel::DoPendReadyToWrite(Context& cx) {
+  if (write_buffer_.empty()) {
+    return OkStatus();
+  }
+  // Flush previously staged data before accepting more.
+  return DoPendWrite(cx);
+}
+
+Status EpollChannel::DoStageWrite(MultiBuf&& data) {
+  PW_TRY(write_status_);
+  // Data is only queued here. It is sent by `DoPendWrite`, which allows
+  // several staged writes to be sent with a single system call.
+  write_buffer_.PushSuffix(std::move(data));
+  return OkStatus();
+}
+
+Poll<Status> EpollChannel::DoPendWrite(Context& cx) {
+  while (write_status_.ok() && !write_buffer_.empty()) {
+    Iovecs iov;
+    size_t iovcnt = FillIovecs(write_buffer_, iov);
+    ssize_t bytes_sent;
+    do {
+      if (is_socket_) {
+        msghdr message{};
+        message.msg_iov = iov.data();
+        message.msg_iovlen = iovcnt;
+        bytes_sent = sendmsg(fd_, &message, MSG_NOSIGNAL);
+      } else {
+        bytes_sent = writev(fd_, iov.data(), static_cast<int>(iovcnt));
+      }
+    } while (bytes_sent < 0 && errno == EINTR);
+
+    if (bytes_sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        PW_ASYNC_STORE_WAKER(
+            cx,
+            dispatcher_.NativeAddWriteWakerForFileDescriptor(fd_),
+            "EpollChannel is waiting for the fd to be writable");
+        return Pending();
+      }
+      if (errno == EPIPE || errno == ECONNRESET) {
+        // The peer is gone, so no further writes can succeed.
+        write_status_ = Status::FailedPrecondition();
+      } else {
+        PW_LOG_ERROR("Failed to write to fd %d: %s", fd_, std::strerror(errno));
+        write_status_ = Status::Internal();
+      }
+      break;
+    }
+    write_buffer_.DiscardPrefix(static_cast<size_t>(bytes_sent));
+  }
+  // Drop any empty chunks left behind.
+  write_buffer_.Release();
+  return write_status_;
+}
+
+Poll<Status> EpollChannel::DoPendClose(Context& cx) {
+  Poll<Status> flushed = DoPendWrite(cx);
+  if (flushed.IsPending()) {
+    return Pending();
+  }
+  Cleanup();
+  return flushed->ok() ? OkStatus() : Status::DataLoss();
+}
+
+}  // namespace pw::channel
@@ -0,0 +1,311 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_channel/epoll_channel.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "pw_assert/assert.h"
+#include "pw_async2/epoll_dispatcher.h"
+#include "pw_async2/func_task.h"
+#include "pw_bytes/suffix.h"
+#include "pw_multibuf/simple_allocator_for_test.h"
+#include "pw_status/status.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using ::pw::OkStatus;
+using ::pw::Status;
+using ::pw::async2::Context;
+using ::pw::async2::EpollDispatcher;
+using ::pw::async2::FuncTask;
+using ::pw::async2::Pending;
+using ::pw::async2::Poll;
+using ::pw::async2::Ready;
+using ::pw::channel::EpollChannel;
+using ::pw::multibuf::MultiBuf;
+using ::pw::multibuf::test::SimpleAllocatorForTest;
+using ::pw::operator""_b;
+
+/// A connected pair of sockets. The first is handed to the channel under test,
+/// which takes ownership of it; the second is the test's end of the connection.
+class SocketPair {
+ public:
+  SocketPair() { PW_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) == 0); }
+
+  ~SocketPair() {
+    if (fds_[1] >= 0) {
+      close(fds_[1]);
+    }
+  }
+
+  int channel_fd() const { return fds_[0]; }
+  int peer_fd() const { return fds_[1]; }
+
+  void ClosePeer() {
+    close(fds_[1]);
+    fds_[1] = -1;
+  }
+
+ private:
+  int fds_[2];
+};
+
+TEST(EpollChannel, ReadsDataWrittenByPeer) {
+  EpollDispatcher dispatcher;
+  SimpleAllocatorForTest read_alloc;
+  SimpleAllocatorForTest write_alloc;
+  SocketPair sockets;
+  EpollChannel channel(
+      sockets.channel_fd(), dispatcher, read_alloc, write_alloc);
+
+  std::optional<MultiBuf> received;
+  FuncTask read_task([&](Context& cx) -> Poll<> {
+    auto read = channel.PendRead(cx);
+    if (read.IsPending()) {
+      return Pending();
+    }
+    EXPECT_EQ(read->status(), OkStatus());
+    if (read->ok()) {
+      received = std::move(**read);
+    }
+    return Ready();
+  });
+  dispatcher.Post(read_task);
+
+  // Nothing has been written yet.
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+  EXPECT_FALSE(received.has_value());
+
+  constexpr std::array<std::byte, 3> kData = {1_b, 2_b, 3_b};
+  ASSERT_EQ(write(sockets.peer_fd(), kData.data(), kData.size()), 3);
+  dispatcher.RunToCompletion();
+
+  ASSERT_TRUE(received.has_value());
+  ASSERT_EQ(received->size(), kData.size());
+  EXPECT_TRUE(std::equal(received->begin(), received->end(), kData.begin()));
+}
+
+TEST(EpollChannel, ReadReturnsOutOfRangeWhenPeerCloses) {
+  EpollDispatcher dispatcher;
+  SimpleAllocatorForTest read_alloc;
+  SimpleAllocatorForTest write_alloc;
+  SocketPair sockets;
+  EpollChannel channel(
+      sockets.channel_fd(), dispatcher, read_alloc, write_alloc);
+
+  Status status;
+  FuncTask read_task([&](Context& cx) -> Poll<> {
+    auto read = channel.PendRead(cx);
+    if (read.IsPending()) {
+      return Pending();
+    }
+    status = read->status();
+    return Ready();
+  });
+  dispatcher.Post(read_task);
+
+  EXPECT_TRUE(dispatcher.RunUntilStalled());
+  sockets.ClosePeer();
+  dispatcher.RunToCompletion();
+
+  EXPECT_EQ(status, Status::OutOfRange());
+  EXPECT_TRUE(channel.is_read_open());
+}
+
+TEST(EpollChannel, WritesStagedBuffersTogether) {
+  EpollDispatcher dispatcher;
+  SimpleAllocatorForTest read_alloc;
+  SimpleAllocatorForTest write_alloc;
+  SocketPair sockets;
+  EpollChannel channel(
+      sockets.channel_fd(), dispatcher, read_alloc, write_alloc);
+
+  MultiBuf first = write_alloc.BufWith({1_b, 2_b});
+  first.PushSuffix(write_alloc.BufWith({3_b}));
+  MultiBuf second = write_alloc.BufWith({4_b, 5_b, 6_b});
+
+  Status status = Status::Unknown();
+  FuncTask write_task([&](Context& cx) -> Poll<> {
+    if (channel.PendReadyToWrite(cx).IsPending()) {
+      return Pending();
+    }
+    if (!first.empty()) {
+      EXPECT_EQ(channel.StageWrite(std::move(first)), OkStatus());
+      EXPECT_EQ(channel.StageWrite(std::move(second)), OkStatus());
+    }
+    auto result = channel.PendWrite(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    status = *result;
+    return Ready();
+  });
+  dispatcher.Post(write_task);
+  dispatcher.RunToCompletion();
+  EXPECT_EQ(status, OkStatus());
+
+  std::array<std::byte, 8> buffer{};
+  ASSERT_EQ(read(sockets.peer_fd(), buffer.data(), buffer.size()), 6);
+  constexpr std::array<std::byte, 6> kExpected = {
+      1_b, 2_b, 3_b, 4_b, 5_b, 6_b};
+  EXPECT_TRUE(std::equal(kExpected.begin(), kExpected.end(), buffer.begin()));
+}
+
+TEST(EpollChannel, WriteFailsWhenPeerCloses) {
+  EpollDispatcher dispatcher;
+  SimpleAllocatorForTest read_alloc;
+  SimpleAllocatorForTest write_alloc;
+  SocketPair sockets;
+  EpollChannel channel(
+      sockets.channel_fd(), dispatcher, read_alloc, write_alloc);
+  sockets.ClosePeer();
+
+  MultiBuf data = write_alloc.BufWith({1_b, 2_b, 3_b});
+  Status status;
+  FuncTask write_task([&](Context& cx) -> Poll<> {
+    if (!data.empty()) {
+      EXPECT_EQ(channel.StageWrite(std::move(data)), OkStatus());
+    }
+    auto result = channel.PendWrite(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    status = *result;
+    return Ready();
+  });
+  dispatcher.Post(write_task);
+  dispatcher.RunToCompletion();
+
+  EXPECT_EQ(status, Status::FailedPrecondition());
+  EXPECT_FALSE(channel.is_write_open());
+}
+
+TEST(EpollChannel, CloseFlushesAndClosesFd) {
+  EpollDispatcher dispatcher;
+  SimpleAllocatorForTest read_alloc;
+  SimpleAllocatorForTest write_alloc;
+  SocketPair sockets;
+  EpollChannel channel(
+      sockets.channel_fd(), dispatcher, read_alloc, write_alloc);
+
+  MultiBuf data = write_alloc.BufWith({7_b, 8_b});
+  Status status = Status::Unknown();
+  FuncTask close_task([&](Context& cx) -> Poll<> {
+    if (!data.empty()) {
+      EXPECT_EQ(channel.StageWrite(std::move(data)), OkStatus());
+    }
+    auto result = channel.PendClose(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    status = *result;
+    return Ready();
+  });
+  dispatcher.Post(close_task);
+  dispatcher.RunToCompletion();
+
+  EXPECT_EQ(status, OkStatus());
+  EXPECT_FALSE(channel.is_read_open());
+  EXPECT_FALSE(channel.is_write_open());
+
+  // The staged data was sent, after which the peer sees end of stream.
+  std::array<std::byte, 4> buffer{};
+  ASSERT_EQ(read(sockets.peer_fd(), buffer.data(), buffer.size()), 2);
+  EXPECT_EQ(buffer[0], 7_b);
+  EXPECT_EQ(buffer[1], 8_b);
+  EXPECT_EQ(read(sockets.peer_fd(), buffer.data(), buffer.size()), 0);
+}
+
+TEST(EpollChannel, TransfersLargeAmountsBetweenChannels) {
+  // Large enough to fill the socket buffers, so both channels must wait for
+  // the dispatcher to report the other end is ready.
+  constexpr size_t kTotalBytes = 1 << 20;
+  constexpr size_t kWriteSize = 512;
+
+  EpollDispatcher dispatcher;
+  SimpleAllocatorForTest<4096> read_alloc;
+  SimpleAllocatorForTest<4096> write_alloc;
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  EpollChannel sender(fds[0], dispatcher, read_alloc, write_alloc);
+  EpollChannel receiver(fds[1], dispatcher, read_alloc, write_alloc);
+
+  size_t bytes_sent = 0;
+  Status send_status = Status::Unknown();
+  FuncTask send_task([&](Context& cx) -> Poll<> {
+    while (bytes_sent < kTotalBytes) {
+      if (sender.PendReadyToWrite(cx).IsPending()) {
+        return Pending();
+      }
+      auto buffer = sender.PendAllocateWriteBuffer(cx, kWriteSize);
+      if (buffer.IsPending()) {
+        return Pending();
+      }
+      if (!buffer->has_value()) {
+        send_status = Status::ResourceExhausted();
+        return Ready();
+      }
+      for (std::byte& b : **buffer) {
+        b = static_cast<std::byte>(bytes_sent % 251);
+        ++bytes_sent;
+      }
+      EXPECT_EQ(sender.StageWrite(std::move(**buffer)), OkStatus());
+    }
+    auto result = sender.PendClose(cx);
+    if (result.IsPending()) {
+      return Pending();
+    }
+    send_status = *result;
+    return Ready();
+  });
+
+  size_t bytes_received = 0;
+  bool data_matches = true;
+  Status receive_status;
+  FuncTask receive_task([&](Context& cx) -> Poll<> {
+    while (true) {
+      auto read = receiver.PendRead(cx);
+      if (read.IsPending()) {
+        return Pending();
+      }
+      if (!read->ok()) {
+        receive_status = read->status();
+        return Ready();
+      }
+      for (std::byte b : **read) {
+        data_matches &= b == static_cast<std::byte>(bytes_received % 251);
+        ++bytes_received;
+      }
+    }
+  });
+
+  dispatcher.Post(send_task);
+  dispatcher.Post(receive_task);
+  dispatcher.RunToCompletion();
+
+  EXPECT_EQ(send_status, OkStatus());
+  EXPECT_EQ(receive_status, Status::OutOfRange());
+  EXPECT_EQ(bytes_received, kTotalBytes);
+  EXPECT_TRUE(data_matches);
+}
+
+}  // namespace
@@ -0,0 +1,107 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_async2/context.h"
+#include "pw_async2/epoll_dispatcher.h"
+#include "pw_async2/poll.h"
+#include "pw_channel/channel.h"
+#include "pw_multibuf/allocator.h"
+#include "pw_multibuf/multibuf.h"
+#include "pw_multibuf/v1/allocator_async.h"
+#include "pw_status/status.h"
+
+namespace pw::channel {
+
+/// @module{pw_channel}
+
+/// @defgroup pw_channel_epoll Epoll channel
+/// @{
+
+/// A byte channel that reads from and writes to a file descriptor, such as a
+/// connected socket, using an `async2::EpollDispatcher`.
+///
+/// Unlike `StreamChannel`, this channel does not use any threads. The file
+/// descriptor is made non-blocking and registered with the dispatcher, and
+/// reads and writes are performed by the tasks using the channel when the
+/// dispatcher reports the descriptor is ready. A single dispatcher thread can
+/// therefore serve many connections.
+///
+/// Reads fill buffers from the read allocator directly using `readv`. Staged
+/// writes are queued without copying, and are sent with as few `sendmsg` (or,
+/// for descriptors that are not sockets, `writev`) calls as possible when
+/// `PendWrite` or `PendReadyToWrite` is called.
+///
+/// The channel takes ownership of the file descriptor, and closes it when the
+/// channel is closed or destroyed. The channel must only be used by tasks
+/// running on the dispatcher it was constructed with.
+class EpollChannel final : public Implement<ByteReaderWriter> {
+ public:
+  /// Creates a channel for the given file descriptor.
+  ///
+  /// If the descriptor cannot be registered with the dispatcher, an error is
+  /// logged and the channel is created closed.
+  ///
+  /// @param[in]  fd                File descriptor to read and write.
+  /// @param[in]  dispatcher        Dispatcher that runs the channel's users.
+  /// @param[in]  read_allocator    Allocator used for buffers to read into.
+  /// @param[in]  write_allocator   Allocator used for write buffers.
+  EpollChannel(int fd,
+               async2::EpollDispatcher& dispatcher,
+               multibuf::MultiBufAllocator& read_allocator,
+               multibuf::MultiBufAllocator& write_allocator);
+
+  EpollChannel(const EpollChannel&) = delete;
+  EpollChannel& operator=(const EpollChannel&) = delete;
+  EpollChannel(EpollChannel&&) = delete;
+  EpollChannel& operator=(EpollChannel&&) = delete;
+
+  ~EpollChannel() override { Cleanup(); }
+
+ private:
+  async2::PollResult<multibuf::MultiBuf> DoPendRead(
+      async2::Context& cx) override;
+
+  async2::Poll<Status> DoPendReadyToWrite(async2::Context& cx) override;
+
+  async2::PollOptional<multibuf::MultiBuf> DoPendAllocateWriteBuffer(
+      async2::Context& cx, size_t min_bytes) override {
+    write_alloc_future_.SetDesiredSize(min_bytes);
+    return write_alloc_future_.Pend(cx);
+  }
+
+  Status DoStageWrite(multibuf::MultiBuf&& data) override;
+
+  async2::Poll<Status> DoPendWrite(async2::Context& cx) override;
+
+  async2::Poll<Status> DoPendClose(async2::Context& cx) override;
+
+  /// Unregisters and closes the file descriptor, and releases any buffers.
+  void Cleanup();
+
+  int fd_;
+  bool is_socket_ = false;
+  async2::EpollDispatcher& dispatcher_;
+  multibuf::v1::MultiBufAllocationFuture read_alloc_future_;
+  multibuf::v1::MultiBufAllocationFuture write_alloc_future_;
+  multibuf::MultiBuf read_buffer_;
+  multibuf::MultiBuf write_buffer_;
+  Status write_status_;
+};
+
+/// @}
+
+}  // namespace pw::channel
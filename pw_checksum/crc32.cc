@@ -16,6 +16,13 @@
 
 #include <array>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PW_CHECKSUM_CRC32_PCLMUL 1
+#include <immintrin.h>
+#else
+#define PW_CHECKSUM_CRC32_PCLMUL 0
+#endif  // defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
 namespace pw::checksum {
 namespace {
 
@@ -49,12 +56,175 @@ constexpr std::array<uint32_t, (1 << kBits)> GenerateCrc32Table() {
   return table;
 }
 
+// Generates the tables for a slicing-by-8 CRC32 implementation. Table 0 is the
+// 8-bit lookup table. Entry i of table k is the CRC of byte i followed by k
+// zero bytes, so eight bytes can be processed with independent lookups.
+template <uint32_t kPolynomial>
+constexpr std::array<std::array<uint32_t, 256>, 8>
+GenerateCrc32SlicingTables() {
+  std::array<std::array<uint32_t, 256>, 8> tables{};
+  tables[0] = GenerateCrc32Table<8, kPolynomial>();
+  for (size_t k = 1; k < tables.size(); k++) {
+    for (size_t i = 0; i < 256; i++) {
+      const uint32_t previous = tables[k - 1][i];
+      tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+    }
+  }
+  return tables;
+}
+
 // Reversed polynomial for the commonly used CRC32 variant. See:
 // https://en.wikipedia.org/wiki/Cyclic_redundancy_check#Polynomial_representations_of_cyclic_redundancy_checks
 constexpr uint32_t kCrc32Polynomial = 0xEDB88320;
 
+// Reads a little-endian 32-bit value. Compilers reduce this to a single load
+// on little-endian targets.
+constexpr uint32_t LoadLittleEndian32(const uint8_t* bytes) {
+  return static_cast<uint32_t>(bytes[0]) |
+         static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+#if PW_CHECKSUM_CRC32_PCLMUL
+
+// Inputs shorter than this are not worth the setup cost of folding.
+constexpr size_t kPclmulMinimumSize = 64;
+
+#define PW_CHECKSUM_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+
+PW_CHECKSUM_CRC32_PCLMUL_TARGET inline __m128i Load128(const uint8_t* bytes) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+}
+
+PW_CHECKSUM_CRC32_PCLMUL_TARGET inline __m128i LoadConstants(
+    const uint64_t* constants) {
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(constants));
+}
+
+// Folds value forward by 128 bits with the constants in k and adds next.
+PW_CHECKSUM_CRC32_PCLMUL_TARGET inline __m128i Fold128(__m128i value,
+                                                       __m128i next,
+                                                       __m128i k) {
+  const __m128i low = _mm_clmulepi64_si128(value, k, 0x00);
+  const __m128i high = _mm_clmulepi64_si128(value, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(high, next), low);
+}
+
+// Folds 16-byte blocks with carry-less multiplication, then reduces the result
+// to a CRC32 with a Barrett reduction. size_bytes must be a multiple of 16 and
+// at least 64. See "Fast CRC Computation for Generic Polynomials Using
+// PCLMULQDQ Instruction" (Gopal et al., Intel, 2009). The constants are powers
+// of x modulo the bit-reflected CRC32 polynomial.
+PW_CHECKSUM_CRC32_PCLMUL_TARGET uint32_t Crc32Pclmul(
+    const uint8_t* data, size_t size_bytes, uint32_t state) {
+  alignas(16) static constexpr uint64_t kK1K2[] = {0x0154442bd4, 0x01c6e41596};
+  alignas(16) static constexpr uint64_t kK3K4[] = {0x01751997d0, 0x00ccaa009e};
+  alignas(16) static constexpr uint64_t kK5K0[] = {0x0163cd6124, 0x0000000000};
+  alignas(16) static constexpr uint64_t kPoly[] = {0x01db710641, 0x01f7011641};
+
+  // Fold four 128-bit lanes in parallel, 64 bytes per iteration.
+  __m128i x1 = _mm_xor_si128(Load128(data), _mm_cvtsi32_si128(state));
+  __m128i x2 = Load128(data + 16);
+  __m128i x3 = Load128(data + 32);
+  __m128i x4 = Load128(data + 48);
+  data += 64;
+  size_bytes -= 64;
+
+  __m128i k = LoadConstants(kK1K2);
+  while (size_bytes >= 64) {
+    x1 = Fold128(x1, Load128(data), k);
+    x2 = Fold128(x2, Load128(data + 16), k);
+    x3 = Fold128(x3, Load128(data + 32), k);
+    x4 = Fold128(x4, Load128(data + 48), k);
+
+    data += 64;
+    size_bytes -= 64;
+  }
+
+  // Fold the four lanes into one, then fold in any remaining 16-byte blocks.
+  k = LoadConstants(kK3K4);
+  x1 = Fold128(x1, x2, k);
+  x1 = Fold128(x1, x3, k);
+  x1 = Fold128(x1, x4, k);
+
+  while (size_bytes >= 16) {
+    x1 = Fold128(x1, Load128(data), k);
+    data += 16;
+    size_bytes -= 16;
+  }
+
+  // Fold 128 bits to 64 bits.
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kK5K0));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits.
+  k = LoadConstants(kPoly);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+bool CpuSupportsPclmul() {
+  static const bool supported =
+      __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+  return supported;
+}
+
+#undef PW_CHECKSUM_CRC32_PCLMUL_TARGET
+
+#endif  // PW_CHECKSUM_CRC32_PCLMUL
+
 }  // namespace
 
+extern "C" uint32_t _pw_checksum_InternalCrc32Accelerated(const void* data,
+                                                          size_t size_bytes,
+                                                          uint32_t state) {
+#if PW_CHECKSUM_CRC32_PCLMUL
+  if (size_bytes >= kPclmulMinimumSize && CpuSupportsPclmul()) {
+    const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+    const size_t folded_size = size_bytes & ~size_t{15};
+    state = Crc32Pclmul(data_bytes, folded_size, state);
+    return _pw_checksum_InternalCrc32SlicingBy8(
+        data_bytes + folded_size, size_bytes - folded_size, state);
+  }
+#endif  // PW_CHECKSUM_CRC32_PCLMUL
+  return _pw_checksum_InternalCrc32SlicingBy8(data, size_bytes, state);
+}
+
+extern "C" uint32_t _pw_checksum_InternalCrc32SlicingBy8(const void* data,
+                                                         size_t size_bytes,
+                                                         uint32_t state) {
+  static constexpr std::array<std::array<uint32_t, 256>, 8> kCrc32Tables =
+      GenerateCrc32SlicingTables<kCrc32Polynomial>();
+  const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
+
+  for (; size_bytes >= 8; size_bytes -= 8, data_bytes += 8) {
+    const uint32_t low = state ^ LoadLittleEndian32(data_bytes);
+    const uint32_t high = LoadLittleEndian32(data_bytes + 4);
+    state = kCrc32Tables[7][low & 0xFFu] ^
+            kCrc32Tables[6][(low >> 8) & 0xFFu] ^
+            kCrc32Tables[5][(low >> 16) & 0xFFu] ^
+            kCrc32Tables[4][low >> 24] ^ kCrc32Tables[3][high & 0xFFu] ^
+            kCrc32Tables[2][(high >> 8) & 0xFFu] ^
+            kCrc32Tables[1][(high >> 16) & 0xFFu] ^ kCrc32Tables[0][high >> 24];
+  }
+
+  for (size_t i = 0; i < size_bytes; ++i) {
+    state = kCrc32Tables[0][(state ^ data_bytes[i]) & 0xFFu] ^ (state >> 8);
+  }
+
+  return state;
+}
+
 extern "C" uint32_t _pw_checksum_InternalCrc32EightBit(const void* data,
                                                        size_t size_bytes,
                                                        uint32_t state) {
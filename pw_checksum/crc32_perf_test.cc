@@ -12,6 +12,8 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string_view>
 
@@ -28,6 +30,16 @@ constexpr std::string_view kString =
     "people very angry and been widely regarded as a bad move.";
 constexpr auto kBytes = bytes::Array<1, 2, 3, 4, 5, 6, 7, 8, 9>();
 
+// Large enough that per-call overhead is negligible, so throughput in bytes per
+// cycle is kBlock.size() divided by the cycles per iteration.
+constexpr std::array<std::byte, 4096> kBlock = [] {
+  std::array<std::byte, 4096> block{};
+  for (size_t i = 0; i < block.size(); ++i) {
+    block[i] = static_cast<std::byte>(i * 31 + 7);
+  }
+  return block;
+}();
+
 void Crc32OneBitTest(perf_test::State& state, span<const std::byte> data) {
   while (state.KeepRunning()) {
     Crc32OneBit::Calculate(data);
@@ -46,13 +58,40 @@ void Crc32EightBitTest(perf_test::State& state, span<const std::byte> data) {
   }
 }
 
+void Crc32SlicingBy8Test(perf_test::State& state, span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32SlicingBy8::Calculate(data);
+  }
+}
+
+void Crc32AcceleratedTest(perf_test::State& state,
+                          span<const std::byte> data) {
+  while (state.KeepRunning()) {
+    Crc32Accelerated::Calculate(data);
+  }
+}
+
 PW_PERF_TEST(CrcOneBitStringTest, Crc32OneBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcFourBitStringTest, Crc32FourBitTest, as_bytes(span(kString)));
 PW_PERF_TEST(CrcEightBitStringTest, Crc32EightBitTest, as_bytes(span(kString)));
+PW_PERF_TEST(CrcSlicingBy8StringTest,
+             Crc32SlicingBy8Test,
+             as_bytes(span(kString)));
+PW_PERF_TEST(CrcAcceleratedStringTest,
+             Crc32AcceleratedTest,
+             as_bytes(span(kString)));
 
 PW_PERF_TEST(CrcOneBitBytesTest, Crc32OneBitTest, kBytes);
 PW_PERF_TEST(CrcFourBitBytesTest, Crc32FourBitTest, kBytes);
 PW_PERF_TEST(CrcEightBitBytesTest, Crc32EightBitTest, kBytes);
+PW_PERF_TEST(CrcSlicingBy8BytesTest, Crc32SlicingBy8Test, kBytes);
+PW_PERF_TEST(CrcAcceleratedBytesTest, Crc32AcceleratedTest, kBytes);
+
+PW_PERF_TEST(CrcOneBitBlockTest, Crc32OneBitTest, kBlock);
+PW_PERF_TEST(CrcFourBitBlockTest, Crc32FourBitTest, kBlock);
+PW_PERF_TEST(CrcEightBitBlockTest, Crc32EightBitTest, kBlock);
+PW_PERF_TEST(CrcSlicingBy8BlockTest, Crc32SlicingBy8Test, kBlock);
+PW_PERF_TEST(CrcAcceleratedBlockTest, Crc32AcceleratedTest, kBlock);
 
 }  // namespace
 }  // namespace pw::checksum
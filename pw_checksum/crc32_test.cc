@@ -13,6 +13,7 @@
 // the License.
 #include "pw_checksum/crc32.h"
 
+#include <array>
 #include <string_view>
 
 #include "pw_bytes/array.h"
@@ -46,6 +47,10 @@ TEST(Crc32, Empty) {
   EXPECT_EQ(Crc32FourBit::Calculate(span<std::byte>()),
             PW_CHECKSUM_EMPTY_CRC32);
   EXPECT_EQ(Crc32OneBit::Calculate(span<std::byte>()), PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32SlicingBy8::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
+  EXPECT_EQ(Crc32Accelerated::Calculate(span<std::byte>()),
+            PW_CHECKSUM_EMPTY_CRC32);
 }
 
 TEST(Crc32, Buffer) {
@@ -53,6 +58,8 @@ TEST(Crc32, Buffer) {
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32SlicingBy8::Calculate(as_bytes(span(kBytes))), kBufferCrc);
+  EXPECT_EQ(Crc32Accelerated::Calculate(as_bytes(span(kBytes))), kBufferCrc);
 }
 
 TEST(Crc32, String) {
@@ -60,6 +67,8 @@ TEST(Crc32, String) {
   EXPECT_EQ(Crc32EightBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32FourBit::Calculate(as_bytes(span(kString))), kStringCrc);
   EXPECT_EQ(Crc32OneBit::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32SlicingBy8::Calculate(as_bytes(span(kString))), kStringCrc);
+  EXPECT_EQ(Crc32Accelerated::Calculate(as_bytes(span(kString))), kStringCrc);
 }
 
 template <typename CrcVariant>
@@ -76,6 +85,8 @@ TEST(Crc32Class, ByteByByte) {
   TestByByte<Crc32EightBit>();
   TestByByte<Crc32FourBit>();
   TestByByte<Crc32OneBit>();
+  TestByByte<Crc32SlicingBy8>();
+  TestByByte<Crc32Accelerated>();
 }
 
 template <typename CrcVariant>
@@ -90,6 +101,8 @@ TEST(Crc32Class, Buffer) {
   TestBuffer<Crc32EightBit>();
   TestBuffer<Crc32FourBit>();
   TestBuffer<Crc32OneBit>();
+  TestBuffer<Crc32SlicingBy8>();
+  TestBuffer<Crc32Accelerated>();
 }
 
 template <typename CrcVariant>
@@ -105,6 +118,8 @@ TEST(Crc32Class, BufferAppend) {
   TestBufferAppend<Crc32EightBit>();
   TestBufferAppend<Crc32FourBit>();
   TestBufferAppend<Crc32OneBit>();
+  TestBufferAppend<Crc32SlicingBy8>();
+  TestBufferAppend<Crc32Accelerated>();
 }
 
 template <typename CrcVariant>
@@ -119,6 +134,60 @@ TEST(Crc32Class, String) {
   TestString<Crc32EightBit>();
   TestString<Crc32FourBit>();
   TestString<Crc32OneBit>();
+  TestString<Crc32SlicingBy8>();
+  TestString<Crc32Accelerated>();
+}
+
+// Fills a buffer with pseudorandom bytes from a fixed seed.
+template <size_t kSize>
+std::array<std::byte, kSize> PseudorandomBytes() {
+  std::array<std::byte, kSize> bytes;
+  uint32_t state = 0x12345678;
+  for (std::byte& b : bytes) {
+    state = state * 1664525u + 1013904223u;
+    b = static_cast<std::byte>(state >> 24);
+  }
+  return bytes;
+}
+
+// Checks the table-driven variants against Crc32EightBit for a range of sizes
+// and alignments, including sizes that exercise the tail handling of each.
+template <typename CrcVariant>
+void TestMatchesEightBit() {
+  static const std::array<std::byte, 4096 + 16> kData =
+      PseudorandomBytes<4096 + 16>();
+  constexpr size_t kSizes[] = {
+      0, 1, 7, 8, 9, 15, 16, 17, 63, 64, 65, 127, 128, 255, 1000, 4096};
+
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t size : kSizes) {
+      const auto data = span(kData).subspan(offset, size);
+      EXPECT_EQ(CrcVariant::Calculate(data), Crc32EightBit::Calculate(data))
+          << "offset " << offset << ", size " << size;
+    }
+  }
+}
+
+TEST(Crc32, SlicingBy8MatchesEightBit) {
+  TestMatchesEightBit<Crc32SlicingBy8>();
+}
+
+TEST(Crc32, AcceleratedMatchesEightBit) {
+  TestMatchesEightBit<Crc32Accelerated>();
+}
+
+TEST(Crc32Class, AcceleratedAppendMatchesEightBit) {
+  static const std::array<std::byte, 1024> kData = PseudorandomBytes<1024>();
+  const uint32_t expected = Crc32EightBit::Calculate(kData);
+
+  // Split the data at points that leave both parts above and below the
+  // accelerated path's minimum size.
+  for (size_t split : {size_t{1}, size_t{63}, size_t{100}, size_t{1000}}) {
+    Crc32Accelerated crc;
+    crc.Update(span(kData).first(split));
+    crc.Update(span(kData).subspan(split));
+    EXPECT_EQ(crc.value(), expected) << "split " << split;
+  }
 }
 
 extern "C" uint32_t CallChecksumCrc32(const void* data, size_t size_bytes);
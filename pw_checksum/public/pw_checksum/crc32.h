@@ -35,6 +35,12 @@ extern "C" {
 #define _PW_CHECKSUM_CRC32_INITIAL_STATE 0xFFFFFFFFu
 
 // Internal implementation function for CRC32. Do not call it directly.
+uint32_t _pw_checksum_InternalCrc32Accelerated(const void* data,
+                                               size_t size_bytes,
+                                               uint32_t state);
+uint32_t _pw_checksum_InternalCrc32SlicingBy8(const void* data,
+                                              size_t size_bytes,
+                                              uint32_t state);
 uint32_t _pw_checksum_InternalCrc32EightBit(const void* data,
                                             size_t size_bytes,
                                             uint32_t state);
@@ -46,7 +52,11 @@ uint32_t _pw_checksum_InternalCrc32OneBit(const void* data,
                                           size_t size_bytes,
                                           uint32_t state);
 
-#if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS
+#if PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_ACCELERATED
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32Accelerated
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_SLICING_BY_8
+#define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32SlicingBy8
+#elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_8BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32EightBit
 #elif PW_CHECKSUM_CRC32_DEFAULT_IMPL == PW_CHECKSUM_CRC32_4BITS
 #define _pw_checksum_InternalCrc32 _pw_checksum_InternalCrc32FourBit
@@ -120,6 +130,14 @@ class Crc32Impl {
 /// CRC-32: 8 bits per loop, initial value 0xFFFFFFFF.
 using Crc32 = Crc32Impl<_pw_checksum_InternalCrc32>;
 
+/// CRC-32: carry-less multiplication (PCLMULQDQ) on x86-64 processors that
+/// support it, otherwise slicing-by-8. Initial value 0xFFFFFFFF.
+using Crc32Accelerated = Crc32Impl<_pw_checksum_InternalCrc32Accelerated>;
+
+/// CRC-32: 64 bits per loop with eight 256-entry tables, initial value
+/// 0xFFFFFFFF.
+using Crc32SlicingBy8 = Crc32Impl<_pw_checksum_InternalCrc32SlicingBy8>;
+
 /// CRC-32: 8 bits per loop, initial value 0xFFFFFFFF.
 using Crc32EightBit = Crc32Impl<_pw_checksum_InternalCrc32EightBit>;
 
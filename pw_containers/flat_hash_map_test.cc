@@ -0,0 +1,383 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/flat_hash_map.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "pw_allocator/fault_injecting_allocator.h"
+#include "pw_allocator/testing.h"
+#include "pw_containers/internal/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::allocator::test::AllocatorForTest;
+using pw::allocator::test::FaultInjectingAllocator;
+using pw::containers::test::CopyOnly;
+using pw::containers::test::Counter;
+using pw::containers::test::MoveOnly;
+
+class FlatHashMapTest : public ::testing::Test {
+ protected:
+  FlatHashMapTest() : allocator_(allocator_for_test_) {}
+
+  AllocatorForTest<8192> allocator_for_test_;
+  FaultInjectingAllocator allocator_;
+};
+
+TEST_F(FlatHashMapTest, ConstructDestruct) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.size(), 0u);
+  EXPECT_EQ(map.bucket_count(), 0u);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(allocator_for_test_.GetAllocated(), 0u);
+}
+
+TEST_F(FlatHashMapTest, VerifyDestruction) {
+  Counter::Reset();
+  {
+    pw::FlatHashMap<int, Counter> map(allocator_);
+    map.emplace(1);
+    map.emplace(2);
+    EXPECT_EQ(Counter::created, 2);
+  }
+  EXPECT_EQ(Counter::created + Counter::moved, Counter::destroyed);
+}
+
+TEST_F(FlatHashMapTest, InsertAndFind) {
+  pw::FlatHashMap<int, std::string> map(allocator_);
+
+  auto result = map.insert({1, "one"});
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(result.first->first, 1);
+  EXPECT_EQ(result.first->second, "one");
+  EXPECT_EQ(map.size(), 1u);
+
+  EXPECT_TRUE(map.contains(1));
+  EXPECT_FALSE(map.contains(2));
+
+  auto it = map.find(1);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ(it->second, "one");
+  EXPECT_EQ(map.find(2), map.end());
+
+  auto result2 = map.insert({1, "another one"});
+  EXPECT_FALSE(result2.second);
+  EXPECT_EQ(result2.first->second, "one");
+  EXPECT_EQ(map.size(), 1u);
+}
+
+TEST_F(FlatHashMapTest, TryInsertAllocationFailure) {
+  pw::FlatHashMap<int, int> map(allocator_);
+
+  const std::pair<const int, int> item1{1, 10};
+  auto result = map.try_insert(item1);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_TRUE(result->second);
+
+  // Fill the first table, then fail to grow.
+  while (map.size() < map.capacity()) {
+    map.emplace(static_cast<int>(map.size()) + 1, 0);
+  }
+  allocator_.DisableAll();
+  const std::pair<const int, int> item2{1000, 20};
+  EXPECT_FALSE(map.try_insert(item2).has_value());
+  EXPECT_FALSE(map.try_emplace(1001, 30).has_value());
+  allocator_.EnableAll();
+
+  EXPECT_EQ(map.size(), map.capacity());
+  EXPECT_EQ(map.at(1), 10);
+  EXPECT_FALSE(map.contains(1000));
+  EXPECT_TRUE(map.try_emplace(1000, 20).has_value());
+}
+
+TEST_F(FlatHashMapTest, InsertInitializerListAndRange) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.insert({{1, 10}, {2, 20}, {3, 30}});
+  EXPECT_EQ(map.size(), 3u);
+
+  const std::pair<const int, int> items[] = {{3, 0}, {4, 40}};
+  map.insert(std::begin(items), std::end(items));
+  EXPECT_EQ(map.size(), 4u);
+  EXPECT_EQ(map.at(3), 30);
+  EXPECT_EQ(map.at(4), 40);
+}
+
+TEST_F(FlatHashMapTest, InsertWithAutoRehash) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 200; ++i) {
+    map.emplace(i, i * 10);
+  }
+  EXPECT_EQ(map.size(), 200u);
+  EXPECT_GE(map.capacity(), 200u);
+  for (int i = 0; i < 200; ++i) {
+    ASSERT_EQ(map.at(i), i * 10);
+  }
+  EXPECT_FALSE(map.contains(200));
+}
+
+TEST_F(FlatHashMapTest, EmplaceMoveOnly) {
+  pw::FlatHashMap<int, MoveOnly> map(allocator_);
+  map.emplace(1, MoveOnly(10));
+  for (int i = 2; i < 100; ++i) {
+    map.emplace(i, i);
+  }
+  EXPECT_EQ(map.at(1).value, 10);
+  EXPECT_EQ(map.at(99).value, 99);
+}
+
+TEST_F(FlatHashMapTest, OperatorBrackets) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map[1] = 10;
+  EXPECT_EQ(map[1], 10);
+  EXPECT_EQ(map[2], 0);
+  EXPECT_EQ(map.size(), 2u);
+}
+
+TEST_F(FlatHashMapTest, Erase) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.insert({{1, 10}, {2, 20}, {3, 30}});
+
+  EXPECT_EQ(map.erase(2), 1u);
+  EXPECT_EQ(map.erase(2), 0u);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_FALSE(map.contains(2));
+
+  // Erasing does not move other elements.
+  auto* three = &map.at(3);
+  auto it = map.erase(map.find(1));
+  EXPECT_EQ(&map.at(3), three);
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_TRUE(it == map.end() || it->first == 3);
+
+  EXPECT_EQ(map.erase(map.begin(), map.end()), map.end());
+  EXPECT_TRUE(map.empty());
+}
+
+TEST_F(FlatHashMapTest, EraseWhileIterating) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i, i);
+  }
+  for (auto it = map.begin(); it != map.end();) {
+    it = it->first % 2 == 0 ? map.erase(it) : std::next(it);
+  }
+  EXPECT_EQ(map.size(), 50u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+}
+
+TEST_F(FlatHashMapTest, ClearAndReset) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.insert({{1, 10}, {2, 20}});
+  const size_t slots = map.bucket_count();
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.bucket_count(), slots);
+  EXPECT_NE(allocator_for_test_.GetAllocated(), 0u);
+
+  map.reset();
+  EXPECT_EQ(map.bucket_count(), 0u);
+  EXPECT_EQ(allocator_for_test_.GetAllocated(), 0u);
+
+  map.emplace(3, 30);
+  EXPECT_EQ(map.at(3), 30);
+}
+
+TEST_F(FlatHashMapTest, Iterators) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  int expected_sum = 0;
+  for (int i = 1; i <= 40; ++i) {
+    map.emplace(i, i);
+    expected_sum += i;
+  }
+
+  int sum = 0;
+  size_t count = 0;
+  for (auto& [key, value] : map) {
+    EXPECT_EQ(key, value);
+    sum += value;
+    ++count;
+  }
+  EXPECT_EQ(sum, expected_sum);
+  EXPECT_EQ(count, map.size());
+
+  const auto& const_map = map;
+  EXPECT_EQ(static_cast<size_t>(
+                std::distance(const_map.begin(), const_map.end())),
+            map.size());
+  pw::FlatHashMap<int, int>::const_iterator it = map.begin();
+  EXPECT_EQ(it, const_map.cbegin());
+}
+
+TEST_F(FlatHashMapTest, EqualRange) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.emplace(1, 10);
+
+  auto [first, last] = map.equal_range(1);
+  ASSERT_NE(first, map.end());
+  EXPECT_EQ(first->second, 10);
+  EXPECT_EQ(std::next(first), last);
+
+  auto [missing_first, missing_last] = map.equal_range(2);
+  EXPECT_EQ(missing_first, map.end());
+  EXPECT_EQ(missing_last, map.end());
+}
+
+TEST_F(FlatHashMapTest, Swap) {
+  pw::FlatHashMap<int, int> map1(allocator_);
+  pw::FlatHashMap<int, int> map2(allocator_);
+  map1.emplace(1, 10);
+  map2.insert({{2, 20}, {3, 30}});
+
+  map1.swap(map2);
+  EXPECT_EQ(map1.size(), 2u);
+  EXPECT_EQ(map1.at(3), 30);
+  EXPECT_EQ(map2.size(), 1u);
+  EXPECT_EQ(map2.at(1), 10);
+}
+
+TEST_F(FlatHashMapTest, Reserve) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.reserve(100);
+  EXPECT_GE(map.capacity(), 100u);
+
+  const size_t slots = map.bucket_count();
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i, i);
+  }
+  EXPECT_EQ(map.bucket_count(), slots);
+
+  allocator_.DisableAll();
+  EXPECT_FALSE(map.try_reserve(1000));
+  EXPECT_TRUE(map.try_reserve(50));
+  allocator_.EnableAll();
+}
+
+TEST_F(FlatHashMapTest, Rehash) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.insert({{1, 10}, {2, 20}});
+  map.rehash(256);
+  EXPECT_GE(map.bucket_count(), 256u);
+  EXPECT_EQ(map.at(1), 10);
+  EXPECT_EQ(map.at(2), 20);
+}
+
+TEST_F(FlatHashMapTest, MoveConstructAndAssign) {
+  pw::FlatHashMap<int, Counter> map1(allocator_);
+  map1.emplace(1, 10);
+  map1.emplace(2, 20);
+
+  pw::FlatHashMap<int, Counter> map2(std::move(map1));
+  EXPECT_EQ(map2.size(), 2u);
+  EXPECT_EQ(map2.at(1), 10);
+  EXPECT_TRUE(map1.empty());  // NOLINT(bugprone-use-after-move)
+
+  pw::FlatHashMap<int, Counter> map3(allocator_);
+  map3.emplace(3, 30);
+  Counter::Reset();
+  map3 = std::move(map2);
+  EXPECT_EQ(Counter::destroyed, 1);
+  EXPECT_EQ(map3.size(), 2u);
+  EXPECT_EQ(map3.at(2), 20);
+}
+
+TEST_F(FlatHashMapTest, HashCollisions) {
+  struct BadHash {
+    size_t operator()(int) const { return 0; }  // All keys hash to 0
+  };
+
+  pw::FlatHashMap<int, int, BadHash> map(allocator_);
+  for (int i = 0; i < 50; ++i) {
+    map.emplace(i, i * 10);
+  }
+  EXPECT_EQ(map.size(), 50u);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(map.at(i), i * 10);
+  }
+
+  for (int i = 0; i < 50; i += 2) {
+    EXPECT_EQ(map.erase(i), 1u);
+  }
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+}
+
+TEST_F(FlatHashMapTest, ErasedSlotsAreReclaimed) {
+  pw::FlatHashMap<int, int> map(allocator_);
+  map.reserve(64);
+  const size_t slots = map.bucket_count();
+
+  // Churning through many keys leaves deleted slots, which are reclaimed by
+  // rehashing in place rather than growing.
+  for (int i = 0; i < 10000; ++i) {
+    map.emplace(i, i);
+    if (i >= 32) {
+      ASSERT_EQ(map.erase(i - 32), 1u);
+    }
+  }
+  EXPECT_EQ(map.size(), 32u);
+  EXPECT_EQ(map.bucket_count(), slots);
+  for (int i = 10000 - 32; i < 10000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST_F(FlatHashMapTest, MatchesUnorderedMap) {
+  pw::FlatHashMap<uint32_t, uint32_t> map(allocator_);
+  std::unordered_map<uint32_t, uint32_t> expected;
+
+  uint32_t state = 1;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t key = (state >> 16) % 200;
+    switch ((state >> 8) % 4) {
+      case 0:
+      case 1:
+        EXPECT_EQ(map.emplace(key, state).second,
+                  expected.emplace(key, state).second);
+        break;
+      case 2:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 3:
+        EXPECT_EQ(map.contains(key), expected.count(key) == 1);
+        break;
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+
+  size_t count = 0;
+  for (const auto& [key, value] : map) {
+    ASSERT_EQ(expected.at(key), value);
+    ++count;
+  }
+  EXPECT_EQ(count, expected.size());
+}
+
+static_assert(!std::is_copy_constructible_v<pw::FlatHashMap<int, int>>);
+static_assert(std::is_move_constructible_v<pw::FlatHashMap<int, MoveOnly>>);
+static_assert(!std::is_copy_assignable_v<pw::FlatHashMap<int, CopyOnly>>);
+static_assert(std::is_move_assignable_v<pw::FlatHashMap<int, MoveOnly>>);
+
+}  // namespace
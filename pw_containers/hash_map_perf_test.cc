@@ -0,0 +1,108 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Compares insert and lookup performance of pw::FlatHashMap,
+// pw::DynamicHashMap, and std::unordered_map across table sizes.
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "pw_allocator/libc_allocator.h"
+#include "pw_assert/check.h"
+#include "pw_containers/dynamic_hash_map.h"
+#include "pw_containers/flat_hash_map.h"
+#include "pw_perf_test/perf_test.h"
+
+namespace {
+
+using Key = uint32_t;
+using Value = uint32_t;
+
+// Spreads keys over the key space, like IDs or tokens would be.
+constexpr Key KeyAt(size_t index) {
+  return static_cast<Key>(index * 2654435761u);
+}
+
+struct FlatHashMapType {
+  using Map = pw::FlatHashMap<Key, Value>;
+  static Map Make() { return Map(pw::allocator::GetLibCAllocator()); }
+};
+
+struct DynamicHashMapType {
+  using Map = pw::DynamicHashMap<Key, Value>;
+  static Map Make() { return Map(pw::allocator::GetLibCAllocator()); }
+};
+
+struct UnorderedMapType {
+  using Map = std::unordered_map<Key, Value, pw::Hash, pw::EqualTo>;
+  static Map Make() { return Map(); }
+};
+
+// Inserts `size` elements into an empty map, including growing the map.
+template <typename MapType>
+void Insert(pw::perf_test::State& state, size_t size) {
+  while (state.KeepRunning()) {
+    auto map = MapType::Make();
+    for (size_t i = 0; i < size; ++i) {
+      map.emplace(KeyAt(i), static_cast<Value>(i));
+    }
+    PW_CHECK_UINT_EQ(map.size(), size);
+  }
+}
+
+// Looks up every key in a map of `size` elements, followed by the same number
+// of keys that are not in the map.
+template <typename MapType>
+void Lookup(pw::perf_test::State& state, size_t size) {
+  auto map = MapType::Make();
+  for (size_t i = 0; i < size; ++i) {
+    map.emplace(KeyAt(i), static_cast<Value>(i));
+  }
+
+  size_t found = 0;
+  while (state.KeepRunning()) {
+    found = 0;
+    for (size_t i = 0; i < size * 2; ++i) {
+      found += map.count(KeyAt(i));
+    }
+  }
+  PW_CHECK_UINT_EQ(found, size);
+}
+
+PW_PERF_TEST(Insert16_FlatHashMap, Insert<FlatHashMapType>, 16);
+PW_PERF_TEST(Insert16_DynamicHashMap, Insert<DynamicHashMapType>, 16);
+PW_PERF_TEST(Insert16_UnorderedMap, Insert<UnorderedMapType>, 16);
+
+PW_PERF_TEST(Insert256_FlatHashMap, Insert<FlatHashMapType>, 256);
+PW_PERF_TEST(Insert256_DynamicHashMap, Insert<DynamicHashMapType>, 256);
+PW_PERF_TEST(Insert256_UnorderedMap, Insert<UnorderedMapType>, 256);
+
+PW_PERF_TEST(Insert4096_FlatHashMap, Insert<FlatHashMapType>, 4096);
+PW_PERF_TEST(Insert4096_DynamicHashMap, Insert<DynamicHashMapType>, 4096);
+PW_PERF_TEST(Insert4096_UnorderedMap, Insert<UnorderedMapType>, 4096);
+
+PW_PERF_TEST(Lookup16_FlatHashMap, Lookup<FlatHashMapType>, 16);
+PW_PERF_TEST(Lookup16_DynamicHashMap, Lookup<DynamicHashMapType>, 16);
+PW_PERF_TEST(Lookup16_UnorderedMap, Lookup<UnorderedMapType>, 16);
+
+PW_PERF_TEST(Lookup256_FlatHashMap, Lookup<FlatHashMapType>, 256);
+PW_PERF_TEST(Lookup256_DynamicHashMap, Lookup<DynamicHashMapType>, 256);
+PW_PERF_TEST(Lookup256_UnorderedMap, Lookup<UnorderedMapType>, 256);
+
+PW_PERF_TEST(Lookup4096_FlatHashMap, Lookup<FlatHashMapType>, 4096);
+PW_PERF_TEST(Lookup4096_DynamicHashMap, Lookup<DynamicHashMapType>, 4096);
+PW_PERF_TEST(Lookup4096_UnorderedMap, Lookup<UnorderedMapType>, 4096);
+
+}  // namespace
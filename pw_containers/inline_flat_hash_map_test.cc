@@ -0,0 +1,145 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_containers/inline_flat_hash_map.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "pw_containers/internal/test_helpers.h"
+#include "pw_unit_test/framework.h"
+
+namespace {
+
+using pw::containers::test::Counter;
+
+TEST(InlineFlatHashMap, ConstructDestruct) {
+  pw::InlineFlatHashMap<int, int, 10> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.capacity(), 10u);
+  EXPECT_EQ(map.max_size(), 10u);
+  EXPECT_GE(map.bucket_count(), 10u);
+}
+
+TEST(InlineFlatHashMap, ZeroCapacity) {
+  pw::InlineFlatHashMap<int, int, 0> map;
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_FALSE(map.try_emplace(1, 1).has_value());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(InlineFlatHashMap, InitializerList) {
+  pw::InlineFlatHashMap<int, std::string, 4> map = {{1, "one"}, {2, "two"}};
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_EQ(map.at(2), "two");
+}
+
+TEST(InlineFlatHashMap, FillToCapacity) {
+  pw::InlineFlatHashMap<int, int, 20> map;
+  for (int i = 0; i < 20; ++i) {
+    auto result = map.try_emplace(i, i * 10);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->second);
+  }
+  EXPECT_EQ(map.size(), 20u);
+  EXPECT_FALSE(map.try_emplace(20, 200).has_value());
+
+  // Existing keys are still found when the map is full.
+  auto result = map.try_emplace(5, 0);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_FALSE(result->second);
+  EXPECT_EQ(result->first->second, 50);
+
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(map.at(i), i * 10);
+  }
+}
+
+TEST(InlineFlatHashMap, ErasedSlotsAreReclaimed) {
+  pw::InlineFlatHashMap<uint32_t, uint32_t, 14> map;
+  for (uint32_t i = 0; i < 5000; ++i) {
+    if (i >= 14) {
+      ASSERT_EQ(map.size(), map.capacity());
+      ASSERT_EQ(map.erase(i - 14), 1u);
+    }
+    ASSERT_TRUE(map.try_emplace(i, i).has_value()) << i;
+  }
+  EXPECT_EQ(map.size(), 14u);
+  for (uint32_t i = 5000 - 14; i < 5000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+}
+
+TEST(InlineFlatHashMap, CopyAndMove) {
+  pw::InlineFlatHashMap<int, Counter, 8> map;
+  map.emplace(1, 10);
+  map.emplace(2, 20);
+
+  pw::InlineFlatHashMap<int, Counter, 8> copy(map);
+  EXPECT_EQ(copy.size(), 2u);
+  EXPECT_EQ(copy.at(1), 10);
+  EXPECT_EQ(map.at(1), 10);
+
+  pw::InlineFlatHashMap<int, Counter, 8> moved(std::move(map));
+  EXPECT_EQ(moved.size(), 2u);
+  EXPECT_EQ(moved.at(2), 20);
+  EXPECT_TRUE(map.empty());  // NOLINT(bugprone-use-after-move)
+
+  map = copy;
+  EXPECT_EQ(map.at(2), 20);
+  copy.clear();
+  copy = std::move(map);
+  EXPECT_EQ(copy.size(), 2u);
+  EXPECT_TRUE(map.empty());  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(InlineFlatHashMap, VerifyDestruction) {
+  Counter::Reset();
+  {
+    pw::InlineFlatHashMap<int, Counter, 4> map;
+    map.emplace(1, 1);
+    map.emplace(2, 2);
+    map.erase(1);
+    EXPECT_EQ(Counter::destroyed, 1);
+  }
+  EXPECT_EQ(Counter::destroyed, 2);
+}
+
+TEST(InlineFlatHashMap, MatchesUnorderedMap) {
+  pw::InlineFlatHashMap<uint32_t, uint32_t, 100> map;
+  std::unordered_map<uint32_t, uint32_t> expected;
+
+  uint32_t state = 1;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t key = (state >> 16) % 256;
+    if ((state >> 8) % 2 == 0 && expected.size() < map.capacity()) {
+      EXPECT_EQ(map.emplace(key, state).second,
+                expected.emplace(key, state).second);
+    } else {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+
+  for (const auto& [key, value] : expected) {
+    EXPECT_EQ(map.at(key), value);
+  }
+}
+
+}  // namespace
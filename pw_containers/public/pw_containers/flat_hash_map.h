@@ -0,0 +1,257 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "pw_allocator/allocator.h"
+#include "pw_assert/assert.h"
+#include "pw_containers/functional.h"
+#include "pw_containers/internal/generic_flat_hash_map.h"
+
+namespace pw {
+
+/// @submodule{pw_containers,maps}
+
+/// Unordered associative container, similar to `std::unordered_map`, that
+/// stores its elements in a single open-addressing table.
+///
+/// `pw::FlatHashMap` has the same API as `pw::DynamicHashMap`, including the
+/// `try_*` operations that return `std::nullopt` or `false` on allocation
+/// failure, but a different storage model:
+///
+/// - Elements are stored inline in one array of slots, with one control byte
+///   per slot, in a single allocation. There is no per-element allocation and
+///   no pointer chasing on lookup.
+/// - Lookups compare a group of control bytes at once, using SSE2 where it is
+///   available or 64-bit integer operations otherwise. Each control byte holds
+///   7 bits of the element's hash, so most non-matching slots are skipped
+///   without comparing keys.
+/// - The maximum load factor is fixed at 7/8.
+/// - Erasing an element does not move other elements, so iterators to other
+///   elements remain valid. Inserting may rehash, which invalidates all
+///   iterators.
+/// - Never allocates in the constructor.
+///
+/// Prefer `pw::DynamicHashMap` when elements are large or must not move in
+/// memory, since `pw::FlatHashMap` relocates elements when it grows. Keys are
+/// copied when the table is rehashed.
+///
+/// @warning The container's allocator MUST outlive the container, unless
+/// `reset()` is called first to free all memory.
+template <typename Key,
+          typename Value,
+          typename Hash = pw::Hash,
+          typename Equal = pw::EqualTo,
+          typename SizeType = uint16_t>
+class FlatHashMap
+    : public containers::internal::GenericFlatHashMap<
+          FlatHashMap<Key, Value, Hash, Equal, SizeType>,
+          Key,
+          Value,
+          Hash,
+          Equal,
+          SizeType> {
+ private:
+  using Base = containers::internal::GenericFlatHashMap<FlatHashMap,
+                                                        Key,
+                                                        Value,
+                                                        Hash,
+                                                        Equal,
+                                                        SizeType>;
+
+ public:
+  using typename Base::size_type;
+  using typename Base::value_type;
+  using allocator_type = Allocator;
+
+  /// Constructs an empty `FlatHashMap`. No memory is allocated.
+  constexpr explicit FlatHashMap(Allocator& allocator,
+                                 const Hash& hash = Hash(),
+                                 const Equal& equal = Equal()) noexcept
+      : Base(hash, equal), allocator_(&allocator) {}
+
+  ~FlatHashMap() { reset(); }
+
+  /// Copy construction/assignment is not supported because they require
+  /// allocations that could fail.
+  FlatHashMap(const FlatHashMap&) = delete;
+  FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+  /// Move construction takes ownership of the table of `other`.
+  FlatHashMap(FlatHashMap&& other) noexcept
+      : Base(other.hash_function(), other.key_eq()),
+        allocator_(other.allocator_) {
+    Base::SwapState(other);
+  }
+
+  /// Move assignment frees the current table and takes ownership of the table
+  /// and allocator of `other`.
+  FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+    if (&other == this) {
+      return *this;
+    }
+    reset();
+    allocator_ = other.allocator_;
+    Base::SwapState(other);
+    return *this;
+  }
+
+  /// Returns the allocator used by this map.
+  allocator_type& get_allocator() const { return *allocator_; }
+
+  /// Returns the number of elements the map can hold without rehashing.
+  size_type capacity() const {
+    return static_cast<size_type>(
+        containers::internal::FlatHashMaxLoad(Base::slot_count()));
+  }
+
+  /// Returns the maximum number of elements, which is limited by `SizeType`.
+  static constexpr size_type max_size() {
+    return static_cast<size_type>(
+        containers::internal::FlatHashMaxLoad(kMaxSlots));
+  }
+
+  /// Destroys all elements and frees the table.
+  void reset() {
+    Base::DestroyAll();
+    Deallocate();
+    Base::Init(nullptr, nullptr, 0);
+  }
+
+  /// Swaps the contents of two maps. No allocations occur.
+  void swap(FlatHashMap& other) noexcept {
+    std::swap(allocator_, other.allocator_);
+    Base::SwapState(other);
+  }
+
+  /// Attempts to set the number of slots to at least `count` and rehash the
+  /// container. Rehashing also reclaims the slots of erased elements. The
+  /// table never shrinks.
+  ///
+  /// @returns `true` if successful, `false` if allocation fails.
+  [[nodiscard]] bool try_rehash(size_type count) {
+    if (count > kMaxSlots) {
+      return false;
+    }
+    size_t slots = containers::internal::FlatHashSlotsFor(Base::size());
+    while (slots < count) {
+      slots *= 2;
+    }
+    if (slots <= Base::slot_count()) {
+      Base::RehashInPlace();
+      return true;
+    }
+    return TryResize(static_cast<size_type>(slots));
+  }
+
+  /// Sets the number of slots to at least `count` and rehashes the container.
+  /// Crashes on allocation failure.
+  void rehash(size_type count) { PW_ASSERT(try_rehash(count)); }
+
+  /// Attempts to make room for at least `count` elements without further
+  /// rehashing.
+  ///
+  /// @returns `true` if successful; `false` if allocation failed.
+  [[nodiscard]] bool try_reserve(size_type count) {
+    if (count <= capacity()) {
+      return true;
+    }
+    if (count > max_size()) {
+      return false;
+    }
+    return TryResize(static_cast<size_type>(
+        containers::internal::FlatHashSlotsFor(count)));
+  }
+
+  /// Reserves enough space for `count` elements. Crashes on allocation
+  /// failure.
+  void reserve(size_type count) { PW_ASSERT(try_reserve(count)); }
+
+ private:
+  friend Base;
+
+  using FlatHashCtrl = containers::internal::FlatHashCtrl;
+
+  // The largest power of two that fits in size_type.
+  static constexpr size_t kMaxSlots =
+      (size_t{std::numeric_limits<size_type>::max()} >> 1) + 1;
+
+  static_assert(kMaxSlots >= containers::internal::FlatHashGroup::kWidth,
+                "SizeType is too small");
+
+  // Called by the base class when the table has no room for a new element.
+  bool TryGrow() {
+    const size_type slots = Base::slot_count();
+
+    // If most of the unusable slots hold erased elements, reclaim them instead
+    // of growing.
+    if (slots > containers::internal::FlatHashGroup::kWidth &&
+        size_t{Base::size()} * 32 <= size_t{slots} * 25) {
+      Base::RehashInPlace();
+      return true;
+    }
+
+    if (slots == 0) {
+      return TryResize(
+          static_cast<size_type>(containers::internal::FlatHashGroup::kWidth));
+    }
+    if (slots >= kMaxSlots) {
+      Base::RehashInPlace();
+      return Base::growth_left() > 0;
+    }
+    return TryResize(static_cast<size_type>(size_t{slots} * 2));
+  }
+
+  // Moves the elements to a new table with `slots` slots.
+  bool TryResize(size_type slots) {
+    // Slots are stored first so that they are aligned, followed by the
+    // control bytes.
+    const size_t slot_bytes = sizeof(value_type) * slots;
+    void* memory = allocator_->Allocate(
+        allocator::Layout(slot_bytes + slots, alignof(value_type)));
+    if (memory == nullptr) {
+      return false;
+    }
+
+    FlatHashCtrl* const old_ctrl = Base::ctrl();
+    value_type* const old_slots = Base::slots();
+    const size_type old_slot_count = Base::slot_count();
+
+    auto* bytes = static_cast<std::byte*>(memory);
+    Base::Init(reinterpret_cast<FlatHashCtrl*>(bytes + slot_bytes),
+               reinterpret_cast<value_type*>(bytes),
+               slots);
+    Base::MoveElementsFrom(old_ctrl, old_slots, old_slot_count);
+
+    if (old_slots != nullptr) {
+      allocator_->Deallocate(old_slots);
+    }
+    return true;
+  }
+
+  void Deallocate() {
+    if (Base::slots() != nullptr) {
+      allocator_->Deallocate(Base::slots());
+    }
+  }
+
+  Allocator* allocator_;
+};
+
+/// @}
+
+}  // namespace pw
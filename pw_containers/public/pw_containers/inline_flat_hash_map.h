@@ -0,0 +1,141 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "pw_containers/functional.h"
+#include "pw_containers/internal/generic_flat_hash_map.h"
+
+namespace pw {
+
+/// @submodule{pw_containers,maps}
+
+/// Fixed-capacity unordered associative container with inline storage.
+///
+/// `pw::InlineFlatHashMap` uses the same open-addressing table as
+/// `pw::FlatHashMap`, but stores it in the object itself, so it never
+/// allocates. It holds up to `kCapacity` elements. The `try_*` operations
+/// return `std::nullopt` when the map is full, and the other insertion
+/// operations crash.
+///
+/// The table is sized so that `kCapacity` elements stay within the 7/8 maximum
+/// load factor. Slots of erased elements are reclaimed by rehashing in place
+/// when needed.
+template <typename Key,
+          typename Value,
+          size_t kCapacity,
+          typename Hash = pw::Hash,
+          typename Equal = pw::EqualTo>
+class InlineFlatHashMap
+    : public containers::internal::GenericFlatHashMap<
+          InlineFlatHashMap<Key, Value, kCapacity, Hash, Equal>,
+          Key,
+          Value,
+          Hash,
+          Equal,
+          std::conditional_t<(kCapacity < 0x7000), uint16_t, uint32_t>> {
+ private:
+  using Base = containers::internal::GenericFlatHashMap<
+      InlineFlatHashMap,
+      Key,
+      Value,
+      Hash,
+      Equal,
+      std::conditional_t<(kCapacity < 0x7000), uint16_t, uint32_t>>;
+
+  static constexpr size_t kSlots =
+      kCapacity == 0 ? 0 : containers::internal::FlatHashSlotsFor(kCapacity);
+
+ public:
+  using typename Base::size_type;
+  using typename Base::value_type;
+
+  explicit InlineFlatHashMap(const Hash& hash = Hash(),
+                             const Equal& equal = Equal())
+      : Base(hash, equal) {
+    Base::Init(ctrl_storage_.data(), slot_data(), kSlots);
+  }
+
+  InlineFlatHashMap(std::initializer_list<value_type> list)
+      : InlineFlatHashMap() {
+    Base::insert(list);
+  }
+
+  InlineFlatHashMap(const InlineFlatHashMap& other)
+      : InlineFlatHashMap(other.hash_function(), other.key_eq()) {
+    Base::insert(other.begin(), other.end());
+  }
+
+  /// Moves the elements of `other` into this map. `other` is left empty.
+  InlineFlatHashMap(InlineFlatHashMap&& other)
+      : InlineFlatHashMap(other.hash_function(), other.key_eq()) {
+    MoveFrom(other);
+  }
+
+  InlineFlatHashMap& operator=(const InlineFlatHashMap& other) {
+    if (&other != this) {
+      Base::clear();
+      Base::insert(other.begin(), other.end());
+    }
+    return *this;
+  }
+
+  InlineFlatHashMap& operator=(InlineFlatHashMap&& other) {
+    if (&other != this) {
+      Base::clear();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~InlineFlatHashMap() { Base::DestroyAll(); }
+
+  static constexpr size_type capacity() { return kCapacity; }
+  static constexpr size_type max_size() { return kCapacity; }
+
+ private:
+  friend Base;
+
+  bool TryGrow() {
+    // The map is not full, so the table must have erased slots to reclaim.
+    Base::RehashInPlace();
+    return Base::growth_left() > 0;
+  }
+
+  void MoveFrom(InlineFlatHashMap& other) {
+    for (auto& [key, value] : other) {
+      Base::emplace(key, std::move(value));
+    }
+    other.clear();
+  }
+
+  value_type* slot_data() {
+    return std::launder(reinterpret_cast<value_type*>(slot_storage_.data()));
+  }
+
+  std::array<containers::internal::FlatHashCtrl, kSlots> ctrl_storage_;
+  alignas(value_type) std::array<std::byte, sizeof(value_type) * kSlots>
+      slot_storage_;
+};
+
+/// @}
+
+}  // namespace pw
@@ -0,0 +1,737 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "lib/stdcompat/bit.h"
+#include "pw_assert/assert.h"
+#include "pw_containers/internal/traits.h"
+#include "pw_preprocessor/compiler.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PW_CONTAINERS_FLAT_HASH_MAP_SSE2 1
+#else
+#define PW_CONTAINERS_FLAT_HASH_MAP_SSE2 0
+#endif  // defined(__SSE2__)
+
+namespace pw::containers::internal {
+
+// Each slot in a flat hash map has a control byte. Full slots store the low 7
+// bits of the element's hash ("H2"), so most mismatches are rejected without
+// comparing keys. Empty and deleted slots have the high bit set.
+using FlatHashCtrl = int8_t;
+
+inline constexpr FlatHashCtrl kFlatHashEmpty = -128;  // 0b10000000
+inline constexpr FlatHashCtrl kFlatHashDeleted = -2;  // 0b11111110
+
+constexpr bool IsFlatHashFull(FlatHashCtrl ctrl) { return ctrl >= 0; }
+
+// Set of slots in a group that matched a query. Each slot is represented by
+// 2^kShift bits, of which only the highest may be set.
+template <typename T, int kShift>
+class FlatHashBitMask {
+ public:
+  constexpr explicit FlatHashBitMask(T mask) : mask_(mask) {}
+
+  constexpr explicit operator bool() const { return mask_ != 0; }
+
+  /// Returns the index within the group of the first matching slot.
+  constexpr size_t Lowest() const {
+    return static_cast<size_t>(cpp20::countr_zero(mask_)) >> kShift;
+  }
+
+  constexpr void RemoveLowest() { mask_ &= static_cast<T>(mask_ - 1); }
+
+ private:
+  T mask_;
+};
+
+#if PW_CONTAINERS_FLAT_HASH_MAP_SSE2
+
+// Compares 16 control bytes at a time with SSE2.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+
+  explicit FlatHashGroup(const FlatHashCtrl* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  FlatHashBitMask<uint32_t, 0> Match(FlatHashCtrl h2) const {
+    return ToMask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+
+  FlatHashBitMask<uint32_t, 0> MatchEmpty() const {
+    return ToMask(_mm_cmpeq_epi8(_mm_set1_epi8(kFlatHashEmpty), ctrl_));
+  }
+
+  FlatHashBitMask<uint32_t, 0> MatchEmptyOrDeleted() const {
+    // Only empty and deleted slots have the high bit set.
+    return ToMask(ctrl_);
+  }
+
+ private:
+  static FlatHashBitMask<uint32_t, 0> ToMask(__m128i bytes) {
+    return FlatHashBitMask<uint32_t, 0>(
+        static_cast<uint32_t>(_mm_movemask_epi8(bytes)));
+  }
+
+  __m128i ctrl_;
+};
+
+#else
+
+// Compares 8 control bytes at a time with 64-bit integer operations.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 8;
+
+  explicit FlatHashGroup(const FlatHashCtrl* ctrl) : ctrl_(Load(ctrl)) {}
+
+  FlatHashBitMask<uint64_t, 3> Match(FlatHashCtrl h2) const {
+    // Finds zero bytes in ctrl_ ^ h2. This may report a false positive for a
+    // byte that follows a true match, but only for full slots, whose keys are
+    // compared anyway.
+    const uint64_t x = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return FlatHashBitMask<uint64_t, 3>((x - kLsbs) & ~x & kMsbs);
+  }
+
+  FlatHashBitMask<uint64_t, 3> MatchEmpty() const {
+    // Empty is the only control byte with the high bit set and bit 1 clear.
+    return FlatHashBitMask<uint64_t, 3>(ctrl_ & ~(ctrl_ << 6) & kMsbs);
+  }
+
+  FlatHashBitMask<uint64_t, 3> MatchEmptyOrDeleted() const {
+    return FlatHashBitMask<uint64_t, 3>(ctrl_ & kMsbs);
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101;
+  static constexpr uint64_t kMsbs = 0x8080808080808080;
+
+  // Loads the group so that slot i is in byte i, regardless of endianness.
+  static uint64_t Load(const FlatHashCtrl* ctrl) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      word |= uint64_t{static_cast<uint8_t>(ctrl[i])} << (8 * i);
+    }
+    return word;
+  }
+
+  uint64_t ctrl_;
+};
+
+#endif  // PW_CONTAINERS_FLAT_HASH_MAP_SSE2
+
+/// Returns the number of elements a table with `slots` slots can hold before
+/// it must be rehashed. The maximum load factor is 7/8, which guarantees that
+/// every probe sequence reaches an empty slot.
+constexpr size_t FlatHashMaxLoad(size_t slots) { return slots - slots / 8; }
+
+/// Returns the smallest valid slot count that can hold `count` elements.
+constexpr size_t FlatHashSlotsFor(size_t count) {
+  size_t slots = FlatHashGroup::kWidth;
+  while (FlatHashMaxLoad(slots) < count) {
+    slots *= 2;
+  }
+  return slots;
+}
+
+/// Common implementation of `pw::FlatHashMap` and `pw::InlineFlatHashMap`.
+///
+/// This class manages an open-addressing hash table in storage provided by the
+/// derived class. The table is an array of slots and an array of control
+/// bytes, both with a power-of-two size that is a multiple of the group width.
+/// Lookups probe whole groups of control bytes at once.
+///
+/// The derived class must provide:
+///
+/// - `size_type max_size() const`: the maximum number of elements.
+/// - `bool TryGrow()`: makes room for at least one more element, returning
+///   false if it cannot.
+///
+/// @warning Keys are copied, rather than moved, when the table is rehashed,
+/// since the stored key is const.
+template <typename Derived,
+          typename Key,
+          typename Value,
+          typename Hash,
+          typename Equal,
+          typename SizeType>
+class GenericFlatHashMap {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = SizeType;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+
+ private:
+  template <bool kIsConst>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = GenericFlatHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<kIsConst, const value_type&, value_type&>;
+    using pointer =
+        std::conditional_t<kIsConst, const value_type*, value_type*>;
+
+    constexpr Iterator() = default;
+
+    template <bool kOtherConst,
+              typename = std::enable_if_t<kIsConst && !kOtherConst>>
+    constexpr Iterator(const Iterator<kOtherConst>& other)
+        : ctrl_(other.ctrl_), end_(other.end_), slot_(other.slot_) {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+
+    Iterator& operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipUnused();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    friend bool operator==(Iterator lhs, Iterator rhs) {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+    friend bool operator!=(Iterator lhs, Iterator rhs) {
+      return lhs.ctrl_ != rhs.ctrl_;
+    }
+
+   private:
+    template <bool>
+    friend class Iterator;
+
+    friend class GenericFlatHashMap;
+
+    Iterator(const FlatHashCtrl* ctrl, const FlatHashCtrl* end, pointer slot)
+        : ctrl_(ctrl), end_(end), slot_(slot) {
+      SkipUnused();
+    }
+
+    void SkipUnused() {
+      while (ctrl_ != end_ && !IsFlatHashFull(*ctrl_)) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const FlatHashCtrl* ctrl_ = nullptr;
+    const FlatHashCtrl* end_ = nullptr;
+    pointer slot_ = nullptr;
+  };
+
+ public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using insert_return_type = std::pair<iterator, bool>;
+
+  // Iterators
+
+  iterator begin() { return iterator(ctrl_, ctrl_ + slot_count_, slots_); }
+  const_iterator begin() const {
+    return const_iterator(ctrl_, ctrl_ + slot_count_, slots_);
+  }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() {
+    return iterator(ctrl_ + slot_count_, ctrl_ + slot_count_, nullptr);
+  }
+  const_iterator end() const {
+    return const_iterator(ctrl_ + slot_count_, ctrl_ + slot_count_, nullptr);
+  }
+  const_iterator cend() const { return end(); }
+
+  // Capacity
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+
+  // Modifiers
+
+  /// Removes all elements from the map. Does not release any memory.
+  void clear() {
+    DestroyAll();
+    Init(ctrl_, slots_, slot_count_);
+  }
+
+  /// Attempts to insert a value into the map.
+  /// @returns An `insert_return_type` on success, or `std::nullopt` if the map
+  /// is full and cannot grow.
+  [[nodiscard]] std::optional<insert_return_type> try_insert(
+      const value_type& value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  // Moving into a fallible insertion is deleted to prevent "ghost moves."
+  // If insertion fails, the object would be moved-from but not stored.
+  // Use try_emplace instead to ensure moves only occur on success.
+  std::optional<insert_return_type> try_insert(value_type&&) = delete;
+
+  /// Inserts a value into the map. Crashes if the map cannot hold it.
+  insert_return_type insert(const value_type& value) {
+    return emplace(value.first, value.second);
+  }
+
+  insert_return_type insert(value_type&& value) {
+    return emplace(std::move(value.first), std::move(value.second));
+  }
+
+  template <typename InputIt,
+            typename = containers::internal::EnableIfInputIterator<InputIt>>
+  void insert(InputIt first, InputIt last) {
+    for (auto it = first; it != last; ++it) {
+      emplace(it->first, it->second);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  /// Attempts to construct an element in-place.
+  /// @returns A pair containing the iterator and success bool, or
+  /// `std::nullopt` if the map is full and cannot grow.
+  template <typename K, typename... Args>
+  [[nodiscard]] std::optional<insert_return_type> try_emplace(K&& key,
+                                                              Args&&... args) {
+    return TryEmplaceImpl(std::forward<K>(key), std::forward<Args>(args)...);
+  }
+
+  /// Constructs an element in-place. Crashes if the map cannot hold it.
+  template <typename K, typename... Args>
+  insert_return_type emplace(K&& key, Args&&... args) {
+    auto result =
+        try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    PW_ASSERT(result.has_value());
+    return result.value();
+  }
+
+  /// Removes the element at `pos`. Other elements are not moved, so iterators
+  /// to them remain valid.
+  ///
+  /// @returns Iterator following the removed element.
+  iterator erase(const_iterator pos) {
+    PW_ASSERT(pos != end());
+    const size_type index = static_cast<size_type>(pos.ctrl_ - ctrl_);
+    EraseAt(index);
+    return iterator(ctrl_ + index + 1, ctrl_ + slot_count_, slots_ + index + 1);
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  /// Removes elements in the range `[first, last)`.
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    const size_type index = static_cast<size_type>(last.ctrl_ - ctrl_);
+    return iterator(ctrl_ + index, ctrl_ + slot_count_, slots_ + index);
+  }
+
+  /// Removes the element with the matching key. Returns number of elements
+  /// removed (0 or 1).
+  size_type erase(const key_type& key) {
+    const size_type index = FindIndex(key);
+    if (index == kNotFound) {
+      return 0;
+    }
+    EraseAt(index);
+    return 1;
+  }
+
+  // Lookup
+
+  /// Returns a reference to the mapped value of the element with key equivalent
+  /// to `key`.
+  ///
+  /// @pre The key must exist in the map. Crashes if not found.
+  mapped_type& at(const key_type& key) {
+    auto it = find(key);
+    PW_ASSERT(it != end());
+    return it->second;
+  }
+
+  const mapped_type& at(const key_type& key) const {
+    auto it = find(key);
+    PW_ASSERT(it != end());
+    return it->second;
+  }
+
+  /// Returns a reference to the value associated with `key`. If `key` does not
+  /// exist, it is inserted via a default-constructed value.
+  ///
+  /// @pre The map must be able to hold a new element. Crashes on failure.
+  template <typename U = mapped_type,
+            typename = std::enable_if_t<std::is_default_constructible_v<U>>>
+  mapped_type& operator[](const key_type& key) {
+    return emplace(key).first->second;
+  }
+
+  /// Returns the number of elements with key `key` (0 or 1).
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+  /// Finds an element with key equivalent to `key`.
+  /// @returns Iterator to an element with key equivalent to `key`, or `end()`
+  /// if no such element is found.
+  iterator find(const key_type& key) {
+    const size_type index = FindIndex(key);
+    if (index == kNotFound) {
+      return end();
+    }
+    return iterator(ctrl_ + index, ctrl_ + slot_count_, slots_ + index);
+  }
+
+  const_iterator find(const key_type& key) const {
+    const size_type index = FindIndex(key);
+    if (index == kNotFound) {
+      return end();
+    }
+    return const_iterator(ctrl_ + index, ctrl_ + slot_count_, slots_ + index);
+  }
+
+  /// Checks if there is an element with key equivalent to `key` in the
+  /// container.
+  bool contains(const key_type& key) const {
+    return FindIndex(key) != kNotFound;
+  }
+
+  /// Returns a range containing all elements with the given key in the
+  /// container. Since this is a unique map, the range will contain at most one
+  /// element.
+  std::pair<iterator, iterator> equal_range(const key_type& key) {
+    auto it = find(key);
+    if (it == end()) {
+      return std::make_pair(it, it);
+    }
+    return std::make_pair(it, std::next(it));
+  }
+
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type& key) const {
+    auto it = find(key);
+    if (it == end()) {
+      return std::make_pair(it, it);
+    }
+    return std::make_pair(it, std::next(it));
+  }
+
+  // Hash policy
+
+  /// Returns the number of slots in the table.
+  size_type bucket_count() const { return slot_count_; }
+
+  /// Returns the current load factor (ratio of elements to slots) as a
+  /// percentage.
+  size_type load_factor_percent() const {
+    if (slot_count_ == 0) {
+      return 0;
+    }
+    return static_cast<size_type>((size_t{size_} * 100) / slot_count_);
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+ protected:
+  static constexpr size_type kNotFound = static_cast<size_type>(-1);
+
+  constexpr GenericFlatHashMap(const Hash& hash, const Equal& equal)
+      : hash_(hash), equal_(equal) {}
+
+  ~GenericFlatHashMap() = default;
+
+  /// Points the map at empty storage with `slot_count` slots. Any elements in
+  /// the previous storage must already have been destroyed or moved.
+  void Init(FlatHashCtrl* ctrl, value_type* slots, size_type slot_count) {
+    ctrl_ = ctrl;
+    slots_ = slots;
+    slot_count_ = slot_count;
+    size_ = 0;
+    growth_left_ = static_cast<size_type>(FlatHashMaxLoad(slot_count));
+    for (size_type i = 0; i < slot_count; ++i) {
+      ctrl_[i] = kFlatHashEmpty;
+    }
+  }
+
+  /// Moves every element from the given storage into this map's storage,
+  /// which must be empty and large enough to hold them.
+  void MoveElementsFrom(FlatHashCtrl* ctrl,
+                        value_type* slots,
+                        size_type slot_count) {
+    for (size_type i = 0; i < slot_count; ++i) {
+      if (!IsFlatHashFull(ctrl[i])) {
+        continue;
+      }
+      const size_t hash = HashOf(slots[i].first);
+      const size_type index = FindFirstNonFull(hash);
+      Relocate(slots[i], slots_[index]);
+      SetCtrl(index, hash);
+      --growth_left_;
+      ++size_;
+    }
+  }
+
+  /// Rehashes the table into its existing storage, which reclaims the slots
+  /// of erased elements.
+  void RehashInPlace();
+
+  /// Destroys all elements without updating the control bytes.
+  void DestroyAll() {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (size_type i = 0; i < slot_count_; ++i) {
+        if (IsFlatHashFull(ctrl_[i])) {
+          std::destroy_at(&slots_[i]);
+        }
+      }
+    }
+  }
+
+  void SwapState(GenericFlatHashMap& other) {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(slot_count_, other.slot_count_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+  }
+
+  FlatHashCtrl* ctrl() const { return ctrl_; }
+  value_type* slots() const { return slots_; }
+  size_type slot_count() const { return slot_count_; }
+  size_type growth_left() const { return growth_left_; }
+
+ private:
+  // Visits groups in the order h1, h1 + 1, h1 + 3, h1 + 6, ... which covers
+  // every group when the number of groups is a power of two.
+  class ProbeSequence {
+   public:
+    ProbeSequence(size_t hash, size_type slot_count)
+        : mask_(static_cast<size_t>(slot_count) - 1),
+          offset_(((hash >> 7) * FlatHashGroup::kWidth) & mask_) {}
+
+    size_type offset() const { return static_cast<size_type>(offset_); }
+
+    void Next() {
+      step_ += FlatHashGroup::kWidth;
+      offset_ = (offset_ + step_) & mask_;
+    }
+
+   private:
+    size_t mask_;
+    size_t offset_;
+    size_t step_ = 0;
+  };
+
+  Derived& derived() { return static_cast<Derived&>(*this); }
+
+  // Hashes a key. pw::Hash and std::hash are often close to the identity for
+  // integers, so the result is mixed so that both the probe start and H2
+  // depend on every bit of the key's hash.
+  size_t HashOf(const key_type& key) const {
+    const uint64_t hash =
+        static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  static FlatHashCtrl H2(size_t hash) {
+    return static_cast<FlatHashCtrl>(hash & 0x7F);
+  }
+
+  void SetCtrl(size_type index, size_t hash) { ctrl_[index] = H2(hash); }
+
+  static void Relocate(value_type& from, value_type& to) {
+    new (&to) value_type(std::move(from));
+    std::destroy_at(&from);
+  }
+
+  size_type FindIndex(const key_type& key) const {
+    if (slot_count_ == 0) {
+      return kNotFound;
+    }
+    const size_t hash = HashOf(key);
+    const FlatHashCtrl h2 = H2(hash);
+    for (ProbeSequence seq(hash, slot_count_);; seq.Next()) {
+      const FlatHashGroup group(ctrl_ + seq.offset());
+      for (auto match = group.Match(h2); match; match.RemoveLowest()) {
+        const size_type index =
+            static_cast<size_type>(seq.offset() + match.Lowest());
+        if (equal_(slots_[index].first, key)) {
+          return index;
+        }
+      }
+      if (group.MatchEmpty()) {
+        return kNotFound;
+      }
+    }
+  }
+
+  // Returns the first empty or deleted slot in the key's probe sequence.
+  size_type FindFirstNonFull(size_t hash) const {
+    for (ProbeSequence seq(hash, slot_count_);; seq.Next()) {
+      const FlatHashGroup group(ctrl_ + seq.offset());
+      if (const auto match = group.MatchEmptyOrDeleted(); match) {
+        return static_cast<size_type>(seq.offset() + match.Lowest());
+      }
+    }
+  }
+
+  template <typename K, typename... Args>
+  std::optional<insert_return_type> TryEmplaceImpl(K&& key, Args&&... args) {
+    const key_type& lookup_key = key;
+    if (const size_type index = FindIndex(lookup_key); index != kNotFound) {
+      return std::make_pair(
+          iterator(ctrl_ + index, ctrl_ + slot_count_, slots_ + index), false);
+    }
+
+    if (size_ >= derived().max_size()) {
+      return std::nullopt;
+    }
+
+    const size_t hash = HashOf(lookup_key);
+    size_type index = slot_count_ == 0 ? 0 : FindFirstNonFull(hash);
+
+    // A deleted slot can be reused without consuming growth.
+    if (growth_left_ == 0 &&
+        (slot_count_ == 0 || ctrl_[index] != kFlatHashDeleted)) {
+      if (!derived().TryGrow()) {
+        return std::nullopt;
+      }
+      index = FindFirstNonFull(hash);
+    }
+
+    if (ctrl_[index] == kFlatHashEmpty) {
+      --growth_left_;
+    }
+    new (&slots_[index])
+        value_type(std::piecewise_construct,
+                   std::forward_as_tuple(std::forward<K>(key)),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+    SetCtrl(index, hash);
+    ++size_;
+    return std::make_pair(
+        iterator(ctrl_ + index, ctrl_ + slot_count_, slots_ + index), true);
+  }
+
+  void EraseAt(size_type index) {
+    std::destroy_at(&slots_[index]);
+    --size_;
+
+    // If the slot's group has an empty slot, the group has never been full, so
+    // no probe sequence continues past it and the slot can be marked empty.
+    // Otherwise, it is marked deleted to keep later probes going.
+    const size_type group_start =
+        static_cast<size_type>(index & ~(FlatHashGroup::kWidth - 1));
+    if (FlatHashGroup(ctrl_ + group_start).MatchEmpty()) {
+      ctrl_[index] = kFlatHashEmpty;
+      ++growth_left_;
+    } else {
+      ctrl_[index] = kFlatHashDeleted;
+    }
+  }
+
+  FlatHashCtrl* ctrl_ = nullptr;
+  value_type* slots_ = nullptr;
+  size_type slot_count_ = 0;
+  size_type size_ = 0;
+
+  // Number of empty slots that may be filled before the table must grow.
+  size_type growth_left_ = 0;
+
+  PW_NO_UNIQUE_ADDRESS Hash hash_;
+  PW_NO_UNIQUE_ADDRESS Equal equal_;
+};
+
+// Template method implementations.
+
+template <typename Derived,
+          typename Key,
+          typename Value,
+          typename Hash,
+          typename Equal,
+          typename SizeType>
+void GenericFlatHashMap<Derived, Key, Value, Hash, Equal, SizeType>::
+    RehashInPlace() {
+  // Mark full slots as deleted to track which elements still need to be
+  // placed, and free the slots of erased elements.
+  for (size_type i = 0; i < slot_count_; ++i) {
+    ctrl_[i] = IsFlatHashFull(ctrl_[i]) ? kFlatHashDeleted : kFlatHashEmpty;
+  }
+
+  alignas(value_type) std::byte temp_storage[sizeof(value_type)];
+  auto& temp = *reinterpret_cast<value_type*>(temp_storage);
+
+  for (size_type i = 0; i < slot_count_; ++i) {
+    if (ctrl_[i] != kFlatHashDeleted) {
+      continue;
+    }
+    const size_t hash = HashOf(slots_[i].first);
+    const size_type target = FindFirstNonFull(hash);
+    constexpr size_type kGroupMask =
+        static_cast<size_type>(~(FlatHashGroup::kWidth - 1));
+
+    // Every group before the target's group is full of placed elements, so an
+    // element already in the target group can stay where it is.
+    if ((i & kGroupMask) == (target & kGroupMask)) {
+      SetCtrl(i, hash);
+      continue;
+    }
+
+    if (ctrl_[target] == kFlatHashEmpty) {
+      Relocate(slots_[i], slots_[target]);
+      SetCtrl(target, hash);
+      ctrl_[i] = kFlatHashEmpty;
+      continue;
+    }
+
+    // The target holds an element that has not been placed yet. Swap it into
+    // this slot and process this slot again.
+    Relocate(slots_[i], temp);
+    Relocate(slots_[target], slots_[i]);
+    Relocate(temp, slots_[target]);
+    SetCtrl(target, hash);
+    --i;
+  }
+
+  growth_left_ =
+      static_cast<size_type>(FlatHashMaxLoad(slot_count_) - size_);
+}
+
+}  // namespace pw::containers::internal
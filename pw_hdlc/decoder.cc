@@ -14,6 +14,9 @@
 
 #include "pw_hdlc/decoder.h"
 
+#include <cstdint>
+#include <cstring>
+
 #include "pw_assert/check.h"
 #include "pw_bytes/endian.h"
 #include "pw_hdlc/internal/protocol.h"
@@ -39,6 +42,44 @@ Result<Frame> Frame::Parse(ConstByteSpan frame) {
                frame.subspan(address_size + 1, static_cast<size_t>(data_size)));
 }
 
+namespace {
+
+constexpr uint64_t EveryByte(uint8_t value) {
+  return uint64_t{value} * 0x0101010101010101u;
+}
+
+// True if any byte in the word is zero.
+constexpr bool HasZeroByte(uint64_t word) {
+  return ((word - EveryByte(0x01)) & ~word & EveryByte(0x80)) != 0;
+}
+
+// Returns the index of the first flag byte in data, or data.size() if there is
+// none. If include_escape is true, escape bytes are also matched. Scans eight
+// bytes at a time.
+size_t FindControlByte(ConstByteSpan data, bool include_escape) {
+  constexpr uint64_t kFlags = EveryByte(static_cast<uint8_t>(kFlag));
+  constexpr uint64_t kEscapes = EveryByte(static_cast<uint8_t>(kEscape));
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, &data[i], sizeof(word));
+    if (HasZeroByte(word ^ kFlags) ||
+        (include_escape && HasZeroByte(word ^ kEscapes))) {
+      break;
+    }
+  }
+
+  for (; i < data.size(); ++i) {
+    if (data[i] == kFlag || (include_escape && data[i] == kEscape)) {
+      return i;
+    }
+  }
+  return data.size();
+}
+
+}  // namespace
+
 Result<Frame> Decoder::Process(const byte new_byte) {
   switch (state_) {
     case State::kInterFrame: {
@@ -101,6 +142,65 @@ Result<Frame> Decoder::Process(const byte new_byte) {
   PW_CRASH("Bad decoder state");
 }
 
+size_t Decoder::ProcessRun(ConstByteSpan data) {
+  switch (state_) {
+    case State::kInterFrame: {
+      // Discard everything up to the next flag, counting the discarded bytes.
+      const size_t run = FindControlByte(data, /*include_escape=*/false);
+      current_frame_size_ += run;
+      return run;
+    }
+    case State::kFrame: {
+      const size_t run = FindControlByte(data, /*include_escape=*/true);
+      AppendBytes(data.first(run));
+      return run;
+    }
+    case State::kFrameEscape:
+      return 0;
+  }
+  PW_CRASH("Bad decoder state");
+}
+
+void Decoder::AppendBytes(ConstByteSpan data) {
+  // Short runs do not eject every byte in the ring buffer, so handle them one
+  // byte at a time.
+  if (data.size() < last_read_bytes_.size()) {
+    for (byte b : data) {
+      AppendByte(b);
+    }
+    return;
+  }
+
+  if (current_frame_size_ < max_size()) {
+    const size_t to_copy =
+        std::min(data.size(), max_size() - current_frame_size_);
+    std::memcpy(&buffer_[current_frame_size_], data.data(), to_copy);
+  }
+
+  // Every byte in the ring buffer is ejected, oldest first. Until the ring
+  // buffer fills, its oldest byte is at index 0.
+  const size_t buffered =
+      std::min(current_frame_size_, last_read_bytes_.size());
+  size_t index = current_frame_size_ < last_read_bytes_.size()
+                     ? 0
+                     : last_read_bytes_index_;
+  for (size_t i = 0; i < buffered; ++i) {
+    fcs_.Update(last_read_bytes_[index]);
+    index = (index + 1) % last_read_bytes_.size();
+  }
+
+  // All but the last bytes of the run are checksummed. The last bytes are
+  // retained in case they are the FCS.
+  const size_t checksummed = data.size() - last_read_bytes_.size();
+  fcs_.Update(data.first(checksummed));
+  std::memcpy(last_read_bytes_.data(),
+              &data[checksummed],
+              last_read_bytes_.size());
+  last_read_bytes_index_ = 0;
+
+  current_frame_size_ += data.size();
+}
+
 void Decoder::AppendByte(byte new_byte) {
   if (current_frame_size_ < max_size()) {
     buffer_[current_frame_size_] = new_byte;
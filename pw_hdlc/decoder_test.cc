@@ -14,12 +14,16 @@
 
 #include "pw_hdlc/decoder.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstring>
 
 #include "pw_bytes/array.h"
 #include "pw_fuzzer/fuzztest.h"
+#include "pw_hdlc/encoder.h"
 #include "pw_hdlc/internal/protocol.h"
+#include "pw_stream/memory_stream.h"
 #include "pw_unit_test/framework.h"
 
 namespace pw::hdlc {
@@ -154,6 +158,149 @@ TEST(Decoder, TooLargeForBuffer_DecodesNextFrame) {
   EXPECT_EQ(OkStatus(), decoder.Process(kFlag).status());
 }
 
+// Records the frames and errors reported by a decoder.
+class Outcomes {
+ public:
+  static constexpr size_t kMaxOutcomes = 64;
+  static constexpr size_t kMaxFrameData = 128;
+
+  void Add(const Result<Frame>& result) {
+    ASSERT_LT(count_, kMaxOutcomes);
+    Outcome& outcome = outcomes_[count_++];
+    outcome.status = result.status();
+    if (result.ok()) {
+      outcome.address = result->address();
+      outcome.control = result->control();
+      outcome.data_size = result->data().size();
+      ASSERT_LE(outcome.data_size, kMaxFrameData);
+      std::memcpy(
+          outcome.data.data(), result->data().data(), outcome.data_size);
+    }
+  }
+
+  size_t count() const { return count_; }
+
+  void ExpectEq(const Outcomes& other) const {
+    ASSERT_EQ(count_, other.count_);
+    for (size_t i = 0; i < count_; ++i) {
+      const Outcome& a = outcomes_[i];
+      const Outcome& b = other.outcomes_[i];
+      EXPECT_EQ(a.status, b.status) << "outcome " << i;
+      EXPECT_EQ(a.address, b.address) << "outcome " << i;
+      EXPECT_EQ(a.control, b.control) << "outcome " << i;
+      ASSERT_EQ(a.data_size, b.data_size) << "outcome " << i;
+      EXPECT_TRUE(std::equal(a.data.begin(),
+                             a.data.begin() + a.data_size,
+                             b.data.begin()))
+          << "outcome " << i;
+    }
+  }
+
+ private:
+  struct Outcome {
+    Status status;
+    uint64_t address = 0;
+    byte control{};
+    size_t data_size = 0;
+    std::array<byte, kMaxFrameData> data{};
+  };
+
+  std::array<Outcome, kMaxOutcomes> outcomes_;
+  size_t count_ = 0;
+};
+
+template <size_t kBufferSize>
+Outcomes DecodeByteByByte(ConstByteSpan data) {
+  DecoderBuffer<kBufferSize> decoder;
+  Outcomes outcomes;
+  for (byte b : data) {
+    Result<Frame> result = decoder.Process(b);
+    if (result.status() != Status::Unavailable()) {
+      outcomes.Add(result);
+    }
+  }
+  return outcomes;
+}
+
+// Decodes data with the span-based Process, passing chunk_size bytes per call.
+template <size_t kBufferSize>
+Outcomes DecodeInChunks(ConstByteSpan data, size_t chunk_size) {
+  DecoderBuffer<kBufferSize> decoder;
+  Outcomes outcomes;
+  while (!data.empty()) {
+    const size_t size = std::min(chunk_size, data.size());
+    decoder.Process(data.first(size), [&outcomes](const Result<Frame>& r) {
+      outcomes.Add(r);
+    });
+    data = data.subspan(size);
+  }
+  return outcomes;
+}
+
+template <size_t kBufferSize>
+void ExpectBulkMatchesByteByByte(ConstByteSpan data) {
+  const Outcomes expected = DecodeByteByByte<kBufferSize>(data);
+  for (size_t chunk_size = 1; chunk_size <= data.size(); ++chunk_size) {
+    DecodeInChunks<kBufferSize>(data, chunk_size).ExpectEq(expected);
+  }
+}
+
+// Frames from the tests above, plus escaped data, bytes between frames, and
+// invalid escape sequences.
+constexpr auto kMixedStream = bytes::Concat(
+    bytes::String("~1234\xa3\xe0\xe3\x9b~"),
+    bytes::String("~12345678901234567890\xf2\x19\x63\x90~"),
+    bytes::String("garbage~12\xcd\x44\x53\x4f~~~"),
+    bytes::String("~1234\x7d\x5e\x7d\x5d" "5678\xa3\xe0~"),
+    bytes::String("~1234\x7d\x7d" "5678~~1234\x7d~"),
+    bytes::String("~12345\x1c\x3a\xf5\xcb~1234\xa3\xe0\xe3\x9b~12"));
+
+TEST(Decoder, BulkProcessMatchesByteByByte_MixedStream) {
+  ExpectBulkMatchesByteByByte<8>(kMixedStream);
+  ExpectBulkMatchesByteByByte<64>(kMixedStream);
+}
+
+TEST(Decoder, BulkProcessMatchesByteByByte_EncodedFrames) {
+  // Payloads full of flag and escape bytes, so frames contain many escapes.
+  std::array<byte, 1024> stream_buffer;
+  stream::MemoryWriter writer(stream_buffer);
+
+  uint32_t state = 0x2b4e;
+  for (size_t frame = 0; frame < 12; ++frame) {
+    std::array<byte, 48> payload;
+    const size_t payload_size = frame * 4;
+    for (size_t i = 0; i < payload_size; ++i) {
+      state = state * 1664525u + 1013904223u;
+      const uint8_t value = static_cast<uint8_t>(state >> 24);
+      payload[i] = value < 64 ? kFlag : value < 128 ? kEscape : byte{value};
+    }
+    ASSERT_EQ(OkStatus(),
+              WriteUIFrame(frame * 37,
+                           span(payload).first(payload_size),
+                           writer));
+  }
+
+  const Outcomes expected = DecodeByteByByte<64>(writer.WrittenData());
+  EXPECT_EQ(expected.count(), 12u);
+
+  ExpectBulkMatchesByteByByte<16>(writer.WrittenData());
+  ExpectBulkMatchesByteByByte<64>(writer.WrittenData());
+}
+
+void BulkProcessMatchesByteByByte(ConstByteSpan data, size_t chunk_size) {
+  DecodeInChunks<32>(data, chunk_size).ExpectEq(DecodeByteByByte<32>(data));
+}
+
+FUZZ_TEST(Decoder, BulkProcessMatchesByteByByte)
+    .WithDomains(VectorOf<1024>(ElementOf<byte>({kFlag,
+                                                 kEscape,
+                                                 byte{0x5e},
+                                                 byte{0x5d},
+                                                 byte{0x00},
+                                                 byte{0x31},
+                                                 byte{0xff}})),
+                 InRange<size_t>(1, 64));
+
 void ProcessNeverCrashes(ConstByteSpan data) {
   DecoderBuffer<1024> decoder;
   for (byte b : data) {
@@ -103,10 +103,20 @@ class Decoder {
 
   /// @brief Processes a span of data and calls the provided callback with each
   /// frame or error.
+  ///
+  /// Produces the same frames and errors as calling `Process(std::byte)` for
+  /// each byte, but copies and checksums runs of unescaped frame data in bulk.
   template <typename F, typename... Args>
   void Process(ConstByteSpan data, F&& callback, Args&&... args) {
-    for (std::byte b : data) {
-      auto result = Process(b);
+    while (true) {
+      // Consume bytes that cannot complete a frame in bulk, then process the
+      // flag or escape byte that ended the run.
+      data = data.subspan(ProcessRun(data));
+      if (data.empty()) {
+        return;
+      }
+      auto result = Process(data.front());
+      data = data.subspan(1);
       if (result.status() != Status::Unavailable()) {
         callback(std::forward<Args>(args)..., result);
       }
@@ -136,8 +146,16 @@ class Decoder {
     fcs_.clear();
   }
 
+  // Consumes the longest prefix of data that does not contain a flag or escape
+  // byte, if the decoder is in a state where those bytes cannot complete a
+  // frame. Returns the number of bytes consumed.
+  size_t ProcessRun(ConstByteSpan data);
+
   void AppendByte(std::byte new_byte);
 
+  // Equivalent to calling AppendByte for each byte in data.
+  void AppendBytes(ConstByteSpan data);
+
   Status CheckFrame() const;
 
   bool VerifyFrameCheckSequence() const;
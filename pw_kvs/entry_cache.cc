@@ -17,7 +17,9 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <mutex>
 
 #include "pw_assert/check.h"
 #include "pw_kvs/flash_memory.h"
@@ -60,62 +62,66 @@ void EntryMetadata::Reset(const KeyDescriptor& descriptor, Address address) {
   addresses_ = addresses_.first(1);
 }
 
-StatusWithSize EntryCache::Find(FlashPartition& partition,
-                                const Sectors& sectors,
-                                const EntryFormats& formats,
-                                std::string_view key,
-                                EntryMetadata* metadata) const {
+StatusWithSize EntryCache::Find(
+    FlashPartition& partition,
+    const Sectors& sectors,
+    const EntryFormats& formats,
+    std::string_view key,
+    EntryMetadata* metadata,
+    sync::VirtualBasicLockable& shared_state_lock) const {
   const uint32_t hash = internal::Hash(key);
+
+  // Key hashes are unique within the cache, so at most one descriptor matches.
+  const int index = FindIndex(hash);
+  if (index == -1) {
+    return StatusWithSize::NotFound();
+  }
+  const size_t i = static_cast<size_t>(index);
+
   Entry::KeyBuffer key_buffer;
   bool error_detected = false;
+  bool key_found = false;
+  std::string_view read_key;
 
-  for (size_t i = 0; i < descriptors_.size(); ++i) {
-    if (descriptors_[i].key_hash == hash) {
-      bool key_found = false;
-      std::string_view read_key;
-
-      for (Address address : addresses(i)) {
-        Status read_result =
-            Entry::ReadKey(partition, address, key.size(), key_buffer.data());
-
-        read_key = std::string_view(key_buffer.data(), key.size());
-
-        if (read_result.ok() && hash == internal::Hash(read_key)) {
-          key_found = true;
-          break;
-        } else {
-          // A hash mismatch can be caused by reading invalid data or a key hash
-          // collision of keys with differing size. To verify the data read from
-          // flash is good, validate the entry.
-          Entry entry;
-          read_result = Entry::Read(partition, address, formats, &entry);
-          if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
-            key_found = true;
-            break;
-          }
-
-          PW_LOG_WARN(
-              "   Found corrupt entry, invalidating this copy of the key");
-          error_detected = true;
-          sectors.FromAddress(address).mark_corrupt();
-        }
-      }
-      size_t error_val = error_detected ? 1 : 0;
-
-      if (!key_found) {
-        PW_LOG_ERROR("No valid entries for key. Data has been lost!");
-        return StatusWithSize::DataLoss(error_val);
-      } else if (key == read_key) {
-        PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
-        *metadata = EntryMetadata(descriptors_[i], addresses(i));
-        return StatusWithSize(error_val);
-      } else {
-        PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
-        return StatusWithSize::AlreadyExists(error_val);
+  for (Address address : addresses(i)) {
+    Status read_result =
+        Entry::ReadKey(partition, address, key.size(), key_buffer.data());
+
+    read_key = std::string_view(key_buffer.data(), key.size());
+
+    if (read_result.ok() && hash == internal::Hash(read_key)) {
+      key_found = true;
+      break;
+    } else {
+      // A hash mismatch can be caused by reading invalid data or a key hash
+      // collision of keys with differing size. To verify the data read from
+      // flash is good, validate the entry.
+      std::lock_guard lock(shared_state_lock);
+      Entry entry;
+      read_result = Entry::Read(partition, address, formats, &entry);
+      if (read_result.ok() && entry.VerifyChecksumInFlash().ok()) {
+        key_found = true;
+        break;
       }
+
+      PW_LOG_WARN("   Found corrupt entry, invalidating this copy of the key");
+      error_detected = true;
+      sectors.FromAddress(address).mark_corrupt();
     }
   }
-  return StatusWithSize::NotFound();
+  size_t error_val = error_detected ? 1 : 0;
+
+  if (!key_found) {
+    PW_LOG_ERROR("No valid entries for key. Data has been lost!");
+    return StatusWithSize::DataLoss(error_val);
+  } else if (key == read_key) {
+    PW_LOG_DEBUG("Found match for key hash 0x%08" PRIx32, hash);
+    *metadata = EntryMetadata(descriptors_[i], addresses(i));
+    return StatusWithSize(error_val);
+  } else {
+    PW_LOG_WARN("Found key hash collision for 0x%08" PRIx32, hash);
+    return StatusWithSize::AlreadyExists(error_val);
+  }
 }
 
 EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
@@ -123,6 +129,7 @@ EntryMetadata EntryCache::AddNew(const KeyDescriptor& descriptor,
   // TODO(hepler): DCHECK(!full());
   Address* first_address = ResetAddresses(descriptors_.size(), address);
   descriptors_.push_back(descriptor);
+  IndexInsert(descriptors_.size() - 1);
   return EntryMetadata(descriptors_.back(), span(first_address, 1));
 }
 
@@ -138,7 +145,15 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
   // deleted descriptor's space and then pops the last entry.
   Address* addresses_at_end = first_address(descriptors_.size() - 1);
 
+  // Update the key index while the descriptors are still in place.
+  IndexRemove(index_to_remove);
+
   if (index_to_remove < descriptors_.size() - 1) {
+    if (has_key_index()) {
+      key_index_[IndexSlotOf(last_desc.key_hash)] =
+          static_cast<IndexSlot>(index_to_remove + 1);
+    }
+
     Address* addresses_to_remove = first_address(index_to_remove);
     for (unsigned int i = 0; i < redundancy_; i++) {
       addresses_to_remove[i] = addresses_at_end[i];
@@ -152,10 +167,10 @@ EntryCache::iterator EntryCache::RemoveEntry(iterator& entry_it) {
   return {this, descriptors_.data() + index_to_remove};
 }
 
-// TODO(hepler): This method is the trigger of the O(valid_entries *
-// all_entries) time complexity for reading. At some cost to memory, this could
-// be optimized by using a hash table instead of scanning, but in practice this
-// should be fine for a small number of keys
+// Without a key index, this method is the trigger of the O(valid_entries *
+// all_entries) time complexity for reading, since FindIndex scans all
+// descriptors. This is fine for a small number of keys; larger caches should
+// use a key index.
 Status EntryCache::AddNewOrUpdateExisting(const KeyDescriptor& descriptor,
                                           Address address,
                                           size_t sector_size_bytes) const {
@@ -221,7 +236,26 @@ size_t EntryCache::present_entries() const {
   return present_entries;
 }
 
+void EntryCache::Reset() const {
+  descriptors_.clear();
+  std::fill(key_index_.begin(), key_index_.end(), IndexSlot{0});
+}
+
 int EntryCache::FindIndex(uint32_t key_hash) const {
+  if (has_key_index()) {
+    // The key index has more slots than descriptors, so the probe always
+    // reaches an empty slot.
+    for (size_t slot = IndexHome(key_hash);; slot = NextIndexSlot(slot)) {
+      const IndexSlot entry = key_index_[slot];
+      if (entry == 0u) {
+        return -1;
+      }
+      if (descriptors_[entry - 1u].key_hash == key_hash) {
+        return static_cast<int>(entry - 1u);
+      }
+    }
+  }
+
   for (size_t i = 0; i < descriptors_.size(); ++i) {
     if (descriptors_[i].key_hash == key_hash) {
       return static_cast<int>(i);
@@ -230,6 +264,49 @@ int EntryCache::FindIndex(uint32_t key_hash) const {
   return -1;
 }
 
+size_t EntryCache::IndexSlotOf(uint32_t key_hash) const {
+  size_t slot = IndexHome(key_hash);
+  while (descriptors_[key_index_[slot] - 1u].key_hash != key_hash) {
+    slot = NextIndexSlot(slot);
+  }
+  return slot;
+}
+
+void EntryCache::IndexInsert(size_t descriptor_index) const {
+  if (!has_key_index()) {
+    return;
+  }
+  size_t slot = IndexHome(descriptors_[descriptor_index].key_hash);
+  while (key_index_[slot] != 0u) {
+    slot = NextIndexSlot(slot);
+  }
+  key_index_[slot] = static_cast<IndexSlot>(descriptor_index + 1);
+}
+
+void EntryCache::IndexRemove(size_t descriptor_index) const {
+  if (!has_key_index()) {
+    return;
+  }
+
+  // Remove with backward shift deletion: move later entries in the probe
+  // sequence into the hole unless that would place them before their home
+  // slot. This keeps every probe sequence free of holes without tombstones.
+  size_t hole = IndexSlotOf(descriptors_[descriptor_index].key_hash);
+  for (size_t slot = NextIndexSlot(hole); key_index_[slot] != 0u;
+       slot = NextIndexSlot(slot)) {
+    const size_t home =
+        IndexHome(descriptors_[key_index_[slot] - 1u].key_hash);
+    // The entry can move if its home is not cyclically within (hole, slot].
+    const bool home_in_range = hole <= slot ? (hole < home && home <= slot)
+                                            : (hole < home || home <= slot);
+    if (!home_in_range) {
+      key_index_[hole] = key_index_[slot];
+      hole = slot;
+    }
+  }
+  key_index_[hole] = 0;
+}
+
 void EntryCache::AddAddressIfRoom(size_t descriptor_index,
                                   Address address) const {
   Address* const existing = first_address(descriptor_index);
@@ -14,6 +14,8 @@
 
 #include "pw_kvs/internal/entry_cache.h"
 
+#include <array>
+
 #include "pw_bytes/array.h"
 #include "pw_kvs/fake_flash_memory.h"
 #include "pw_kvs/flash_memory.h"
@@ -194,6 +196,109 @@ TEST_F(EmptyEntryCache, Iterator_Const_CanBeAssignedFromMutable) {
   EXPECT_EQ(99u, it->first_address());
 }
 
+class IndexedEntryCache : public ::testing::Test {
+ protected:
+  static constexpr size_t kMaxEntries = 32;
+  static constexpr size_t kRedundancy = 1;
+  static constexpr size_t kIndexSlots = 64;
+
+  IndexedEntryCache()
+      : entries_(descriptors_, addresses_, kRedundancy, key_index_) {
+    entries_.Reset();
+  }
+
+  // True if the cache has an entry with this hash. Adding an older entry for
+  // an existing key is ignored, so this only modifies the cache if the hash is
+  // missing, in which case the new entry is removed again.
+  bool Contains(uint32_t key_hash) {
+    const size_t before = entries_.total_entries();
+    const Status status = entries_.AddNewOrUpdateExisting(
+        {key_hash, 0, EntryState::kValid}, 0, 1);
+    if (status.IsResourceExhausted()) {
+      return false;
+    }
+    if (entries_.total_entries() == before) {
+      return true;
+    }
+    auto last = entries_.begin();
+    for (size_t i = 1; i < entries_.total_entries(); ++i) {
+      ++last;
+    }
+    entries_.RemoveEntry(last);
+    return false;
+  }
+
+  Vector<KeyDescriptor, kMaxEntries> descriptors_;
+  EntryCache::AddressList<kMaxEntries, kRedundancy> addresses_;
+  std::array<EntryCache::IndexSlot, kIndexSlots> key_index_;
+
+  EntryCache entries_;
+};
+
+TEST_F(IndexedEntryCache, AddNewOrUpdateExisting_FindsExistingEntries) {
+  ASSERT_TRUE(entries_.has_key_index());
+
+  for (uint32_t i = 0; i < kMaxEntries; ++i) {
+    ASSERT_EQ(OkStatus(),
+              entries_.AddNewOrUpdateExisting(
+                  {i << 16, 1, EntryState::kValid}, i, 1));
+  }
+  ASSERT_TRUE(entries_.full());
+
+  // Updates to existing entries succeed when the cache is full.
+  for (uint32_t i = 0; i < kMaxEntries; ++i) {
+    ASSERT_EQ(OkStatus(),
+              entries_.AddNewOrUpdateExisting(
+                  {i << 16, 2, EntryState::kValid}, 100 + i, 1));
+  }
+  EXPECT_EQ(kMaxEntries, entries_.total_entries());
+
+  for (const EntryMetadata& entry : entries_) {
+    EXPECT_EQ(2u, entry.transaction_id());
+    EXPECT_EQ(100u + (entry.hash() >> 16), entry.first_address());
+  }
+}
+
+TEST_F(IndexedEntryCache, RemoveEntry_KeepsIndexConsistent) {
+  // Track which hashes from a small pool are present while randomly adding
+  // and removing entries, so that probe sequences frequently overlap.
+  constexpr uint32_t kHashes = 3 * kMaxEntries;
+  std::array<bool, kHashes> present{};
+  uint32_t state = 1;
+
+  for (int i = 0; i < 2000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const uint32_t hash = (state >> 8) % kHashes;
+
+    if (present[hash]) {
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->hash() == hash) {
+          entries_.RemoveEntry(it);
+          break;
+        }
+      }
+      present[hash] = false;
+    } else if (!entries_.full()) {
+      ASSERT_EQ(OkStatus(),
+                entries_.AddNewOrUpdateExisting(
+                    {hash, 1, EntryState::kValid}, hash, 1));
+      present[hash] = true;
+    }
+
+    if (i % 50 == 0) {
+      for (uint32_t h = 0; h < kHashes; ++h) {
+        ASSERT_EQ(present[h], Contains(h)) << h;
+      }
+    }
+  }
+
+  entries_.Reset();
+  EXPECT_EQ(0u, entries_.total_entries());
+  for (uint32_t h = 0; h < kHashes; ++h) {
+    EXPECT_FALSE(Contains(h));
+  }
+}
+
 constexpr size_t kSectorSize = 64;
 constexpr uint32_t kMagic = 0xa14ae726;
 // For KVS entry magic value always use a random 32 bit integer rather than a
@@ -20,9 +20,12 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstring>
+#include <limits>
+#include <mutex>
 #include <type_traits>
 
 #include "pw_assert/check.h"
+#include "pw_kvs/internal/hash.h"
 #include "pw_kvs_private/config.h"
 #include "pw_log/log.h"
 #include "pw_status/try.h"
@@ -32,8 +35,31 @@ namespace {
 
 using std::byte;
 
+// Keys of the tombstones written before and after the entries of a PutMany().
+// The leading null character keeps them from colliding with user keys.
+constexpr char kTransactionBeginKeyData[] = "\0pw_kvs.txn.begin";
+constexpr char kTransactionCommitKeyData[] = "\0pw_kvs.txn.commit";
+
+constexpr std::string_view kTransactionBeginKey(
+    kTransactionBeginKeyData, sizeof(kTransactionBeginKeyData) - 1);
+constexpr std::string_view kTransactionCommitKey(
+    kTransactionCommitKeyData, sizeof(kTransactionCommitKeyData) - 1);
+
+// Loads every entry, regardless of its transaction ID.
+constexpr uint32_t kNoTransactionLimit = std::numeric_limits<uint32_t>::max();
+
+constexpr bool IsTransactionMarker(std::string_view key) {
+  return key == kTransactionBeginKey || key == kTransactionCommitKey;
+}
+
+constexpr bool IsTransactionMarker(uint32_t hash) {
+  return hash == internal::Hash(kTransactionBeginKey) ||
+         hash == internal::Hash(kTransactionCommitKey);
+}
+
 constexpr bool InvalidKey(std::string_view key) {
-  return key.empty() || (key.size() > internal::Entry::kMaxKeyLength);
+  return key.empty() || (key.size() > internal::Entry::kMaxKeyLength) ||
+         IsTransactionMarker(key);
 }
 
 }  // namespace
@@ -45,14 +71,19 @@ KeyValueStore::KeyValueStore(FlashPartition* partition,
                              Vector<SectorDescriptor>& sector_descriptor_list,
                              const SectorDescriptor** temp_sectors_to_skip,
                              Vector<KeyDescriptor>& key_descriptor_list,
-                             Address* addresses)
+                             Address* addresses,
+                             span<internal::EntryCache::IndexSlot> key_index)
     : partition_(*partition),
       formats_(formats),
       sectors_(sector_descriptor_list, *partition, temp_sectors_to_skip),
-      entry_cache_(key_descriptor_list, addresses, redundancy),
+      entry_cache_(key_descriptor_list, addresses, redundancy, key_index),
       options_(options),
       initialized_(InitializationState::kNotInitialized),
+      incremental_gc_sector_(nullptr),
+      transaction_in_progress_(false),
+      transaction_rollback_pending_(false),
       error_detected_(false),
+      shared_state_lock_(&sync::NoOpLock::Instance()),
       internal_stats_({}),
       last_transaction_id_(0) {}
 
@@ -144,10 +175,51 @@ Status KeyValueStore::Init() {
 }
 
 Status KeyValueStore::InitializeMetadata() {
+  transaction_rollback_pending_ = false;
+
+  Status status = LoadMetadata(kNoTransactionLimit);
+
+  const uint32_t interrupted_transaction_id = InterruptedTransactionId();
+  if (interrupted_transaction_id == 0u) {
+    return status;
+  }
+
+  // A PutMany() did not write its commit marker. Reload without the entries
+  // written after the begin marker, which restores the prior values of the
+  // transaction's keys. The sectors with the skipped entries are marked for
+  // garbage collection, after which FixErrors() completes the rollback.
+  PW_LOG_WARN("Rolling back transaction interrupted after ID %u",
+              unsigned(interrupted_transaction_id));
+  transaction_rollback_pending_ = true;
+
+  // Never reuse the transaction IDs of the skipped entries.
+  const uint32_t newest_transaction_id = last_transaction_id_;
+  last_transaction_id_ = 0;
+  status = LoadMetadata(interrupted_transaction_id);
+  last_transaction_id_ = std::max(last_transaction_id_, newest_transaction_id);
+  return status;
+}
+
+uint32_t KeyValueStore::InterruptedTransactionId() const {
+  EntryMetadata begin;
+  if (!FindEntry(kTransactionBeginKey, &begin).ok()) {
+    return 0;
+  }
+
+  EntryMetadata commit;
+  if (FindEntry(kTransactionCommitKey, &commit).ok() &&
+      commit.IsNewerThan(begin.transaction_id())) {
+    return 0;
+  }
+  return begin.transaction_id();
+}
+
+Status KeyValueStore::LoadMetadata(uint32_t newest_transaction_id) {
   const size_t sector_size_bytes = partition_.sector_size_bytes();
 
   sectors_.Reset();
   entry_cache_.Reset();
+  incremental_gc_sector_ = nullptr;
 
   PW_LOG_DEBUG("First pass: Read all entries from all sectors");
   Address sector_address = 0;
@@ -161,6 +233,7 @@ Status KeyValueStore::InitializeMetadata() {
     Address entry_address = sector_address;
 
     size_t sector_corrupt_bytes = 0;
+    size_t sector_skipped_entries = 0;
 
     for (int num_entries_in_sector = 0; true; num_entries_in_sector++) {
       PW_LOG_DEBUG("Load entry: sector=%u, entry#=%d, address=%u",
@@ -174,11 +247,15 @@ Status KeyValueStore::InitializeMetadata() {
       }
 
       Address next_entry_address;
-      Status status = LoadEntry(entry_address, &next_entry_address);
+      Status status =
+          LoadEntry(entry_address, &next_entry_address, newest_transaction_id);
       if (status.IsNotFound()) {
         PW_LOG_DEBUG(
             "Hit un-written data in sector; moving to the next sector");
         break;
+      } else if (status.IsAborted()) {
+        // The entry is from an interrupted transaction; leave it out.
+        sector_skipped_entries++;
       } else if (!status.ok()) {
         // The entry could not be read, indicating likely data corruption within
         // the sector. Try to scan the remainder of the sector for other
@@ -223,6 +300,16 @@ Status KeyValueStore::InitializeMetadata() {
                   unsigned(sector_corrupt_bytes));
     }
 
+    if (sector_skipped_entries > 0) {
+      // Garbage collect the sector to remove the skipped entries from flash.
+      sector.mark_corrupt();
+      error_detected_ = true;
+
+      PW_LOG_WARN("Sector %u contains %u entries of an interrupted transaction",
+                  sectors_.Index(sector),
+                  unsigned(sector_skipped_entries));
+    }
+
     if (sector.Empty(sector_size_bytes)) {
       empty_sector_found = true;
     }
@@ -308,6 +395,7 @@ Status KeyValueStore::InitializeMetadata() {
 }
 
 KeyValueStore::StorageStats KeyValueStore::GetStorageStats() const {
+  std::lock_guard lock(*shared_state_lock_);
   StorageStats stats{};
   const size_t sector_size = partition_.sector_size_bytes();
   bool found_empty_sector = false;
@@ -361,7 +449,8 @@ bool KeyValueStore::CheckForErrors() {
 }
 
 Status KeyValueStore::LoadEntry(Address entry_address,
-                                Address* next_entry_address) {
+                                Address* next_entry_address,
+                                uint32_t newest_transaction_id) {
   Entry entry;
   PW_TRY(Entry::Read(partition_, entry_address, formats_, &entry));
 
@@ -384,6 +473,10 @@ Status KeyValueStore::LoadEntry(Address entry_address,
   // A valid entry was found, so update the next entry address before doing any
   // of the checks that happen in AddNewOrUpdateExisting.
   *next_entry_address = entry.next_address();
+
+  if (entry.transaction_id() > newest_transaction_id) {
+    return Status::Aborted();
+  }
   return entry_cache_.AddNewOrUpdateExisting(
       entry.descriptor(key), entry.address(), partition_.sector_size_bytes());
 }
@@ -430,7 +523,10 @@ Status KeyValueStore::RemoveDeletedKeyEntries() {
 
     // The iterator we are given back from RemoveEntry could also be deleted,
     // so loop until we find one that isn't deleted.
-    while (entry_metadata.state() == EntryState::kDeleted) {
+    // Transaction markers are kept, since removing only one of them could make
+    // committed entries appear to be part of an interrupted transaction.
+    while (entry_metadata.state() == EntryState::kDeleted &&
+           !IsTransactionMarker(entry_metadata.hash())) {
       // Read the original entry to get the size for sector accounting purposes.
       Entry entry;
       PW_TRY(ReadEntry(entry_metadata, entry));
@@ -512,6 +608,220 @@ Status KeyValueStore::Delete(std::string_view key) {
   return WriteEntryForExistingKey(metadata, EntryState::kDeleted, key, {});
 }
 
+Status KeyValueStore::PutMany(span<const KeyValue> entries) {
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const KeyValue& entry = entries[i];
+    PW_TRY(CheckWriteOperation(entry.key));
+
+    if (Entry::size(partition_, entry.key, entry.value) >
+        partition_.sector_size_bytes()) {
+      PW_LOG_DEBUG("%u B value with %u B key cannot fit in one sector",
+                   unsigned(entry.value.size()),
+                   unsigned(entry.key.size()));
+      return Status::InvalidArgument();
+    }
+
+    for (size_t j = 0; j < i; ++j) {
+      if (entries[j].key == entry.key) {
+        PW_LOG_DEBUG("Key 0x%08x is written more than once in a transaction",
+                     unsigned(internal::Hash(entry.key)));
+        return Status::InvalidArgument();
+      }
+    }
+  }
+
+  if (entries.empty()) {
+    return initialized() ? OkStatus() : Status::FailedPrecondition();
+  }
+
+  // A single entry is written atomically without the transaction markers.
+  if (entries.size() == 1u) {
+    return PutBytes(entries[0].key, entries[0].value);
+  }
+
+  PW_TRY(PrepareTransaction(entries));
+
+  PW_LOG_DEBUG("Writing %u entries in a transaction", unsigned(entries.size()));
+  transaction_in_progress_ = true;
+
+  Status status = WriteTransactionMarker(kTransactionBeginKey);
+  if (status.ok()) {
+    status = WriteTransactionEntries(entries);
+  }
+  if (status.ok()) {
+    status = WriteTransactionMarker(kTransactionCommitKey);
+  }
+
+  transaction_in_progress_ = false;
+
+  if (!status.ok()) {
+    RollBackTransaction();
+  }
+  return status;
+}
+
+Status KeyValueStore::PrepareTransaction(span<const KeyValue> entries) {
+  // Count the cache entries needed for new keys and for markers that have not
+  // been written before.
+  size_t new_entries = 0;
+  size_t write_size = 0;
+  size_t largest_entry_size = 0;
+
+  for (std::string_view marker_key :
+       {kTransactionBeginKey, kTransactionCommitKey}) {
+    EntryMetadata metadata;
+    Status status = FindEntry(marker_key, &metadata);
+    if (status.IsNotFound()) {
+      new_entries += 1;
+    } else if (!status.ok()) {
+      return status;
+    }
+    write_size += Entry::size(partition_, marker_key, {});
+    largest_entry_size =
+        std::max(largest_entry_size, Entry::size(partition_, marker_key, {}));
+  }
+
+  for (const KeyValue& entry : entries) {
+    EntryMetadata metadata;
+    Status status = FindEntry(entry.key, &metadata);
+    if (status.IsNotFound()) {
+      new_entries += 1;
+    } else if (!status.ok()) {
+      return status;
+    }
+    write_size += Entry::size(partition_, entry.key, entry.value);
+    largest_entry_size = std::max(
+        largest_entry_size, Entry::size(partition_, entry.key, entry.value));
+  }
+
+  if (entry_cache_.total_entries() + new_entries >
+      entry_cache_.max_entries()) {
+    PW_LOG_WARN(
+        "KVS full: transaction needs %u new entries, but only %u are free",
+        unsigned(new_entries),
+        unsigned(entry_cache_.max_entries() - entry_cache_.total_entries()));
+    return Status::ResourceExhausted();
+  }
+
+  // Garbage collect until there is enough writable space for every copy of
+  // every entry. This is checked up front because garbage collection during
+  // the transaction could erase the prior values that a rollback restores.
+  // Entries do not span sectors, so allow for up to one unusable entry's worth
+  // of space at the end of each sector the transaction writes to.
+  const size_t sector_size = partition_.sector_size_bytes();
+  const size_t sectors_written = (write_size + sector_size - 1) / sector_size;
+  write_size =
+      (write_size + (sectors_written + 1) * largest_entry_size) * redundancy();
+  size_t gc_sector_count = 0;
+
+  while (GetStorageStats().writable_bytes < write_size) {
+    if (options_.gc_on_write == GargbageCollectOnWrite::kDisabled ||
+        gc_sector_count > partition_.sector_count()) {
+      PW_LOG_WARN("Unable to find space to write %u B transaction",
+                  unsigned(write_size));
+      return Status::ResourceExhausted();
+    }
+
+    Status gc_status = GarbageCollect(span<const Address>());
+    if (gc_status.IsNotFound()) {
+      return Status::ResourceExhausted();
+    }
+    PW_TRY(gc_status);
+    gc_sector_count++;
+  }
+  return OkStatus();
+}
+
+Status KeyValueStore::WriteTransactionEntries(span<const KeyValue> entries) {
+  const auto run_size = [&](size_t first, size_t count) {
+    size_t size = 0;
+    for (size_t i = first; i < first + count; ++i) {
+      size += Entry::size(partition_, entries[i].key, entries[i].value);
+    }
+    return size;
+  };
+
+  Address* reserved_addresses = entry_cache_.TempReservedAddressesForWrite();
+  size_t first = 0;
+
+  while (first < entries.size()) {
+    // Find the longest run of entries that fits in one sector.
+    size_t count = 1;
+    while (first + count < entries.size() &&
+           run_size(first, count + 1) <= partition_.sector_size_bytes()) {
+      count += 1;
+    }
+
+    // Reserve space for the whole run at once. If no sector has room for it,
+    // split the run until one does.
+    Status status = GetAddressesForWrite(reserved_addresses,
+                                         run_size(first, count));
+    while (status.IsResourceExhausted() && count > 1u) {
+      count /= 2;
+      status = GetAddressesForWrite(reserved_addresses, run_size(first, count));
+    }
+    PW_TRY(status);
+
+    for (size_t i = first; i < first + count; ++i) {
+      PW_TRY(WriteTransactionEntry(reserved_addresses,
+                                   entries[i].key,
+                                   entries[i].value,
+                                   EntryState::kValid));
+    }
+    first += count;
+  }
+  return OkStatus();
+}
+
+Status KeyValueStore::WriteTransactionEntry(const Address* reserved_addresses,
+                                            std::string_view key,
+                                            span<const byte> value,
+                                            EntryState new_state) {
+  EntryMetadata metadata;
+  Status status = FindEntry(key, &metadata);
+
+  if (status.IsNotFound()) {
+    return WriteEntryToSectors(
+        reserved_addresses, key, value, new_state, nullptr, 0);
+  }
+  PW_TRY(status);
+
+  // Read the prior entry to get the size for sector accounting purposes.
+  Entry prior_entry;
+  PW_TRY(ReadEntry(metadata, prior_entry));
+
+  return WriteEntryToSectors(reserved_addresses,
+                             key,
+                             value,
+                             new_state,
+                             &metadata,
+                             prior_entry.size());
+}
+
+Status KeyValueStore::WriteTransactionMarker(std::string_view marker_key) {
+  Address* reserved_addresses = entry_cache_.TempReservedAddressesForWrite();
+  PW_TRY(GetAddressesForWrite(reserved_addresses,
+                              Entry::size(partition_, marker_key, {})));
+  return WriteTransactionEntry(
+      reserved_addresses, marker_key, {}, EntryState::kDeleted);
+}
+
+void KeyValueStore::RollBackTransaction() {
+  PW_LOG_WARN("Transaction failed; rolling back its entries");
+  error_detected_ = true;
+  initialized_ = InitializationState::kNeedsMaintenance;
+
+  InitializeMetadata().IgnoreError();  // Errors are repaired below.
+
+  if (options_.recovery != ErrorRecovery::kManual) {
+    Status repair_status = FixErrors();
+    if (!repair_status.ok()) {
+      PW_LOG_WARN("Unable to repair KVS after failed transaction: %s",
+                  repair_status.str());
+    }
+  }
+}
+
 void KeyValueStore::Item::ReadKey() {
   key_buffer_.fill('\0');
 
@@ -560,6 +870,7 @@ Status KeyValueStore::ReadEntry(const EntryMetadata& metadata,
     }
 
     // Found a bad address. Set the sector as corrupt.
+    std::lock_guard lock(*shared_state_lock_);
     error_detected_ = true;
     sectors_.FromAddress(address).mark_corrupt();
   }
@@ -570,8 +881,8 @@ Status KeyValueStore::ReadEntry(const EntryMetadata& metadata,
 
 Status KeyValueStore::FindEntry(std::string_view key,
                                 EntryMetadata* metadata_out) const {
-  StatusWithSize find_result =
-      entry_cache_.Find(partition_, sectors_, formats_, key, metadata_out);
+  StatusWithSize find_result = entry_cache_.Find(
+      partition_, sectors_, formats_, key, metadata_out, *shared_state_lock_);
 
   if (find_result.size() > 0u) {
     error_detected_ = true;
@@ -602,6 +913,7 @@ StatusWithSize KeyValueStore::Get(std::string_view key,
 
   StatusWithSize result = entry.ReadValue(value_buffer, offset_bytes);
   if (options_.verify_on_read) {
+    std::lock_guard lock(*shared_state_lock_);
     Status verify_result = OkStatus();
     if (result.ok() && offset_bytes == 0u) {
       verify_result =
@@ -748,21 +1060,37 @@ Status KeyValueStore::WriteEntry(std::string_view key,
   const size_t entry_size = Entry::size(partition_, key, value);
   PW_TRY(GetAddressesForWrite(reserved_addresses, entry_size));
 
-  // Write the entry at the first address that was found.
-  Entry entry = CreateEntry(reserved_addresses[0], key, value, new_state);
+  size_t prior_size = prior_entry != nullptr ? prior_entry->size() : 0;
+  return WriteEntryToSectors(
+      reserved_addresses, key, value, new_state, prior_metadata, prior_size);
+}
+
+Status KeyValueStore::WriteEntryToSectors(const Address* reserved_addresses,
+                                          std::string_view key,
+                                          span<const byte> value,
+                                          EntryState new_state,
+                                          EntryMetadata* prior_metadata,
+                                          size_t prior_size) {
+  // Write the entry at the next writable address in the first reserved sector.
+  // A transaction reserves space for several entries at once, so this is not
+  // necessarily the reserved address itself.
+  SectorDescriptor& sector = sectors_.FromAddress(reserved_addresses[0]);
+  Entry entry = CreateEntry(
+      sectors_.NextWritableAddress(sector), key, value, new_state);
   PW_TRY(AppendEntry(entry, key, value));
 
   // After writing the first entry successfully, update the key descriptors.
   // Once a single new the entry is written, the old entries are invalidated.
-  size_t prior_size = prior_entry != nullptr ? prior_entry->size() : 0;
   EntryMetadata new_metadata =
       CreateOrUpdateKeyDescriptor(entry, key, prior_metadata, prior_size);
 
   // Write the additional copies of the entry, if redundancy is greater than 1.
   for (size_t i = 1; i < redundancy(); ++i) {
-    entry.set_address(reserved_addresses[i]);
+    const Address address = sectors_.NextWritableAddress(
+        sectors_.FromAddress(reserved_addresses[i]));
+    entry.set_address(address);
     PW_TRY(AppendEntry(entry, key, value));
-    new_metadata.AddNewAddress(reserved_addresses[i]);
+    new_metadata.AddNewAddress(address);
   }
   return OkStatus();
 }
@@ -823,7 +1151,8 @@ Status KeyValueStore::GetSectorForWrite(
   Status result = sectors_.FindSpace(sector, entry_size, reserved_addresses);
 
   size_t gc_sector_count = 0;
-  bool do_auto_gc = options_.gc_on_write != GargbageCollectOnWrite::kDisabled;
+  bool do_auto_gc = options_.gc_on_write != GargbageCollectOnWrite::kDisabled &&
+                    !transaction_in_progress_;
 
   // Do garbage collection as needed, so long as policy allows.
   while (result.IsResourceExhausted() && do_auto_gc) {
@@ -937,6 +1266,12 @@ Status KeyValueStore::RelocateEntry(const EntryMetadata& metadata,
   PW_TRY(sectors_.FindSpaceDuringGarbageCollection(
       &new_sector, entry.size(), metadata.addresses(), reserved_addresses));
 
+  return MoveEntryToSector(entry, new_sector, address);
+}
+
+Status KeyValueStore::MoveEntryToSector(Entry& entry,
+                                        SectorDescriptor* new_sector,
+                                        KeyValueStore::Address& address) {
   Address new_address = sectors_.NextWritableAddress(*new_sector);
   PW_TRY_ASSIGN(const size_t result_size,
                 CopyEntryToSector(entry, new_sector, new_address));
@@ -1050,6 +1385,104 @@ Status KeyValueStore::PartialMaintenance() {
   return GarbageCollect(span<const Address>());
 }
 
+Status KeyValueStore::IncrementalMaintenance(size_t max_relocated_bytes,
+                                             size_t empty_sectors_for_writes) {
+  if (initialized_ == InitializationState::kNotInitialized) {
+    return Status::FailedPrecondition();
+  }
+
+  CheckForErrors();
+  // Do automatic repair, if KVS options allow for it.
+  if (error_detected_ && options_.recovery != ErrorRecovery::kManual) {
+    PW_TRY(Repair());
+  }
+
+  SectorDescriptor* sector =
+      IncrementalGarbageCollectionSector(empty_sectors_for_writes);
+  if (sector == nullptr) {
+    return OkStatus();
+  }
+
+  // Stop new entries from being written to the sector, so that relocating its
+  // entries eventually finishes.
+  sector->RemoveWritableBytes(static_cast<uint16_t>(sector->writable_bytes()));
+
+  size_t relocated_bytes = 0;
+  for (EntryMetadata& metadata : entry_cache_) {
+    for (Address& address : metadata.addresses()) {
+      if (!sectors_.AddressInSector(*sector, address)) {
+        continue;
+      }
+      if (relocated_bytes > 0u && relocated_bytes >= max_relocated_bytes) {
+        return Status::DeadlineExceeded();
+      }
+
+      Entry entry;
+      PW_TRY(ReadEntry(metadata, entry));
+
+      // Relocate without using the empty sector reserved for garbage
+      // collection. If no other sector has room, finish collecting the sector
+      // in one step, which may use the reserved sector.
+      SectorDescriptor* new_sector;
+      if (!sectors_.FindSpace(&new_sector, entry.size(), metadata.addresses())
+               .ok()) {
+        PW_LOG_DEBUG("No room to relocate incrementally; collecting sector %u",
+                     sectors_.Index(sector));
+        incremental_gc_sector_ = nullptr;
+        PW_TRY(GarbageCollectSector(*sector, {}));
+        return IncrementalMaintenanceStatus(empty_sectors_for_writes);
+      }
+
+      PW_TRY(MoveEntryToSector(entry, new_sector, address));
+      relocated_bytes += entry.size();
+    }
+  }
+
+  // Erase the sector in a separate step from relocating its last entries.
+  if (relocated_bytes > 0u) {
+    return Status::DeadlineExceeded();
+  }
+
+  incremental_gc_sector_ = nullptr;
+  PW_TRY(GarbageCollectSector(*sector, {}));
+  return IncrementalMaintenanceStatus(empty_sectors_for_writes);
+}
+
+KeyValueStore::SectorDescriptor*
+KeyValueStore::IncrementalGarbageCollectionSector(
+    size_t empty_sectors_for_writes) {
+  const size_t sector_size_bytes = partition_.sector_size_bytes();
+
+  // Continue with the current sector, unless it was collected by a write.
+  if (incremental_gc_sector_ != nullptr &&
+      !incremental_gc_sector_->Empty(sector_size_bytes)) {
+    return incremental_gc_sector_;
+  }
+  incremental_gc_sector_ = nullptr;
+
+  // Writes never use the last empty sector, so it does not count toward
+  // empty_sectors_for_writes.
+  size_t empty_sectors = 0;
+  for (const SectorDescriptor& sector : sectors_) {
+    if (sector.Empty(sector_size_bytes)) {
+      empty_sectors += 1;
+    }
+  }
+  if (empty_sectors < empty_sectors_for_writes + 1) {
+    incremental_gc_sector_ =
+        sectors_.FindSectorToGarbageCollect(span<const Address>());
+  }
+  return incremental_gc_sector_;
+}
+
+Status KeyValueStore::IncrementalMaintenanceStatus(
+    size_t empty_sectors_for_writes) {
+  return IncrementalGarbageCollectionSector(empty_sectors_for_writes) ==
+                 nullptr
+             ? OkStatus()
+             : Status::DeadlineExceeded();
+}
+
 Status KeyValueStore::GarbageCollect(span<const Address> reserved_addresses) {
   PW_LOG_DEBUG("Garbage Collect a single sector");
   for ([[maybe_unused]] Address address : reserved_addresses) {
@@ -1122,6 +1555,7 @@ Status KeyValueStore::GarbageCollectSector(
 
 StatusWithSize KeyValueStore::UpdateEntriesToPrimaryFormat() {
   size_t entries_updated = 0;
+  bool update_transaction_markers = false;
   for (EntryMetadata& prior_metadata : entry_cache_) {
     Entry entry;
     PW_TRY_WITH_SIZE(ReadEntry(prior_metadata, entry));
@@ -1130,6 +1564,13 @@ StatusWithSize KeyValueStore::UpdateEntriesToPrimaryFormat() {
       continue;
     }
 
+    if (IsTransactionMarker(prior_metadata.hash())) {
+      // Updating gives the marker a new transaction ID, so the markers are
+      // rewritten in order after the other entries.
+      update_transaction_markers = true;
+      continue;
+    }
+
     PW_LOG_DEBUG(
         "Updating entry 0x%08x from old format [0x%08x] to new format "
         "[0x%08x]",
@@ -1170,6 +1611,12 @@ StatusWithSize KeyValueStore::UpdateEntriesToPrimaryFormat() {
     }
   }
 
+  if (update_transaction_markers) {
+    PW_TRY_WITH_SIZE(WriteTransactionMarker(kTransactionBeginKey));
+    PW_TRY_WITH_SIZE(WriteTransactionMarker(kTransactionCommitKey));
+    entries_updated += 2;
+  }
+
   return StatusWithSize(entries_updated);
 }
 
@@ -1308,6 +1755,16 @@ Status KeyValueStore::FixErrors() {
     overall_status = repair_status;
   }
 
+  // Step 4: Once the entries of an interrupted transaction have been garbage
+  // collected, write a commit marker so the rollback is not repeated.
+  if (overall_status.ok() && transaction_rollback_pending_) {
+    overall_status = WriteTransactionMarker(kTransactionCommitKey);
+    if (overall_status.ok()) {
+      transaction_rollback_pending_ = false;
+      PW_LOG_INFO("Interrupted transaction rolled back");
+    }
+  }
+
   if (overall_status.ok()) {
     error_detected_ = false;
     initialized_ = InitializationState::kReady;
@@ -0,0 +1,281 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures Get and Put latency for KVSs of different sizes, with and without a
+// key index, and compares updating keys with Put and PutMany. Each iteration
+// performs kOperations operations, so the per-call latency is the reported
+// time divided by kOperations.
+//
+// The PutLatency tests log the p99 and maximum latency of individual Put calls
+// in a workload like key_value_store_wear_test, with garbage collection done
+// by Put or by IncrementalMaintenance between writes.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <utility>
+
+#include "pw_assert/check.h"
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kSectorSize = 4 * 1024;
+constexpr size_t kSectorCount = 128;
+constexpr size_t kOperations = 128;
+
+// Large enough for 8192 small entries with plenty of room for GC.
+FakeFlashMemoryBuffer<kSectorSize, kSectorCount> test_flash(16);
+FlashPartition test_partition(&test_flash);
+
+ChecksumCrc16 checksum;
+
+// For KVS magic value always use a random 32 bit integer rather than a
+// human readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x5fa4c2e1, .checksum = &checksum};
+
+class Key {
+ public:
+  explicit Key(size_t index) {
+    std::snprintf(buffer_.data(), buffer_.size(), "key_%05u", unsigned(index));
+  }
+
+  operator std::string_view() const { return buffer_.data(); }
+
+ private:
+  std::array<char, 16> buffer_;
+};
+
+// Returns the index of the key for the nth operation. Spreads operations over
+// the whole KVS so that lookups do not favor keys near the start of the cache.
+constexpr size_t KeyIndex(size_t operation, size_t entries) {
+  return (operation * 2654435761u) % entries;
+}
+
+// Returns a KVS with kEntries entries. All KVSs share the same flash, so this
+// erases the partition and fills the KVS each time it is called. The KVS has
+// room for the two entries PutMany uses to mark transactions.
+template <size_t kEntries, size_t kKeyIndexSlots>
+KeyValueStore& FilledKvs() {
+  static KeyValueStoreBuffer<kEntries + 2,
+                             kSectorCount,
+                             1,
+                             1,
+                             kKeyIndexSlots>
+      kvs(&test_partition, kFormat);
+
+  PW_CHECK_OK(test_partition.Erase());
+  PW_CHECK_OK(kvs.Init());
+  for (size_t i = 0; i < kEntries; ++i) {
+    PW_CHECK_OK(kvs.Put(Key(i), static_cast<uint32_t>(i)));
+  }
+  return kvs;
+}
+
+template <size_t kEntries, size_t kKeyIndexSlots>
+void Get(pw::perf_test::State& state) {
+  KeyValueStore& kvs = FilledKvs<kEntries, kKeyIndexSlots>();
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kOperations; ++i) {
+      const size_t index = KeyIndex(i, kEntries);
+      uint32_t value = 0;
+      PW_CHECK_OK(kvs.Get(Key(index), &value));
+      PW_CHECK_UINT_EQ(value, index);
+    }
+  }
+}
+
+template <size_t kEntries, size_t kKeyIndexSlots>
+void Put(pw::perf_test::State& state) {
+  KeyValueStore& kvs = FilledKvs<kEntries, kKeyIndexSlots>();
+
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kOperations; ++i) {
+      PW_CHECK_OK(kvs.Put(Key(KeyIndex(i, kEntries)), value++));
+    }
+  }
+}
+
+template <size_t... kIndices>
+std::array<Key, sizeof...(kIndices)> MakeKeys(
+    std::index_sequence<kIndices...>) {
+  return {Key(kIndices)...};
+}
+
+// Updates kOperations keys in one atomic PutMany call.
+template <size_t kEntries>
+void PutMany(pw::perf_test::State& state) {
+  static_assert(kOperations <= kEntries);
+  KeyValueStore& kvs = FilledKvs<kEntries, 2 * kEntries>();
+
+  const std::array<Key, kOperations> keys =
+      MakeKeys(std::make_index_sequence<kOperations>());
+  std::array<uint32_t, kOperations> values{};
+  std::array<KeyValueStore::KeyValue, kOperations> entries;
+  for (size_t i = 0; i < kOperations; ++i) {
+    entries[i] = {keys[i], as_bytes(span(&values[i], 1))};
+  }
+
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    for (uint32_t& entry_value : values) {
+      entry_value = value++;
+    }
+    PW_CHECK_OK(kvs.PutMany(entries));
+  }
+}
+
+// Updates the same kOperations keys as PutMany, one Put call at a time.
+template <size_t kEntries>
+void PutEach(pw::perf_test::State& state) {
+  static_assert(kOperations <= kEntries);
+  KeyValueStore& kvs = FilledKvs<kEntries, 2 * kEntries>();
+
+  uint32_t value = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < kOperations; ++i) {
+      PW_CHECK_OK(kvs.Put(Key(i), value++));
+    }
+  }
+}
+
+// Latencies of individual Put calls, in nanoseconds.
+class LatencySamples {
+ public:
+  void Add(std::chrono::steady_clock::duration latency) {
+    if (count_ < samples_.size()) {
+      samples_[count_++] = static_cast<uint32_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(latency)
+              .count());
+    }
+  }
+
+  void Log(const char* name) {
+    const auto end = samples_.begin() + count_;
+    const auto p99 = samples_.begin() + count_ * 99 / 100;
+    std::nth_element(samples_.begin(), p99, end);
+    PW_LOG_INFO("%s: %u Puts, p99 %u ns, max %u ns",
+                name,
+                unsigned(count_),
+                unsigned(*p99),
+                unsigned(*std::max_element(p99, end)));
+  }
+
+ private:
+  std::array<uint32_t, 16384> samples_;
+  size_t count_ = 0;
+};
+
+// Repeatedly writes one large entry and rotates through updates of many small
+// entries, so sectors fill with a mix of valid and stale data. With
+// kIncremental, garbage collection is done by IncrementalMaintenance between
+// rounds of writes, as an idle hook would; otherwise Put garbage collects when
+// it runs out of space.
+template <bool kIncremental>
+void PutLatency(pw::perf_test::State& state) {
+  constexpr size_t kSmallKeys = 48;
+  constexpr size_t kSmallPutsPerRound = 16;
+  constexpr size_t kStepBytes = 512;
+  constexpr size_t kEmptySectorsForWrites = 2;
+
+  static KeyValueStoreBuffer<64, kSectorCount> kvs(&test_partition, kFormat);
+  PW_CHECK_OK(test_partition.Erase());
+  PW_CHECK_OK(kvs.Init());
+
+  static std::array<std::byte, 3 * kSectorSize / 4> large_value;
+  static LatencySamples samples;
+  samples = LatencySamples();
+
+  size_t small_key = 0;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < 8; ++i) {
+      large_value[0] = std::byte(i);
+      auto start = std::chrono::steady_clock::now();
+      PW_CHECK_OK(kvs.Put("large", large_value));
+      samples.Add(std::chrono::steady_clock::now() - start);
+
+      for (size_t j = 0; j < kSmallPutsPerRound; ++j) {
+        small_key = (small_key + 1) % kSmallKeys;
+        start = std::chrono::steady_clock::now();
+        PW_CHECK_OK(kvs.Put(Key(small_key), span(large_value).first(64)));
+        samples.Add(std::chrono::steady_clock::now() - start);
+      }
+
+      if constexpr (kIncremental) {
+        while (kvs.IncrementalMaintenance(kStepBytes, kEmptySectorsForWrites)
+                   .IsDeadlineExceeded()) {
+        }
+      }
+    }
+  }
+
+  samples.Log(kIncremental ? "PutLatency_IncrementalGc" : "PutLatency_PutGc");
+}
+
+// Wrappers with a single template argument for use in PW_PERF_TEST.
+template <size_t kEntries>
+void GetScan(pw::perf_test::State& state) {
+  Get<kEntries, 0>(state);
+}
+
+template <size_t kEntries>
+void GetKeyIndex(pw::perf_test::State& state) {
+  Get<kEntries, 2 * kEntries>(state);
+}
+
+template <size_t kEntries>
+void PutScan(pw::perf_test::State& state) {
+  Put<kEntries, 0>(state);
+}
+
+template <size_t kEntries>
+void PutKeyIndex(pw::perf_test::State& state) {
+  Put<kEntries, 2 * kEntries>(state);
+}
+
+PW_PERF_TEST(Get64_Scan, GetScan<64>);
+PW_PERF_TEST(Get64_KeyIndex, GetKeyIndex<64>);
+PW_PERF_TEST(Get512_Scan, GetScan<512>);
+PW_PERF_TEST(Get512_KeyIndex, GetKeyIndex<512>);
+PW_PERF_TEST(Get8192_Scan, GetScan<8192>);
+PW_PERF_TEST(Get8192_KeyIndex, GetKeyIndex<8192>);
+
+PW_PERF_TEST(Put64_Scan, PutScan<64>);
+PW_PERF_TEST(Put64_KeyIndex, PutKeyIndex<64>);
+PW_PERF_TEST(Put512_Scan, PutScan<512>);
+PW_PERF_TEST(Put512_KeyIndex, PutKeyIndex<512>);
+PW_PERF_TEST(Put8192_Scan, PutScan<8192>);
+PW_PERF_TEST(Put8192_KeyIndex, PutKeyIndex<8192>);
+
+PW_PERF_TEST(Update512_PutEach, PutEach<512>);
+PW_PERF_TEST(Update512_PutMany, PutMany<512>);
+
+PW_PERF_TEST(PutLatency_PutGc, PutLatency<false>);
+PW_PERF_TEST(PutLatency_IncrementalGc, PutLatency<true>);
+
+}  // namespace
+}  // namespace pw::kvs
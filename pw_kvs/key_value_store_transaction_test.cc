@@ -0,0 +1,308 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_kvs_private/config.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+using KeyValue = KeyValueStore::KeyValue;
+
+constexpr size_t kSectorSize = 512;
+constexpr size_t kSectorCount = 16;
+constexpr size_t kMaxEntries = 32;
+
+using Flash = FakeFlashMemoryBuffer<kSectorSize, kSectorCount>;
+using Kvs = KeyValueStoreBuffer<kMaxEntries, kSectorCount>;
+
+ChecksumCrc16 checksum;
+
+// For KVS magic value always use a random 32 bit integer rather than a
+// human readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x2c9ab6e5, .checksum = &checksum};
+
+constexpr Options kManualRecovery{.recovery = ErrorRecovery::kManual};
+
+constexpr std::array<std::string_view, 3> kKeys = {"alpha", "beta", "gamma"};
+
+// Returns the values that a transaction writes in place of `value`.
+constexpr uint32_t Updated(uint32_t value) { return value + 100; }
+
+class KvsTransactionTest : public ::testing::Test {
+ protected:
+  KvsTransactionTest()
+      : flash_(16), partition_(&flash_), kvs_(&partition_, kFormat) {}
+
+  void SetUp() override {
+    ASSERT_EQ(OkStatus(), partition_.Erase());
+    ASSERT_EQ(OkStatus(), kvs_.Init());
+  }
+
+  // Writes an initial value for each key in kKeys with Put().
+  void PutInitialValues(KeyValueStore& kvs) {
+    for (uint32_t i = 0; i < kKeys.size(); ++i) {
+      ASSERT_EQ(OkStatus(), kvs.Put(kKeys[i], i));
+    }
+  }
+
+  // Checks that every key in kKeys has the value returned by `expected`.
+  template <typename Function>
+  void ExpectValues(KeyValueStore& kvs, Function expected) {
+    for (uint32_t i = 0; i < kKeys.size(); ++i) {
+      uint32_t value = 0;
+      ASSERT_EQ(OkStatus(), kvs.Get(kKeys[i], &value));
+      EXPECT_EQ(expected(i), value);
+    }
+  }
+
+  Flash flash_;
+  FlashPartition partition_;
+  Kvs kvs_;
+};
+
+TEST_F(KvsTransactionTest, PutMany_AddsEntries) {
+  const uint32_t values[] = {1, 2, 3};
+  const KeyValue entries[] = {{kKeys[0], as_bytes(span(&values[0], 1))},
+                              {kKeys[1], as_bytes(span(&values[1], 1))},
+                              {kKeys[2], as_bytes(span(&values[2], 1))}};
+
+  ASSERT_EQ(OkStatus(), kvs_.PutMany(entries));
+  ExpectValues(kvs_, [](uint32_t i) { return i + 1; });
+}
+
+TEST_F(KvsTransactionTest, PutMany_MarkersAreNotKeys) {
+  PutInitialValues(kvs_);
+  const uint32_t value = 7;
+  const KeyValue entries[] = {{kKeys[0], as_bytes(span(&value, 1))},
+                              {"delta", as_bytes(span(&value, 1))}};
+  ASSERT_EQ(OkStatus(), kvs_.PutMany(entries));
+
+  EXPECT_EQ(kvs_.size(), kKeys.size() + 1);
+  size_t count = 0;
+  for (const auto& item : kvs_) {
+    static_cast<void>(item);
+    count += 1;
+  }
+  EXPECT_EQ(count, kKeys.size() + 1);
+}
+
+TEST_F(KvsTransactionTest, PutMany_UpdatesExistingEntries) {
+  PutInitialValues(kvs_);
+
+  const uint32_t values[] = {Updated(0), Updated(1), Updated(2)};
+  const KeyValue entries[] = {{kKeys[0], as_bytes(span(&values[0], 1))},
+                              {kKeys[1], as_bytes(span(&values[1], 1))},
+                              {kKeys[2], as_bytes(span(&values[2], 1))}};
+  ASSERT_EQ(OkStatus(), kvs_.PutMany(entries));
+  ExpectValues(kvs_, Updated);
+
+  // The entries are still present after reinitializing.
+  Kvs reloaded(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  ExpectValues(reloaded, Updated);
+}
+
+TEST_F(KvsTransactionTest, PutMany_EntriesSpanSectors) {
+  std::array<std::array<std::byte, 150>, 8> values;
+  std::array<std::array<char, 8>, 8> keys;
+  std::array<KeyValue, 8> entries;
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    values[i].fill(std::byte(i));
+    keys[i] = {'k', 'e', 'y', char('0' + i)};
+    entries[i] = {std::string_view(keys[i].data(), 4), values[i]};
+  }
+
+  for (int round = 0; round < 3; ++round) {
+    ASSERT_EQ(OkStatus(), kvs_.PutMany(entries));
+  }
+
+  Kvs reloaded(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    std::array<std::byte, 150> value;
+    ASSERT_EQ(OkStatus(), reloaded.Get(entries[i].key, value).status());
+    EXPECT_EQ(value, values[i]);
+  }
+}
+
+TEST_F(KvsTransactionTest, PutMany_Empty) {
+  EXPECT_EQ(OkStatus(), kvs_.PutMany({}));
+  EXPECT_EQ(kvs_.size(), 0u);
+}
+
+TEST_F(KvsTransactionTest, PutMany_InvalidKeys_NothingWritten) {
+  const uint32_t value = 1;
+  const KeyValue repeated[] = {{kKeys[0], as_bytes(span(&value, 1))},
+                               {kKeys[0], as_bytes(span(&value, 1))}};
+  EXPECT_EQ(Status::InvalidArgument(), kvs_.PutMany(repeated));
+
+  const KeyValue empty_key[] = {{kKeys[0], as_bytes(span(&value, 1))},
+                                {"", as_bytes(span(&value, 1))}};
+  EXPECT_EQ(Status::InvalidArgument(), kvs_.PutMany(empty_key));
+
+  EXPECT_EQ(kvs_.size(), 0u);
+  EXPECT_EQ(kvs_.GetStorageStats().in_use_bytes, 0u);
+}
+
+TEST_F(KvsTransactionTest, PutMany_NoRoomForNewKeys_NothingWritten) {
+  PutInitialValues(kvs_);
+
+  // One of the keys exists, but the markers need two more entries, so the
+  // transaction needs one more entry than the cache has.
+  std::array<std::array<char, 8>, kMaxEntries - kKeys.size()> keys;
+  std::array<KeyValue, keys.size()> entries;
+  const uint32_t value = Updated(0);
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    keys[i] = {'k', 'e', 'y', char('a' + i / 26), char('a' + i % 26)};
+    entries[i] = {std::string_view(keys[i].data(), 5),
+                  as_bytes(span(&value, 1))};
+  }
+  entries[0].key = kKeys[0];
+
+  EXPECT_EQ(Status::ResourceExhausted(), kvs_.PutMany(entries));
+  EXPECT_EQ(kvs_.size(), kKeys.size());
+  ExpectValues(kvs_, [](uint32_t i) { return i; });
+}
+
+TEST_F(KvsTransactionTest, Transaction_Commit) {
+  PutInitialValues(kvs_);
+
+  const uint32_t first = Updated(0);
+  const uint32_t second = Updated(1);
+  KeyValueStore::Transaction<2> transaction(kvs_);
+  ASSERT_EQ(OkStatus(), transaction.Put(kKeys[0], first));
+  ASSERT_EQ(OkStatus(), transaction.Put(kKeys[1], second));
+  EXPECT_EQ(Status::ResourceExhausted(), transaction.Put(kKeys[2], second));
+  EXPECT_EQ(transaction.size(), 2u);
+
+  // Nothing is written until the transaction is committed.
+  ExpectValues(kvs_, [](uint32_t i) { return i; });
+
+  ASSERT_EQ(OkStatus(), transaction.Commit());
+  EXPECT_EQ(transaction.size(), 0u);
+  ExpectValues(kvs_, [](uint32_t i) { return i < 2 ? Updated(i) : i; });
+}
+
+TEST_F(KvsTransactionTest, PutMany_WriteFails_RollsBack) {
+  PutInitialValues(kvs_);
+
+  const uint32_t values[] = {Updated(0), Updated(1), Updated(2)};
+  const KeyValue entries[] = {{kKeys[0], as_bytes(span(&values[0], 1))},
+                              {kKeys[1], as_bytes(span(&values[1], 1))},
+                              {kKeys[2], as_bytes(span(&values[2], 1))}};
+
+  // Fail one write after the first two entries are written.
+  flash_.InjectWriteError(FlashError::Unconditional(Status::Unavailable(),
+                                                    /*times=*/1,
+                                                    /*delay=*/3));
+  EXPECT_FALSE(kvs_.PutMany(entries).ok());
+
+  // The KVS is repaired and none of the entries were updated.
+  EXPECT_TRUE(kvs_.initialized());
+  ExpectValues(kvs_, [](uint32_t i) { return i; });
+
+  ASSERT_EQ(OkStatus(), kvs_.PutMany(entries));
+  ExpectValues(kvs_, Updated);
+}
+
+// Interrupts a transaction at each of its writes in turn. Reinitializing the
+// KVS must restore either all or none of the entries.
+TEST(KvsTransaction, InterruptedAtEachWrite_InitRollsBack) {
+  const uint32_t values[] = {Updated(0), Updated(1), Updated(2)};
+  const KeyValue entries[] = {{kKeys[0], as_bytes(span(&values[0], 1))},
+                              {kKeys[1], as_bytes(span(&values[1], 1))},
+                              {kKeys[2], as_bytes(span(&values[2], 1))}};
+
+  for (size_t write = 0; true; ++write) {
+    Flash flash(16);
+    FlashPartition partition(&flash);
+    ASSERT_EQ(OkStatus(), partition.Erase());
+
+    {
+      // Manual recovery leaves the flash as it was when the write failed, as
+      // if the device lost power.
+      Kvs kvs(&partition, kFormat, kManualRecovery);
+      ASSERT_EQ(OkStatus(), kvs.Init());
+      for (uint32_t i = 0; i < kKeys.size(); ++i) {
+        ASSERT_EQ(OkStatus(), kvs.Put(kKeys[i], i));
+      }
+
+      flash.InjectWriteError(
+          FlashError::Unconditional(Status::Unavailable(), 1, write));
+      if (kvs.PutMany(entries).ok()) {
+        ASSERT_GT(write, 3u);  // Should fail at least for the first entries.
+        break;
+      }
+    }
+
+    // The fake flash stores data even when a write fails, so the transaction
+    // is committed if its commit marker was written.
+    Kvs kvs(&partition, kFormat);
+    ASSERT_EQ(OkStatus(), kvs.Init()) << "Write " << write;
+    EXPECT_EQ(kvs.size(), kKeys.size());
+
+    uint32_t first_value = 0;
+    ASSERT_EQ(OkStatus(), kvs.Get(kKeys[0], &first_value));
+    const bool committed = first_value == Updated(0);
+    for (uint32_t i = 0; i < kKeys.size(); ++i) {
+      uint32_t value = 0;
+      ASSERT_EQ(OkStatus(), kvs.Get(kKeys[i], &value));
+      EXPECT_EQ(committed ? Updated(i) : i, value) << "Write " << write;
+    }
+
+    // The rollback completed, so a second Init() needs no repairs.
+    Kvs reloaded(&partition, kFormat, kManualRecovery);
+    ASSERT_EQ(OkStatus(), reloaded.Init());
+    EXPECT_EQ(OkStatus(), reloaded.PutMany(entries));
+  }
+}
+
+#if PW_KVS_REMOVE_DELETED_KEYS_IN_HEAVY_MAINTENANCE
+
+TEST_F(KvsTransactionTest, HeavyMaintenance_KeepsCommittedEntries) {
+  PutInitialValues(kvs_);
+
+  const uint32_t values[] = {Updated(0), Updated(1)};
+  const KeyValue entries[] = {{kKeys[0], as_bytes(span(&values[0], 1))},
+                              {kKeys[1], as_bytes(span(&values[1], 1))}};
+  ASSERT_EQ(OkStatus(), kvs_.PutMany(entries));
+  ASSERT_EQ(OkStatus(), kvs_.Delete(kKeys[2]));
+  ASSERT_EQ(OkStatus(), kvs_.HeavyMaintenance());
+
+  Kvs reloaded(&partition_, kFormat);
+  ASSERT_EQ(OkStatus(), reloaded.Init());
+  EXPECT_EQ(reloaded.size(), 2u);
+  for (uint32_t i = 0; i < 2; ++i) {
+    uint32_t value = 0;
+    ASSERT_EQ(OkStatus(), reloaded.Get(kKeys[i], &value));
+    EXPECT_EQ(Updated(i), value);
+  }
+}
+
+#endif  // PW_KVS_REMOVE_DELETED_KEYS_IN_HEAVY_MAINTENANCE
+
+}  // namespace
+}  // namespace pw::kvs
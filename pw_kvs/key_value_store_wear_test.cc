@@ -115,5 +115,53 @@ TEST_F(WearTest, TwoPassFillWithLargeAndLarger) {
             2u * partition_.average_erase_count());
 }
 
+TEST_F(WearTest, IncrementalMaintenance_NothingToCollect) {
+  EXPECT_EQ(OkStatus(), kvs_.IncrementalMaintenance(128));
+  EXPECT_EQ(0u, kvs_.GetStorageStats().sector_erase_count);
+
+  KeyValueStoreBuffer<kMaxEntries, kSectors> uninitialized(&partition_, format);
+  EXPECT_EQ(Status::FailedPrecondition(),
+            uninitialized.IncrementalMaintenance(128));
+}
+
+// Interleaves writes with steps of incremental maintenance, as an idle hook
+// would, and checks that the writes themselves never garbage collect.
+TEST_F(WearTest, IncrementalMaintenance_WritesDoNotGarbageCollect) {
+  constexpr size_t kMaxStepsBetweenWrites = 16;
+  constexpr size_t kStepBytes = 128;
+  // Each round of writes fills at most two sectors.
+  constexpr size_t kEmptySectorsForWrites = 2;
+
+  partition_.ResetCounters();
+
+  char small_key[] = "small_0";
+  for (size_t i = 0; i < kSectors * 20; ++i) {
+    test_data[0]++;
+
+    // Alternate between a large entry and several small entries, so sectors
+    // hold a mix of valid and stale entries.
+    const size_t erases_before_put = kvs_.GetStorageStats().sector_erase_count;
+    ASSERT_EQ(OkStatus(), kvs_.Put("large_entry", span(test_data)));
+    for (char digit = '0'; digit < '4'; ++digit) {
+      small_key[6] = digit;
+      ASSERT_EQ(OkStatus(),
+                kvs_.Put(small_key, span(test_data, 1 + i % 32)));
+    }
+    EXPECT_EQ(erases_before_put, kvs_.GetStorageStats().sector_erase_count)
+        << "Write " << i << " garbage collected";
+
+    Status status = Status::DeadlineExceeded();
+    for (size_t step = 0;
+         step < kMaxStepsBetweenWrites && status.IsDeadlineExceeded();
+         ++step) {
+      status = kvs_.IncrementalMaintenance(kStepBytes, kEmptySectorsForWrites);
+    }
+    ASSERT_EQ(OkStatus(), status);
+  }
+
+  EXPECT_EQ(5u, kvs_.size());
+  EXPECT_GE(partition_.min_erase_count(), 1u);
+}
+
 }  // namespace
 }  // namespace pw::kvs
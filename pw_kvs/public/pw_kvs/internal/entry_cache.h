@@ -24,6 +24,7 @@
 #include "pw_kvs/internal/key_descriptor.h"
 #include "pw_kvs/internal/sectors.h"
 #include "pw_span/span.h"
+#include "pw_sync/virtual_basic_lockable.h"
 
 namespace pw {
 namespace kvs {
@@ -70,7 +71,8 @@ class EntryMetadata {
   void RemoveAddress(Address address_to_remove);
 
   // Resets the KeyDescrtiptor and addresses to refer to the provided
-  // KeyDescriptor and address.
+  // KeyDescriptor and address. If the EntryCache has a key index, the key hash
+  // MUST NOT change.
   void Reset(const KeyDescriptor& descriptor, Address address);
 
  private:
@@ -152,15 +154,26 @@ class EntryCache {
   template <size_t kMaxEntries, size_t kRedundancy>
   using AddressList = Address[kMaxEntries * kRedundancy + kRedundancy];
 
+  // A slot in the optional key index, which maps key hashes to descriptors.
+  // Each slot holds a descriptor index plus one, or 0 if the slot is empty.
+  using IndexSlot = uint16_t;
+
+  // Creates an EntryCache. If key_index is not empty, it is used as an
+  // open-addressed hash table for finding descriptors by key hash instead of
+  // scanning all descriptors. Its size must be a power of two that is larger
+  // than the maximum number of descriptors. The key index is cleared by
+  // Reset().
   constexpr EntryCache(Vector<KeyDescriptor>& descriptors,
                        Address* addresses,
-                       size_t redundancy)
+                       size_t redundancy,
+                       span<IndexSlot> key_index = {})
       : descriptors_(descriptors),
         addresses_(addresses),
-        redundancy_(redundancy) {}
+        redundancy_(redundancy),
+        key_index_(key_index) {}
 
   // Clears all KeyDescriptors.
-  void Reset() const { descriptors_.clear(); }
+  void Reset() const;
 
   // Finds the metadata for an entry matching a particular key. Searches for a
   // KeyDescriptor that matches this key and sets *metadata to point to it if
@@ -174,11 +187,15 @@ class EntryCache {
   //                 key's hash collides with the hash for an existing
   //                 descriptor
   //
+  // shared_state_lock is held while verifying checksums and marking sectors
+  // corrupt, which modify state shared with other readers.
   StatusWithSize Find(FlashPartition& partition,
                       const Sectors& sectors,
                       const EntryFormats& formats,
                       std::string_view key,
-                      EntryMetadata* metadata) const;
+                      EntryMetadata* metadata,
+                      sync::VirtualBasicLockable& shared_state_lock =
+                          sync::NoOpLock::Instance()) const;
 
   // Adds a new descriptor to the descriptor list. The entry MUST be unique and
   // the EntryCache must NOT be full!
@@ -217,6 +234,9 @@ class EntryCache {
   // The maximum number of entries supported by this EntryCache.
   size_t max_entries() const { return descriptors_.max_size(); }
 
+  // True if descriptors are found through the key index.
+  bool has_key_index() const { return !key_index_.empty(); }
+
   iterator begin() const { return {this, descriptors_.begin()}; }
   const_iterator cbegin() const { return {this, descriptors_.begin()}; }
 
@@ -226,6 +246,23 @@ class EntryCache {
  private:
   int FindIndex(uint32_t key_hash) const;
 
+  // Returns the first key index slot to probe for a key hash.
+  size_t IndexHome(uint32_t key_hash) const {
+    return ((key_hash * 0x9E3779B9u) >> 16) & (key_index_.size() - 1);
+  }
+
+  size_t NextIndexSlot(size_t slot) const {
+    return (slot + 1) & (key_index_.size() - 1);
+  }
+
+  // Returns the key index slot that refers to the descriptor with this hash.
+  // The descriptor MUST be in the key index.
+  size_t IndexSlotOf(uint32_t key_hash) const;
+
+  // Adds or removes the descriptor at descriptor_index to the key index.
+  void IndexInsert(size_t descriptor_index) const;
+  void IndexRemove(size_t descriptor_index) const;
+
   // Adds the address to the descriptor at the specified index if there is an
   // address slot available.
   void AddAddressIfRoom(size_t descriptor_index, Address address) const;
@@ -242,6 +279,7 @@ class EntryCache {
   Vector<KeyDescriptor>& descriptors_;
   FlashPartition::Address* const addresses_;
   const size_t redundancy_;
+  const span<IndexSlot> key_index_;
 };
 
 }  // namespace internal
@@ -0,0 +1,81 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+
+#include "pw_sync/binary_semaphore.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::kvs::internal {
+
+// A lock that may be held by any number of readers at once, or by a single
+// writer. It is built from a mutex and a binary semaphore, so it works with
+// any pw_sync backend.
+//
+// A writer waiting for the lock blocks new readers, so a steady stream of
+// readers cannot starve writers.
+class PW_LOCKABLE("pw::kvs::internal::ReaderWriterLock") ReaderWriterLock {
+ public:
+  ReaderWriterLock() : readers_(0) { resource_.release(); }
+
+  ReaderWriterLock(const ReaderWriterLock&) = delete;
+  ReaderWriterLock& operator=(const ReaderWriterLock&) = delete;
+
+  // Blocks until no other thread holds the lock, then acquires it exclusively.
+  void lock() PW_EXCLUSIVE_LOCK_FUNCTION();
+
+  // Releases a lock acquired with lock().
+  void unlock() PW_UNLOCK_FUNCTION();
+
+  // Blocks until no thread holds or is waiting for the lock exclusively, then
+  // acquires it shared with other readers.
+  void lock_shared() PW_SHARED_LOCK_FUNCTION();
+
+  // Releases a lock acquired with lock_shared().
+  void unlock_shared() PW_UNLOCK_FUNCTION();
+
+ private:
+  // Held by writers while they wait for and hold the lock. Readers pass
+  // through it before registering, so they queue behind a waiting writer.
+  sync::Mutex turnstile_;
+
+  // Guards the reader count.
+  sync::Mutex readers_mutex_;
+  size_t readers_ PW_GUARDED_BY(readers_mutex_);
+
+  // Held by the writer, or by the readers as a group. Readers release it from
+  // whichever thread leaves last, so this cannot be a mutex.
+  sync::BinarySemaphore resource_;
+};
+
+// Holds a ReaderWriterLock shared for the lifetime of the object.
+class PW_SCOPED_LOCKABLE SharedLock {
+ public:
+  explicit SharedLock(ReaderWriterLock& lock) PW_SHARED_LOCK_FUNCTION(lock)
+      : lock_(lock) {
+    lock_.lock_shared();
+  }
+
+  SharedLock(const SharedLock&) = delete;
+  SharedLock& operator=(const SharedLock&) = delete;
+
+  ~SharedLock() PW_UNLOCK_FUNCTION() { lock_.unlock_shared(); }
+
+ private:
+  ReaderWriterLock& lock_;
+};
+
+}  // namespace pw::kvs::internal
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
@@ -31,6 +32,7 @@
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
+#include "pw_sync/virtual_basic_lockable.h"
 
 namespace pw {
 
@@ -198,6 +200,96 @@ class KeyValueStore {
     return PutBytes(key, as_bytes(span<const T>(&value, 1)));
   }
 
+  /// A key and value to write with `PutMany()`.
+  struct KeyValue {
+    std::string_view key;
+    span<const std::byte> value;
+  };
+
+  /// Atomically adds or updates several key-value entries. After a power loss
+  /// or other interruption, `Init()` restores either all or none of the
+  /// entries.
+  ///
+  /// The entries are written contiguously, in as few sectors as possible,
+  /// between a pair of transaction marker entries. The markers are tombstones
+  /// with reserved keys, so they occupy two entries in the KVS's entry cache
+  /// but are not visible as keys.
+  ///
+  /// @param[in] entries The keys and values to write. Each key may only
+  /// appear once.
+  ///
+  /// @returns
+  /// * @OK: All entries were successfully added or updated.
+  /// * @DATA_LOSS: Checksum validation failed after writing data. No entries
+  ///   were updated.
+  /// * @RESOURCE_EXHAUSTED: Not enough space to add the entries. No entries
+  ///   were updated.
+  /// * @ALREADY_EXISTS: An entry could not be added because a different key
+  ///   with the same hash is already in the KVS. No entries were updated.
+  /// * @FAILED_PRECONDITION: The KVS is not initialized. Call `Init()` before
+  ///   calling this method.
+  /// * @INVALID_ARGUMENT: A key is empty, too long, or repeated, or a value is
+  ///   too large.
+  Status PutMany(span<const KeyValue> entries);
+
+  /// Stages up to `kMaxWrites` key-value entries to write atomically with
+  /// `PutMany()`.
+  ///
+  /// The transaction refers to the staged keys and values; it does not copy
+  /// them. They must remain valid until `Commit()` is called.
+  ///
+  /// @code{.cpp}
+  ///   pw::kvs::KeyValueStore::Transaction<2> transaction(kvs);
+  ///   transaction.Put("volume", volume);
+  ///   transaction.Put("brightness", brightness);
+  ///   PW_TRY(transaction.Commit());
+  /// @endcode
+  template <size_t kMaxWrites>
+  class Transaction {
+   public:
+    explicit constexpr Transaction(KeyValueStore& kvs) : kvs_(kvs) {}
+
+    /// Stages a write of a key-value entry.
+    ///
+    /// @returns
+    /// * @OK: The write was staged.
+    /// * @RESOURCE_EXHAUSTED: The transaction already has `kMaxWrites` writes.
+    template <typename T,
+              typename std::enable_if_t<ConvertsToSpan<T>::value>* = nullptr>
+    Status Put(const std::string_view& key, const T& value) {
+      return PutBytes(key, as_bytes(internal::make_span(value)));
+    }
+
+    template <typename T,
+              typename std::enable_if_t<!ConvertsToSpan<T>::value>* = nullptr>
+    Status Put(const std::string_view& key, const T& value) {
+      CheckThatObjectCanBePutOrGet<T>();
+      return PutBytes(key, as_bytes(span<const T>(&value, 1)));
+    }
+
+    /// Writes all staged entries with `PutMany()` and clears the transaction.
+    Status Commit() {
+      Status status = kvs_.PutMany(writes_);
+      writes_.clear();
+      return status;
+    }
+
+    /// The number of staged writes.
+    size_t size() const { return writes_.size(); }
+
+   private:
+    Status PutBytes(std::string_view key, span<const std::byte> value) {
+      if (writes_.full()) {
+        return Status::ResourceExhausted();
+      }
+      writes_.push_back(KeyValue{key, value});
+      return OkStatus();
+    }
+
+    KeyValueStore& kvs_;
+    Vector<KeyValue, kMaxWrites> writes_;
+  };
+
   /// Removes a key-value entry from the KVS.
   ///
   /// @param[in] key - The name of the key-value entry to delete.
@@ -254,6 +346,33 @@ class KeyValueStore {
   /// that makes sense for the KVS implementation.
   Status PartialMaintenance();
 
+  /// Performs a bounded step of garbage collection, so that maintenance can
+  /// be spread over idle time instead of blocking a write. Each call either
+  /// relocates valid entries out of the sector being collected, stopping once
+  /// `max_relocated_bytes` have been moved, or erases that sector once it has
+  /// no valid entries. At least one entry is relocated per call.
+  ///
+  /// Sectors are collected until the KVS has `empty_sectors_for_writes` empty
+  /// sectors in addition to the one it reserves for garbage collection. As
+  /// long as these steps keep up with writes, `Put()` does not need to garbage
+  /// collect. Keep enough empty sectors for the largest burst of writes
+  /// between steps.
+  ///
+  /// Call this from an idle hook or a low-priority task while it returns
+  /// `DEADLINE_EXCEEDED`. To bound time rather than bytes, use a small budget
+  /// and stop calling it when the time is up.
+  ///
+  /// If configured for at least lazy recovery, repairs any corruption first.
+  /// Repairs are not bounded by `max_relocated_bytes`.
+  ///
+  /// @returns
+  /// * @OK: No garbage collection is needed.
+  /// * @DEADLINE_EXCEEDED: The step completed and more work remains.
+  /// * @FAILED_PRECONDITION: The KVS is not initialized. Call `Init()` before
+  ///   calling this method.
+  Status IncrementalMaintenance(size_t max_relocated_bytes,
+                                size_t empty_sectors_for_writes = 1);
+
   void LogDebugInfo() const;
 
   // Classes and functions to support STL-style iteration.
@@ -434,9 +553,12 @@ class KeyValueStore {
                 Vector<SectorDescriptor>& sector_descriptor_list,
                 const SectorDescriptor** temp_sectors_to_skip,
                 Vector<KeyDescriptor>& key_descriptor_list,
-                Address* addresses);
+                Address* addresses,
+                span<internal::EntryCache::IndexSlot> key_index = {});
 
  private:
+  friend class ThreadSafeKeyValueStore;
+
   using EntryMetadata = internal::EntryMetadata;
   using EntryState = internal::EntryState;
 
@@ -451,7 +573,22 @@ class KeyValueStore {
   }
 
   Status InitializeMetadata();
-  Status LoadEntry(Address entry_address, Address* next_entry_address);
+
+  // Loads entries from flash, ignoring entries with transaction IDs newer
+  // than newest_transaction_id.
+  Status LoadMetadata(uint32_t newest_transaction_id);
+
+  // Returns the transaction ID of the begin marker of an interrupted
+  // transaction, or 0 if the last transaction was committed.
+  uint32_t InterruptedTransactionId() const;
+
+  //       OK: the entry was loaded
+  //  ABORTED: the entry is valid, but is newer than newest_transaction_id
+  //
+  // Otherwise returns the errors of Entry::Read.
+  Status LoadEntry(Address entry_address,
+                   Address* next_entry_address,
+                   uint32_t newest_transaction_id);
   Status ScanForEntry(const SectorDescriptor& sector,
                       Address start_address,
                       Address* next_entry_address);
@@ -522,6 +659,38 @@ class KeyValueStore {
                     EntryMetadata* prior_metadata = nullptr,
                     const internal::Entry* prior_entry = nullptr);
 
+  // Writes an entry and its redundant copies at the next writable addresses of
+  // the sectors that contain the reserved addresses.
+  Status WriteEntryToSectors(const Address* reserved_addresses,
+                             std::string_view key,
+                             span<const std::byte> value,
+                             EntryState new_state,
+                             EntryMetadata* prior_metadata,
+                             size_t prior_size);
+
+  // Checks that the entry cache and flash have room for a PutMany(). Garbage
+  // collects sectors as needed, since this cannot be done once the
+  // transaction starts.
+  Status PrepareTransaction(span<const KeyValue> entries);
+
+  // Writes the entries of a PutMany() between the transaction markers. Entries
+  // are written in runs that fit in one sector.
+  Status WriteTransactionEntries(span<const KeyValue> entries);
+
+  // Writes one entry of a transaction to the sectors that were reserved for
+  // it, replacing the prior entry for the key, if any.
+  Status WriteTransactionEntry(const Address* reserved_addresses,
+                               std::string_view key,
+                               span<const std::byte> value,
+                               EntryState new_state);
+
+  // Writes a tombstone for a transaction marker key.
+  Status WriteTransactionMarker(std::string_view marker_key);
+
+  // Reloads the KVS after a failed PutMany(), which discards the entries
+  // written by the transaction, and repairs it if the options allow.
+  void RollBackTransaction();
+
   EntryMetadata CreateOrUpdateKeyDescriptor(const Entry& new_entry,
                                             std::string_view key,
                                             EntryMetadata* prior_metadata,
@@ -552,6 +721,21 @@ class KeyValueStore {
                        KeyValueStore::Address& address,
                        span<const Address> reserved_addresses);
 
+  // Copies an entry to the next writable address in new_sector and updates
+  // address, which refers to the copy being moved, to the new location.
+  Status MoveEntryToSector(Entry& entry,
+                           SectorDescriptor* new_sector,
+                           KeyValueStore::Address& address);
+
+  // Returns the sector that IncrementalMaintenance() is collecting, selecting
+  // a new one if needed, or nullptr if no sector needs to be collected.
+  SectorDescriptor* IncrementalGarbageCollectionSector(
+      size_t empty_sectors_for_writes);
+
+  // Returns OK if no more sectors need incremental garbage collection, or
+  // DEADLINE_EXCEEDED if more do.
+  Status IncrementalMaintenanceStatus(size_t empty_sectors_for_writes);
+
   // Perform all maintenance possible, including all neeeded repairing of
   // corruption and garbage collection of reclaimable space in the KVS. When
   // configured for manual recovery, this is the only way KVS repair is
@@ -610,8 +794,9 @@ class KeyValueStore {
   // List of sectors used by this KVS.
   internal::Sectors sectors_;
 
-  // Unordered list of KeyDescriptors. Finding a key requires scanning and
-  // verifying a match by reading the actual entry.
+  // Unordered list of KeyDescriptors. Finding a key requires scanning, or a
+  // key index lookup if one is provided, and verifying a match by reading the
+  // actual entry.
   internal::EntryCache entry_cache_;
 
   Options options_;
@@ -636,9 +821,28 @@ class KeyValueStore {
   };
   InitializationState initialized_;
 
+  // The sector that IncrementalMaintenance() is relocating entries out of.
+  SectorDescriptor* incremental_gc_sector_;
+
+  // Set while PutMany() writes its entries. Garbage collection is disabled so
+  // that the prior values of the keys remain in flash until the commit marker
+  // is written.
+  bool transaction_in_progress_;
+
+  // Set when Init() found an interrupted transaction. Once the sectors with
+  // the transaction's entries are garbage collected, a commit marker is
+  // written to finish the rollback.
+  bool transaction_rollback_pending_;
+
   // error_detected_ needs to be set from const KVS methods (such as Get), so
-  // make it mutable.
-  mutable bool error_detected_;
+  // make it mutable. It is atomic so that concurrent readers may set it.
+  mutable std::atomic<bool> error_detected_;
+
+  // Held by const methods while they use the entry formats' checksums or mark
+  // sectors corrupt, which modifies state shared between readers. This is a
+  // no-op lock unless set by ThreadSafeKeyValueStore, which allows concurrent
+  // readers.
+  sync::VirtualBasicLockable* shared_state_lock_;
 
   struct InternalStats {
     size_t sector_erase_count;
@@ -650,10 +854,18 @@ class KeyValueStore {
   uint32_t last_transaction_id_;
 };
 
+// Allocates the buffers for a KeyValueStore.
+//
+// kKeyIndexSlots optionally enables a hash index from key hash to entry, which
+// makes finding a key O(1) on average instead of O(kMaxEntries). This speeds
+// up Get, Put, Delete, and Init for KVSs with many entries, at a cost of 2
+// bytes of RAM per slot. If nonzero, kKeyIndexSlots must be a power of two
+// larger than kMaxEntries; about twice kMaxEntries is a good choice.
 template <size_t kMaxEntries,
           size_t kMaxUsableSectors,
           size_t kRedundancy = 1,
-          size_t kEntryFormats = 1>
+          size_t kEntryFormats = 1,
+          size_t kKeyIndexSlots = 0>
 class KeyValueStoreBuffer : public KeyValueStore {
  public:
   // Constructs a KeyValueStore on the partition, with support for one
@@ -682,9 +894,11 @@ class KeyValueStoreBuffer : public KeyValueStore {
                       sectors_,
                       temp_sectors_to_skip_,
                       key_descriptors_,
-                      addresses_),
+                      addresses_,
+                      key_index_),
         sectors_(),
         key_descriptors_(),
+        key_index_(),
         formats_() {
     std::copy(formats.begin(), formats.end(), formats_.begin());
   }
@@ -694,6 +908,13 @@ class KeyValueStoreBuffer : public KeyValueStore {
   static_assert(kMaxUsableSectors > 0u);
   static_assert(kRedundancy > 0u);
   static_assert(kEntryFormats > 0u);
+  static_assert(kKeyIndexSlots == 0u ||
+                    (kKeyIndexSlots > kMaxEntries &&
+                     (kKeyIndexSlots & (kKeyIndexSlots - 1)) == 0u),
+                "kKeyIndexSlots must be 0 or a power of two larger than "
+                "kMaxEntries");
+  static_assert(kKeyIndexSlots == 0u || kMaxEntries < 0xFFFFu,
+                "The key index supports at most 65534 entries");
 
   Vector<SectorDescriptor, kMaxUsableSectors> sectors_;
 
@@ -714,6 +935,10 @@ class KeyValueStoreBuffer : public KeyValueStore {
   // KeyDescriptors.
   internal::EntryCache::AddressList<kRedundancy, kMaxEntries> addresses_;
 
+  // Optional open-addressed hash table that maps key hashes to entries in the
+  // EntryCache.
+  std::array<internal::EntryCache::IndexSlot, kKeyIndexSlots> key_index_;
+
   // EntryFormats that can be read by this KeyValueStore.
   std::array<EntryFormat, kEntryFormats> formats_;
 };
@@ -0,0 +1,141 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+
+#include "pw_kvs/internal/reader_writer_lock.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_status/status_with_size.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_sync/virtual_basic_lockable.h"
+
+namespace pw::kvs {
+
+/// Provides thread-safe access to a `KeyValueStore`.
+///
+/// Reads (`Get()`, `ValueSize()`, `ForEach()`, and the accessors) share a
+/// reader-writer lock, so any number of threads may read at once. Writes and
+/// maintenance hold the lock exclusively. Since garbage collection and repair
+/// only run from writes and maintenance, readers never see an entry while it
+/// is being relocated. Readers only exclude each other while they verify a
+/// checksum, since checksum algorithms keep their state in the shared
+/// `EntryFormat`.
+///
+/// Readers may call the `FlashMemory`'s `Read()` concurrently, so it must be
+/// safe to call from multiple threads. The wrapped `KeyValueStore` must only
+/// be accessed through this class while it exists.
+class ThreadSafeKeyValueStore {
+ public:
+  explicit ThreadSafeKeyValueStore(KeyValueStore& kvs) : kvs_(kvs) {
+    kvs_.shared_state_lock_ = &shared_state_mutex_;
+  }
+
+  ~ThreadSafeKeyValueStore() {
+    kvs_.shared_state_lock_ = &sync::NoOpLock::Instance();
+  }
+
+  ThreadSafeKeyValueStore(const ThreadSafeKeyValueStore&) = delete;
+  ThreadSafeKeyValueStore& operator=(const ThreadSafeKeyValueStore&) = delete;
+
+  /// @copydoc KeyValueStore::Init
+  Status Init() PW_LOCKS_EXCLUDED(lock_);
+
+  bool initialized() const PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::Get
+  StatusWithSize Get(std::string_view key,
+                     span<std::byte> value,
+                     size_t offset_bytes = 0) const PW_LOCKS_EXCLUDED(lock_);
+
+  /// Overload of `Get()` that accepts a pointer to a trivially copyable
+  /// object.
+  template <typename Pointer,
+            typename = std::enable_if_t<std::is_pointer<Pointer>::value>>
+  Status Get(const std::string_view& key, const Pointer& pointer) const
+      PW_LOCKS_EXCLUDED(lock_) {
+    internal::SharedLock lock(lock_);
+    return kvs_.Get(key, pointer);
+  }
+
+  /// @copydoc KeyValueStore::Put
+  template <typename T>
+  Status Put(const std::string_view& key, const T& value)
+      PW_LOCKS_EXCLUDED(lock_) {
+    std::lock_guard lock(lock_);
+    return kvs_.Put(key, value);
+  }
+
+  /// @copydoc KeyValueStore::PutMany
+  Status PutMany(span<const KeyValueStore::KeyValue> entries)
+      PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::Delete
+  Status Delete(std::string_view key) PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::ValueSize
+  StatusWithSize ValueSize(std::string_view key) const
+      PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::HeavyMaintenance
+  Status HeavyMaintenance() PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::FullMaintenance
+  Status FullMaintenance() PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::PartialMaintenance
+  Status PartialMaintenance() PW_LOCKS_EXCLUDED(lock_);
+
+  /// @copydoc KeyValueStore::IncrementalMaintenance
+  Status IncrementalMaintenance(size_t max_relocated_bytes,
+                                size_t empty_sectors_for_writes = 1)
+      PW_LOCKS_EXCLUDED(lock_);
+
+  /// Calls `function` with each `KeyValueStore::Item` in the KVS while holding
+  /// the lock shared. `function` may read the item's value, but must not call
+  /// into this `ThreadSafeKeyValueStore`.
+  template <typename Function>
+  void ForEach(Function&& function) const PW_LOCKS_EXCLUDED(lock_) {
+    internal::SharedLock lock(lock_);
+    for (const KeyValueStore::Item& item : kvs_) {
+      function(item);
+    }
+  }
+
+  size_t size() const PW_LOCKS_EXCLUDED(lock_);
+
+  size_t max_size() const PW_LOCKS_EXCLUDED(lock_);
+
+  bool empty() const PW_LOCKS_EXCLUDED(lock_) { return size() == 0u; }
+
+  KeyValueStore::StorageStats GetStorageStats() const PW_LOCKS_EXCLUDED(lock_);
+
+  bool error_detected() const PW_LOCKS_EXCLUDED(lock_);
+
+ private:
+  mutable internal::ReaderWriterLock lock_;
+  KeyValueStore& kvs_ PW_GUARDED_BY(lock_);
+
+  // Set as the KVS's shared_state_lock_, so that readers holding lock_ shared
+  // take turns using checksums and marking corrupt sectors.
+  sync::VirtualMutex shared_state_mutex_;
+};
+
+}  // namespace pw::kvs
@@ -0,0 +1,132 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_kvs/thread_safe_key_value_store.h"
+
+#include <mutex>
+
+namespace pw::kvs {
+namespace internal {
+
+// The lock and unlock functions acquire and release the underlying primitives
+// in different calls, which the thread safety analysis cannot follow.
+
+void ReaderWriterLock::lock() PW_NO_LOCK_SAFETY_ANALYSIS {
+  turnstile_.lock();
+  resource_.acquire();
+}
+
+void ReaderWriterLock::unlock() PW_NO_LOCK_SAFETY_ANALYSIS {
+  resource_.release();
+  turnstile_.unlock();
+}
+
+void ReaderWriterLock::lock_shared() PW_NO_LOCK_SAFETY_ANALYSIS {
+  // Wait behind any writer that holds or is waiting for the lock.
+  turnstile_.lock();
+  turnstile_.unlock();
+
+  std::lock_guard lock(readers_mutex_);
+  if (readers_ == 0u) {
+    resource_.acquire();
+  }
+  readers_ += 1;
+}
+
+void ReaderWriterLock::unlock_shared() PW_NO_LOCK_SAFETY_ANALYSIS {
+  std::lock_guard lock(readers_mutex_);
+  readers_ -= 1;
+  if (readers_ == 0u) {
+    resource_.release();
+  }
+}
+
+}  // namespace internal
+
+Status ThreadSafeKeyValueStore::Init() {
+  std::lock_guard lock(lock_);
+  return kvs_.Init();
+}
+
+bool ThreadSafeKeyValueStore::initialized() const {
+  internal::SharedLock lock(lock_);
+  return kvs_.initialized();
+}
+
+StatusWithSize ThreadSafeKeyValueStore::Get(std::string_view key,
+                                            span<std::byte> value,
+                                            size_t offset_bytes) const {
+  internal::SharedLock lock(lock_);
+  return kvs_.Get(key, value, offset_bytes);
+}
+
+Status ThreadSafeKeyValueStore::PutMany(
+    span<const KeyValueStore::KeyValue> entries) {
+  std::lock_guard lock(lock_);
+  return kvs_.PutMany(entries);
+}
+
+Status ThreadSafeKeyValueStore::Delete(std::string_view key) {
+  std::lock_guard lock(lock_);
+  return kvs_.Delete(key);
+}
+
+StatusWithSize ThreadSafeKeyValueStore::ValueSize(std::string_view key) const {
+  internal::SharedLock lock(lock_);
+  return kvs_.ValueSize(key);
+}
+
+Status ThreadSafeKeyValueStore::HeavyMaintenance() {
+  std::lock_guard lock(lock_);
+  return kvs_.HeavyMaintenance();
+}
+
+Status ThreadSafeKeyValueStore::FullMaintenance() {
+  std::lock_guard lock(lock_);
+  return kvs_.FullMaintenance();
+}
+
+Status ThreadSafeKeyValueStore::PartialMaintenance() {
+  std::lock_guard lock(lock_);
+  return kvs_.PartialMaintenance();
+}
+
+Status ThreadSafeKeyValueStore::IncrementalMaintenance(
+    size_t max_relocated_bytes, size_t empty_sectors_for_writes) {
+  std::lock_guard lock(lock_);
+  return kvs_.IncrementalMaintenance(max_relocated_bytes,
+                                     empty_sectors_for_writes);
+}
+
+size_t ThreadSafeKeyValueStore::size() const {
+  internal::SharedLock lock(lock_);
+  return kvs_.size();
+}
+
+size_t ThreadSafeKeyValueStore::max_size() const {
+  internal::SharedLock lock(lock_);
+  return kvs_.max_size();
+}
+
+KeyValueStore::StorageStats ThreadSafeKeyValueStore::GetStorageStats() const {
+  internal::SharedLock lock(lock_);
+  return kvs_.GetStorageStats();
+}
+
+bool ThreadSafeKeyValueStore::error_detected() const {
+  internal::SharedLock lock(lock_);
+  return kvs_.error_detected();
+}
+
+}  // namespace pw::kvs
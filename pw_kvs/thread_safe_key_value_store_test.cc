@@ -0,0 +1,204 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_kvs/thread_safe_key_value_store.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_kvs/crc16_checksum.h"
+#include "pw_kvs/fake_flash_memory.h"
+#include "pw_kvs/flash_memory.h"
+#include "pw_kvs/key_value_store.h"
+#include "pw_log/log.h"
+#include "pw_thread/thread.h"
+#include "pw_thread_stl/options.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::kvs {
+namespace {
+
+constexpr size_t kSectorSize = 1024;
+constexpr size_t kSectorCount = 8;
+constexpr size_t kMaxEntries = 16;
+
+ChecksumCrc16 checksum;
+
+// For KVS magic value always use a random 32 bit integer rather than a
+// human readable 4 bytes. See pw_kvs/format.h for more information.
+constexpr EntryFormat kFormat{.magic = 0x4b2a9f10, .checksum = &checksum};
+
+constexpr std::array<std::string_view, 4> kKeys = {"w", "x", "y", "z"};
+
+// Each write stores the same counter twice, so a reader can tell if it read a
+// value that was partially written or mixed from two entries.
+struct Value {
+  uint32_t counter;
+  uint32_t check;
+};
+
+class ThreadSafeKvsTest : public ::testing::Test {
+ protected:
+  ThreadSafeKvsTest()
+      : flash_(kFlashAlignment),
+        partition_(&flash_),
+        kvs_(&partition_, kFormat),
+        thread_safe_kvs_(kvs_) {}
+
+  void SetUp() override {
+    ASSERT_EQ(OkStatus(), partition_.Erase());
+    ASSERT_EQ(OkStatus(), thread_safe_kvs_.Init());
+  }
+
+  static constexpr size_t kFlashAlignment = 16;
+
+  FakeFlashMemoryBuffer<kSectorSize, kSectorCount> flash_;
+  FlashPartition partition_;
+  KeyValueStoreBuffer<kMaxEntries, kSectorCount> kvs_;
+  ThreadSafeKeyValueStore thread_safe_kvs_;
+};
+
+TEST_F(ThreadSafeKvsTest, ReadsAndWrites) {
+  EXPECT_TRUE(thread_safe_kvs_.initialized());
+  EXPECT_TRUE(thread_safe_kvs_.empty());
+  EXPECT_EQ(thread_safe_kvs_.max_size(), kMaxEntries);
+
+  ASSERT_EQ(OkStatus(), thread_safe_kvs_.Put(kKeys[0], Value{1, 1}));
+  const uint32_t other = 2;
+  const KeyValueStore::KeyValue entries[] = {
+      {kKeys[1], as_bytes(span(&other, 1))},
+      {kKeys[2], as_bytes(span(&other, 1))}};
+  ASSERT_EQ(OkStatus(), thread_safe_kvs_.PutMany(entries));
+  EXPECT_EQ(thread_safe_kvs_.size(), 3u);
+
+  Value value{};
+  ASSERT_EQ(OkStatus(), thread_safe_kvs_.Get(kKeys[0], &value));
+  EXPECT_EQ(value.counter, 1u);
+  EXPECT_EQ(thread_safe_kvs_.ValueSize(kKeys[1]).size(), sizeof(other));
+
+  size_t count = 0;
+  thread_safe_kvs_.ForEach([&count](const KeyValueStore::Item& item) {
+    EXPECT_NE(std::string_view(item.key()), kKeys[3]);
+    count += 1;
+  });
+  EXPECT_EQ(count, 3u);
+
+  ASSERT_EQ(OkStatus(), thread_safe_kvs_.Delete(kKeys[2]));
+  EXPECT_EQ(Status::NotFound(), thread_safe_kvs_.Get(kKeys[2], &value));
+  EXPECT_EQ(thread_safe_kvs_.size(), 2u);
+
+  EXPECT_EQ(OkStatus(), thread_safe_kvs_.FullMaintenance());
+  EXPECT_FALSE(thread_safe_kvs_.error_detected());
+}
+
+// State shared between the test and its threads. pw::Function can only
+// capture one pointer without allocating, so threads capture this struct.
+struct Context {
+  explicit Context(ThreadSafeKeyValueStore& store) : kvs(store) {}
+
+  ThreadSafeKeyValueStore& kvs;
+  std::atomic<bool> writing{true};
+  std::atomic<uint32_t> reads{0};
+  std::atomic<uint32_t> read_errors{0};
+  uint32_t writes = 0;
+  Status write_status;
+};
+
+constexpr size_t kReaderThreads = 3;
+constexpr uint32_t kWriteRounds = 400;
+
+void Reader(Context& context) {
+  std::array<uint32_t, kKeys.size()> last_counters{};
+  while (context.writing.load()) {
+    for (size_t i = 0; i < kKeys.size(); ++i) {
+      Value value{};
+      if (!context.kvs.Get(kKeys[i], &value).ok() ||
+          value.counter != value.check || value.counter < last_counters[i]) {
+        context.read_errors.fetch_add(1);
+      }
+      last_counters[i] = value.counter;
+      context.reads.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+// Rewrites every key repeatedly, so that writes regularly garbage collect and
+// relocate the entries readers are reading. Also runs incremental maintenance,
+// which relocates entries without a write.
+void Writer(Context& context) {
+  for (uint32_t counter = 1; counter <= kWriteRounds; ++counter) {
+    for (std::string_view key : kKeys) {
+      Status status = context.kvs.Put(key, Value{counter, counter});
+      if (!status.ok()) {
+        context.write_status = status;
+        context.writing.store(false);
+        return;
+      }
+      context.writes += 1;
+    }
+    if (counter % 16 == 0) {
+      while (context.kvs.IncrementalMaintenance(64).IsDeadlineExceeded()) {
+      }
+    }
+  }
+  context.writing.store(false);
+}
+
+TEST_F(ThreadSafeKvsTest, ConcurrentReadersAndWriter) {
+  for (std::string_view key : kKeys) {
+    ASSERT_EQ(OkStatus(), thread_safe_kvs_.Put(key, Value{0, 0}));
+  }
+
+  Context context(thread_safe_kvs_);
+  const auto start = std::chrono::steady_clock::now();
+  {
+    std::array<Thread, kReaderThreads> readers;
+    for (Thread& reader : readers) {
+      reader = Thread(thread::stl::Options(), [&context] { Reader(context); });
+    }
+    Thread writer(thread::stl::Options(), [&context] { Writer(context); });
+
+    writer.join();
+    for (Thread& reader : readers) {
+      reader.join();
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(OkStatus(), context.write_status);
+  EXPECT_EQ(context.writes, kWriteRounds * kKeys.size());
+  EXPECT_EQ(context.read_errors.load(), 0u);
+  EXPECT_GT(context.reads.load(), 0u);
+
+  const auto elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  PW_LOG_INFO("%u reader threads: %u reads and %u writes in %u us",
+              static_cast<unsigned>(kReaderThreads),
+              static_cast<unsigned>(context.reads.load()),
+              static_cast<unsigned>(context.writes),
+              static_cast<unsigned>(elapsed_us));
+
+  for (size_t i = 0; i < kKeys.size(); ++i) {
+    Value value{};
+    ASSERT_EQ(OkStatus(), thread_safe_kvs_.Get(kKeys[i], &value));
+    EXPECT_EQ(value.counter, kWriteRounds);
+  }
+}
+
+}  // namespace
+}  // namespace pw::kvs
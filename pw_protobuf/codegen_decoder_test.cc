@@ -1305,6 +1305,71 @@ TEST(Codegen, FindStreamShadowed) {
   EXPECT_EQ(Pigweed::FindMagicNumber(reader).value(), 99u);
 }
 
+TEST(Codegen, View) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.error_message
+    0x2a, 0x10, 'n', 'o', 't', ' ', 'a', ' ',
+    't', 'y', 'p', 'e', 'w', 'r', 'i', 't', 'e', 'r',
+    // pigweed.pigweed
+    0x3a, 0x02,
+    // pigweed.pigweed.status
+    0x08, 0x02,
+    // pigweed.id[0]
+    0x52, 0x02,
+    // pigweed.id[0].id
+    0x08, 0x31,
+    // pigweed.id[1]
+    0x52, 0x02,
+    // pigweed.id[1].id
+    0x08, 0x39,
+  };
+  // clang-format on
+
+  const Pigweed::View pigweed(as_bytes(span(proto_data)));
+  EXPECT_EQ(pigweed.magic_number().value(), 0x49u);
+
+  // Strings refer to the serialized message rather than being copied.
+  Result<std::string_view> error_message = pigweed.error_message();
+  ASSERT_EQ(error_message.status(), OkStatus());
+  EXPECT_EQ(*error_message, "not a typewriter");
+  EXPECT_EQ(error_message->data(),
+            reinterpret_cast<const char*>(&proto_data[4]));
+
+  Result<Pigweed::Pigweed::View> nested = pigweed.pigweed();
+  ASSERT_EQ(nested.status(), OkStatus());
+  EXPECT_EQ(nested->status().value(), Bool::FILE_NOT_FOUND);
+
+  BytesFinder ids = pigweed.id();
+  Result<ConstByteSpan> id = ids.Next();
+  ASSERT_EQ(id.status(), OkStatus());
+  EXPECT_EQ(Proto::ID::View(*id).id().value(), 0x31u);
+  id = ids.Next();
+  ASSERT_EQ(id.status(), OkStatus());
+  EXPECT_EQ(Proto::ID::View(*id).id().value(), 0x39u);
+  EXPECT_EQ(ids.Next().status(), Status::NotFound());
+
+  EXPECT_EQ(pigweed.ziggy().status(), Status::NotFound());
+  EXPECT_EQ(pigweed.device_info().status(), Status::NotFound());
+  EXPECT_EQ(pigweed.proto().status(), Status::NotFound());
+}
+
+TEST(Codegen, ViewShadowed) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number = 42
+    0x08, 0x2a,
+    // pigweed.magic_number = 99
+    0x08, 0x63,
+  };
+  // clang-format on
+
+  EXPECT_EQ(Pigweed::View(as_bytes(span(proto_data))).magic_number().value(),
+            99u);
+}
+
 TEST(CodegenRepeated, Find) {
   // clang-format off
   constexpr uint8_t proto_data[] = {
@@ -1342,6 +1407,38 @@ TEST(CodegenRepeated, Find) {
   EXPECT_EQ(fixed32s_finder.Next().status(), Status::NotFound());
 }
 
+TEST(CodegenRepeated, View) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0, 16, 32, 48}
+    0x08, 0x00,
+    0x08, 0x10,
+    0x08, 0x20,
+    0x08, 0x30,
+    // strings[], v={"a", "bc"}
+    0x1a, 0x01, 'a',
+    0x1a, 0x02, 'b', 'c',
+  };
+  // clang-format on
+
+  const RepeatedTest::View repeated(as_bytes(span(proto_data)));
+
+  Uint32Finder uint32s_finder = repeated.uint32s();
+  for (uint32_t i = 0; i < 4; ++i) {
+    Result<uint32_t> result = uint32s_finder.Next();
+    EXPECT_EQ(result.status(), OkStatus());
+    EXPECT_EQ(result.value(), i * 16u);
+  }
+  EXPECT_EQ(uint32s_finder.Next().status(), Status::NotFound());
+
+  StringFinder strings_finder = repeated.strings();
+  EXPECT_EQ(strings_finder.Next().value(), "a");
+  EXPECT_EQ(strings_finder.Next().value(), "bc");
+  EXPECT_EQ(strings_finder.Next().status(), Status::NotFound());
+
+  EXPECT_EQ(repeated.fixed32s().Next().status(), Status::NotFound());
+}
+
 TEST(CodegenRepeated, FindStream) {
   // clang-format off
   constexpr uint8_t proto_data[] = {
@@ -1351,6 +1351,278 @@ TEST(CodegenMessage, DISABLED_ReadDoesNotOverrun) {
   std::ignore = decoder.Read(message, kMessageFields);
 }
 
+TEST(CodegenMessage, Decode) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+    // pigweed.cycles
+    0x19, 0xde, 0xad, 0xca, 0xfe, 0x10, 0x20, 0x30, 0x40,
+    // pigweed.ratio
+    0x25, 0x8f, 0xc2, 0xb5, 0xbf,
+    // pigweed.error_message
+    0x2a, 0x10, 'n', 'o', 't', ' ', 'a', ' ',
+    't', 'y', 'p', 'e', 'w', 'r', 'i', 't', 'e', 'r',
+    // pigweed.bin
+    0x40, 0x01,
+    // pigweed.bungle
+    0x70, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+  };
+  // clang-format on
+
+  Pigweed::Message message{};
+  ASSERT_EQ(Pigweed::Decode(as_bytes(span(proto_data)), message), OkStatus());
+
+  EXPECT_EQ(message.magic_number, 0x49u);
+  EXPECT_EQ(message.ziggy, -111);
+  EXPECT_EQ(message.cycles, 0x40302010fecaaddeu);
+  EXPECT_EQ(message.ratio, -1.42f);
+  EXPECT_EQ(std::string_view(message.error_message), "not a typewriter");
+  EXPECT_EQ(message.bin, Pigweed::Protobuf::Binary::ZERO);
+  EXPECT_EQ(message.bungle, -111);
+}
+
+TEST(CodegenMessage, DecodeOutOfOrder) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.bungle
+    0x70, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+    // unknown field 1000
+    0xc0, 0x3e, 0x01,
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.ziggy
+    0x10, 0x02,
+  };
+  // clang-format on
+
+  Pigweed::Message message{};
+  ASSERT_EQ(Pigweed::Decode(as_bytes(span(proto_data)), message), OkStatus());
+
+  EXPECT_EQ(message.magic_number, 0x49u);
+  EXPECT_EQ(message.ziggy, 1);
+  EXPECT_EQ(message.bungle, -111);
+}
+
+TEST(CodegenMessage, DecodeRepeatedScalar) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0, 16}
+    0x08, 0x00,
+    0x08, 0x10,
+    // uint32s[], v={32, 48}
+    0x0a, 0x02,
+    0x20,
+    0x30,
+    // fixed32s[]. v={0, 16}
+    0x32, 0x08,
+    0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00,
+    // fixed32s[]. v={32, 48}
+    0x35, 0x20, 0x00, 0x00, 0x00,
+    0x35, 0x30, 0x00, 0x00, 0x00,
+    // uint64s[], v={1000, 2000, 3000, 4000}
+    0x42, 0x08, 0xe8, 0x07, 0xd0, 0x0f, 0xb8, 0x17, 0xa0, 0x1f,
+    // doubles[], v={3.14159, 2.71828}
+    0x22, 0x10,
+    0x6e, 0x86, 0x1b, 0xf0, 0xf9, 0x21, 0x09, 0x40,
+    0x90, 0xf7, 0xaa, 0x95, 0x09, 0xbf, 0x05, 0x40,
+  };
+  // clang-format on
+
+  RepeatedTest::Message message{};
+  ASSERT_EQ(RepeatedTest::Decode(as_bytes(span(proto_data)), message),
+            OkStatus());
+
+  ASSERT_EQ(message.uint32s.size(), 4u);
+  for (unsigned short i = 0; i < 4; ++i) {
+    EXPECT_EQ(message.uint32s[i], i * 16u);
+  }
+
+  ASSERT_EQ(message.fixed32s.size(), 4u);
+  for (unsigned short i = 0; i < 4; ++i) {
+    EXPECT_EQ(message.fixed32s[i], i * 16u);
+  }
+
+  EXPECT_EQ(message.uint64s[0], 1000u);
+  EXPECT_EQ(message.uint64s[1], 2000u);
+  EXPECT_EQ(message.uint64s[2], 3000u);
+  EXPECT_EQ(message.uint64s[3], 4000u);
+
+  EXPECT_EQ(message.doubles[0], 3.14159);
+  EXPECT_EQ(message.doubles[1], 2.71828);
+}
+
+TEST(CodegenMessage, DecodePackedScalarExhausted) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // uint32s[], v={0, 16, 32, 48, 64, 80, 96, 112, 128}
+    0x0a, 0x0a,
+    0x00,
+    0x10,
+    0x20,
+    0x30,
+    0x40,
+    0x50,
+    0x60,
+    0x70,
+    0x80, 0x01,
+  };
+  // clang-format on
+
+  // uint32s has max_count=8, and we're trying to read 9.
+  RepeatedTest::Message message{};
+  EXPECT_EQ(RepeatedTest::Decode(as_bytes(span(proto_data)), message),
+            Status::ResourceExhausted());
+}
+
+TEST(CodegenMessage, DecodeNested) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.pigweed
+    0x3a, 0x02,
+    // pigweed.pigweed.status
+    0x08, 0x02,
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+  };
+  // clang-format on
+
+  Pigweed::Message message{};
+  ASSERT_EQ(Pigweed::Decode(as_bytes(span(proto_data)), message), OkStatus());
+
+  EXPECT_EQ(message.magic_number, 0x49u);
+  EXPECT_EQ(message.pigweed.status, Bool::FILE_NOT_FOUND);
+  EXPECT_EQ(message.ziggy, -111);
+}
+
+TEST(CodegenMessage, DecodeOptionalPresent) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // optional.sometimes_present_fixed
+    0x0d, 0x2a, 0x00, 0x00, 0x00,
+    // optional.sometimes_present_varint
+    0x10, 0x2a,
+    // optional.explicitly_present_fixed
+    0x1d, 0x45, 0x00, 0x00, 0x00,
+    // optional.explicitly_present_varint
+    0x20, 0x45,
+  };
+  // clang-format on
+
+  OptionalTest::Message message{};
+  ASSERT_EQ(OptionalTest::Decode(as_bytes(span(proto_data)), message),
+            OkStatus());
+
+  EXPECT_EQ(message.sometimes_present_fixed, 0x2a);
+  EXPECT_EQ(message.sometimes_present_varint, 0x2a);
+  ASSERT_TRUE(message.explicitly_present_fixed);
+  EXPECT_EQ(*message.explicitly_present_fixed, 0x45);
+  ASSERT_TRUE(message.explicitly_present_varint);
+  EXPECT_EQ(*message.explicitly_present_varint, 0x45);
+}
+
+TEST(CodegenMessage, DecodeStringCallback) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.description
+    0x62, 0x0b, 'a', 'n', ' ', 'o', 'p', 'e', 'n', ' ', 's', 'r', 'c',
+    // pigweed.ziggy
+    0x10, 0xdd, 0x01,
+  };
+  // clang-format on
+
+  Pigweed::Message message{};
+  int invocations = 0;
+  message.description.SetDecoder(
+      [&invocations](Pigweed::StreamDecoder& decoder) {
+        invocations += 1;
+        EXPECT_EQ(decoder.Field().value(), Pigweed::Fields::kDescription);
+
+        std::array<char, 16> description{};
+        const auto sws = decoder.ReadDescription(description);
+        EXPECT_EQ(sws.status(), OkStatus());
+        EXPECT_EQ(std::string_view(description.data(), sws.size()),
+                  "an open src");
+        return sws.status();
+      });
+
+  ASSERT_EQ(Pigweed::Decode(as_bytes(span(proto_data)), message), OkStatus());
+  EXPECT_EQ(invocations, 1);
+  EXPECT_EQ(message.magic_number, 0x49u);
+  EXPECT_EQ(message.ziggy, -111);
+}
+
+TEST(CodegenMessage, DecodeOneOfMultipleFieldsFails) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // type.an_int
+    0x08, 0x20,
+    // type.a_message
+    0x1a, 0x02, 0x08, 0x01,
+  };
+  // clang-format on
+
+  OneOfTest::Message message;
+  message.type.SetDecoder(
+      [](OneOfTest::Fields, OneOfTest::StreamDecoder&) { return OkStatus(); });
+
+  EXPECT_EQ(OneOfTest::Decode(as_bytes(span(proto_data)), message),
+            Status::DataLoss());
+}
+
+TEST(CodegenMessage, DecodeTruncated) {
+  // clang-format off
+  constexpr uint8_t proto_data[] = {
+    // pigweed.magic_number
+    0x08, 0x49,
+    // pigweed.error_message, with 2 of 16 bytes present
+    0x2a, 0x10, 'n', 'o',
+  };
+  // clang-format on
+
+  Pigweed::Message message{};
+  EXPECT_EQ(Pigweed::Decode(as_bytes(span(proto_data)), message),
+            Status::DataLoss());
+}
+
+TEST(CodegenMessage, DecodeMatchesRead) {
+  RepeatedTest::Message original{};
+  original.uint32s = {1, 200, 30000, 4000000};
+  original.fixed32s = {5, 6, 7};
+  original.doubles = {1.5, -2.25};
+  original.uint64s = {1u << 20, 1u << 30, 7, 8};
+  original.enums = {Enum::GREEN, Enum::RED};
+
+  std::array<std::byte, 128> buffer{};
+  RepeatedTest::MemoryEncoder encoder(buffer);
+  ASSERT_EQ(encoder.Write(original), OkStatus());
+
+  RepeatedTest::Message decoded{};
+  ASSERT_EQ(RepeatedTest::Decode(encoder, decoded), OkStatus());
+
+  stream::MemoryReader reader(encoder);
+  RepeatedTest::StreamDecoder stream_decoder(reader);
+  RepeatedTest::Message read{};
+  ASSERT_EQ(stream_decoder.Read(read), OkStatus());
+
+  for (const RepeatedTest::Message* message : {&decoded, &read}) {
+    EXPECT_EQ(message->uint32s, original.uint32s);
+    EXPECT_EQ(message->fixed32s, original.fixed32s);
+    EXPECT_EQ(message->doubles, original.doubles);
+    EXPECT_EQ(message->uint64s, original.uint64s);
+    EXPECT_EQ(message->enums, original.enums);
+  }
+}
+
 TEST(CodegenMessage, Write) {
   constexpr uint8_t pigweed_data[] = {
       0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80};
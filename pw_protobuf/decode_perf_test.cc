@@ -0,0 +1,134 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_protobuf/stream_decoder.h"
+#include "pw_protobuf_test_protos/full_test.pwpb.h"
+#include "pw_protobuf_test_protos/repeated.pwpb.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_stream/memory_stream.h"
+
+// Compares decoding generated message structs from an in-memory buffer with
+// the generated Decode() functions against StreamDecoder::Read() over a
+// stream::MemoryReader.
+
+namespace pw::protobuf {
+namespace {
+
+namespace Pigweed = test::pwpb::Pigweed;
+namespace RepeatedTest = test::pwpb::RepeatedTest;
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__clang__) || defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  // Fallback if not GCC/Clang
+  static_cast<void>(value);
+#endif
+}
+
+// Scalar message benchmarks (~50 bytes)
+// clang-format off
+constexpr uint8_t kScalarProto[] = {
+  // pigweed.magic_number
+  0x08, 0x49,
+  // pigweed.ziggy
+  0x10, 0xdd, 0x01,
+  // pigweed.cycles
+  0x19, 0xde, 0xad, 0xca, 0xfe, 0x10, 0x20, 0x30, 0x40,
+  // pigweed.ratio
+  0x25, 0x8f, 0xc2, 0xb5, 0xbf,
+  // pigweed.error_message
+  0x2a, 0x10, 'n', 'o', 't', ' ', 'a', ' ',
+  't', 'y', 'p', 'e', 'w', 'r', 'i', 't', 'e', 'r',
+  // pigweed.pigweed
+  0x3a, 0x02,
+  // pigweed.pigweed.status
+  0x08, 0x02,
+  // pigweed.bin
+  0x40, 0x01,
+  // pigweed.bungle
+  0x70, 0x91, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01,
+};
+// clang-format on
+
+void StreamReadScalar(pw::perf_test::State& state) {
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(as_bytes(span(kScalarProto)));
+    Pigweed::StreamDecoder decoder(reader);
+    Pigweed::Message message{};
+    decoder.Read(message).IgnoreError();
+    DoNotOptimize(message);
+  }
+}
+PW_PERF_TEST(StreamReadScalarMessage, StreamReadScalar);
+
+void BufferDecodeScalar(pw::perf_test::State& state) {
+  while (state.KeepRunning()) {
+    Pigweed::Message message{};
+    Pigweed::Decode(as_bytes(span(kScalarProto)), message).IgnoreError();
+    DoNotOptimize(message);
+  }
+}
+PW_PERF_TEST(BufferDecodeScalarMessage, BufferDecodeScalar);
+
+// Packed repeated field benchmarks (~80 bytes)
+// clang-format off
+constexpr uint8_t kPackedProto[] = {
+  // uint32s[], v={0, 16, 32, 48, 64, 80, 96, 112}
+  0x0a, 0x08, 0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+  // doubles[], v={3.14159, 2.71828}
+  0x22, 0x10,
+  0x6e, 0x86, 0x1b, 0xf0, 0xf9, 0x21, 0x09, 0x40,
+  0x90, 0xf7, 0xaa, 0x95, 0x09, 0xbf, 0x05, 0x40,
+  // fixed32s[], v={0, 16, 32, 48, 64, 80, 96, 112}
+  0x32, 0x20,
+  0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x20, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00,
+  0x60, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00,
+  // uint64s[], v={1000, 2000, 3000, 4000}
+  0x42, 0x08, 0xe8, 0x07, 0xd0, 0x0f, 0xb8, 0x17, 0xa0, 0x1f,
+  // enums[], v={RED, AMBER, GREEN, RED}
+  0x4a, 0x04, 0x00, 0x01, 0x02, 0x00,
+};
+// clang-format on
+
+void StreamReadPacked(pw::perf_test::State& state) {
+  while (state.KeepRunning()) {
+    stream::MemoryReader reader(as_bytes(span(kPackedProto)));
+    RepeatedTest::StreamDecoder decoder(reader);
+    RepeatedTest::Message message{};
+    decoder.Read(message).IgnoreError();
+    DoNotOptimize(message);
+  }
+}
+PW_PERF_TEST(StreamReadPackedMessage, StreamReadPacked);
+
+void BufferDecodePacked(pw::perf_test::State& state) {
+  while (state.KeepRunning()) {
+    RepeatedTest::Message message{};
+    RepeatedTest::Decode(as_bytes(span(kPackedProto)), message).IgnoreError();
+    DoNotOptimize(message);
+  }
+}
+PW_PERF_TEST(BufferDecodePackedMessage, BufferDecodePacked);
+
+}  // namespace
+}  // namespace pw::protobuf
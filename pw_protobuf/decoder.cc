@@ -14,9 +14,19 @@
 
 #include "pw_protobuf/decoder.h"
 
+#include <cstdint>
 #include <cstring>
+#include <limits>
+#include <optional>
 
 #include "pw_assert/check.h"
+#include "pw_bytes/endian.h"
+#include "pw_containers/vector.h"
+#include "pw_protobuf/internal/codegen.h"
+#include "pw_protobuf/stream_decoder.h"
+#include "pw_status/try.h"
+#include "pw_stream/memory_stream.h"
+#include "pw_string/string.h"
 #include "pw_varint/varint.h"
 
 namespace pw::protobuf {
@@ -290,4 +300,394 @@ Status CallbackDecoder::Decode(span<const std::byte> proto) {
   return OkStatus();
 }
 
+namespace internal {
+namespace {
+
+// Stores a decoded varint into out, which is a bool, 32-bit or 64-bit integer,
+// with the same conversions and range checks as StreamDecoder.
+Status StoreVarint(uint64_t value,
+                   span<std::byte> out,
+                   VarintType decode_type) {
+  if (out.size() == sizeof(uint64_t)) {
+    if (decode_type == VarintType::kZigZag) {
+      const int64_t signed_value = varint::ZigZagDecode(value);
+      std::memcpy(out.data(), &signed_value, sizeof(signed_value));
+    } else {
+      std::memcpy(out.data(), &value, sizeof(value));
+    }
+  } else if (out.size() == sizeof(uint32_t)) {
+    if (decode_type == VarintType::kUnsigned) {
+      if (value > std::numeric_limits<uint32_t>::max()) {
+        return Status::FailedPrecondition();
+      }
+      const uint32_t unsigned_value = static_cast<uint32_t>(value);
+      std::memcpy(out.data(), &unsigned_value, sizeof(unsigned_value));
+    } else {
+      const int64_t signed_value = decode_type == VarintType::kZigZag
+                                       ? varint::ZigZagDecode(value)
+                                       : static_cast<int64_t>(value);
+      if (signed_value > std::numeric_limits<int32_t>::max() ||
+          signed_value < std::numeric_limits<int32_t>::min()) {
+        return Status::FailedPrecondition();
+      }
+      const int32_t narrowed_value = static_cast<int32_t>(signed_value);
+      std::memcpy(out.data(), &narrowed_value, sizeof(narrowed_value));
+    }
+  } else {
+    PW_CHECK(decode_type == VarintType::kUnsigned,
+             "Protobuf bool can never be signed");
+    const bool bool_value = value != 0u;
+    std::memcpy(out.data(), &bool_value, sizeof(bool_value));
+  }
+  return OkStatus();
+}
+
+// Copies a little-endian fixed-size value of out.size() bytes into out.
+void StoreFixed(const std::byte* value, span<std::byte> out) {
+  if (out.size() == sizeof(uint32_t)) {
+    const uint32_t fixed = bytes::ReadInOrder<uint32_t>(endian::little, value);
+    std::memcpy(out.data(), &fixed, sizeof(fixed));
+  } else {
+    const uint64_t fixed = bytes::ReadInOrder<uint64_t>(endian::little, value);
+    std::memcpy(out.data(), &fixed, sizeof(fixed));
+  }
+}
+
+template <typename T>
+Status AppendVarint(pw::Vector<T>& out,
+                    uint64_t value,
+                    VarintType decode_type) {
+  if (out.full()) {
+    return Status::ResourceExhausted();
+  }
+  T element{};
+  PW_TRY(StoreVarint(value, as_writable_bytes(span(&element, 1)), decode_type));
+  out.push_back(element);
+  return OkStatus();
+}
+
+// Appends each varint in a packed field to out, decoding directly from the
+// buffer.
+template <typename T>
+Status AppendPackedVarints(pw::Vector<T>& out,
+                           span<const std::byte> packed,
+                           VarintType decode_type) {
+  while (!packed.empty()) {
+    uint64_t value = 0;
+    const size_t bytes_read = varint::Decode(packed, &value);
+    if (bytes_read == 0) {
+      return Status::DataLoss();
+    }
+    PW_TRY(AppendVarint(out, value, decode_type));
+    packed = packed.subspan(bytes_read);
+  }
+  return OkStatus();
+}
+
+// Appends one or more packed little-endian values to out.
+template <typename T>
+Status AppendFixed(pw::Vector<T>& out, span<const std::byte> values) {
+  if (values.size() / sizeof(T) > out.max_size() - out.size()) {
+    return Status::ResourceExhausted();
+  }
+  for (size_t i = 0; i < values.size(); i += sizeof(T)) {
+    out.push_back(bytes::ReadInOrder<T>(endian::little, &values[i]));
+  }
+  return OkStatus();
+}
+
+template <typename Container>
+Status AssignStringOrBytes(std::byte* raw_container,
+                           span<const std::byte> value) {
+  auto& container = *reinterpret_cast<Container*>(raw_container);
+  if (container.capacity() < value.size()) {
+    return Status::ResourceExhausted();
+  }
+  PW_DASSERT(value.size() <= std::numeric_limits<uint16_t>::max());
+  container.resize(static_cast<uint16_t>(value.size()));
+  if (!value.empty()) {
+    std::memcpy(container.data(), value.data(), value.size());
+  }
+  return OkStatus();
+}
+
+Status DecodeFixedField(const MessageField& field,
+                        WireType wire_type,
+                        span<const std::byte> value,
+                        span<std::byte> out) {
+  const size_t elem_size = field.elem_size();
+  PW_CHECK(elem_size == (field.wire_type() == WireType::kFixed32
+                             ? sizeof(uint32_t)
+                             : sizeof(uint64_t)),
+           "Mismatched message field type and size");
+
+  if (field.is_repeated() && wire_type == WireType::kDelimited) {
+    // Packed values are converted in place, without an intermediate copy.
+    if (value.size() % elem_size != 0) {
+      return Status::DataLoss();
+    }
+    if (field.is_fixed_size()) {
+      if (value.size() > out.size()) {
+        return Status::ResourceExhausted();
+      }
+      for (size_t i = 0; i < value.size(); i += elem_size) {
+        StoreFixed(&value[i], out.subspan(i, elem_size));
+      }
+      return OkStatus();
+    }
+    if (elem_size == sizeof(uint64_t)) {
+      return AppendFixed(*reinterpret_cast<pw::Vector<uint64_t>*>(out.data()),
+                         value);
+    }
+    return AppendFixed(*reinterpret_cast<pw::Vector<uint32_t>*>(out.data()),
+                       value);
+  }
+
+  // Fixed size arrays can only be read from packed fields.
+  if (wire_type != field.wire_type() || field.is_fixed_size()) {
+    return Status::NotFound();
+  }
+
+  if (field.is_repeated()) {
+    if (elem_size == sizeof(uint64_t)) {
+      return AppendFixed(*reinterpret_cast<pw::Vector<uint64_t>*>(out.data()),
+                         value);
+    }
+    return AppendFixed(*reinterpret_cast<pw::Vector<uint32_t>*>(out.data()),
+                       value);
+  }
+  if (field.is_optional()) {
+    if (elem_size == sizeof(uint64_t)) {
+      *reinterpret_cast<std::optional<uint64_t>*>(out.data()) =
+          bytes::ReadInOrder<uint64_t>(endian::little, value.data());
+    } else {
+      *reinterpret_cast<std::optional<uint32_t>*>(out.data()) =
+          bytes::ReadInOrder<uint32_t>(endian::little, value.data());
+    }
+    return OkStatus();
+  }
+  PW_CHECK(out.size() == elem_size, "Mismatched message field type and size");
+  StoreFixed(value.data(), out);
+  return OkStatus();
+}
+
+Status DecodeVarintField(const MessageField& field,
+                         WireType wire_type,
+                         span<const std::byte> value,
+                         uint64_t varint_value,
+                         span<std::byte> out) {
+  const size_t elem_size = field.elem_size();
+  PW_CHECK(elem_size == sizeof(uint64_t) || elem_size == sizeof(uint32_t) ||
+               elem_size == sizeof(bool),
+           "Mismatched message field type and size");
+  const VarintType decode_type = field.varint_type();
+
+  if (field.is_repeated() && wire_type == WireType::kDelimited) {
+    if (field.is_fixed_size()) {
+      // Packed values fill the array from the start.
+      while (!value.empty()) {
+        if (out.empty()) {
+          return Status::ResourceExhausted();
+        }
+        uint64_t element = 0;
+        const size_t bytes_read = varint::Decode(value, &element);
+        if (bytes_read == 0) {
+          return Status::DataLoss();
+        }
+        PW_TRY(StoreVarint(element, out.first(elem_size), decode_type));
+        value = value.subspan(bytes_read);
+        out = out.subspan(elem_size);
+      }
+      return OkStatus();
+    }
+    if (elem_size == sizeof(uint64_t)) {
+      return AppendPackedVarints(
+          *reinterpret_cast<pw::Vector<uint64_t>*>(out.data()),
+          value,
+          decode_type);
+    }
+    if (elem_size == sizeof(uint32_t)) {
+      return AppendPackedVarints(
+          *reinterpret_cast<pw::Vector<uint32_t>*>(out.data()),
+          value,
+          decode_type);
+    }
+    return AppendPackedVarints(
+        *reinterpret_cast<pw::Vector<bool>*>(out.data()), value, decode_type);
+  }
+
+  // Fixed size arrays can only be read from packed fields.
+  if (wire_type != WireType::kVarint || field.is_fixed_size()) {
+    return Status::NotFound();
+  }
+
+  if (field.is_repeated()) {
+    if (elem_size == sizeof(uint64_t)) {
+      return AppendVarint(*reinterpret_cast<pw::Vector<uint64_t>*>(out.data()),
+                          varint_value,
+                          decode_type);
+    }
+    if (elem_size == sizeof(uint32_t)) {
+      return AppendVarint(*reinterpret_cast<pw::Vector<uint32_t>*>(out.data()),
+                          varint_value,
+                          decode_type);
+    }
+    return AppendVarint(*reinterpret_cast<pw::Vector<bool>*>(out.data()),
+                        varint_value,
+                        decode_type);
+  }
+  if (field.is_optional()) {
+    // Assign through a temporary of the optional's value type.
+    if (elem_size == sizeof(uint64_t)) {
+      uint64_t element = 0;
+      PW_TRY(StoreVarint(
+          varint_value, as_writable_bytes(span(&element, 1)), decode_type));
+      *reinterpret_cast<std::optional<uint64_t>*>(out.data()) = element;
+    } else if (elem_size == sizeof(uint32_t)) {
+      uint32_t element = 0;
+      PW_TRY(StoreVarint(
+          varint_value, as_writable_bytes(span(&element, 1)), decode_type));
+      *reinterpret_cast<std::optional<uint32_t>*>(out.data()) = element;
+    } else {
+      bool element = false;
+      PW_TRY(StoreVarint(
+          varint_value, as_writable_bytes(span(&element, 1)), decode_type));
+      *reinterpret_cast<std::optional<bool>*>(out.data()) = element;
+    }
+    return OkStatus();
+  }
+  PW_CHECK(out.size() == elem_size, "Mismatched message field type and size");
+  return StoreVarint(varint_value, out, decode_type);
+}
+
+Status DecodeDelimitedField(const MessageField& field,
+                            WireType wire_type,
+                            span<const std::byte> value,
+                            span<std::byte> out) {
+  PW_CHECK(!field.is_repeated(),
+           "Repeated delimited messages always require a callback");
+  if (wire_type != WireType::kDelimited) {
+    return Status::NotFound();
+  }
+
+  if (field.nested_message_fields() != nullptr) {
+    return DecodeMessage(value, out, *field.nested_message_fields());
+  }
+
+  PW_CHECK(field.elem_size() == sizeof(std::byte),
+           "Mismatched message field type and size");
+  if (field.is_fixed_size()) {
+    if (value.size() > out.size()) {
+      return Status::ResourceExhausted();
+    }
+    if (!value.empty()) {
+      std::memcpy(out.data(), value.data(), value.size());
+    }
+    return OkStatus();
+  }
+  if (field.is_string()) {
+    return AssignStringOrBytes<pw::InlineString<>>(out.data(), value);
+  }
+  return AssignStringOrBytes<pw::Vector<std::byte>>(out.data(), value);
+}
+
+}  // namespace
+
+Status DecodeMessage(span<const std::byte> proto,
+                     span<std::byte> message,
+                     span<const MessageField> table) {
+  MessageFieldFinder fields(table);
+
+  while (!proto.empty()) {
+    const span<const std::byte> field_start = proto;
+
+    uint64_t key = 0;
+    size_t bytes_read = varint::Decode(proto, &key);
+    if (bytes_read == 0 || !FieldKey::IsValidKey(key)) {
+      return Status::DataLoss();
+    }
+    proto = proto.subspan(bytes_read);
+    const FieldKey field_key(static_cast<uint32_t>(key));
+
+    // Find the bytes of the field's value and advance past them. Varints are
+    // decoded here, since that is how their size is found.
+    uint64_t varint_value = 0;
+    span<const std::byte> value;
+    switch (field_key.wire_type()) {
+      case WireType::kVarint:
+        bytes_read = varint::Decode(proto, &varint_value);
+        if (bytes_read == 0) {
+          return Status::DataLoss();
+        }
+        value = proto.first(bytes_read);
+        proto = proto.subspan(bytes_read);
+        break;
+
+      case WireType::kDelimited: {
+        uint64_t length = 0;
+        bytes_read = varint::Decode(proto, &length);
+        if (bytes_read == 0 || length > proto.size() - bytes_read) {
+          return Status::DataLoss();
+        }
+        value = proto.subspan(bytes_read, static_cast<size_t>(length));
+        proto = proto.subspan(bytes_read + static_cast<size_t>(length));
+        break;
+      }
+
+      case WireType::kFixed32:
+      case WireType::kFixed64: {
+        const size_t size = field_key.wire_type() == WireType::kFixed32
+                                ? sizeof(uint32_t)
+                                : sizeof(uint64_t);
+        if (proto.size() < size) {
+          return Status::DataLoss();
+        }
+        value = proto.first(size);
+        proto = proto.subspan(size);
+        break;
+      }
+    }
+
+    const MessageField* field = fields.Find(field_key.field_number());
+    if (field == nullptr) {
+      // Skip unknown fields.
+      continue;
+    }
+
+    const span<std::byte> out =
+        message.subspan(field->field_offset(), field->field_size());
+    PW_CHECK(out.begin() >= message.begin() && out.end() <= message.end());
+
+    // Callbacks take a StreamDecoder, so give them one that reads just this
+    // field.
+    if (field->callback_type() != CallbackType::kNone) {
+      stream::MemoryReader reader(
+          field_start.first(field_start.size() - proto.size()));
+      StreamDecoder decoder(reader);
+      PW_TRY(decoder.Read(message, span(field, 1)));
+      continue;
+    }
+
+    // Switch on the expected wire type of the field, not the actual, to ensure
+    // the remote encoder doesn't influence our decoding unexpectedly.
+    switch (field->wire_type()) {
+      case WireType::kFixed64:
+      case WireType::kFixed32:
+        PW_TRY(DecodeFixedField(*field, field_key.wire_type(), value, out));
+        break;
+      case WireType::kVarint:
+        PW_TRY(DecodeVarintField(
+            *field, field_key.wire_type(), value, varint_value, out));
+        break;
+      case WireType::kDelimited:
+        PW_TRY(DecodeDelimitedField(*field, field_key.wire_type(), value, out));
+        break;
+    }
+  }
+
+  return OkStatus();
+}
+
+}  // namespace internal
+
 }  // namespace pw::protobuf
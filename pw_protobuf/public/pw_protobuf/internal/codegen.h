@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -183,6 +184,50 @@ class MessageField {
 static_assert(sizeof(MessageField) <= sizeof(size_t) * 4,
               "MessageField should be four words or less");
 
+// Looks up the fields of a codegen message table by field number while
+// decoding a message.
+//
+// Encoders write fields in the order of the table, so the search starts at the
+// most recently found field. For messages encoded in table order, including
+// ones with repeated fields, each lookup takes one or two comparisons instead
+// of a scan of the table. Fields out of order fall back to a full scan.
+class MessageFieldFinder {
+ public:
+  constexpr explicit MessageFieldFinder(span<const MessageField> table)
+      : table_(table), next_(0) {}
+
+  // Returns the field with the given number, or nullptr if the message does
+  // not have one.
+  constexpr const MessageField* Find(uint32_t field_number) {
+    for (size_t i = next_; i < table_.size(); ++i) {
+      if (table_[i] == field_number) {
+        next_ = i;
+        return &table_[i];
+      }
+    }
+    for (size_t i = 0; i < next_; ++i) {
+      if (table_[i] == field_number) {
+        next_ = i;
+        return &table_[i];
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  span<const MessageField> table_;
+  size_t next_;
+};
+
+// Decodes the serialized message in proto into the structure contained within
+// message, according to the description of fields in table.
+//
+// This is the in-memory counterpart of StreamDecoder::Read(). It is called by
+// the codegen Decode() functions that accept a typed struct Message reference.
+Status DecodeMessage(span<const std::byte> proto,
+                     span<std::byte> message,
+                     span<const MessageField> table);
+
 template <typename...>
 constexpr std::false_type kInvalidMessageStruct{};
 
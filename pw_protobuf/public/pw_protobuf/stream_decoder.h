@@ -770,6 +770,9 @@ class StreamDecoder {
                                        size_t elem_size,
                                        internal::VarintType decode_type);
 
+  StatusWithSize ReadPackedVarintFieldInChunks(
+      span<std::byte> out, size_t elem_size, internal::VarintType decode_type);
+
   template <typename T>
   Status ReadRepeatedFixedField(pw::Vector<T>& out) {
     static_assert(
@@ -859,6 +862,12 @@ class StreamDecoder {
   Status status_;
 
   friend class Message;
+
+  // Decodes callback fields by wrapping them in a StreamDecoder.
+  friend Status internal::DecodeMessage(
+      span<const std::byte> proto,
+      span<std::byte> message,
+      span<const internal::MessageField> table);
 };
 
 /// @endmodule
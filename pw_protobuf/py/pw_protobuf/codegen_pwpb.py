@@ -3552,6 +3552,7 @@ def forward_declare(
     # Declare the message's decoder classes.
     output.write_line()
     output.write_line('class StreamDecoder;')
+    output.write_line('class View;')
 
     # Declare the message's enums.
     for child in message.children():
@@ -3703,6 +3704,18 @@ def generate_table_for_message(
             'MessageField> kMessageFields;'
         )
 
+    # Generate a function that decodes the message struct directly from an
+    # in-memory buffer, without a stream.
+    output.write_line(
+        'inline ::pw::Status Decode(::pw::ConstByteSpan buffer, '
+        'Message& message) {'
+    )
+    output.write_line(
+        f'  return {_INTERNAL_NAMESPACE}::DecodeMessage(buffer, '
+        'pw::as_writable_bytes(pw::span(&message, 1)), kMessageFields);'
+    )
+    output.write_line('}')
+
     output.write_line(f'}}  // namespace {namespace}')
 
 
@@ -3808,6 +3821,113 @@ def generate_find_functions_for_message(
     output.write_line(f'}}  // namespace {namespace}')
 
 
+def _view_accessors(
+    message: ProtoMessage,
+    root: ProtoNode,
+    codegen_options: GeneratorOptions,
+) -> Iterable[tuple[ProtoMessageField, FindMethod]]:
+    """Yields each field of a message with its ConstByteSpan find method."""
+    for field in message.fields():
+        for cls in PROTO_FIELD_FIND_METHODS.get(field.type(), []):
+            if not issubclass(cls, FindStreamMethod):
+                yield field, cls(codegen_options, field, message, root, '')
+
+
+def _is_submessage_view_accessor(field: ProtoMessageField) -> bool:
+    return (
+        field.type() == descriptor_pb2.FieldDescriptorProto.TYPE_MESSAGE
+        and not field.is_repeated()
+    )
+
+
+def _sub_message_view_type(field: ProtoMessageField) -> str:
+    type_node = field.type_node()
+    assert type_node is not None
+    return f'::{type_node.cpp_namespace()}::View'
+
+
+def generate_view_for_message(
+    message: ProtoMessage,
+    root: ProtoNode,
+    output: OutputFile,
+    codegen_options: GeneratorOptions,
+) -> None:
+    """Creates a C++ class which reads fields from a serialized message.
+
+    Fields are found lazily and returned without copying. Accessors for
+    singular sub-message fields return the sub-message's View. As that View may
+    not yet be defined, those accessors are defined separately by
+    define_view_methods_for_message.
+    """
+    assert message.type() == ProtoNode.Type.MESSAGE
+
+    namespace = message.cpp_namespace(root=root)
+    output.write_line(f'namespace {namespace} {{')
+    output.write_line()
+    output.write_line('class View {')
+    output.write_line(' public:')
+
+    with output.indent():
+        output.write_line(
+            'constexpr explicit View(::pw::ConstByteSpan message) '
+            ': message_(message) {}'
+        )
+
+        for field, method in _view_accessors(message, root, codegen_options):
+            output.write_line()
+            if _is_submessage_view_accessor(field):
+                output.write_line(
+                    f'::pw::Result<{_sub_message_view_type(field)}> '
+                    f'{field.field_name()}() const;'
+                )
+                continue
+
+            output.write_line(
+                f'{method.return_type()} {field.field_name()}() const {{'
+            )
+            output.write_line(f'  return {method.name()}(message_);')
+            output.write_line('}')
+
+    output.write_line()
+    output.write_line(' private:')
+    output.write_line('  ::pw::ConstByteSpan message_;')
+    output.write_line('};')
+    output.write_line()
+    output.write_line(f'}}  // namespace {namespace}')
+
+
+def define_view_methods_for_message(
+    message: ProtoMessage,
+    root: ProtoNode,
+    output: OutputFile,
+    codegen_options: GeneratorOptions,
+) -> None:
+    """Defines the View accessors that return sub-message Views."""
+    assert message.type() == ProtoNode.Type.MESSAGE
+
+    namespace = message.cpp_namespace(root=root)
+    for field, method in _view_accessors(message, root, codegen_options):
+        if not _is_submessage_view_accessor(field):
+            continue
+
+        view_type = _sub_message_view_type(field)
+        output.write_line()
+        output.write_line(
+            f'inline ::pw::Result<{view_type}> '
+            f'{namespace}::View::{field.field_name()}() const {{'
+        )
+        with output.indent():
+            output.write_line(
+                f'::pw::Result<::pw::ConstByteSpan> result = '
+                f'{method.name()}(message_);'
+            )
+            output.write_line('if (!result.ok()) {')
+            output.write_line('  return result.status();')
+            output.write_line('}')
+            output.write_line(f'return {view_type}(result.value());')
+        output.write_line('}')
+
+
 def generate_all_for_message(
     message: ProtoMessage,
     root: ProtoNode,
@@ -3820,6 +3940,7 @@ def generate_all_for_message(
         generate_table_for_message,
         generate_sizes_for_message,
         generate_find_functions_for_message,
+        generate_view_for_message,
     )
     for generate in generate_funcs:
         output.write_line()
@@ -3972,6 +4093,9 @@ def generate_code_for_package(
                 codegen_options,
                 class_type,
             )
+        define_view_methods_for_message(
+            message, package, output, codegen_options
+        )
 
     if package.cpp_namespace():
         output.write_line(f'\n}}  // namespace {package.cpp_namespace()}')
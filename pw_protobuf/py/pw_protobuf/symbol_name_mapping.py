@@ -25,8 +25,10 @@ from typing import Set
 PW_PROTO_CODEGEN_RESERVED_WORDS: Set[str] = {
     # Identifiers that conflict with the codegen internals when used in certain
     # contexts:
+    "Decode",
     "Fields",
     "Message",
+    "View",
     # C++20 keywords (https://en.cppreference.com/w/cpp/keyword):
     "alignas",
     "alignof",
@@ -15,6 +15,7 @@
 #include "pw_protobuf/stream_decoder.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <limits>
@@ -40,6 +41,95 @@ namespace pw::protobuf {
 
 using internal::VarintType;
 
+namespace {
+
+// Size of the buffer that packed varint fields are read into, when they are
+// read ahead rather than one varint at a time.
+constexpr size_t kPackedVarintChunkSizeBytes = 32;
+
+// Stores a decoded varint in out, which is a bool, 32-bit, or 64-bit integer.
+Status StoreVarint(uint64_t value,
+                   span<std::byte> out,
+                   VarintType decode_type) {
+  if (out.size() == sizeof(uint64_t)) {
+    if (decode_type == VarintType::kUnsigned) {
+      std::memcpy(out.data(), &value, out.size());
+    } else {
+      const int64_t signed_value = decode_type == VarintType::kZigZag
+                                       ? varint::ZigZagDecode(value)
+                                       : static_cast<int64_t>(value);
+      std::memcpy(out.data(), &signed_value, out.size());
+    }
+  } else if (out.size() == sizeof(uint32_t)) {
+    if (decode_type == VarintType::kUnsigned) {
+      if (value > std::numeric_limits<uint32_t>::max()) {
+        return Status::FailedPrecondition();
+      }
+      std::memcpy(out.data(), &value, out.size());
+    } else {
+      const int64_t signed_value = decode_type == VarintType::kZigZag
+                                       ? varint::ZigZagDecode(value)
+                                       : static_cast<int64_t>(value);
+      if (signed_value > std::numeric_limits<int32_t>::max() ||
+          signed_value < std::numeric_limits<int32_t>::min()) {
+        return Status::FailedPrecondition();
+      }
+      std::memcpy(out.data(), &signed_value, out.size());
+    }
+  } else if (out.size() == sizeof(bool)) {
+    PW_CHECK(decode_type == VarintType::kUnsigned,
+             "Protobuf bool can never be signed");
+    std::memcpy(out.data(), &value, out.size());
+  }
+  return OkStatus();
+}
+
+// Decodes the complete varints at the start of chunk into out, advancing out
+// and number_out past the values. Returns the number of bytes decoded.
+StatusWithSize DecodePackedVarints(ConstByteSpan chunk,
+                                   span<std::byte>& out,
+                                   size_t elem_size,
+                                   VarintType decode_type,
+                                   size_t& number_out) {
+  size_t bytes_read = 0;
+
+  // 64-bit values need no range checks, so decode them in bulk.
+  if (elem_size == sizeof(uint64_t)) {
+    const size_t capacity = out.size() / elem_size;
+    const size_t count =
+        decode_type == VarintType::kZigZag
+            ? varint::DecodePacked(
+                  chunk,
+                  span(reinterpret_cast<int64_t*>(out.data()), capacity),
+                  &bytes_read)
+            : varint::DecodePacked(
+                  chunk,
+                  span(reinterpret_cast<uint64_t*>(out.data()), capacity),
+                  &bytes_read);
+    out = out.subspan(count * elem_size);
+    number_out += count;
+    return StatusWithSize(bytes_read);
+  }
+
+  while (bytes_read < chunk.size() && !out.empty()) {
+    uint64_t value = 0;
+    const size_t size = varint::Decode(chunk.subspan(bytes_read), &value);
+    if (size == 0u) {
+      break;
+    }
+    if (Status status = StoreVarint(value, out.first(elem_size), decode_type);
+        !status.ok()) {
+      return StatusWithSize(status, bytes_read);
+    }
+    bytes_read += size;
+    out = out.subspan(elem_size);
+    ++number_out;
+  }
+  return StatusWithSize(bytes_read);
+}
+
+}  // namespace
+
 Status StreamDecoder::BytesReader::DoSeek(ptrdiff_t offset, Whence origin) {
   PW_TRY(status_);
   if (!decoder_.reader_.seekable()) {
@@ -341,38 +431,7 @@ StatusWithSize StreamDecoder::ReadOneVarint(span<std::byte> out,
     return sws;
   }
 
-  if (out.size() == sizeof(uint64_t)) {
-    if (decode_type == VarintType::kUnsigned) {
-      std::memcpy(out.data(), &value, out.size());
-    } else {
-      const int64_t signed_value = decode_type == VarintType::kZigZag
-                                       ? varint::ZigZagDecode(value)
-                                       : static_cast<int64_t>(value);
-      std::memcpy(out.data(), &signed_value, out.size());
-    }
-  } else if (out.size() == sizeof(uint32_t)) {
-    if (decode_type == VarintType::kUnsigned) {
-      if (value > std::numeric_limits<uint32_t>::max()) {
-        return StatusWithSize(Status::FailedPrecondition(), sws.size());
-      }
-      std::memcpy(out.data(), &value, out.size());
-    } else {
-      const int64_t signed_value = decode_type == VarintType::kZigZag
-                                       ? varint::ZigZagDecode(value)
-                                       : static_cast<int64_t>(value);
-      if (signed_value > std::numeric_limits<int32_t>::max() ||
-          signed_value < std::numeric_limits<int32_t>::min()) {
-        return StatusWithSize(Status::FailedPrecondition(), sws.size());
-      }
-      std::memcpy(out.data(), &signed_value, out.size());
-    }
-  } else if (out.size() == sizeof(bool)) {
-    PW_CHECK(decode_type == VarintType::kUnsigned,
-             "Protobuf bool can never be signed");
-    std::memcpy(out.data(), &value, out.size());
-  }
-
-  return sws;
+  return StatusWithSize(StoreVarint(value, out, decode_type), sws.size());
 }
 
 Status StreamDecoder::ReadFixedField(span<std::byte> out) {
@@ -484,6 +543,14 @@ StatusWithSize StreamDecoder::ReadPackedVarintField(span<std::byte> out,
     return StatusWithSize(status_, 0);
   }
 
+  // Every varint is at least one byte, so if out can hold as many values as
+  // the field has bytes, the field can be read ahead and decoded from memory.
+  // Otherwise, read one varint at a time so that reading stops when out is
+  // full.
+  if (out.size() / elem_size >= delimited_field_size_) {
+    return ReadPackedVarintFieldInChunks(out, elem_size, decode_type);
+  }
+
   size_t bytes_read = 0;
   size_t number_out = 0;
   while (bytes_read < delimited_field_size_ && !out.empty()) {
@@ -505,6 +572,50 @@ StatusWithSize StreamDecoder::ReadPackedVarintField(span<std::byte> out,
   return StatusWithSize(OkStatus(), number_out);
 }
 
+StatusWithSize StreamDecoder::ReadPackedVarintFieldInChunks(
+    span<std::byte> out, size_t elem_size, VarintType decode_type) {
+  std::array<std::byte, kPackedVarintChunkSizeBytes> chunk;
+  size_t buffered = 0;
+  size_t remaining = delimited_field_size_;
+  size_t number_out = 0;
+
+  while (remaining > 0) {
+    const size_t to_read = std::min(chunk.size() - buffered, remaining);
+    Result<ByteSpan> result =
+        reader_.Read(span(chunk).subspan(buffered, to_read));
+    if (!result.ok()) {
+      return StatusWithSize(result.status(), number_out);
+    }
+    position_ += result.value().size();
+    remaining -= result.value().size();
+    buffered += result.value().size();
+
+    const StatusWithSize decoded = DecodePackedVarints(
+        span(chunk).first(buffered), out, elem_size, decode_type, number_out);
+    if (!decoded.ok()) {
+      return StatusWithSize(decoded.status(), number_out);
+    }
+
+    // Keep the start of a varint that continues into the next chunk. A
+    // complete varint never has more than kMaxVarint64SizeBytes bytes.
+    buffered -= decoded.size();
+    if (buffered >= varint::kMaxVarint64SizeBytes) {
+      status_ = Status::DataLoss();
+      return StatusWithSize(status_, number_out);
+    }
+    std::memmove(chunk.data(), chunk.data() + decoded.size(), buffered);
+  }
+
+  if (buffered > 0) {
+    // The field ended in the middle of a varint.
+    status_ = Status::DataLoss();
+    return StatusWithSize(status_, number_out);
+  }
+
+  field_consumed_ = true;
+  return StatusWithSize(OkStatus(), number_out);
+}
+
 Status StreamDecoder::ReadRepeatedVarintFieldGeneric(
     std::byte* data,
     size_t capacity,
@@ -573,12 +684,11 @@ Status StreamDecoder::Read(span<std::byte> message,
                            span<const internal::MessageField> table) {
   PW_TRY(status_);
 
+  internal::MessageFieldFinder fields(table);
   while (Next().ok()) {
-    // Find the field in the table,
-    // TODO: b/234876102 - Finding the field can be made more efficient.
-    const auto field =
-        std::find(table.begin(), table.end(), current_field_.field_number());
-    if (field == table.end()) {
+    const internal::MessageField* field =
+        fields.Find(current_field_.field_number());
+    if (field == nullptr) {
       // If the field is not found, skip to the next one.
       // TODO: b/234873295 - Provide a way to allow the caller to inspect
       // unknown fields, and serialize them back out later.
@@ -15,12 +15,16 @@
 #include "pw_protobuf/stream_decoder.h"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
+#include "pw_bytes/span.h"
 #include "pw_status/status.h"
 #include "pw_status/status_with_size.h"
 #include "pw_stream/memory_stream.h"
 #include "pw_stream/stream.h"
 #include "pw_unit_test/framework.h"
+#include "pw_varint/varint.h"
 
 namespace pw::protobuf {
 namespace {
@@ -1300,6 +1304,62 @@ TEST(StreamDecoder, PackedVarintInsufficientSpace) {
   EXPECT_EQ(uint32[1], 50u);
 }
 
+TEST(StreamDecoder, PackedVarintLongerThanReadAhead) {
+  // Packed fields are read ahead in chunks when the output has space for every
+  // value. Use three-byte varints so that some span two chunks, followed by
+  // another field.
+  constexpr size_t kValues = 40;
+  std::array<std::byte, 2 + 3 * kValues + 2> encoded_proto{};
+  encoded_proto[0] = std::byte{0x0a};
+  encoded_proto[1] = std::byte{3 * kValues};
+  ByteSpan values = span(encoded_proto).subspan(2, 3 * kValues);
+  for (uint32_t i = 0; i < kValues; ++i) {
+    ASSERT_EQ(varint::Encode(20000u + i, values.subspan(3 * i)), 3u);
+  }
+  // type=uint32, k=2, v=7
+  encoded_proto[encoded_proto.size() - 2] = std::byte{0x10};
+  encoded_proto[encoded_proto.size() - 1] = std::byte{0x07};
+
+  stream::MemoryReader reader(encoded_proto);
+  StreamDecoder decoder(reader);
+
+  EXPECT_EQ(decoder.Next(), OkStatus());
+  ASSERT_EQ(decoder.FieldNumber().value(), 1u);
+  std::array<uint32_t, 3 * kValues> uint32{};
+  StatusWithSize size = decoder.ReadPackedUint32(uint32);
+  ASSERT_EQ(size.status(), OkStatus());
+  ASSERT_EQ(size.size(), kValues);
+  for (uint32_t i = 0; i < kValues; ++i) {
+    EXPECT_EQ(uint32[i], 20000u + i);
+  }
+
+  EXPECT_EQ(decoder.Next(), OkStatus());
+  ASSERT_EQ(decoder.FieldNumber().value(), 2u);
+  EXPECT_EQ(decoder.ReadUint32().value(), 7u);
+  EXPECT_EQ(decoder.Next(), Status::OutOfRange());
+}
+
+TEST(StreamDecoder, PackedVarintTruncated) {
+  // clang-format off
+  constexpr uint8_t encoded_proto[] = {
+    // type=uint64[], k=1, v={150, <truncated>}
+    0x0a, 0x03,
+    0x96, 0x01,
+    0x96,
+  };
+  // clang-format on
+
+  stream::MemoryReader reader(as_bytes(span(encoded_proto)));
+  StreamDecoder decoder(reader);
+
+  EXPECT_EQ(decoder.Next(), OkStatus());
+  std::array<uint64_t, 8> uint64{};
+  StatusWithSize size = decoder.ReadPackedUint64(uint64);
+  EXPECT_EQ(size.status(), Status::DataLoss());
+  EXPECT_EQ(size.size(), 1u);
+  EXPECT_EQ(uint64[0], 150u);
+}
+
 TEST(StreamDecoder, PackedVarintVector) {
   // clang-format off
   constexpr uint8_t encoded_proto[] = {
@@ -69,6 +69,22 @@ Result<EncodedPacket> EncodeCallbackToPayloadBuffer(
   return EncodedPacket(std::move(encoding_buffer), payload_size);
 }
 
+// Encodes a stream payload with a callback. As in EncodeStreamToPayloadBuffer,
+// the RPC lock is released while encoding if PW_RPC_LOCKLESS_CHANNEL_SEND is
+// enabled.
+Result<EncodedPacket> EncodeStreamCallbackToPayloadBuffer(
+    const Function<StatusWithSize(ByteSpan)>& callback)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) PW_NO_LOCK_SAFETY_ANALYSIS {
+  if constexpr (cfg::kLocklessChannelSendEnabled<>) {
+    rpc_lock().unlock();
+    Result<EncodedPacket> result = EncodeCallbackToPayloadBuffer(callback);
+    rpc_lock().lock();
+    return result;
+  } else {
+    return EncodeCallbackToPayloadBuffer(callback);
+  }
+}
+
 // Creates an active server-side Call.
 Call::Call(const LockedCallContext& context, CallProperties properties)
     : Call(context.server().ClaimLocked(),
@@ -168,13 +184,24 @@ void Call::MoveFrom(Call& other) {
   on_next_ = std::move(other.on_next_);
 
   if (other.active_locked()) {
-    // Mark the other call inactive, unregister it, and register this one.
-    other.MarkClosed();
+    // Unregister the other call, mark it inactive, and register this one. The
+    // other call is unregistered first since the endpoint finds it by its IDs.
     endpoint().UnregisterCall(other);
+    other.MarkClosed();
     endpoint().RegisterUniqueCall(*this);
   }
 }
 
+void Call::set_id(uint32_t id) {
+  if (!active_locked() || !endpoint().IdChangesBucket(*this, id)) {
+    id_ = id;
+    return;
+  }
+  endpoint().UnregisterCall(*this);
+  id_ = id;
+  endpoint().RegisterUniqueCall(*this);
+}
+
 size_t Call::MaxWriteSizeBytes() const {
   RpcLockGuard lock;
   if (!active_locked()) {
@@ -281,7 +308,7 @@ Status Call::WriteLocked(ConstByteSpan payload) {
 
 Status Call::WriteCallbackLocked(
     const Function<StatusWithSize(ByteSpan)>& callback) {
-  PW_TRY_ASSIGN(auto result, EncodeCallbackToPayloadBuffer(callback));
+  PW_TRY_ASSIGN(auto result, EncodeStreamCallbackToPayloadBuffer(callback));
   return SendPacket(properties_.call_type() == kServerCall
                         ? PacketType::SERVER_STREAM
                         : PacketType::CLIENT_STREAM,
@@ -62,53 +62,43 @@ Status ChannelBase::Send(const Packet& packet) {
 
   PW_CHECK_NOTNULL(output_);
 
-  if (output_->SupportsSendPacket()) {
-    if constexpr (cfg::kLocklessChannelSendEnabled<>) {
-      rpc_lock().unlock();
-    }
-
-    Status sent = output_->SendPacket(packet);
-
-    if constexpr (cfg::kLocklessChannelSendEnabled<>) {
-      rpc_lock().lock();
-    }
-
-    if (!sent.ok()) {
-      PW_LOG_ERROR("Channel %u failed to send packet with status %u",
-                   static_cast<unsigned>(id()),
-                   sent.code());
-      // Channel implementers are free to return whichever status makes sense in
-      // their context, but these are always mapped to UNKNOWN so the
-      // user-facing functions (e.g. Finish()) always return a fixed set of
-      // statuses.
-      return Status::Unknown();
-    }
-    return OkStatus();
-  }
-
-  EncodingBuffer encoding_buffer;
-  ByteSpan buffer = encoding_buffer.GetPacketBuffer(packet.payload().size());
-
-  Result encoded = packet.Encode(buffer);
-
-  if (!encoded.ok()) {
-    PW_LOG_ERROR(
-        "Failed to encode RPC packet type %u to channel %u buffer, status %u",
-        static_cast<unsigned>(packet.type()),
-        static_cast<unsigned>(id()),
-        encoded.status().code());
-    return Status::Internal();
-  }
-
+  // With lockless channel sends, each packet is encoded into its own buffer,
+  // so the lock is released while the packet is encoded as well as sent.
+  // ScopedActiveSend keeps the channel from changing in the meantime.
   if constexpr (cfg::kLocklessChannelSendEnabled<>) {
     rpc_lock().unlock();
   }
 
-  Status sent = output_->Send(encoded.value());
+  const Status sent = EncodeAndSend(packet);
 
   if constexpr (cfg::kLocklessChannelSendEnabled<>) {
     rpc_lock().lock();
   }
+  return sent;
+}
+
+Status ChannelBase::EncodeAndSend(const Packet& packet) {
+  Status sent;
+
+  if (output_->SupportsSendPacket()) {
+    sent = output_->SendPacket(packet);
+  } else {
+    EncodingBuffer encoding_buffer;
+    ByteSpan buffer = encoding_buffer.GetPacketBuffer(packet.payload().size());
+
+    Result encoded = packet.Encode(buffer);
+
+    if (!encoded.ok()) {
+      PW_LOG_ERROR(
+          "Failed to encode RPC packet type %u to channel %u buffer, status %u",
+          static_cast<unsigned>(packet.type()),
+          static_cast<unsigned>(id()),
+          encoded.status().code());
+      return Status::Internal();
+    }
+
+    sent = output_->Send(encoded.value());
+  }
 
   if (!sent.ok()) {
     PW_LOG_ERROR("Channel %u failed to send packet with status %u",
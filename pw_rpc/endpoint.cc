@@ -109,49 +109,113 @@ Result<Packet> Endpoint::ProcessPacket(span<const std::byte> data,
   return result;
 }
 
+namespace {
+
+constexpr bool IsOpenCallId(uint32_t call_id) {
+  return call_id == kOpenCallId || call_id == kLegacyOpenCallId;
+}
+
+}  // namespace
+
 void Endpoint::RegisterCall(Call& new_call) {
   // Mark any exisitng duplicate calls as cancelled.
-  auto [before_call, call] = FindIteratorsForCall(new_call);
-  if (call != calls_.end()) {
-    CloseCallAndMarkForCleanup(before_call, call, Status::Cancelled());
+  Call* existing_call = FindCallByIds(new_call.channel_id_locked(),
+                                      new_call.service_id(),
+                                      new_call.method_id(),
+                                      new_call.id());
+  if (existing_call != nullptr) {
+    CloseCallAndMarkForCleanup(*existing_call, Status::Cancelled());
   }
 
   // Register the new call.
-  calls_.push_front(new_call);
+  RegisterUniqueCall(new_call);
 }
 
-std::tuple<IntrusiveForwardList<Call>::iterator,
-           IntrusiveForwardList<Call>::iterator>
-Endpoint::FindIteratorsForCall(uint32_t channel_id,
-                               uint32_t service_id,
-                               uint32_t method_id,
-                               uint32_t call_id) {
-  auto previous = calls_.before_begin();
-  auto call = calls_.begin();
-
-  while (call != calls_.end()) {
-    if (channel_id == call->channel_id_locked() &&
-        service_id == call->service_id() && method_id == call->method_id()) {
-      if (call_id == call->id() || call_id == kOpenCallId ||
-          call_id == kLegacyOpenCallId) {
-        break;
+Call* Endpoint::FindCallByIds(uint32_t channel_id,
+                              uint32_t service_id,
+                              uint32_t method_id,
+                              uint32_t call_id) {
+  if (IsOpenCallId(call_id)) {
+    // The call could have any ID, so it could be in any bucket.
+    for (IntrusiveForwardList<Call>& bucket : calls_) {
+      Call* call = FindCallInBucket(
+          bucket, channel_id, service_id, method_id, call_id);
+      if (call != nullptr) {
+        return call;
       }
-      if (call->id() == kOpenCallId || call->id() == kLegacyOpenCallId) {
-        // Calls with ID of `kOpenCallId` were unrequested, and
-        // are updated to have the call ID of the first matching request.
-        //
-        // kLegacyOpenCallId is used for compatibility with old servers
-        // which do not specify a Call ID but expect to be able to send
-        // unrequested responses.
-        call->set_id(call_id);
-        break;
+    }
+    return nullptr;
+  }
+
+  const size_t index = BucketIndex(channel_id, service_id, method_id, call_id);
+  Call* call = FindCallInBucket(
+      calls_[index], channel_id, service_id, method_id, call_id);
+  if (call != nullptr) {
+    if (IsOpenCallId(call->id())) {
+      // Calls with an open ID share a bucket with the call IDs that hash to it,
+      // so a call with an open ID may be found here.
+      call->set_id(call_id);
+    }
+    return call;
+  }
+
+  // Check for a call with an open ID, which is stored in the kOpenCallId
+  // bucket.
+  const size_t open_index =
+      BucketIndex(channel_id, service_id, method_id, kOpenCallId);
+  if (open_index == index) {
+    return nullptr;
+  }
+  call = FindCallInBucket(
+      calls_[open_index], channel_id, service_id, method_id, call_id);
+  if (call != nullptr) {
+    // The call adopts this call ID, which moves it to the bucket for that ID.
+    call->set_id(call_id);
+  }
+  return call;
+}
+
+Call* Endpoint::FindCallInBucket(IntrusiveForwardList<Call>& bucket,
+                                 uint32_t channel_id,
+                                 uint32_t service_id,
+                                 uint32_t method_id,
+                                 uint32_t call_id) {
+  for (Call& call : bucket) {
+    if (channel_id == call.channel_id_locked() &&
+        service_id == call.service_id() && method_id == call.method_id()) {
+      // Calls with ID of `kOpenCallId` were unrequested, and are updated to
+      // have the call ID of the first matching request.
+      //
+      // kLegacyOpenCallId is used for compatibility with old servers which do
+      // not specify a Call ID but expect to be able to send unrequested
+      // responses.
+      if (call_id == call.id() || IsOpenCallId(call_id) ||
+          IsOpenCallId(call.id())) {
+        return &call;
       }
     }
-    previous = call;
-    ++call;
+  }
+  return nullptr;
+}
+
+size_t Endpoint::BucketIndex(uint32_t channel_id,
+                             uint32_t service_id,
+                             uint32_t method_id,
+                             uint32_t call_id) {
+  if constexpr (cfg::kCallHashBuckets == 1) {
+    return 0;
   }
 
-  return {previous, call};
+  // Service and method IDs are already hashes. Mix in the channel and call ID,
+  // which are typically small sequential integers.
+  if (call_id == kLegacyOpenCallId) {
+    call_id = kOpenCallId;
+  }
+  uint32_t hash = service_id ^ (method_id * 0x9e3779b1u);
+  hash ^= channel_id * 0x85ebca77u;
+  hash ^= call_id * 0xc2b2ae3du;
+  hash ^= hash >> 16;
+  return hash % cfg::kCallHashBuckets;
 }
 
 Status Endpoint::CloseChannel(uint32_t channel_id) {
@@ -173,17 +237,21 @@ Status Endpoint::CloseChannel(uint32_t channel_id) {
 }
 
 void Endpoint::AbortCalls(AbortIdType type, uint32_t id) {
-  auto previous = calls_.before_begin();
-  auto current = calls_.begin();
-
-  while (current != calls_.end()) {
-    if (id == (type == AbortIdType::kChannel ? current->channel_id_locked()
-                                             : current->service_id())) {
-      current =
-          CloseCallAndMarkForCleanup(previous, current, Status::Aborted());
-    } else {
-      previous = current;
-      ++current;
+  for (IntrusiveForwardList<Call>& bucket : calls_) {
+    auto previous = bucket.before_begin();
+    auto current = bucket.begin();
+
+    while (current != bucket.end()) {
+      if (id == (type == AbortIdType::kChannel ? current->channel_id_locked()
+                                               : current->service_id())) {
+        Call& call = *current;
+        current = bucket.erase_after(previous);
+        call.CloseAndMarkForCleanupFromEndpoint(Status::Aborted());
+        to_cleanup_.push_front(call);
+      } else {
+        previous = current;
+        ++current;
+      }
     }
   }
 }
@@ -217,9 +285,11 @@ void Endpoint::RemoveAllCalls() {
 
   // Close all calls without invoking on_error callbacks, since the calls should
   // have been closed before the Endpoint was deleted.
-  while (!calls_.empty()) {
-    calls_.front().CloseFromDeletedEndpoint();
-    calls_.pop_front();
+  for (IntrusiveForwardList<Call>& bucket : calls_) {
+    while (!bucket.empty()) {
+      bucket.front().CloseFromDeletedEndpoint();
+      bucket.pop_front();
+    }
   }
   while (!to_cleanup_.empty()) {
     to_cleanup_.front().CloseFromDeletedEndpoint();
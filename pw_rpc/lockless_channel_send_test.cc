@@ -16,10 +16,27 @@
 
 #if PW_RPC_LOCKLESS_CHANNEL_SEND
 
+#define PW_LOG_MODULE_NAME "pw_rpc test"
+#define PW_LOG_LEVEL PW_LOG_LEVEL_INFO
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
 #include "pw_rpc/channel.h"
+#include "pw_rpc/internal/call_context.h"
 #include "pw_rpc/internal/channel_list.h"
 #include "pw_rpc/internal/lock.h"
 #include "pw_rpc/internal/packet.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc/service.h"
+#include "pw_rpc_private/fake_server_reader_writer.h"
+#include "pw_rpc_private/test_method.h"
 #include "pw_sync/binary_semaphore.h"
 #include "pw_thread/sleep.h"
 #include "pw_thread/test_thread_context.h"
@@ -131,6 +148,217 @@ TEST(LocklessChannelSend, SendBlocksModification) {
   }
 }
 
+// Multi-writer throughput benchmark. Each writer thread streams packets from
+// its own server call. The channel output stands in for a transport: it
+// decodes every packet, checks that its payload was not overwritten by
+// another writer, and sums the payload. Throughput is logged for increasing
+// numbers of writers; it is not asserted on, since it depends on the host.
+
+constexpr uint32_t kBenchmarkChannelId = 1;
+constexpr uint32_t kBenchmarkServiceId = 16;
+constexpr size_t kMaxWriters = 8;
+constexpr size_t kPacketsPerWriter = 2000;
+constexpr size_t kPayloadSizeBytes = 256;
+
+class BenchmarkService : public Service {
+ public:
+  constexpr BenchmarkService(uint32_t id) : Service(id, method) {}
+
+  static constexpr TestMethodUnion method = TestMethod(8);
+};
+
+class CheckingChannelOutput final : public ChannelOutput {
+ public:
+  CheckingChannelOutput() : ChannelOutput("checking") {}
+
+  size_t packets() const { return packets_.load(std::memory_order_relaxed); }
+  size_t responses() const {
+    return responses_.load(std::memory_order_relaxed);
+  }
+  size_t corrupt_packets() const {
+    return corrupt_packets_.load(std::memory_order_relaxed);
+  }
+
+  Status Send(span<const std::byte> buffer) override {
+    Result<Packet> packet = Packet::FromBuffer(buffer);
+    if (packet.ok() && packet->type() == pwpb::PacketType::RESPONSE) {
+      // Sent when a call finishes.
+      responses_.fetch_add(1, std::memory_order_relaxed);
+      return OkStatus();
+    }
+    if (!packet.ok() || packet->payload().size() != kPayloadSizeBytes) {
+      corrupt_packets_.fetch_add(1, std::memory_order_relaxed);
+      return OkStatus();
+    }
+
+    uint32_t sum = 0;
+    const std::byte first = packet->payload().front();
+    for (std::byte b : packet->payload()) {
+      if (b != first) {
+        corrupt_packets_.fetch_add(1, std::memory_order_relaxed);
+        return OkStatus();
+      }
+      sum += static_cast<uint32_t>(b);
+    }
+
+    checksum_.fetch_add(sum, std::memory_order_relaxed);
+    packets_.fetch_add(1, std::memory_order_relaxed);
+    return OkStatus();
+  }
+
+ private:
+  std::atomic<size_t> packets_ = 0;
+  std::atomic<size_t> responses_ = 0;
+  std::atomic<size_t> corrupt_packets_ = 0;
+  std::atomic<uint32_t> checksum_ = 0;
+};
+
+// How writers pass their payloads to the call.
+enum class WriteMode {
+  // Write a payload that is already encoded.
+  kBytes,
+  // Encode the payload into the call's buffer from a callback, which runs
+  // outside the RPC lock.
+  kCallback,
+};
+
+// Writes kPacketsPerWriter payloads filled with a byte unique to the writer.
+struct StreamWriter {
+  void Run() {
+    std::array<std::byte, kPayloadSizeBytes> payload;
+    payload.fill(fill);
+    const std::byte payload_fill = fill;
+    for (size_t i = 0; i < kPacketsPerWriter; ++i) {
+      Status status;
+      if (mode == WriteMode::kBytes) {
+        status = call.Write(payload);
+      } else {
+        status = call.Write([payload_fill](ByteSpan buffer) {
+          if (buffer.size() < kPayloadSizeBytes) {
+            return StatusWithSize::ResourceExhausted();
+          }
+          std::fill_n(buffer.begin(), kPayloadSizeBytes, payload_fill);
+          return StatusWithSize(kPayloadSizeBytes);
+        });
+      }
+      if (!status.ok()) {
+        failed_writes += 1;
+      }
+    }
+  }
+
+  test::FakeServerWriter call;
+  std::byte fill{};
+  WriteMode mode = WriteMode::kBytes;
+  size_t failed_writes = 0;
+};
+
+test::FakeServerWriter OpenWriter(Server& server,
+                                  BenchmarkService& service,
+                                  uint32_t call_id) {
+  CallContext context(server,
+                      kBenchmarkChannelId,
+                      service,
+                      BenchmarkService::method.method(),
+                      call_id);
+  RpcLockGuard lock;
+  return test::FakeServerWriter(context.ClaimLocked());
+}
+
+void RunWriters(size_t writer_count, WriteMode mode) {
+  CheckingChannelOutput output;
+  Channel channel = Channel::Create<kBenchmarkChannelId>(&output);
+  Server server(span(&channel, 1));
+  BenchmarkService service(kBenchmarkServiceId);
+  server.RegisterService(service);
+
+  std::array<StreamWriter, kMaxWriters> writers;
+  for (size_t i = 0; i < writer_count; ++i) {
+    writers[i].call =
+        OpenWriter(server, service, static_cast<uint32_t>(i + 1));
+    writers[i].fill = static_cast<std::byte>(i + 1);
+    writers[i].mode = mode;
+  }
+
+  std::array<thread::test::TestThreadContext, kMaxWriters> contexts;
+  std::array<Thread, kMaxWriters> threads;
+
+  const chrono::SystemClock::time_point start = chrono::SystemClock::now();
+  for (size_t i = 0; i < writer_count; ++i) {
+    threads[i] = Thread(contexts[i].options(),
+                        [writer = &writers[i]]() { writer->Run(); });
+  }
+  for (size_t i = 0; i < writer_count; ++i) {
+    threads[i].join();
+  }
+  const chrono::SystemClock::duration elapsed =
+      chrono::SystemClock::now() - start;
+
+  const size_t total_packets = writer_count * kPacketsPerWriter;
+  EXPECT_EQ(output.packets(), total_packets);
+  EXPECT_EQ(output.corrupt_packets(), 0u);
+  for (size_t i = 0; i < writer_count; ++i) {
+    EXPECT_EQ(writers[i].failed_writes, 0u);
+    EXPECT_EQ(writers[i].call.Finish(), OkStatus());
+  }
+
+  const auto micros =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  const uint64_t safe_micros = micros > 0 ? static_cast<uint64_t>(micros) : 1;
+  PW_LOG_INFO("%u writers: %u packets in %u us (%u packets/s)",
+              static_cast<unsigned>(writer_count),
+              static_cast<unsigned>(total_packets),
+              static_cast<unsigned>(safe_micros),
+              static_cast<unsigned>(total_packets * 1'000'000 / safe_micros));
+}
+
+TEST(LocklessChannelSend, MultipleWritersThroughput) {
+  for (size_t writers = 1; writers <= kMaxWriters; writers *= 2) {
+    RunWriters(writers, WriteMode::kBytes);
+  }
+}
+
+TEST(LocklessChannelSend, MultipleWritersThroughput_EncodeCallback) {
+  for (size_t writers = 1; writers <= kMaxWriters; writers *= 2) {
+    RunWriters(writers, WriteMode::kCallback);
+  }
+}
+
+TEST(LocklessChannelSend, CallClosedWhileEncoding) {
+  CheckingChannelOutput output;
+  Channel channel = Channel::Create<kBenchmarkChannelId>(&output);
+  Server server(span(&channel, 1));
+  BenchmarkService service(kBenchmarkServiceId);
+  server.RegisterService(service);
+
+  test::FakeServerWriter call = OpenWriter(server, service, 1);
+  sync::BinarySemaphore encoding;
+  sync::BinarySemaphore closed;
+  Status write_status;
+
+  thread::test::TestThreadContext context;
+  Thread writer(context.options(), [&]() {
+    write_status = call.Write([&](ByteSpan buffer) {
+      // The RPC lock is not held while encoding, so the call can be closed.
+      encoding.release();
+      closed.acquire();
+      std::fill_n(buffer.begin(), kPayloadSizeBytes, std::byte{1});
+      return StatusWithSize(kPayloadSizeBytes);
+    });
+  });
+
+  encoding.acquire();
+  EXPECT_EQ(call.Finish(), OkStatus());
+  closed.release();
+  writer.join();
+
+  // The call is checked again after encoding, so the payload is not sent.
+  EXPECT_EQ(write_status, Status::FailedPrecondition());
+  EXPECT_EQ(output.packets(), 0u);
+  EXPECT_EQ(output.corrupt_packets(), 0u);
+  EXPECT_EQ(output.responses(), 1u);
+}
+
 }  // namespace
 }  // namespace pw::rpc::internal
 
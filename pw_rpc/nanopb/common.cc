@@ -112,7 +112,7 @@ Status NanopbSendStream(Call& call,
     return Status::FailedPrecondition();
   }
 
-  auto result = EncodeToPayloadBuffer(
+  auto result = EncodeStreamToPayloadBuffer(
       payload,
       call.type() == kClientCall ? serde->request() : serde->response());
 
@@ -243,6 +243,9 @@ class ChannelBase {
 
   // Invokes ChannelOutput::Send and returns its status. Any non-OK status
   // indicates that the Channel is permanently closed.
+  //
+  // If PW_RPC_LOCKLESS_CHANNEL_SEND is enabled, the RPC lock is released while
+  // the packet is encoded and sent.
   Status Send(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
   constexpr void Close() {
@@ -260,6 +263,10 @@ class ChannelBase {
       : id_(id), output_(output) {}
 
  private:
+  // Encodes the packet, if necessary, and passes it to the ChannelOutput.
+  Status EncodeAndSend(const Packet& packet)
+      PW_RPC_CHANNEL_OUTPUT_SEND_LOCK_REQUIREMENT;
+
   uint32_t id_;
   ChannelOutput* output_;
 };
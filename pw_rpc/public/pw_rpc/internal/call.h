@@ -153,7 +153,9 @@ class Call : public IntrusiveForwardList<Call>::Item, private rpc::Writer {
 
   uint32_t id() const PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) { return id_; }
 
-  void set_id(uint32_t id) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) { id_ = id; }
+  // Changes the call's ID. Active calls are moved to the endpoint's bucket for
+  // the new ID.
+  void set_id(uint32_t id) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
   // Public function for accessing the channel ID of this call. Set to 0 when
   // the call is closed.
@@ -196,6 +196,11 @@
 /// Whether to remove the requirement that Channel::Send hold the pw_rpc global
 /// lock while calling ChannelOutput::Send.
 ///
+/// When enabled, each outgoing packet is encoded into its own dynamically
+/// allocated buffer instead of the shared encoding buffer. The global lock is
+/// then also released while stream payloads and packets are encoded, so
+/// multiple threads writing to streams only serialize on call bookkeeping.
+///
 /// This option depends on PW_RPC_DYNAMIC_ALLOCATION being enabled.
 #ifndef PW_RPC_LOCKLESS_CHANNEL_SEND
 #define PW_RPC_LOCKLESS_CHANNEL_SEND 0
@@ -217,6 +222,35 @@ static_assert(PW_RPC_ALLOW_INVOCATIONS_ON_STACK || PW_RPC_DYNAMIC_ALLOCATION,
               "If PW_RPC_ALLOW_INVOCATIONS_ON_STACK is 0, "
               "PW_RPC_DYNAMIC_ALLOCATION must be 1 to allow RPC calls.");
 
+/// The number of hash buckets each endpoint uses to index its active calls by
+/// channel, service, method, and call ID. With the default of 1, all calls
+/// share one list and finding the call for an incoming packet takes time
+/// proportional to the number of open calls. Endpoints with many long-lived
+/// calls, such as host-side servers with thousands of open streams, can set
+/// this to a larger value so packet dispatch stays fast. The buckets are a
+/// fixed-size array in each endpoint, so each one costs a pointer and no
+/// memory is allocated.
+///
+/// Packets without a call ID, which are sent by older pw_rpc versions, are
+/// still matched by checking every active call.
+#ifndef PW_RPC_CALL_HASH_BUCKETS
+#define PW_RPC_CALL_HASH_BUCKETS 1
+#endif  // PW_RPC_CALL_HASH_BUCKETS
+
+static_assert(PW_RPC_CALL_HASH_BUCKETS > 0,
+              "PW_RPC_CALL_HASH_BUCKETS must be at least 1");
+
+/// The number of hash buckets each server uses to index its registered
+/// services by service ID. With the default of 1, finding the service for an
+/// incoming packet takes time proportional to the number of registered
+/// services. Each bucket costs two pointers per server.
+#ifndef PW_RPC_SERVICE_HASH_BUCKETS
+#define PW_RPC_SERVICE_HASH_BUCKETS 1
+#endif  // PW_RPC_SERVICE_HASH_BUCKETS
+
+static_assert(PW_RPC_SERVICE_HASH_BUCKETS > 0,
+              "PW_RPC_SERVICE_HASH_BUCKETS must be at least 1");
+
 #if defined(PW_RPC_DYNAMIC_CONTAINER) || \
     defined(PW_RPC_DYNAMIC_CONTAINER_INCLUDE)
 static_assert(
@@ -311,6 +345,10 @@ inline constexpr size_t kNanopbStructMinBufferSize =
 inline constexpr size_t kEncodingBufferSizeBytes =
     PW_RPC_ENCODING_BUFFER_SIZE_BYTES;
 
+inline constexpr size_t kCallHashBuckets = PW_RPC_CALL_HASH_BUCKETS;
+
+inline constexpr size_t kServiceHashBuckets = PW_RPC_SERVICE_HASH_BUCKETS;
+
 #undef PW_RPC_NANOPB_STRUCT_MIN_BUFFER_SIZE
 #undef PW_RPC_ENCODING_BUFFER_SIZE_BYTES
 
@@ -165,4 +165,22 @@ template <typename Proto, typename Encoder>
   return EncodedPacket(std::move(encoding_buffer), result.size());
 }
 
+// Encodes a client or server stream payload. If PW_RPC_LOCKLESS_CHANNEL_SEND is
+// enabled, each payload has its own buffer, so the RPC lock is released while
+// the payload is encoded. The call may close in the meantime, so callers must
+// check that it is still active before sending the payload.
+template <typename Proto, typename Encoder>
+[[maybe_unused]] static Result<EncodedPacket> EncodeStreamToPayloadBuffer(
+    Proto& payload, const Encoder& encoder)
+    PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) PW_NO_LOCK_SAFETY_ANALYSIS {
+  if constexpr (cfg::kLocklessChannelSendEnabled<Proto>) {
+    rpc_lock().unlock();
+    Result<EncodedPacket> result = EncodeToPayloadBuffer(payload, encoder);
+    rpc_lock().lock();
+    return result;
+  } else {
+    return EncodeToPayloadBuffer(payload, encoder);
+  }
+}
+
 }  // namespace pw::rpc::internal
@@ -13,9 +13,10 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
-#include <tuple>
 
 #include "pw_assert/assert.h"
 #include "pw_containers/intrusive_list.h"
@@ -23,6 +24,7 @@
 #include "pw_rpc/channel.h"
 #include "pw_rpc/internal/call.h"
 #include "pw_rpc/internal/channel_list.h"
+#include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/lock.h"
 #include "pw_rpc/internal/packet.h"
 #include "pw_span/span.h"
@@ -40,6 +42,10 @@ class LockedEndpoint;
 // calls add themselves to the Endpoint's list when they're started and
 // remove themselves when they complete. Calls do this through their associated
 // Server or Client object, which derive from Endpoint.
+//
+// Active calls are kept in PW_RPC_CALL_HASH_BUCKETS lists, selected by a hash
+// of the call's channel, service, method, and call ID. Calls with an open call
+// ID are stored in the bucket for kOpenCallId.
 class Endpoint {
  public:
   // If an endpoint is deleted, all calls using it are closed without notifying
@@ -74,7 +80,11 @@ class Endpoint {
   // Returns the number calls in the RPC calls list.
   size_t active_call_count() const PW_LOCKS_EXCLUDED(rpc_lock()) {
     RpcLockGuard lock;
-    return static_cast<size_t>(std::distance(calls_.begin(), calls_.end()));
+    size_t count = 0;
+    for (const IntrusiveForwardList<Call>& bucket : calls_) {
+      count += static_cast<size_t>(std::distance(bucket.begin(), bucket.end()));
+    }
+    return count;
   }
 
   // Claims that `rpc_lock()` is held, returning a wrapped endpoint.
@@ -127,19 +137,12 @@ class Endpoint {
       PW_LOCKS_EXCLUDED(rpc_lock());
 
   // Finds a call object for an ongoing call associated with this packet, if
-  // any. The iterator will be calls_end() if no match was found.
-  IntrusiveForwardList<Call>::iterator FindCall(const Packet& packet)
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return std::get<1>(FindIteratorsForCall(packet.channel_id(),
-                                            packet.service_id(),
-                                            packet.method_id(),
-                                            packet.call_id()));
-  }
-
-  // Used to check if a call iterator is valid or not.
-  IntrusiveForwardList<Call>::const_iterator calls_end() const
-      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return calls_.end();
+  // any. Returns nullptr if no match was found.
+  Call* FindCall(const Packet& packet) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return FindCallByIds(packet.channel_id(),
+                         packet.service_id(),
+                         packet.method_id(),
+                         packet.call_id());
   }
 
   // Aborts calls associated with a particular service. Calls to
@@ -155,22 +158,9 @@ class Endpoint {
   // This method is protected so it can be exposed in tests.
   void CloseCallAndMarkForCleanup(Call& call, Status error)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    UnregisterCall(call);
     call.CloseAndMarkForCleanupFromEndpoint(error);
-    calls_.remove(call);
-    to_cleanup_.push_front(call);
-  }
-
-  // Iterator version of CloseCallAndMarkForCleanup. Returns the iterator to the
-  // item after the closed call.
-  IntrusiveForwardList<Call>::iterator CloseCallAndMarkForCleanup(
-      IntrusiveForwardList<Call>::iterator before_call,
-      IntrusiveForwardList<Call>::iterator call_iterator,
-      Status error) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    Call& call = *call_iterator;
-    call.CloseAndMarkForCleanupFromEndpoint(error);
-    auto next = calls_.erase_after(before_call);
     to_cleanup_.push_front(call);
-    return next;
   }
 
  private:
@@ -208,7 +198,7 @@ class Endpoint {
   // Registers a call that is known to be unique. The calls list is NOT checked
   // for existing calls.
   void RegisterUniqueCall(Call& call) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    calls_.push_front(call);
+    BucketFor(call).push_front(call);
   }
 
   void CleanUpCall(Call& call) PW_UNLOCK_FUNCTION(rpc_lock()) {
@@ -217,29 +207,50 @@ class Endpoint {
     call.CleanUpFromEndpoint();
   }
 
-  // Removes the provided call from the call registry.
+  // Removes the provided call from the call registry. The call's IDs must not
+  // have changed since it was registered.
   void UnregisterCall(const Call& call)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    bool closed_call_was_in_list = calls_.remove(call);
+    bool closed_call_was_in_list = BucketFor(call).remove(call);
     PW_DASSERT(closed_call_was_in_list);
   }
 
-  std::tuple<IntrusiveForwardList<Call>::iterator,
-             IntrusiveForwardList<Call>::iterator>
-  FindIteratorsForCall(uint32_t channel_id,
-                       uint32_t service_id,
-                       uint32_t method_id,
-                       uint32_t call_id)
+  // Finds the active call with these IDs, or nullptr if there is none. An open
+  // call ID in the search matches any call ID. A call with an open call ID
+  // matches any call ID, and adopts the searched-for ID.
+  Call* FindCallByIds(uint32_t channel_id,
+                      uint32_t service_id,
+                      uint32_t method_id,
+                      uint32_t call_id) PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
+
+  // Searches one bucket for a call as described in FindCallByIds.
+  static Call* FindCallInBucket(IntrusiveForwardList<Call>& bucket,
+                                uint32_t channel_id,
+                                uint32_t service_id,
+                                uint32_t method_id,
+                                uint32_t call_id)
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock());
 
-  std::tuple<IntrusiveForwardList<Call>::iterator,
-             IntrusiveForwardList<Call>::iterator>
-  FindIteratorsForCall(const Call& call)
+  static size_t BucketIndex(uint32_t channel_id,
+                            uint32_t service_id,
+                            uint32_t method_id,
+                            uint32_t call_id);
+
+  IntrusiveForwardList<Call>& BucketFor(const Call& call)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
+    return calls_[BucketIndex(call.channel_id_locked(),
+                              call.service_id(),
+                              call.method_id(),
+                              call.id())];
+  }
+
+  // Whether changing the call's ID to `new_id` moves it to another bucket.
+  bool IdChangesBucket(const Call& call, uint32_t new_id) const
       PW_EXCLUSIVE_LOCKS_REQUIRED(rpc_lock()) {
-    return FindIteratorsForCall(call.channel_id_locked(),
-                                call.service_id(),
-                                call.method_id(),
-                                call.id());
+    const uint32_t channel_id = call.channel_id_locked();
+    return BucketIndex(
+               channel_id, call.service_id(), call.method_id(), call.id()) !=
+           BucketIndex(channel_id, call.service_id(), call.method_id(), new_id);
   }
 
   // Silently closes all calls. Called by the destructor. This is a
@@ -255,9 +266,11 @@ class Endpoint {
 
   ChannelList channels_ PW_GUARDED_BY(rpc_lock());
 
-  // List of all active calls associated with this endpoint. Calls are added to
-  // this list when they start and removed from it when they finish.
-  IntrusiveForwardList<Call> calls_ PW_GUARDED_BY(rpc_lock());
+  // Lists of all active calls associated with this endpoint, indexed by
+  // BucketIndex. Calls are added to a list when they start and removed from it
+  // when they finish.
+  std::array<IntrusiveForwardList<Call>, cfg::kCallHashBuckets> calls_
+      PW_GUARDED_BY(rpc_lock());
 
   // List of all inactive calls that need to have their on_error callbacks
   // called. Calling on_error requires releasing the RPC lock, so calls are
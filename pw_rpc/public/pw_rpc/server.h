@@ -13,12 +13,15 @@
 // the License.
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
 
 #include "pw_containers/intrusive_list.h"
 #include "pw_rpc/channel.h"
 #include "pw_rpc/internal/call.h"
+#include "pw_rpc/internal/config.h"
 #include "pw_rpc/internal/endpoint.h"
 #include "pw_rpc/internal/grpc.h"
 #include "pw_rpc/internal/lock.h"
@@ -56,11 +59,11 @@ class Server : public internal::Endpoint {
   void RegisterService(Service& service, OtherServices&... services)
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
     internal::RpcLockGuard lock;
-    services_.push_front(service);  // Register the first service
+    BucketFor(service).push_front(service);  // Register the first service
 
     // Register any additional services by expanding the parameter pack. This
     // is a fold expression of the comma operator.
-    (services_.push_front(services), ...);
+    (BucketFor(services).push_front(services), ...);
   }
 
   // Returns whether a service is registered.
@@ -71,7 +74,7 @@ class Server : public internal::Endpoint {
       PW_LOCKS_EXCLUDED(internal::rpc_lock()) {
     internal::RpcLockGuard lock;
 
-    for (const Service& svc : services_) {
+    for (const Service& svc : BucketFor(service)) {
       if (&svc == &service) {
         return true;
       }
@@ -192,19 +195,19 @@ class Server : public internal::Endpoint {
   void HandleCompletionRequest(
       const internal::Packet& packet,
       internal::ChannelBase& channel,
-      IntrusiveForwardList<internal::Call>::iterator call) const
+      internal::Call* call) const
       PW_UNLOCK_FUNCTION(internal::rpc_lock());
 
   void HandleClientStreamPacket(
       const internal::Packet& packet,
       internal::ChannelBase& channel,
-      IntrusiveForwardList<internal::Call>::iterator call) const
+      internal::Call* call) const
       PW_UNLOCK_FUNCTION(internal::rpc_lock());
 
   template <typename... OtherServices>
   void UnregisterServiceLocked(Service& service, OtherServices&... services)
       PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
-    services_.remove(service);
+    BucketFor(service).remove(service);
     UnregisterServiceLocked(services...);
     AbortCallsForService(service);
   }
@@ -220,7 +223,28 @@ class Server : public internal::Endpoint {
   using Endpoint::CleanUpCalls;
   using Endpoint::GetInternalChannel;
 
-  IntrusiveList<Service> services_ PW_GUARDED_BY(internal::rpc_lock());
+  static constexpr size_t BucketIndex(uint32_t service_id) {
+    // Service IDs are hashes, so they may be used directly.
+    return service_id % cfg::kServiceHashBuckets;
+  }
+
+  static size_t BucketIndex(const Service& service) {
+    return BucketIndex(internal::UnwrapServiceId(service.service_id()));
+  }
+
+  IntrusiveList<Service>& BucketFor(const Service& service)
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
+    return services_[BucketIndex(service)];
+  }
+
+  const IntrusiveList<Service>& BucketFor(const Service& service) const
+      PW_EXCLUSIVE_LOCKS_REQUIRED(internal::rpc_lock()) {
+    return services_[BucketIndex(service)];
+  }
+
+  // Lists of the registered services, indexed by BucketIndex.
+  std::array<IntrusiveList<Service>, cfg::kServiceHashBuckets> services_
+      PW_GUARDED_BY(internal::rpc_lock());
 };
 
 /// @}
@@ -0,0 +1,176 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_rpc/internal/config.h"
+
+#if PW_RPC_LOCKLESS_CHANNEL_SEND
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/pwpb/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.rpc.pwpb.h"
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::rpc {
+namespace {
+
+namespace TestRequest = ::pw::rpc::test::pwpb::TestRequest;
+namespace TestResponse = ::pw::rpc::test::pwpb::TestResponse;
+namespace TestStreamResponse = ::pw::rpc::test::pwpb::TestStreamResponse;
+
+using test::pw_rpc::pwpb::TestService;
+
+class TestServiceImpl final : public TestService::Service<TestServiceImpl> {
+ public:
+  Status TestUnaryRpc(const TestRequest::Message&, TestResponse::Message&) {
+    return OkStatus();
+  }
+
+  void TestAnotherUnaryRpc(const TestRequest::Message&,
+                           PwpbUnaryResponder<TestResponse::Message>&) {}
+
+  void TestServerStreamRpc(const TestRequest::Message&,
+                           PwpbServerWriter<TestStreamResponse::Message>&) {}
+
+  void TestClientStreamRpc(
+      PwpbServerReader<TestRequest::Message, TestStreamResponse::Message>&) {}
+
+  void TestBidirectionalStreamRpc(
+      PwpbServerReaderWriter<TestRequest::Message,
+                             TestStreamResponse::Message>&) {}
+};
+
+constexpr size_t kWriters = 4;
+constexpr uint32_t kMessagesPerWriter = 2000;
+constexpr size_t kChunkSizeBytes = 24;
+
+// Decodes each stream message and checks that its chunk holds only the
+// writer's byte and that each writer's messages arrive in order. Messages from
+// one writer are sent by one thread, so each writer's count is only updated by
+// that thread.
+class CheckingChannelOutput final : public ChannelOutput {
+ public:
+  CheckingChannelOutput() : ChannelOutput("checking") {}
+
+  uint32_t messages(size_t writer) const { return messages_[writer]; }
+  size_t corrupt_messages() const {
+    return corrupt_messages_.load(std::memory_order_relaxed);
+  }
+
+  Status Send(span<const std::byte> buffer) override {
+    Result<internal::Packet> packet = internal::Packet::FromBuffer(buffer);
+    if (packet.ok() &&
+        packet->type() == internal::pwpb::PacketType::RESPONSE) {
+      return OkStatus();  // Sent when a call finishes.
+    }
+    if (!packet.ok() || !Check(packet->payload())) {
+      corrupt_messages_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return OkStatus();
+  }
+
+ private:
+  bool Check(ConstByteSpan payload) {
+    Result<ConstByteSpan> chunk = TestStreamResponse::FindChunk(payload);
+    Result<uint32_t> number = TestStreamResponse::FindNumber(payload);
+    if (!chunk.ok() || !number.ok() || chunk->size() != kChunkSizeBytes) {
+      return false;
+    }
+
+    const size_t writer = static_cast<size_t>(chunk->front()) - 1;
+    if (writer >= kWriters || number.value() != messages_[writer] + 1) {
+      return false;
+    }
+    for (std::byte b : *chunk) {
+      if (b != chunk->front()) {
+        return false;
+      }
+    }
+    messages_[writer] += 1;
+    return true;
+  }
+
+  std::array<uint32_t, kWriters> messages_{};
+  std::atomic<size_t> corrupt_messages_ = 0;
+};
+
+// Writes kMessagesPerWriter messages numbered from 1, whose chunks are filled
+// with a byte unique to the writer.
+struct StreamWriter {
+  void Run() {
+    TestStreamResponse::Message message;
+    message.chunk.assign(kChunkSizeBytes, fill);
+    for (uint32_t number = 1; number <= kMessagesPerWriter; ++number) {
+      message.number = number;
+      if (!call.Write(message).ok()) {
+        failed_writes += 1;
+      }
+    }
+  }
+
+  PwpbServerWriter<TestStreamResponse::Message> call;
+  std::byte fill{};
+  size_t failed_writes = 0;
+};
+
+TEST(PwpbLocklessChannelSend, MultipleWritersEncodeIndependently) {
+  // Calls opened by the server share a call ID, so each writer streams on its
+  // own channel.
+  CheckingChannelOutput output;
+  std::array<Channel, kWriters> channels = {
+      Channel::Create<1>(&output),
+      Channel::Create<2>(&output),
+      Channel::Create<3>(&output),
+      Channel::Create<4>(&output),
+  };
+  Server server(channels);
+  TestServiceImpl service;
+  server.RegisterService(service);
+
+  std::array<StreamWriter, kWriters> writers;
+  for (size_t i = 0; i < kWriters; ++i) {
+    writers[i].call = PwpbServerWriter<TestStreamResponse::Message>::Open<
+        TestService::TestServerStreamRpc>(server, channels[i].id(), service);
+    writers[i].fill = static_cast<std::byte>(i + 1);
+  }
+
+  std::array<thread::test::TestThreadContext, kWriters> contexts;
+  std::array<Thread, kWriters> threads;
+  for (size_t i = 0; i < kWriters; ++i) {
+    threads[i] = Thread(contexts[i].options(),
+                        [writer = &writers[i]]() { writer->Run(); });
+  }
+  for (Thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(output.corrupt_messages(), 0u);
+  for (size_t i = 0; i < kWriters; ++i) {
+    EXPECT_EQ(writers[i].failed_writes, 0u);
+    EXPECT_EQ(output.messages(i), kMessagesPerWriter);
+    EXPECT_EQ(writers[i].call.Finish(), OkStatus());
+  }
+}
+
+}  // namespace
+}  // namespace pw::rpc
+
+#endif  // PW_RPC_LOCKLESS_CHANNEL_SEND
@@ -63,7 +63,7 @@ Status PwpbSendStream(Call& call,
     return Status::FailedPrecondition();
   }
 
-  auto buffer = EncodeToPayloadBuffer(
+  auto buffer = EncodeStreamToPayloadBuffer(
       payload,
       call.type() == kClientCall ? serde->request() : serde->response());
   PW_TRY(buffer.status());
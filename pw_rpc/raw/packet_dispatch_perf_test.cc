@@ -0,0 +1,157 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures how long the server takes to dispatch a client stream packet to one
+// of many open calls. With PW_RPC_CALL_HASH_BUCKETS set to 1, the time grows
+// with the number of open calls; with more buckets, it should stay flat.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/span.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_rpc/channel.h"
+#include "pw_rpc/internal/method_info.h"
+#include "pw_rpc/internal/packet.h"
+#include "pw_rpc/raw/server_reader_writer.h"
+#include "pw_rpc/server.h"
+#include "pw_rpc_test_protos/test.raw_rpc.pb.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::rpc {
+namespace {
+
+using internal::Packet;
+using internal::pwpb::PacketType;
+using test::pw_rpc::raw::TestService;
+
+using MethodInfo =
+    internal::MethodInfo<TestService::TestBidirectionalStreamRpc>;
+
+constexpr uint32_t kChannelId = 1;
+constexpr size_t kMaxOpenCalls = 10000;
+
+class DiscardingChannelOutput final : public ChannelOutput {
+ public:
+  DiscardingChannelOutput() : ChannelOutput("DiscardingChannelOutput") {}
+
+  Status Send(span<const std::byte>) override { return OkStatus(); }
+};
+
+// Keeps every bidirectional streaming call open until it is closed.
+class DispatchService final : public TestService::Service<DispatchService> {
+ public:
+  static void TestUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestAnotherUnaryRpc(ConstByteSpan, RawUnaryResponder&) {}
+
+  void TestServerStreamRpc(ConstByteSpan, RawServerWriter&) {}
+
+  void TestClientStreamRpc(RawServerReader&) {}
+
+  void TestBidirectionalStreamRpc(RawServerReaderWriter& call) {
+    PW_CHECK_UINT_LT(open_calls_, calls_.size());
+    calls_[open_calls_] = std::move(call);
+    calls_[open_calls_].set_on_next([this](ConstByteSpan) { ++messages_; });
+    open_calls_ += 1;
+  }
+
+  size_t open_calls() const { return open_calls_; }
+  size_t messages() const { return messages_; }
+
+  void CloseAll() {
+    for (size_t i = 0; i < open_calls_; ++i) {
+      PW_CHECK_OK(calls_[i].Finish(OkStatus()));
+    }
+    open_calls_ = 0;
+    messages_ = 0;
+  }
+
+ private:
+  std::array<RawServerReaderWriter, kMaxOpenCalls> calls_;
+  size_t open_calls_ = 0;
+  size_t messages_ = 0;
+};
+
+class DispatchContext {
+ public:
+  DispatchContext()
+      : channel_(Channel::Create<kChannelId>(&output_)),
+        server_(span(&channel_, 1)) {
+    server_.RegisterService(service_);
+  }
+
+  // Opens calls with IDs 1 through `count`.
+  void OpenCalls(size_t count) {
+    for (uint32_t call_id = 1; call_id <= count; ++call_id) {
+      PW_CHECK_OK(server_.ProcessPacket(Encode(PacketType::REQUEST, call_id)));
+    }
+    PW_CHECK_UINT_EQ(service_.open_calls(), count);
+  }
+
+  // Encodes a packet for the bidirectional streaming RPC.
+  ConstByteSpan Encode(PacketType type, uint32_t call_id) {
+    const Packet packet(type,
+                        kChannelId,
+                        MethodInfo::kServiceId,
+                        MethodInfo::kMethodId,
+                        call_id);
+    Result<ConstByteSpan> encoded = packet.Encode(packet_buffer_);
+    PW_CHECK_OK(encoded.status());
+    return *encoded;
+  }
+
+  Server& server() { return server_; }
+  DispatchService& service() { return service_; }
+
+ private:
+  DiscardingChannelOutput output_;
+  Channel channel_;
+  Server server_;
+  DispatchService service_;
+  std::array<std::byte, 64> packet_buffer_;
+};
+
+DispatchContext& Context() {
+  static DispatchContext context;
+  return context;
+}
+
+// Dispatches client stream packets to the call that was opened first, which is
+// the last one checked when all calls share one list.
+void DispatchClientStream(perf_test::State& state, size_t open_calls) {
+  DispatchContext& context = Context();
+  context.OpenCalls(open_calls);
+  const ConstByteSpan packet = context.Encode(PacketType::CLIENT_STREAM, 1);
+
+  size_t expected_messages = 0;
+  while (state.KeepRunning()) {
+    PW_CHECK_OK(context.server().ProcessPacket(packet));
+    expected_messages += 1;
+  }
+
+  PW_CHECK_UINT_EQ(context.service().messages(), expected_messages);
+  context.service().CloseAll();
+}
+
+PW_PERF_TEST(DispatchClientStream_10Calls, DispatchClientStream, 10);
+PW_PERF_TEST(DispatchClientStream_100Calls, DispatchClientStream, 100);
+PW_PERF_TEST(DispatchClientStream_1000Calls, DispatchClientStream, 1000);
+PW_PERF_TEST(DispatchClientStream_10000Calls, DispatchClientStream, 10000);
+
+}  // namespace
+}  // namespace pw::rpc
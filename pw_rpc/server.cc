@@ -84,14 +84,14 @@ Status Server::ProcessPacket(internal::Packet packet) {
     return OkStatus();
   }
 
-  IntrusiveForwardList<internal::Call>::iterator call = FindCall(packet);
+  internal::Call* call = FindCall(packet);
 
   switch (packet.type()) {
     case PacketType::CLIENT_STREAM:
       HandleClientStreamPacket(packet, *channel, call);
       break;
     case PacketType::CLIENT_ERROR:
-      if (call != calls_end()) {
+      if (call != nullptr) {
         PW_LOG_DEBUG("Server call %u for %u:%08x/%08x terminated with error %s",
                      static_cast<unsigned>(packet.call_id()),
                      static_cast<unsigned>(packet.channel_id()),
@@ -127,11 +127,12 @@ std::tuple<Service*, const internal::Method*> Server::FindMethod(
 
 std::tuple<Service*, const internal::Method*> Server::FindMethodLocked(
     uint32_t service_id, uint32_t method_id) {
-  auto service = std::find_if(services_.begin(), services_.end(), [&](auto& s) {
+  IntrusiveList<Service>& bucket = services_[BucketIndex(service_id)];
+  auto service = std::find_if(bucket.begin(), bucket.end(), [&](auto& s) {
     return internal::UnwrapServiceId(s.service_id()) == service_id;
   });
 
-  if (service == services_.end()) {
+  if (service == bucket.end()) {
     return {};
   }
 
@@ -141,8 +142,8 @@ std::tuple<Service*, const internal::Method*> Server::FindMethodLocked(
 void Server::HandleCompletionRequest(
     const internal::Packet& packet,
     internal::ChannelBase& channel,
-    IntrusiveForwardList<internal::Call>::iterator call) const {
-  if (call == calls_end()) {
+    internal::Call* call) const {
+  if (call == nullptr) {
     channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
     internal::rpc_lock().unlock();
@@ -170,8 +171,8 @@ void Server::HandleCompletionRequest(
 void Server::HandleClientStreamPacket(
     const internal::Packet& packet,
     internal::ChannelBase& channel,
-    IntrusiveForwardList<internal::Call>::iterator call) const {
-  if (call == calls_end()) {
+    internal::Call* call) const {
+  if (call == nullptr) {
     channel.Send(Packet::ServerError(packet, Status::FailedPrecondition()))
         .IgnoreError();  // Errors are logged in Channel::Send.
     internal::rpc_lock().unlock();
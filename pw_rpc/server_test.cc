@@ -706,6 +706,92 @@ TEST_F(BidiMethod, ClientStream_CallsLegacyOpenIdOnCallWithDifferentId) {
   EXPECT_EQ(responder_.as_server_call().id(), kSecondCallId);
 }
 
+TEST_F(BidiMethod, ClientStream_OpenIdCallKeepsAdoptedId) {
+  const uint32_t kSecondCallId = 1625;
+  internal::CallContext context(server_,
+                                channels_[0].id(),
+                                service_42_,
+                                service_42_.method(100),
+                                internal::kOpenCallId);
+  internal::rpc_lock().lock();
+  auto temp_responder =
+      internal::test::FakeServerReaderWriter(context.ClaimLocked());
+  internal::rpc_lock().unlock();
+  responder_ = std::move(temp_responder);
+
+  int messages = 0;
+  responder_.set_on_next([&messages](ConstByteSpan) { messages += 1; });
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(OkStatus(),
+              server_.ProcessPacket(PacketForRpc(
+                  PacketType::CLIENT_STREAM, {}, "hello", kSecondCallId)));
+  }
+  EXPECT_EQ(messages, 3);
+  EXPECT_EQ(output_.total_packets(), 0u);
+
+  // The call no longer matches other call IDs.
+  ASSERT_EQ(OkStatus(),
+            server_.ProcessPacket(PacketForRpc(
+                PacketType::CLIENT_STREAM, {}, "hello", kSecondCallId + 1)));
+  EXPECT_EQ(messages, 3);
+
+  EXPECT_EQ(OkStatus(), responder_.Finish());
+  EXPECT_EQ(static_cast<internal::Endpoint&>(server_).active_call_count(), 0u);
+}
+
+TEST_F(BidiMethod, ClientStream_ManyCallsEachReceiveTheirOwnPackets) {
+  constexpr uint32_t kFirstCallId = 1000;
+  std::array<internal::test::FakeServerReaderWriter, 32> calls;
+  std::array<int, 32> messages{};
+
+  for (uint32_t i = 0; i < calls.size(); ++i) {
+    internal::CallContext context(server_,
+                                  channels_[i % 2].id(),
+                                  service_42_,
+                                  service_42_.method(100),
+                                  kFirstCallId + i);
+    internal::rpc_lock().lock();
+    auto temp_call =
+        internal::test::FakeServerReaderWriter(context.ClaimLocked());
+    internal::rpc_lock().unlock();
+    calls[i] = std::move(temp_call);
+    int* count = &messages[i];
+    calls[i].set_on_next([count](ConstByteSpan) { *count += 1; });
+  }
+  EXPECT_EQ(static_cast<internal::Endpoint&>(server_).active_call_count(),
+            calls.size() + 1);
+
+  for (uint32_t i = 0; i < calls.size(); ++i) {
+    for (uint32_t j = 0; j <= i; ++j) {
+      ASSERT_EQ(OkStatus(),
+                server_.ProcessPacket(EncodePacket(PacketType::CLIENT_STREAM,
+                                                   channels_[i % 2].id(),
+                                                   42,
+                                                   100,
+                                                   kFirstCallId + i)));
+    }
+  }
+  for (uint32_t i = 0; i < calls.size(); ++i) {
+    EXPECT_EQ(messages[i], static_cast<int>(i + 1));
+  }
+  EXPECT_EQ(output_.total_packets(), 0u);
+
+  // Closing a channel aborts only the calls on that channel.
+  EXPECT_EQ(OkStatus(), server_.CloseChannel(channels_[1].id()));
+  for (uint32_t i = 0; i < calls.size(); ++i) {
+    EXPECT_EQ(calls[i].active(), i % 2 == 0);
+  }
+  EXPECT_EQ(static_cast<internal::Endpoint&>(server_).active_call_count(),
+            calls.size() / 2 + 1);
+
+  EXPECT_EQ(OkStatus(), server_.CloseChannel(channels_[0].id()));
+  for (const internal::test::FakeServerReaderWriter& call : calls) {
+    EXPECT_FALSE(call.active());
+  }
+  EXPECT_EQ(static_cast<internal::Endpoint&>(server_).active_call_count(), 0u);
+}
+
 TEST_F(BidiMethod, UnregsiterService_AbortsActiveCalls) {
   ASSERT_TRUE(responder_.active());
 
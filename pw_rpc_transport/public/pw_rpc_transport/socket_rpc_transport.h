@@ -15,12 +15,15 @@
 
 #include <signal.h>
 
+#include <array>
 #include <atomic>
 #include <mutex>
 
 #include "pw_assert/assert.h"
+#include "pw_bytes/span.h"
 #include "pw_chrono/system_clock.h"
 #include "pw_rpc_transport/rpc_transport.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_status/try.h"
 #include "pw_stream/socket_stream.h"
@@ -74,11 +77,31 @@ class SocketRpcTransport : public RpcFrameSender, public thread::ThreadCore {
   uint16_t port() const { return port_; }
   void set_ingress(RpcIngressHandler& ingress) { ingress_ = &ingress; }
 
+  // Sends a frame, batching it with frames sent concurrently by other threads.
+  //
+  // Frames are queued in the order `Send` is called. One caller at a time
+  // writes queued frames to the socket using a single vectored write, while
+  // the others wait for their frame to be written. Each caller returns the
+  // status of the write that included its frame.
   Status Send(RpcFrame frame) override {
-    std::lock_guard lock(write_mutex_);
-    PW_TRY(socket_stream_.Write(frame.header));
-    PW_TRY(socket_stream_.Write(frame.payload));
-    return OkStatus();
+    PendingFrame pending(frame);
+    std::unique_lock lock(send_mutex_);
+    Enqueue(pending);
+    while (!pending.done) {
+      if (flushing_) {
+        send_cv_.wait(lock, [this, &pending]() {
+          return pending.done || !flushing_;
+        });
+        continue;
+      }
+      // No other caller is writing; write the next batch, which may or may not
+      // include this caller's frame.
+      flushing_ = true;
+      WriteBatch(lock);
+      flushing_ = false;
+      send_cv_.notify_all();
+    }
+    return pending.status;
   }
 
   // Returns once the transport is connected to its peer.
@@ -136,6 +159,65 @@ class SocketRpcTransport : public RpcFrameSender, public thread::ThreadCore {
   static constexpr chrono::SystemClock::duration kConnectionRetryPeriod =
       std::chrono::milliseconds(100);
 
+  // Maximum number of frames written to the socket by a single call to WriteV.
+  // Each frame is a header and a payload buffer, so a full batch is sent with
+  // one sendmsg call.
+  static constexpr size_t kMaxFramesPerWrite =
+      stream::SocketStream::kMaxBuffersPerWrite / 2;
+
+  // Frame waiting to be sent. These live on the stack of the sending thread
+  // until the frame has been written.
+  struct PendingFrame {
+    explicit PendingFrame(RpcFrame frame_to_send) : frame(frame_to_send) {}
+
+    RpcFrame frame;
+    PendingFrame* next = nullptr;
+    Status status;
+    bool done = false;
+  };
+
+  // Appends a frame to the send queue. `send_mutex_` must be held.
+  void Enqueue(PendingFrame& pending) {
+    if (send_queue_tail_ == nullptr) {
+      send_queue_head_ = &pending;
+    } else {
+      send_queue_tail_->next = &pending;
+    }
+    send_queue_tail_ = &pending;
+  }
+
+  // Removes up to kMaxFramesPerWrite frames from the send queue and writes
+  // them to the socket. `send_mutex_` must be held by `lock`, and is released
+  // while writing.
+  void WriteBatch(std::unique_lock<sync::Mutex>& lock) {
+    std::array<PendingFrame*, kMaxFramesPerWrite> batch;
+    std::array<ConstByteSpan, kMaxFramesPerWrite * 2> buffers;
+    size_t num_frames = 0;
+    while (send_queue_head_ != nullptr && num_frames < batch.size()) {
+      PendingFrame* pending = send_queue_head_;
+      send_queue_head_ = pending->next;
+      buffers[num_frames * 2] = pending->frame.header;
+      buffers[num_frames * 2 + 1] = pending->frame.payload;
+      batch[num_frames++] = pending;
+    }
+    if (send_queue_head_ == nullptr) {
+      send_queue_tail_ = nullptr;
+    }
+
+    lock.unlock();
+    Status status;
+    {
+      std::lock_guard write_lock(write_mutex_);
+      status = socket_stream_.WriteV(span(buffers.data(), num_frames * 2));
+    }
+    lock.lock();
+
+    for (size_t i = 0; i < num_frames; ++i) {
+      batch[i]->status = status;
+      batch[i]->done = true;
+    }
+  }
+
   void Run() override { Start(); }
 
   // Establishes or accepts a new socket connection. Returns when socket_stream_
@@ -223,6 +305,13 @@ class SocketRpcTransport : public RpcFrameSender, public thread::ThreadCore {
   std::atomic<uint16_t> port_;
   RpcIngressHandler* ingress_ = nullptr;
 
+  // send_mutex_ guards the queue of frames waiting to be sent.
+  sync::Mutex send_mutex_;
+  sync::ConditionVariable send_cv_;
+  PendingFrame* send_queue_head_ = nullptr;
+  PendingFrame* send_queue_tail_ = nullptr;
+  bool flushing_ = false;
+
   // write_mutex_ must be held by the thread performing socket writes.
   sync::Mutex write_mutex_;
   stream::SocketStream socket_stream_;
@@ -0,0 +1,185 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the latency and throughput of `pw.rpc.Benchmark.UnaryEcho` calls
+// made between two `SocketRpcTransport`s connected over loopback, using one or
+// more client threads that share a single transport.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_rpc/benchmark.h"
+#include "pw_rpc/benchmark.raw_rpc.pb.h"
+#include "pw_rpc/synchronous_call.h"
+#include "pw_rpc_transport/egress_ingress.h"
+#include "pw_rpc_transport/local_rpc_egress.h"
+#include "pw_rpc_transport/service_registry.h"
+#include "pw_rpc_transport/socket_rpc_transport.h"
+#include "pw_status/status.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_thread_stl/options.h"
+
+namespace pw::rpc {
+namespace {
+
+constexpr size_t kMaxPacketSize = 512;
+constexpr size_t kLocalEgressQueueSize = 32;
+constexpr size_t kMaxThreads = 4;
+constexpr size_t kCallsPerThread = 2000;
+constexpr size_t kPayloadSize = 64;
+
+using Transport = SocketRpcTransport<kMaxPacketSize>;
+
+/// One side of the connection.
+///
+/// Each client thread uses its own channel, and each channel has its own
+/// egress. This allows the threads to send frames to the shared transport
+/// concurrently.
+struct Endpoint {
+  explicit Endpoint(Transport& rpc_transport)
+      : transport(rpc_transport),
+        egresses{{{"tx1", transport},
+                  {"tx2", transport},
+                  {"tx3", transport},
+                  {"tx4", transport}}},
+        tx_channels{Channel::Create<1>(&egresses[0]),
+                    Channel::Create<2>(&egresses[1]),
+                    Channel::Create<3>(&egresses[2]),
+                    Channel::Create<4>(&egresses[3])},
+        rx_channels{ChannelEgress{1, local_egress},
+                    ChannelEgress{2, local_egress},
+                    ChannelEgress{3, local_egress},
+                    ChannelEgress{4, local_egress}},
+        rpc_ingress(rx_channels),
+        service_registry(tx_channels) {
+    local_egress.set_packet_processor(service_registry);
+    transport.set_ingress(rpc_ingress);
+  }
+
+  LocalRpcEgress<kLocalEgressQueueSize, kMaxPacketSize> local_egress;
+  Transport& transport;
+  std::array<SimpleRpcEgress<kMaxPacketSize>, kMaxThreads> egresses;
+  std::array<Channel, kMaxThreads> tx_channels;
+  std::array<ChannelEgress, kMaxThreads> rx_channels;
+  SimpleRpcIngress<kMaxPacketSize> rpc_ingress;
+  ServiceRegistry service_registry;
+};
+
+/// Makes `kCallsPerThread` unary calls on a given channel.
+class CallerThreadCore : public thread::ThreadCore {
+ public:
+  CallerThreadCore() = default;
+
+  void Init(Client& client, uint32_t channel_id) {
+    client_ = &client;
+    channel_id_ = channel_id;
+  }
+
+  size_t failures() const { return failures_; }
+
+ private:
+  void Run() override {
+    std::array<std::byte, kPayloadSize> payload{};
+    failures_ = 0;
+    for (size_t i = 0; i < kCallsPerThread; ++i) {
+      Status status = SynchronousCall<pw_rpc::raw::Benchmark::UnaryEcho>(
+          *client_, channel_id_, payload, [](ConstByteSpan, Status) {});
+      if (!status.ok()) {
+        ++failures_;
+      }
+    }
+  }
+
+  Client* client_ = nullptr;
+  uint32_t channel_id_ = 0;
+  size_t failures_ = 0;
+};
+
+/// Makes calls from `num_threads` threads at once, and logs the results.
+void MeasureCalls(Client& client, size_t num_threads) {
+  std::array<CallerThreadCore, kMaxThreads> callers;
+  auto begin = chrono::SystemClock::now();
+  {
+    std::array<Thread, kMaxThreads> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      callers[i].Init(client, static_cast<uint32_t>(i + 1));
+      threads[i] = Thread(thread::stl::Options(), callers[i]);
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads[i].join();
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      chrono::SystemClock::now() - begin);
+
+  size_t num_calls = num_threads * kCallsPerThread;
+  size_t num_failures = 0;
+  for (size_t i = 0; i < num_threads; ++i) {
+    num_failures += callers[i].failures();
+  }
+  auto ns = static_cast<uint64_t>(elapsed.count());
+  PW_LOG_INFO("%u thread(s): %7u ns/call, %7u calls/s, %u failed",
+              static_cast<unsigned>(num_threads),
+              static_cast<unsigned>(ns / num_calls),
+              static_cast<unsigned>((num_calls * 1000000000ull) / ns),
+              static_cast<unsigned>(num_failures));
+}
+
+void DoSocketRpcTransportBenchmark() {
+  Transport server_transport(Transport::kAsServer, /*port=*/0);
+  Endpoint server(server_transport);
+  BenchmarkService service;
+  server.service_registry.RegisterService(service);
+  Thread server_egress_thread(thread::stl::Options(), server.local_egress);
+  Thread server_transport_thread(thread::stl::Options(), server_transport);
+  server_transport.WaitUntilReady();
+
+  Transport client_transport(
+      Transport::kAsClient, "localhost", server_transport.port());
+  Endpoint client(client_transport);
+  Thread client_egress_thread(thread::stl::Options(), client.local_egress);
+  Thread client_transport_thread(thread::stl::Options(), client_transport);
+
+  server_transport.WaitUntilConnected();
+  client_transport.WaitUntilConnected();
+
+  Client& rpc_client = client.service_registry.client_server().client();
+  for (size_t num_threads = 1; num_threads <= kMaxThreads; num_threads *= 2) {
+    MeasureCalls(rpc_client, num_threads);
+  }
+
+  client.local_egress.Stop();
+  server.local_egress.Stop();
+  client_transport.Stop();
+  server_transport.Stop();
+
+  client_egress_thread.join();
+  server_egress_thread.join();
+  client_transport_thread.join();
+  server_transport_thread.join();
+}
+
+}  // namespace
+}  // namespace pw::rpc
+
+int main() {
+  pw::rpc::DoSocketRpcTransportBenchmark();
+  return 0;
+}
@@ -15,6 +15,7 @@
 #include "pw_rpc_transport/socket_rpc_transport.h"
 
 #include <algorithm>
+#include <array>
 #include <random>
 
 #include "pw_allocator/testing.h"
@@ -194,6 +195,98 @@ TEST(SocketRpcTransportTest, SendAndReceiveFramesOverSocketConnection) {
                          server_sender.sent().begin()));
 }
 
+// Sends a number of identical frames filled with a given value.
+class FixedFrameSenderThreadCore : public thread::ThreadCore {
+ public:
+  static constexpr size_t kHeaderSize = 4;
+  static constexpr size_t kPayloadSize = 12;
+  static constexpr size_t kFrameSize = kHeaderSize + kPayloadSize;
+
+  FixedFrameSenderThreadCore(SocketRpcTransport<kReadBufferSize>& transport,
+                             std::byte value,
+                             size_t num_frames)
+      : transport_(transport), num_frames_(num_frames) {
+    frame_.fill(value);
+  }
+
+ private:
+  void Run() override {
+    ConstByteSpan frame(frame_);
+    for (size_t i = 0; i < num_frames_; ++i) {
+      EXPECT_EQ(transport_.Send(RpcFrame{.header = frame.first(kHeaderSize),
+                                         .payload = frame.last(kPayloadSize)}),
+                OkStatus());
+    }
+  }
+
+  SocketRpcTransport<kReadBufferSize>& transport_;
+  std::array<std::byte, kFrameSize> frame_;
+  size_t num_frames_;
+};
+
+TEST(SocketRpcTransportTest, ConcurrentSendsAreNotInterleaved) {
+  // Each sender fills its frames with its own value, so that the receiver can
+  // check that every frame arrived whole.
+  constexpr size_t kNumSenders = 4;
+  constexpr size_t kFramesPerSender = 256;
+  constexpr size_t kFrameSize = FixedFrameSenderThreadCore::kFrameSize;
+  constexpr size_t kWriteSize = kNumSenders * kFramesPerSender * kFrameSize;
+
+  TestIngress server_ingress(kWriteSize);
+  TestIngress client_ingress(0);
+
+  auto server = SocketRpcTransport<kReadBufferSize>(
+      SocketRpcTransport<kReadBufferSize>::kAsServer,
+      kServerPort,
+      server_ingress);
+  auto server_thread = Thread(thread::stl::Options(), server);
+  server.WaitUntilReady();
+
+  auto client = SocketRpcTransport<kReadBufferSize>(
+      SocketRpcTransport<kReadBufferSize>::kAsClient,
+      "localhost",
+      server.port(),
+      client_ingress);
+  auto client_thread = Thread(thread::stl::Options(), client);
+
+  client.WaitUntilConnected();
+  server.WaitUntilConnected();
+
+  FixedFrameSenderThreadCore sender0(client, std::byte{0}, kFramesPerSender);
+  FixedFrameSenderThreadCore sender1(client, std::byte{1}, kFramesPerSender);
+  FixedFrameSenderThreadCore sender2(client, std::byte{2}, kFramesPerSender);
+  FixedFrameSenderThreadCore sender3(client, std::byte{3}, kFramesPerSender);
+  auto sender0_thread = Thread(thread::stl::Options(), sender0);
+  auto sender1_thread = Thread(thread::stl::Options(), sender1);
+  auto sender2_thread = Thread(thread::stl::Options(), sender2);
+  auto sender3_thread = Thread(thread::stl::Options(), sender3);
+  sender0_thread.join();
+  sender1_thread.join();
+  sender2_thread.join();
+  sender3_thread.join();
+
+  server_ingress.Wait();
+  server.Stop();
+  client.Stop();
+  server_thread.join();
+  client_thread.join();
+
+  const auto& received = server_ingress.received();
+  ASSERT_EQ(received.size(), kWriteSize);
+  std::array<size_t, kNumSenders> num_frames{};
+  for (size_t offset = 0; offset < received.size(); offset += kFrameSize) {
+    std::byte value = received[offset];
+    ASSERT_LT(static_cast<size_t>(value), kNumSenders);
+    EXPECT_TRUE(std::all_of(received.begin() + offset,
+                            received.begin() + offset + kFrameSize,
+                            [value](std::byte b) { return b == value; }));
+    ++num_frames[static_cast<size_t>(value)];
+  }
+  for (size_t count : num_frames) {
+    EXPECT_EQ(count, kFramesPerSender);
+  }
+}
+
 TEST(SocketRpcTransportTest, ServerReconnects) {
   // Set up a server and a client that reconnects multiple times. The server
   // must accept the new connection gracefully.
@@ -13,6 +13,7 @@
 // the License.
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "pw_result/result.h"
@@ -31,6 +32,10 @@ namespace pw::stream {
 /// class.
 class SocketStream : public NonSeekableReaderWriter {
  public:
+  /// Maximum number of non-empty buffers that `WriteV` passes to a single
+  /// `sendmsg` call. Larger writes are split across multiple calls.
+  static constexpr size_t kMaxBuffersPerWrite = 32;
+
   SocketStream() = default;
   // Construct a SocketStream directly from a file descriptor.
   explicit SocketStream(int connection_fd) : connection_fd_(connection_fd) {
@@ -93,6 +98,8 @@ class SocketStream : public NonSeekableReaderWriter {
 
   Status DoWrite(span<const std::byte> data) override;
 
+  Status DoWriteV(span<const ConstByteSpan> data) override;
+
   StatusWithSize DoRead(ByteSpan dest) override;
 
   // Take ownership of the connection. There may be multiple owners. Each time
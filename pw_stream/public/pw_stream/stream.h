@@ -182,6 +182,26 @@ class Stream {
   /// @overload
   Status Write(const std::byte b) { return Write(&b, 1); }
 
+  /// Writes the concatenation of several buffers to this stream, in order.
+  ///
+  /// This behaves as if Write() were called for each buffer in turn, but
+  /// allows streams that can accept scattered data directly, such as
+  /// `SocketStream`, to do so with a single operation instead of copying the
+  /// buffers together or issuing one write per buffer.
+  ///
+  /// Derived classes should NOT try to override the public WriteV method.
+  /// Instead, override DoWriteV(). The default implementation calls DoWrite()
+  /// for each non-empty buffer.
+  ///
+  /// @returns The same values as Write(). If an error is returned, some of the
+  /// buffers may have already been written.
+  Status WriteV(span<const ConstByteSpan> data) {
+    for ([[maybe_unused]] ConstByteSpan buffer : data) {
+      PW_DASSERT(buffer.empty() || buffer.data() != nullptr);
+    }
+    return DoWriteV(data);
+  }
+
   /// Changes the current position in the stream for both reading and writing,
   /// if supported.
   ///
@@ -281,6 +301,20 @@ class Stream {
   /// Virtual Write() function implemented by derived classes.
   virtual Status DoWrite(ConstByteSpan data) = 0;
 
+  /// Virtual WriteV() function optionally implemented by derived classes.
+  /// The default implementation calls DoWrite() for each non-empty buffer.
+  virtual Status DoWriteV(span<const ConstByteSpan> data) {
+    for (ConstByteSpan buffer : data) {
+      if (buffer.empty()) {
+        continue;
+      }
+      if (Status status = DoWrite(buffer); !status.ok()) {
+        return status;
+      }
+    }
+    return OkStatus();
+  }
+
   /// Virtual Seek() function implemented by derived classes.
   virtual Status DoSeek(ptrdiff_t offset, Whence origin) = 0;
 
@@ -332,8 +366,13 @@ class Reader : public Stream {
       : Stream(true, false, seekability) {}
 
   using Stream::Write;
+  using Stream::WriteV;
 
   Status DoWrite(ConstByteSpan) final { return Status::Unimplemented(); }
+
+  Status DoWriteV(span<const ConstByteSpan>) final {
+    return Status::Unimplemented();
+  }
 };
 
 /// A Reader that supports at least relative seeking within some range of the
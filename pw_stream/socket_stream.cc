@@ -27,9 +27,11 @@
 #include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif  // defined(_WIN32) && _WIN32
 
+#include <array>
 #include <cerrno>
 #include <cstring>
 
@@ -44,6 +46,26 @@ namespace {
 constexpr uint32_t kServerBacklogLength = 1;
 constexpr const char* kLocalhostAddress = "localhost";
 
+int GetSendFlags() {
+  int send_flags = 0;
+#if defined(__linux__)
+  // Use MSG_NOSIGNAL to avoid getting a SIGPIPE signal when the remote
+  // peer drops the connection. This is supported on Linux only.
+  send_flags |= MSG_NOSIGNAL;
+#endif  // defined(__linux__)
+  return send_flags;
+}
+
+// Converts the result of a failed or partial send into a status.
+Status GetSendError() {
+  if (errno == EPIPE) {
+    // An EPIPE indicates that the connection is closed.  Return an OutOfRange
+    // error.
+    return Status::OutOfRange();
+  }
+  return Status::Unknown();
+}
+
 // Set necessary options on a socket file descriptor.
 void ConfigureSocket([[maybe_unused]] int socket) {
 #if defined(__APPLE__)
@@ -191,13 +213,6 @@ void SocketStream::Close() {
 }
 
 Status SocketStream::DoWrite(span<const std::byte> data) {
-  int send_flags = 0;
-#if defined(__linux__)
-  // Use MSG_NOSIGNAL to avoid getting a SIGPIPE signal when the remote
-  // peer drops the connection. This is supported on Linux only.
-  send_flags |= MSG_NOSIGNAL;
-#endif  // defined(__linux__)
-
   ssize_t bytes_sent;
   {
     ConnectionOwnership ownership(this);
@@ -207,19 +222,62 @@ Status SocketStream::DoWrite(span<const std::byte> data) {
     bytes_sent = send(ownership.fd(),
                       reinterpret_cast<const char*>(data.data()),
                       data.size_bytes(),
-                      send_flags);
+                      GetSendFlags());
   }
 
   if (bytes_sent < 0 || static_cast<size_t>(bytes_sent) != data.size()) {
-    if (errno == EPIPE) {
-      // An EPIPE indicates that the connection is closed.  Return an OutOfRange
-      // error.
-      return Status::OutOfRange();
-    }
+    return GetSendError();
+  }
+  return OkStatus();
+}
 
+Status SocketStream::DoWriteV(span<const ConstByteSpan> data) {
+#if defined(_WIN32) && _WIN32
+  for (ConstByteSpan buffer : data) {
+    if (buffer.empty()) {
+      continue;
+    }
+    if (Status status = DoWrite(buffer); !status.ok()) {
+      return status;
+    }
+  }
+  return OkStatus();
+#else
+  ConnectionOwnership ownership(this);
+  if (ownership.fd() == kInvalidFd) {
     return Status::Unknown();
   }
+
+  // kMaxBuffersPerWrite is well below IOV_MAX on all supported platforms.
+  std::array<iovec, kMaxBuffersPerWrite> iov;
+  while (!data.empty()) {
+    size_t num_iovecs = 0;
+    size_t total = 0;
+    while (!data.empty() && num_iovecs < iov.size()) {
+      ConstByteSpan buffer = data.front();
+      data = data.subspan(1);
+      if (buffer.empty()) {
+        continue;
+      }
+      iov[num_iovecs].iov_base = const_cast<std::byte*>(buffer.data());
+      iov[num_iovecs].iov_len = buffer.size();
+      total += buffer.size();
+      ++num_iovecs;
+    }
+    if (num_iovecs == 0) {
+      break;
+    }
+
+    msghdr message = {};
+    message.msg_iov = iov.data();
+    message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(num_iovecs);
+    ssize_t bytes_sent = sendmsg(ownership.fd(), &message, GetSendFlags());
+    if (bytes_sent < 0 || static_cast<size_t>(bytes_sent) != total) {
+      return GetSendError();
+    }
+  }
   return OkStatus();
+#endif  // defined(_WIN32) && _WIN32
 }
 
 StatusWithSize SocketStream::DoRead(ByteSpan dest) {
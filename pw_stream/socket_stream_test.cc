@@ -14,6 +14,10 @@
 
 #include "pw_stream/socket_stream.h"
 
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
 #include <thread>
 
 #include "pw_result/result.h"
@@ -142,6 +146,79 @@ TEST(SocketStreamTest, ReadWrite) {
   server.Close();
 }
 
+TEST(SocketStreamTest, WriteV) {
+  ServerSocket server;
+  EXPECT_EQ(server.Listen(), OkStatus());
+
+  Result<SocketStream> server_stream = Status::Unavailable();
+  auto accept_thread = std::thread{[&]() { server_stream = server.Accept(); }};
+
+  SocketStream client;
+  EXPECT_EQ(client.Connect("localhost", server.port()), OkStatus());
+
+  accept_thread.join();
+  ASSERT_EQ(server_stream.status(), OkStatus());
+
+  // Use more buffers than fit in a single `sendmsg` call, some of them empty.
+  std::array<std::byte, 64> payload;
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::byte>(i);
+  }
+  std::array<ConstByteSpan, 40> buffers;
+  ConstByteSpan remaining(payload);
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    size_t size = i % 3 == 0 ? 0 : 2;
+    buffers[i] = remaining.first(size);
+    remaining = remaining.subspan(size);
+  }
+  const size_t total = payload.size() - remaining.size();
+
+  EXPECT_EQ(client.WriteV(buffers), OkStatus());
+
+  std::array<std::byte, 64> read_buffer{};
+  Result<ByteSpan> read_result =
+      server_stream->ReadExact(span(read_buffer).first(total));
+  ASSERT_EQ(read_result.status(), OkStatus());
+  EXPECT_TRUE(std::equal(
+      read_result->begin(), read_result->end(), payload.begin()));
+
+  client.Close();
+  server_stream->Close();
+  server.Close();
+}
+
+TEST(SocketStreamTest, WriteV_FullBatchIsOneSend) {
+  // Datagram sockets preserve message boundaries, so each sendmsg call made by
+  // WriteV is received as a separate message.
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds), 0);
+  SocketStream writer(fds[0]);
+
+  constexpr size_t kFullBatch = SocketStream::kMaxBuffersPerWrite;
+  std::array<std::byte, kFullBatch + 1> payload{};
+  std::array<ConstByteSpan, kFullBatch + 1> buffers;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    buffers[i] = span(payload).subspan(i, 1);
+  }
+  std::array<std::byte, kFullBatch * 2> read_buffer;
+
+  EXPECT_EQ(writer.WriteV(span(buffers).first(kFullBatch)), OkStatus());
+  EXPECT_EQ(recv(fds[1], read_buffer.data(), read_buffer.size(), MSG_DONTWAIT),
+            static_cast<ssize_t>(kFullBatch));
+  EXPECT_EQ(recv(fds[1], read_buffer.data(), read_buffer.size(), MSG_DONTWAIT),
+            -1);
+
+  // One more buffer than a full batch takes a second send.
+  EXPECT_EQ(writer.WriteV(buffers), OkStatus());
+  EXPECT_EQ(recv(fds[1], read_buffer.data(), read_buffer.size(), MSG_DONTWAIT),
+            static_cast<ssize_t>(kFullBatch));
+  EXPECT_EQ(recv(fds[1], read_buffer.data(), read_buffer.size(), MSG_DONTWAIT),
+            1);
+
+  writer.Close();
+  close(fds[1]);
+}
+
 TEST(SocketStreamTest, MultipleClients) {
   ServerSocket server;
   EXPECT_EQ(server.Listen(), OkStatus());
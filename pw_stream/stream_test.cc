@@ -137,6 +137,7 @@ void TestStreamImpl() {
   ASSERT_EQ(readable ? OkStatus() : Status::Unimplemented(),
             stream.Read({}).status());
   ASSERT_EQ(writable ? OkStatus() : Status::Unimplemented(), stream.Write({}));
+  ASSERT_EQ(writable ? OkStatus() : Status::Unimplemented(), stream.WriteV({}));
   ASSERT_EQ(seekable ? OkStatus() : Status::Unimplemented(), stream.Seek(0));
 
   // Check ConservativeLimits()
@@ -270,5 +271,56 @@ TEST(Stream, ReadExact_HandlesError) {
   EXPECT_EQ(result.status(), Status::Internal());
 }
 
+/// Writer that records the size of each call to DoWrite, and fails once a
+/// given number of calls have been made.
+class TestRecordingWriter : public NonSeekableWriter {
+ public:
+  explicit TestRecordingWriter(size_t max_writes) : max_writes_(max_writes) {}
+
+  span<const size_t> write_sizes() const {
+    return span(write_sizes_.data(), num_writes_);
+  }
+
+ private:
+  Status DoWrite(ConstByteSpan data) override {
+    if (num_writes_ == max_writes_) {
+      return Status::ResourceExhausted();
+    }
+    write_sizes_[num_writes_++] = data.size();
+    return OkStatus();
+  }
+
+  size_t max_writes_;
+  std::array<size_t, 8> write_sizes_{};
+  size_t num_writes_ = 0;
+};
+
+TEST(Stream, WriteV_WritesEachBuffer) {
+  constexpr auto kData = bytes::Array<0x00, 0x01, 0x02, 0x03, 0x04, 0x05>();
+  ConstByteSpan data(kData);
+  auto buffers = containers::to_array<ConstByteSpan>(
+      {data.first(1), ConstByteSpan(), data.subspan(1, 3), data.last(2)});
+
+  TestRecordingWriter writer(8);
+  EXPECT_EQ(writer.WriteV(buffers), OkStatus());
+
+  // Empty buffers are skipped.
+  ASSERT_EQ(writer.write_sizes().size(), 3u);
+  EXPECT_EQ(writer.write_sizes()[0], 1u);
+  EXPECT_EQ(writer.write_sizes()[1], 3u);
+  EXPECT_EQ(writer.write_sizes()[2], 2u);
+}
+
+TEST(Stream, WriteV_StopsOnError) {
+  constexpr auto kData = bytes::Array<0x00, 0x01, 0x02, 0x03, 0x04, 0x05>();
+  ConstByteSpan data(kData);
+  auto buffers = containers::to_array<ConstByteSpan>(
+      {data.first(1), data.subspan(1, 3), data.last(2)});
+
+  TestRecordingWriter writer(1);
+  EXPECT_EQ(writer.WriteV(buffers), Status::ResourceExhausted());
+  EXPECT_EQ(writer.write_sizes().size(), 1u);
+}
+
 }  // namespace
 }  // namespace pw::stream
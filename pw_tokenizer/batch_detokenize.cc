@@ -0,0 +1,169 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/batch_detokenize.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "pw_bytes/endian.h"
+
+namespace pw::tokenizer {
+
+BatchDetokenizer::BatchDetokenizer(const Detokenizer& detokenizer,
+                                   const Options& options)
+    : options_(options) {
+  const unsigned threads = std::max(options_.threads, 1u);
+  workers_.reserve(threads);
+  for (unsigned i = 0; i < threads; ++i) {
+    workers_.emplace_back(detokenizer, options_.max_cached_tokens);
+  }
+}
+
+span<const std::string_view> BatchDetokenizer::DetokenizeInto(
+    span<const span<const std::byte>> messages,
+    std::string& output,
+    std::string_view domain) {
+  ends_.resize(messages.size());
+  results_.resize(messages.size());
+
+  // Split the messages into contiguous chunks, one per thread. The calling
+  // thread decodes the first chunk directly into the output.
+  const size_t threads = ThreadsFor(messages.size());
+  const size_t chunk_size = (messages.size() + threads - 1) / threads;
+  const auto chunk_first = [&](size_t index) {
+    return std::min(index * chunk_size, messages.size());
+  };
+  const auto decode_chunk = [&](size_t index) {
+    const size_t first = chunk_first(index);
+    const size_t size = chunk_first(index + 1) - first;
+    std::string* text = &output;
+    if (index != 0) {
+      text = &workers_[index].scratch();
+      text->clear();  // Keep the scratch buffer's capacity between batches.
+    }
+    workers_[index].Decode(messages.subspan(first, size),
+                           domain,
+                           *text,
+                           span(ends_).subspan(first, size));
+  };
+
+  const size_t start = output.size();
+  std::vector<std::thread> helpers;
+  helpers.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i) {
+    helpers.emplace_back(decode_chunk, i);
+  }
+  decode_chunk(0);
+  for (std::thread& helper : helpers) {
+    helper.join();
+  }
+
+  // Append the text from the helper threads. Their ends are relative to their
+  // scratch buffers, so offset them to positions in the output.
+  for (size_t i = 1; i < threads; ++i) {
+    const size_t offset = output.size();
+    output.append(workers_[i].scratch());
+    for (size_t j = chunk_first(i); j < chunk_first(i + 1); ++j) {
+      ends_[j] += offset;
+    }
+  }
+
+  // The output is complete, so views into it are now stable.
+  size_t begin = start;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    results_[i] = std::string_view(output.data() + begin, ends_[i] - begin);
+    begin = ends_[i];
+  }
+  return results_;
+}
+
+size_t BatchDetokenizer::cache_hits() const {
+  size_t hits = 0;
+  for (const Worker& worker : workers_) {
+    hits += worker.cache_hits();
+  }
+  return hits;
+}
+
+size_t BatchDetokenizer::ThreadsFor(size_t messages) const {
+  const size_t min_messages =
+      std::max<size_t>(options_.min_messages_per_thread, 1);
+  return std::clamp<size_t>(messages / min_messages, 1, workers_.size());
+}
+
+void BatchDetokenizer::Worker::Decode(
+    span<const span<const std::byte>> messages,
+    std::string_view domain,
+    std::string& text,
+    span<size_t> ends) {
+  if (domain != cache_domain_) {
+    cache_.clear();
+    cache_domain_ = domain;
+  }
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    DecodeOne(messages[i], domain, text);
+    ends[i] = text.size();
+  }
+}
+
+BatchDetokenizer::Worker::CachedToken& BatchDetokenizer::Worker::Lookup(
+    uint32_t token, std::string_view domain) {
+  if (auto it = cache_.find(token); it != cache_.end()) {
+    cache_hits_ += 1;
+    return it->second;
+  }
+
+  if (cache_.size() >= max_cached_tokens_) {
+    cache_.clear();
+  }
+
+  CachedToken& cached = cache_[token];
+  cached.entries = detokenizer_->DatabaseLookup(token, domain);
+  return cached;
+}
+
+void BatchDetokenizer::Worker::DecodeOne(span<const std::byte> message,
+                                         std::string_view domain,
+                                         std::string& text) {
+  // Match Detokenizer::Detokenize, which returns an empty string if there is
+  // no token.
+  if (message.empty()) {
+    return;
+  }
+
+  const uint32_t token = bytes::ReadInOrder<uint32_t>(
+      endian::little, message.data(), message.size());
+  const span<const std::byte> arguments =
+      message.size() < sizeof(token) ? span<const std::byte>()
+                                     : message.subspan(sizeof(token));
+
+  CachedToken& cached = Lookup(token, domain);
+  if (arguments.empty() && cached.has_no_arguments) {
+    text.append(cached.no_arguments);
+    return;
+  }
+
+  const DetokenizedString result(
+      *detokenizer_, false, token, cached.entries, arguments);
+  text.append(result.BestString());
+
+  if (arguments.empty()) {
+    cached.no_arguments = result.BestString();
+    cached.has_no_arguments = true;
+  }
+}
+
+}  // namespace pw::tokenizer
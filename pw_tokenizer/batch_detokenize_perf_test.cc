@@ -0,0 +1,177 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Log ingestion benchmarks. These detokenize a corpus of messages shaped like a
+// recorded device log: most messages come from a few hundred hot log
+// statements, with a long tail of rarely seen ones.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_assert/check.h"
+#include "pw_bytes/array.h"
+#include "pw_bytes/endian.h"
+#include "pw_log/log.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+#include "pw_tokenizer/batch_detokenize.h"
+#include "pw_tokenizer/detokenize.h"
+#include "pw_tokenizer/flat_token_database.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr uint32_t kDatabaseEntries = 10000;
+constexpr size_t kCorpusMessages = 8192;
+constexpr uint32_t kHotStatements = 300;
+
+constexpr uint32_t TokenFor(uint32_t entry) { return entry * 2654435761u; }
+
+// Returns a binary token database with kDatabaseEntries entries.
+const std::vector<char>& BinaryDatabase() {
+  static const std::vector<char> database = [] {
+    std::vector<char> data;
+    const auto append_uint32 = [&data](uint32_t value) {
+      for (std::byte b : bytes::CopyInOrder(endian::little, value)) {
+        data.push_back(static_cast<char>(b));
+      }
+    };
+
+    constexpr std::string_view kMagicAndVersion("TOKENS\0\0", 8);
+    data.insert(data.end(), kMagicAndVersion.begin(), kMagicAndVersion.end());
+    append_uint32(kDatabaseEntries);
+    append_uint32(0);
+
+    for (uint32_t i = 0; i < kDatabaseEntries; ++i) {
+      append_uint32(TokenFor(i));
+      append_uint32(TokenDatabase::kDateRemovedNever);
+    }
+    for (uint32_t i = 0; i < kDatabaseEntries; ++i) {
+      const std::string string =
+          "Message " + std::to_string(i) + ": value %d, name %s";
+      data.insert(data.end(), string.begin(), string.end());
+      data.push_back('\0');
+    }
+    return data;
+  }();
+  return database;
+}
+
+TokenDatabase MapDatabase() { return TokenDatabase::Create(BinaryDatabase()); }
+
+const std::vector<std::byte>& FlatDatabase() {
+  static const std::vector<std::byte> database = [] {
+    FlatTokenDatabaseBuilder builder;
+    builder.Add(MapDatabase());
+    return builder.Build();
+  }();
+  return database;
+}
+
+const std::vector<std::vector<std::byte>>& LogCorpus() {
+  static const std::vector<std::vector<std::byte>> corpus = [] {
+    std::vector<std::vector<std::byte>> messages;
+    messages.reserve(kCorpusMessages);
+    uint32_t state = 1;
+    for (size_t i = 0; i < kCorpusMessages; ++i) {
+      state = state * 1664525u + 1013904223u;
+      const uint32_t entry = (state >> 8) % 16 == 0
+                                 ? (state >> 12) % kDatabaseEntries
+                                 : (state >> 12) % kHotStatements;
+      std::vector<std::byte>& message = messages.emplace_back();
+      for (std::byte b : bytes::CopyInOrder(endian::little, TokenFor(entry))) {
+        message.push_back(b);
+      }
+      // A zig-zag encoded %d argument under 64 and a 4-character %s argument.
+      message.push_back(static_cast<std::byte>((i % 64) * 2));
+      for (std::byte b : bytes::String("\x04them")) {
+        message.push_back(b);
+      }
+    }
+    return messages;
+  }();
+  return corpus;
+}
+
+std::vector<span<const std::byte>> LogCorpusBatch() {
+  std::vector<span<const std::byte>> batch;
+  for (const std::vector<std::byte>& message : LogCorpus()) {
+    batch.push_back(message);
+  }
+  return batch;
+}
+
+void DetokenizeCorpusOneByOne(perf_test::State& state,
+                              const Detokenizer& detokenizer) {
+  const std::vector<span<const std::byte>> batch = LogCorpusBatch();
+  std::vector<std::string> results(batch.size());
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+      results[i] = detokenizer.Detokenize(batch[i]).BestString();
+    }
+  }
+  PW_CHECK(results.back().find("Message ") == 0);
+}
+
+void DetokenizeCorpusInBatches(perf_test::State& state,
+                               const Detokenizer& detokenizer,
+                               unsigned threads) {
+  BatchDetokenizer::Options options;
+  options.threads = threads;
+  BatchDetokenizer batch_detokenizer(detokenizer, options);
+  const std::vector<span<const std::byte>> batch = LogCorpusBatch();
+
+  span<const std::string_view> results;
+  while (state.KeepRunning()) {
+    results = batch_detokenizer.Detokenize(batch);
+  }
+  PW_CHECK(results.back() ==
+           detokenizer.Detokenize(batch.back()).BestString());
+  PW_LOG_INFO("%u thread(s): %zu cache hits for %zu messages",
+              threads,
+              batch_detokenizer.cache_hits(),
+              batch.size());
+}
+
+void CorpusTokenDatabase(perf_test::State& state) {
+  DetokenizeCorpusOneByOne(state, Detokenizer(MapDatabase()));
+}
+
+void CorpusFlatDatabase(perf_test::State& state) {
+  DetokenizeCorpusOneByOne(
+      state, Detokenizer(FlatTokenDatabase::Create(FlatDatabase())));
+}
+
+void CorpusBatchTokenDatabase(perf_test::State& state, unsigned threads) {
+  DetokenizeCorpusInBatches(state, Detokenizer(MapDatabase()), threads);
+}
+
+void CorpusBatchFlatDatabase(perf_test::State& state, unsigned threads) {
+  DetokenizeCorpusInBatches(
+      state, Detokenizer(FlatTokenDatabase::Create(FlatDatabase())), threads);
+}
+
+PW_PERF_TEST(Corpus_TokenDatabase, CorpusTokenDatabase);
+PW_PERF_TEST(Corpus_FlatTokenDatabase, CorpusFlatDatabase);
+PW_PERF_TEST(Corpus_Batch_TokenDatabase, CorpusBatchTokenDatabase, 1u);
+PW_PERF_TEST(Corpus_Batch_FlatTokenDatabase, CorpusBatchFlatDatabase, 1u);
+PW_PERF_TEST(Corpus_Batch4_TokenDatabase, CorpusBatchTokenDatabase, 4u);
+PW_PERF_TEST(Corpus_Batch4_FlatTokenDatabase, CorpusBatchFlatDatabase, 4u);
+
+}  // namespace
+}  // namespace pw::tokenizer
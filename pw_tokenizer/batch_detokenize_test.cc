@@ -0,0 +1,187 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/batch_detokenize.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_tokenizer/flat_token_database.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::tokenizer {
+namespace {
+
+using namespace std::literals::string_view_literals;
+
+constexpr char kData[] =
+    "TOKENS\0\0\x05\x00\x00\x00\0\0\0\0"
+    "\x01\0\0\0\xff\xff\xff\xff"
+    "\x02\0\0\0\xff\xff\xff\xff"
+    "\x03\0\0\0\xff\xff\xff\xff"
+    "\x04\0\0\0\x01\x02\x03\x04"
+    "\x04\0\0\0\xff\xff\xff\xff"
+    "Hello!\0"
+    "Now there are %d of %s!\0"
+    "%c!\0"
+    "Removed %d\0"
+    "Active %d";
+
+constexpr TokenDatabase kDatabase = TokenDatabase::Create<kData>();
+
+// Messages with and without arguments, unknown tokens, partial tokens, and
+// collisions.
+constexpr std::string_view kMessages[] = {
+    "\1\0\0\0"sv,
+    "\2\0\0\0\4\4them"sv,
+    "\3\0\0\0\xfc\x01"sv,
+    "\4\0\0\0\x02"sv,
+    "\1\0\0\0"sv,
+    ""sv,
+    "\1\0"sv,
+    "\x99\0\0\0"sv,
+    "\2\0\0\0\x80\x01\4them"sv,
+    "\2\0\0\0"sv,
+    "\1\0\0\0"sv,
+};
+
+std::vector<span<const std::byte>> MakeBatch(size_t repeat) {
+  std::vector<span<const std::byte>> batch;
+  for (size_t i = 0; i < repeat; ++i) {
+    for (std::string_view message : kMessages) {
+      batch.push_back(as_bytes(span(message)));
+    }
+  }
+  return batch;
+}
+
+void ExpectMatchesDetokenizer(const Detokenizer& detokenizer,
+                              BatchDetokenizer& batch_detokenizer,
+                              size_t repeat) {
+  const std::vector<span<const std::byte>> batch = MakeBatch(repeat);
+  const span<const std::string_view> results =
+      batch_detokenizer.Detokenize(batch);
+
+  ASSERT_EQ(results.size(), batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    EXPECT_EQ(results[i], detokenizer.Detokenize(batch[i]).BestString())
+        << "message " << i;
+  }
+}
+
+TEST(BatchDetokenizer, MatchesDetokenizer) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer batch_detokenizer(detokenizer);
+
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 1);
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 3);
+}
+
+TEST(BatchDetokenizer, MatchesDetokenizer_FlatDatabase) {
+  FlatTokenDatabaseBuilder builder;
+  builder.Add(kDatabase);
+  const std::vector<std::byte> data = builder.Build();
+  const Detokenizer detokenizer(FlatTokenDatabase::Create(data));
+  BatchDetokenizer batch_detokenizer(detokenizer);
+
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 2);
+}
+
+TEST(BatchDetokenizer, MultipleThreads) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer::Options options;
+  options.threads = 4;
+  options.min_messages_per_thread = 5;
+  BatchDetokenizer batch_detokenizer(detokenizer, options);
+
+  // Smaller than one chunk per thread, uneven chunks, and many chunks.
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 1);
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 3);
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 50);
+}
+
+TEST(BatchDetokenizer, DetokenizeInto_AppendsToOutput) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer::Options options;
+  options.threads = 4;
+  options.min_messages_per_thread = 5;
+  BatchDetokenizer batch_detokenizer(detokenizer, options);
+
+  const std::vector<span<const std::byte>> batch = MakeBatch(3);
+  std::string output = "Existing text";
+  const span<const std::string_view> results =
+      batch_detokenizer.DetokenizeInto(batch, output);
+
+  ASSERT_EQ(results.size(), batch.size());
+  EXPECT_EQ(std::string_view(output).substr(0, 13), "Existing text");
+  std::string expected = "Existing text";
+  for (size_t i = 0; i < batch.size(); ++i) {
+    const std::string text = detokenizer.Detokenize(batch[i]).BestString();
+    EXPECT_EQ(results[i], text) << "message " << i;
+    EXPECT_GE(results[i].data(), output.data());
+    EXPECT_LE(results[i].data() + results[i].size(),
+              output.data() + output.size());
+    expected += text;
+  }
+  EXPECT_EQ(output, expected);
+}
+
+TEST(BatchDetokenizer, CachesTokens) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer batch_detokenizer(detokenizer);
+
+  const std::vector<span<const std::byte>> batch = MakeBatch(1);
+  batch_detokenizer.Detokenize(batch);
+  const size_t first_hits = batch_detokenizer.cache_hits();
+  EXPECT_GT(first_hits, 0u);
+
+  // Every token is cached for the second batch. The empty message has no
+  // token to look up.
+  batch_detokenizer.Detokenize(batch);
+  EXPECT_EQ(batch_detokenizer.cache_hits() - first_hits, batch.size() - 1);
+}
+
+TEST(BatchDetokenizer, CacheEviction) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer::Options options;
+  options.max_cached_tokens = 2;
+  BatchDetokenizer batch_detokenizer(detokenizer, options);
+
+  ExpectMatchesDetokenizer(detokenizer, batch_detokenizer, 4);
+}
+
+TEST(BatchDetokenizer, Domains) {
+  Result<Detokenizer> detokenizer = Detokenizer::FromCsv(
+      "00000001,          ,\"\",\"Default\"\n"
+      "00000001,          ,\"OTHER\",\"Other\"\n");
+  ASSERT_EQ(OkStatus(), detokenizer.status());
+  BatchDetokenizer batch_detokenizer(*detokenizer);
+
+  const std::vector<span<const std::byte>> batch = {
+      as_bytes(span("\1\0\0\0"sv))};
+  EXPECT_EQ(batch_detokenizer.Detokenize(batch)[0], "Default");
+  EXPECT_EQ(batch_detokenizer.Detokenize(batch, "OTHER")[0], "Other");
+  EXPECT_EQ(batch_detokenizer.Detokenize(batch)[0], "Default");
+}
+
+TEST(BatchDetokenizer, EmptyBatch) {
+  const Detokenizer detokenizer(kDatabase);
+  BatchDetokenizer batch_detokenizer(detokenizer);
+  EXPECT_TRUE(batch_detokenizer.Detokenize({}).empty());
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
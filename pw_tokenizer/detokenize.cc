@@ -428,6 +428,17 @@ void AddEntryIfUnique(std::vector<TokenizedStringEntry>& entries,
   entries.emplace_back(std::move(format_string), date_removed);
 }
 
+// Domains are stored without whitespace.
+std::string CanonicalDomain(std::string_view domain) {
+  std::string canonical_domain;
+  for (char ch : domain) {
+    if (!std::isspace(ch)) {
+      canonical_domain.push_back(ch);
+    }
+  }
+  return canonical_domain;
+}
+
 }  // namespace
 
 DetokenizedString::DetokenizedString(
@@ -656,14 +667,11 @@ DetokenizedString Detokenizer::DetokenizeBase64Message(
 
 span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
     uint32_t token, std::string_view domain) const {
-  std::string canonical_domain;
-  for (char ch : domain) {
-    if (!std::isspace(ch)) {
-      canonical_domain.push_back(ch);
-    }
+  if (flat_database_.ok()) {
+    return FlatDatabaseLookup(token, domain);
   }
 
-  auto domain_it = database_.find(canonical_domain);
+  auto domain_it = database_.find(CanonicalDomain(domain));
   if (domain_it == database_.end()) {
     return span<TokenizedStringEntry>();
   }
@@ -675,6 +683,39 @@ span<const TokenizedStringEntry> Detokenizer::DatabaseLookup(
   return span(token_it->second);
 }
 
+span<const TokenizedStringEntry> Detokenizer::FlatDatabaseLookup(
+    uint32_t token, std::string_view domain) const {
+  // Key the cache by canonical domain so that different spellings of a domain
+  // share entries.
+  const std::string canonical_domain = CanonicalDomain(domain);
+  std::lock_guard lock(flat_cache_->mutex);
+  DomainTokenEntriesMap& cache = flat_cache_->entries;
+  if (auto domain_it = cache.find(canonical_domain); domain_it != cache.end()) {
+    if (auto token_it = domain_it->second.find(token);
+        token_it != domain_it->second.end()) {
+      return span(token_it->second);
+    }
+  }
+
+  // Only tokens that are in the database are cached, so looking up unknown
+  // tokens or domains does not grow the cache.
+  const FlatTokenDatabase::Entries found =
+      flat_database_.Find(canonical_domain, token);
+  if (found.empty()) {
+    return span<TokenizedStringEntry>();
+  }
+
+  std::vector<TokenizedStringEntry>& entries = cache[canonical_domain][token];
+  entries.reserve(found.size());
+  for (size_t i = 0; i < found.size(); ++i) {
+    const FlatTokenDatabase::Entry entry = found[i];
+    // Strings in a flat database are null terminated.
+    entries.emplace_back(FormatString(entry.string.data()),
+                         entry.date_removed);
+  }
+  return span(entries);
+}
+
 std::string Detokenizer::DetokenizeTextRecursive(std::string_view text,
                                                  unsigned max_passes) const {
   NestedMessageDetokenizer detokenizer(*this);
@@ -13,12 +13,25 @@
 // the License.
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "pw_assert/check.h"
 #include "pw_bytes/array.h"
+#include "pw_bytes/endian.h"
+#include "pw_log/log.h"
 #include "pw_perf_test/perf_test.h"
 #include "pw_span/span.h"
 #include "pw_tokenizer/detokenize.h"
+#include "pw_tokenizer/flat_token_database.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif  // defined(__linux__)
 
 namespace pw::tokenizer {
 namespace {
@@ -121,5 +134,138 @@ PW_PERF_TEST(DetokenizeText_TwoMessages,
              "What the $qqqqqvwB, $Dg8AAQQEdGhlbQ==",
              "What the ~!, Now there are 2 of them!");
 
+// Database startup benchmarks. These compare constructing a Detokenizer from a
+// binary TokenDatabase, which parses every entry into a hash table, with
+// searching a FlatTokenDatabase in place.
+constexpr uint32_t kLargeDatabaseEntries = 10000;
+
+// Returns a binary token database with kLargeDatabaseEntries entries.
+const std::vector<char>& LargeBinaryDatabase() {
+  static const std::vector<char> database = [] {
+    std::vector<char> data;
+    const auto append_uint32 = [&data](uint32_t value) {
+      for (std::byte b : bytes::CopyInOrder(endian::little, value)) {
+        data.push_back(static_cast<char>(b));
+      }
+    };
+
+    constexpr std::string_view kMagicAndVersion("TOKENS\0\0", 8);
+    data.insert(data.end(), kMagicAndVersion.begin(), kMagicAndVersion.end());
+    append_uint32(kLargeDatabaseEntries);
+    append_uint32(0);
+
+    for (uint32_t i = 0; i < kLargeDatabaseEntries; ++i) {
+      append_uint32(i * 2654435761u);
+      append_uint32(TokenDatabase::kDateRemovedNever);
+    }
+    for (uint32_t i = 0; i < kLargeDatabaseEntries; ++i) {
+      const std::string string =
+          "Message " + std::to_string(i) + ": value %d, name %s";
+      data.insert(data.end(), string.begin(), string.end());
+      data.push_back('\0');
+    }
+    return data;
+  }();
+  return database;
+}
+
+TokenDatabase LargeTokenDatabase() {
+  return TokenDatabase::Create(LargeBinaryDatabase());
+}
+
+const std::vector<std::byte>& LargeFlatDatabase() {
+  static const std::vector<std::byte> database = [] {
+    FlatTokenDatabaseBuilder builder;
+    builder.Add(LargeTokenDatabase());
+    return builder.Build();
+  }();
+  return database;
+}
+
+// Returns the resident set size of this process in bytes, or 0 if unknown.
+size_t ResidentSetSize() {
+#if defined(__linux__)
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0;
+  }
+  unsigned long total_pages = 0;
+  unsigned long resident_pages = 0;
+  const int fields =
+      std::fscanf(statm, "%lu %lu", &total_pages, &resident_pages);
+  std::fclose(statm);
+  if (fields != 2) {
+    return 0;
+  }
+  return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif  // defined(__linux__)
+}
+
+// Logs how much the resident set grows while a detokenizer exists.
+template <typename MakeDetokenizer>
+void LogResidentSetGrowth(const char* name, MakeDetokenizer make_detokenizer) {
+  const size_t before = ResidentSetSize();
+  const Detokenizer detokenizer = make_detokenizer();
+  const size_t after = ResidentSetSize();
+  PW_LOG_INFO("%s: resident set grew by %zu KiB for %u entries",
+              name,
+              (after > before ? after - before : 0) / 1024,
+              static_cast<unsigned>(kLargeDatabaseEntries));
+}
+
+void ConstructFromTokenDatabase(perf_test::State& state) {
+  const TokenDatabase database = LargeTokenDatabase();
+  LogResidentSetGrowth("TokenDatabase",
+                       [&database] { return Detokenizer(database); });
+
+  while (state.KeepRunning()) {
+    Detokenizer detokenizer(database);
+    PW_CHECK(!detokenizer.database().empty());
+  }
+}
+
+void ConstructFromFlatDatabase(perf_test::State& state) {
+  const std::vector<std::byte>& data = LargeFlatDatabase();
+  LogResidentSetGrowth("FlatTokenDatabase", [&data] {
+    return Detokenizer(FlatTokenDatabase::Create(data));
+  });
+
+  while (state.KeepRunning()) {
+    Detokenizer detokenizer(FlatTokenDatabase::Create(data));
+    PW_CHECK(detokenizer.database().empty());
+  }
+}
+
+PW_PERF_TEST(Startup_TokenDatabase, ConstructFromTokenDatabase);
+PW_PERF_TEST(Startup_FlatTokenDatabase, ConstructFromFlatDatabase);
+
+void DetokenizeLargeDatabase(perf_test::State& state,
+                             const Detokenizer& detokenizer) {
+  // Token 1234 is the 1234th entry's token.
+  const auto encoded = bytes::Concat(
+      bytes::CopyInOrder(endian::little, uint32_t{1234} * 2654435761u),
+      bytes::String("\x04\x04them"));
+
+  std::string result;
+  while (state.KeepRunning()) {
+    result = detokenizer.Detokenize(encoded).BestString();
+  }
+  PW_CHECK(result == "Message 1234: value 2, name them");
+}
+
+void DetokenizeTokenDatabase(perf_test::State& state) {
+  DetokenizeLargeDatabase(state, Detokenizer(LargeTokenDatabase()));
+}
+
+void DetokenizeFlatDatabase(perf_test::State& state) {
+  DetokenizeLargeDatabase(
+      state, Detokenizer(FlatTokenDatabase::Create(LargeFlatDatabase())));
+}
+
+PW_PERF_TEST(Detokenize_TokenDatabase, DetokenizeTokenDatabase);
+PW_PERF_TEST(Detokenize_FlatTokenDatabase, DetokenizeFlatDatabase);
+
 }  // namespace
 }  // namespace pw::tokenizer
@@ -0,0 +1,310 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/flat_token_database.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <tuple>
+
+#include "pw_bytes/endian.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::tokenizer {
+namespace {
+
+constexpr char kMagicAndVersion[] = {'T', 'O', 'K', 'F', 'L', 'T', '\0', '\0'};
+
+bool IsSpace(char ch) {
+  return std::isspace(static_cast<unsigned char>(ch)) != 0;
+}
+
+// Compares a domain to a canonical domain name, ignoring whitespace in the
+// domain. Returns <0, 0, or >0, like std::string_view::compare.
+int CompareDomain(std::string_view domain, std::string_view name) {
+  size_t i = 0;
+  for (char ch : domain) {
+    if (IsSpace(ch)) {
+      continue;
+    }
+    if (i == name.size()) {
+      return 1;
+    }
+    const auto lhs = static_cast<unsigned char>(ch);
+    const auto rhs = static_cast<unsigned char>(name[i++]);
+    if (lhs != rhs) {
+      return lhs < rhs ? -1 : 1;
+    }
+  }
+  return i == name.size() ? 0 : -1;
+}
+
+void AppendUint32(std::vector<std::byte>& output, uint32_t value) {
+  const auto bytes = bytes::CopyInOrder(endian::little, value);
+  output.insert(output.end(), bytes.begin(), bytes.end());
+}
+
+void AppendString(std::vector<std::byte>& output, std::string_view string) {
+  const auto* data = reinterpret_cast<const std::byte*>(string.data());
+  output.insert(output.end(), data, data + string.size());
+  output.push_back(std::byte{'\0'});
+}
+
+}  // namespace
+
+FlatTokenDatabase::Entry FlatTokenDatabase::Entries::operator[](
+    size_t index) const {
+  return database_->entry(first_ + index);
+}
+
+FlatTokenDatabase FlatTokenDatabase::Create(span<const std::byte> data) {
+  if (data.size() < kHeaderSize ||
+      std::memcmp(data.data(), kMagicAndVersion, sizeof(kMagicAndVersion)) !=
+          0) {
+    return FlatTokenDatabase();
+  }
+
+  FlatTokenDatabase database;
+  database.data_ = data;
+  database.domain_count_ = database.ReadUint32(8);
+  database.entry_count_ = database.ReadUint32(12);
+
+  // Check that the tables fit, using 64-bit math to avoid overflow.
+  const uint64_t strings_start =
+      kHeaderSize + uint64_t{kDomainSize} * database.domain_count_ +
+      uint64_t{kEntrySize} * database.entry_count_;
+  if (strings_start > data.size()) {
+    return FlatTokenDatabase();
+  }
+
+  // Strings must be null terminated, so the database must end with '\0'.
+  const bool has_strings = database.domain_count_ + database.entry_count_ != 0;
+  if (has_strings && data.back() != std::byte{'\0'}) {
+    return FlatTokenDatabase();
+  }
+
+  const auto string_in_bounds = [&](size_t offset) {
+    const uint32_t string_offset = database.ReadUint32(offset);
+    return string_offset >= strings_start && string_offset < data.size();
+  };
+
+  for (size_t i = 0; i < database.domain_count_; ++i) {
+    const size_t offset = kHeaderSize + i * kDomainSize;
+    const uint64_t first_entry = database.ReadUint32(offset + 4);
+    const uint64_t entry_count = database.ReadUint32(offset + 8);
+    if (!string_in_bounds(offset) ||
+        first_entry + entry_count > database.entry_count_) {
+      return FlatTokenDatabase();
+    }
+  }
+
+  const size_t entries_start =
+      kHeaderSize + database.domain_count_ * kDomainSize;
+  for (size_t i = 0; i < database.entry_count_; ++i) {
+    if (!string_in_bounds(entries_start + i * kEntrySize + 8)) {
+      return FlatTokenDatabase();
+    }
+  }
+
+  return database;
+}
+
+FlatTokenDatabase::Entries FlatTokenDatabase::Find(std::string_view domain,
+                                                   uint32_t token) const {
+  DomainRecord record;
+  if (!FindDomain(domain, record)) {
+    return Entries();
+  }
+
+  const size_t entries_start = kHeaderSize + domain_count_ * kDomainSize;
+  const auto token_at = [&](size_t index) {
+    return ReadUint32(entries_start + index * kEntrySize);
+  };
+
+  // Binary search for the first entry with the token.
+  size_t first = record.first_entry;
+  size_t count = record.entry_count;
+  while (count > 0) {
+    const size_t step = count / 2;
+    if (token_at(first + step) < token) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  const size_t end = record.first_entry + record.entry_count;
+  size_t last = first;
+  while (last < end && token_at(last) == token) {
+    ++last;
+  }
+  return Entries(*this, first, last - first);
+}
+
+FlatTokenDatabase::Entry FlatTokenDatabase::entry(size_t index) const {
+  const size_t offset =
+      kHeaderSize + domain_count_ * kDomainSize + index * kEntrySize;
+  return Entry{ReadUint32(offset),
+               ReadUint32(offset + 4),
+               ReadString(ReadUint32(offset + 8))};
+}
+
+uint32_t FlatTokenDatabase::ReadUint32(size_t offset) const {
+  return bytes::ReadInOrder<uint32_t>(endian::little, &data_[offset]);
+}
+
+std::string_view FlatTokenDatabase::ReadString(size_t offset) const {
+  // Create() checked that the data ends with a null terminator.
+  return std::string_view(reinterpret_cast<const char*>(&data_[offset]));
+}
+
+FlatTokenDatabase::DomainRecord FlatTokenDatabase::domain(size_t index) const {
+  const size_t offset = kHeaderSize + index * kDomainSize;
+  return DomainRecord{ReadString(ReadUint32(offset)),
+                      ReadUint32(offset + 4),
+                      ReadUint32(offset + 8)};
+}
+
+bool FlatTokenDatabase::FindDomain(std::string_view domain_name,
+                                   DomainRecord& result) const {
+  size_t first = 0;
+  size_t count = domain_count_;
+  while (count > 0) {
+    const size_t step = count / 2;
+    if (CompareDomain(domain_name, domain(first + step).name) > 0) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  if (first == domain_count_) {
+    return false;
+  }
+  result = domain(first);
+  return CompareDomain(domain_name, result.name) == 0;
+}
+
+void FlatTokenDatabaseBuilder::Add(std::string_view domain,
+                                   uint32_t token,
+                                   uint32_t date_removed,
+                                   std::string_view string) {
+  std::string canonical_domain;
+  for (char ch : domain) {
+    if (!IsSpace(ch)) {
+      canonical_domain.push_back(ch);
+    }
+  }
+  entries_.push_back(PendingEntry{
+      std::move(canonical_domain), token, date_removed, std::string(string)});
+}
+
+void FlatTokenDatabaseBuilder::Add(const TokenDatabase& database,
+                                   std::string_view domain) {
+  for (const TokenDatabase::Entry& entry : database) {
+    Add(domain, entry.token, entry.date_removed, entry.string);
+  }
+}
+
+Status FlatTokenDatabaseBuilder::AddCsv(std::string_view csv) {
+  // Detokenizer::FromCsv validates the CSV and parses its dates.
+  Result<Detokenizer> detokenizer = Detokenizer::FromCsv(csv);
+  if (!detokenizer.ok()) {
+    return detokenizer.status();
+  }
+
+  for (const auto& [domain, tokens] : detokenizer->database()) {
+    for (const auto& [token, entries] : tokens) {
+      for (const auto& [format_string, date_removed] : entries) {
+        Add(domain, token, date_removed, format_string.text());
+      }
+    }
+  }
+  return OkStatus();
+}
+
+std::vector<std::byte> FlatTokenDatabaseBuilder::Build() const {
+  // Sort by domain, token, and string, with the latest removal date first so
+  // that duplicates can be dropped.
+  std::vector<const PendingEntry*> sorted;
+  sorted.reserve(entries_.size());
+  for (const PendingEntry& entry : entries_) {
+    sorted.push_back(&entry);
+  }
+  std::sort(sorted.begin(),
+            sorted.end(),
+            [](const PendingEntry* lhs, const PendingEntry* rhs) {
+              return std::tie(lhs->domain,
+                              lhs->token,
+                              lhs->string,
+                              rhs->date_removed) <
+                     std::tie(rhs->domain,
+                              rhs->token,
+                              rhs->string,
+                              lhs->date_removed);
+            });
+  const auto same_entry = [](const PendingEntry* lhs,
+                             const PendingEntry* rhs) {
+    return lhs->domain == rhs->domain && lhs->token == rhs->token &&
+           lhs->string == rhs->string;
+  };
+  sorted.erase(std::unique(sorted.begin(), sorted.end(), same_entry),
+               sorted.end());
+
+  // Each domain is a run of entries. Record the index of each run's start.
+  std::vector<size_t> domain_starts;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    if (i == 0 || sorted[i]->domain != sorted[i - 1]->domain) {
+      domain_starts.push_back(i);
+    }
+  }
+
+  const size_t strings_start =
+      FlatTokenDatabase::kHeaderSize +
+      domain_starts.size() * FlatTokenDatabase::kDomainSize +
+      sorted.size() * FlatTokenDatabase::kEntrySize;
+
+  std::vector<std::byte> output;
+  std::vector<std::byte> strings;
+
+  const auto* magic = reinterpret_cast<const std::byte*>(kMagicAndVersion);
+  output.insert(output.end(), magic, magic + sizeof(kMagicAndVersion));
+  AppendUint32(output, static_cast<uint32_t>(domain_starts.size()));
+  AppendUint32(output, static_cast<uint32_t>(sorted.size()));
+
+  for (size_t i = 0; i < domain_starts.size(); ++i) {
+    const size_t first = domain_starts[i];
+    const size_t end =
+        i + 1 < domain_starts.size() ? domain_starts[i + 1] : sorted.size();
+    AppendUint32(output, static_cast<uint32_t>(strings_start + strings.size()));
+    AppendUint32(output, static_cast<uint32_t>(first));
+    AppendUint32(output, static_cast<uint32_t>(end - first));
+    AppendString(strings, sorted[first]->domain);
+  }
+
+  for (const PendingEntry* entry : sorted) {
+    AppendUint32(output, entry->token);
+    AppendUint32(output, entry->date_removed);
+    AppendUint32(output, static_cast<uint32_t>(strings_start + strings.size()));
+    AppendString(strings, entry->string);
+  }
+
+  output.insert(output.end(), strings.begin(), strings.end());
+  return output;
+}
+
+}  // namespace pw::tokenizer
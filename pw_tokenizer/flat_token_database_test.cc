@@ -0,0 +1,238 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_tokenizer/flat_token_database.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "pw_tokenizer/detokenize.h"
+#include "pw_unit_test/framework.h"
+
+namespace pw::tokenizer {
+namespace {
+
+using namespace std::literals::string_view_literals;
+
+constexpr char kBasicData[] =
+    "TOKENS\0\0\x04\x00\x00\x00\0\0\0\0"
+    "\x01\0\0\0\xff\xff\xff\xff"
+    "\x02\0\0\0\x01\x02\x03\x04"
+    "\x02\0\0\0\xff\xff\xff\xff"
+    "\xFF\0\0\0\xff\xff\xff\xff"
+    "hi!\0"
+    "goodbye\0"
+    "good %s\0"
+    ":)";
+
+constexpr TokenDatabase kBasicDatabase = TokenDatabase::Create<kBasicData>();
+
+constexpr std::string_view kCsv =
+    "00000001,          ,\"\",\"hi!\"\n"
+    "00000002,2023-01-02,\"TEST_DOMAIN\",\"Two %d\"\n"
+    "00000003,          ,\"TEST_DOMAIN\",\"Three\"\n"
+    "00000003,          ,\"TEST_DOMAIN\",\"Three\"\n"
+    "00000003,          ,\"OTHER\",\"Other three\"\n";
+
+TEST(FlatTokenDatabase, Build_FromTokenDatabase) {
+  FlatTokenDatabaseBuilder builder;
+  builder.Add(kBasicDatabase);
+  const std::vector<std::byte> data = builder.Build();
+
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(data);
+  ASSERT_TRUE(database.ok());
+  EXPECT_EQ(database.domain_count(), 1u);
+  EXPECT_EQ(database.size(), 4u);
+
+  FlatTokenDatabase::Entries entries = database.Find("", 1);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].token, 1u);
+  EXPECT_EQ(entries[0].date_removed, TokenDatabase::kDateRemovedNever);
+  EXPECT_EQ(entries[0].string, "hi!"sv);
+
+  entries = database.Find("", 2);
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[0].string, "good %s"sv);
+  EXPECT_EQ(entries[1].string, "goodbye"sv);
+  EXPECT_EQ(entries[1].date_removed, 0x04030201u);
+
+  entries = database.Find("", 0xFF);
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].string, ":)"sv);
+}
+
+TEST(FlatTokenDatabase, Find_Missing) {
+  FlatTokenDatabaseBuilder builder;
+  builder.Add(kBasicDatabase);
+  const std::vector<std::byte> data = builder.Build();
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(data);
+
+  EXPECT_TRUE(database.Find("", 0).empty());
+  EXPECT_TRUE(database.Find("", 3).empty());
+  EXPECT_TRUE(database.Find("", 0xFFFFFFFF).empty());
+  EXPECT_TRUE(database.Find("nope", 1).empty());
+}
+
+TEST(FlatTokenDatabase, Build_FromCsv) {
+  FlatTokenDatabaseBuilder builder;
+  ASSERT_EQ(OkStatus(), builder.AddCsv(kCsv));
+  const std::vector<std::byte> data = builder.Build();
+
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(data);
+  ASSERT_TRUE(database.ok());
+  EXPECT_EQ(database.domain_count(), 3u);
+  EXPECT_EQ(database.size(), 4u) << "Duplicate entries are merged";
+
+  ASSERT_EQ(database.Find("", 1).size(), 1u);
+  EXPECT_EQ(database.Find("", 1)[0].string, "hi!"sv);
+
+  ASSERT_EQ(database.Find("TEST_DOMAIN", 2).size(), 1u);
+  EXPECT_EQ(database.Find("TEST_DOMAIN", 2)[0].string, "Two %d"sv);
+  EXPECT_EQ(database.Find("TEST_DOMAIN", 2)[0].date_removed,
+            (2023u << 16) | (1u << 8) | 2u);
+
+  ASSERT_EQ(database.Find("OTHER", 3).size(), 1u);
+  EXPECT_EQ(database.Find("OTHER", 3)[0].string, "Other three"sv);
+  EXPECT_TRUE(database.Find("OTHER", 2).empty());
+}
+
+TEST(FlatTokenDatabase, Find_IgnoresWhitespaceInDomain) {
+  FlatTokenDatabaseBuilder builder;
+  builder.Add(" TEST _DOMAIN\n", 2, TokenDatabase::kDateRemovedNever, "Two");
+  const std::vector<std::byte> data = builder.Build();
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(data);
+
+  ASSERT_EQ(database.Find("TEST_DOMAIN", 2).size(), 1u);
+  ASSERT_EQ(database.Find("TEST_\tDOMAIN ", 2).size(), 1u);
+  EXPECT_TRUE(database.Find("TEST_DOMAIN2", 2).empty());
+  EXPECT_TRUE(database.Find("TEST_DOMAI", 2).empty());
+}
+
+TEST(FlatTokenDatabase, Build_MergesDuplicatesWithLatestDate) {
+  FlatTokenDatabaseBuilder builder;
+  builder.Add("", 1, 100, "one");
+  builder.Add("", 1, TokenDatabase::kDateRemovedNever, "one");
+  builder.Add("", 1, 200, "one");
+  EXPECT_EQ(builder.size(), 3u);
+
+  const std::vector<std::byte> data = builder.Build();
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(data);
+  ASSERT_EQ(database.Find("", 1).size(), 1u);
+  EXPECT_EQ(database.Find("", 1)[0].date_removed,
+            TokenDatabase::kDateRemovedNever);
+}
+
+TEST(FlatTokenDatabase, Build_Empty) {
+  const std::vector<std::byte> data = FlatTokenDatabaseBuilder().Build();
+  const FlatTokenDatabase database = FlatTokenDatabase::Create(data);
+  ASSERT_TRUE(database.ok());
+  EXPECT_EQ(database.size(), 0u);
+  EXPECT_TRUE(database.Find("", 1).empty());
+}
+
+TEST(FlatTokenDatabase, Create_InvalidData) {
+  FlatTokenDatabaseBuilder builder;
+  builder.Add(kBasicDatabase);
+  std::vector<std::byte> data = builder.Build();
+  ASSERT_TRUE(FlatTokenDatabase::Create(data).ok());
+
+  EXPECT_FALSE(FlatTokenDatabase::Create(span(data).first(15)).ok());
+
+  // Truncated string table.
+  EXPECT_FALSE(
+      FlatTokenDatabase::Create(span(data).first(data.size() - 1)).ok());
+
+  // Bad magic.
+  std::vector<std::byte> bad_magic = data;
+  bad_magic[0] = std::byte{'t'};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_magic).ok());
+
+  // Entry count larger than the data.
+  std::vector<std::byte> bad_count = data;
+  bad_count[15] = std::byte{0x10};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_count).ok());
+
+  // Domain name offset out of bounds.
+  std::vector<std::byte> bad_offset = data;
+  bad_offset[FlatTokenDatabase::kHeaderSize + 3] = std::byte{0x7f};
+  EXPECT_FALSE(FlatTokenDatabase::Create(bad_offset).ok());
+
+  EXPECT_FALSE(FlatTokenDatabase().ok());
+}
+
+TEST(FlatTokenDatabase, Detokenizer_MatchesParsedDatabase) {
+  FlatTokenDatabaseBuilder builder;
+  ASSERT_EQ(OkStatus(), builder.AddCsv(kCsv));
+  const std::vector<std::byte> data = builder.Build();
+
+  const Detokenizer flat(FlatTokenDatabase::Create(data));
+  Result<Detokenizer> parsed = Detokenizer::FromCsv(kCsv);
+  ASSERT_EQ(OkStatus(), parsed.status());
+
+  EXPECT_TRUE(flat.database().empty());
+
+  constexpr std::string_view kMessages[] = {
+      "\1\0\0\0"sv, "\2\0\0\0\4"sv, "\3\0\0\0"sv, "\4\0\0\0"sv};
+  for (std::string_view domain : {""sv, "TEST_DOMAIN"sv, "OTHER"sv}) {
+    for (std::string_view message : kMessages) {
+      const DetokenizedString expected = parsed->Detokenize(message, domain);
+      const DetokenizedString actual = flat.Detokenize(message, domain);
+      EXPECT_EQ(actual.ok(), expected.ok());
+      EXPECT_EQ(actual.BestString(), expected.BestString());
+      EXPECT_EQ(actual.matches().size(), expected.matches().size());
+    }
+  }
+
+  EXPECT_EQ(flat.DetokenizeText("${TEST_DOMAIN}AwAAAA== ${OTHER}#00000003"),
+            "Three Other three");
+}
+
+TEST(FlatTokenDatabase, Detokenizer_LookupsRemainValid) {
+  FlatTokenDatabaseBuilder builder;
+  ASSERT_EQ(OkStatus(), builder.AddCsv(kCsv));
+  const std::vector<std::byte> data = builder.Build();
+  const Detokenizer detokenizer(FlatTokenDatabase::Create(data));
+
+  const span<const TokenizedStringEntry> first =
+      detokenizer.DatabaseLookup(1, "");
+  ASSERT_EQ(first.size(), 1u);
+
+  // Later lookups do not overwrite earlier results.
+  const span<const TokenizedStringEntry> second =
+      detokenizer.DatabaseLookup(3, "OTHER");
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_EQ(detokenizer.DatabaseLookup(4, "").size(), 0u);
+  EXPECT_EQ(first[0].first.text(), "hi!");
+  EXPECT_EQ(second[0].first.text(), "Other three");
+
+  // Repeated lookups return the entries parsed by the first lookup.
+  EXPECT_EQ(detokenizer.DatabaseLookup(1, "").data(), first.data());
+}
+
+TEST(FlatTokenDatabase, Detokenizer_DomainSpellingsShareEntries) {
+  FlatTokenDatabaseBuilder builder;
+  ASSERT_EQ(OkStatus(), builder.AddCsv(kCsv));
+  const std::vector<std::byte> data = builder.Build();
+  const Detokenizer detokenizer(FlatTokenDatabase::Create(data));
+
+  const span<const TokenizedStringEntry> entries =
+      detokenizer.DatabaseLookup(3, "OTHER");
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(detokenizer.DatabaseLookup(3, " OT HER\t").data(), entries.data());
+  EXPECT_EQ(detokenizer.DatabaseLookup(3, "\nOTHER ").data(), entries.data());
+}
+
+}  // namespace
+}  // namespace pw::tokenizer
@@ -0,0 +1,157 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "pw_span/span.h"
+#include "pw_tokenizer/detokenize.h"
+
+namespace pw::tokenizer {
+
+/// @submodule{pw_tokenizer,detokenize}
+
+/// Detokenizes batches of binary encoded messages, such as the messages from a
+/// log ingestion pipeline.
+///
+/// For each message, `BatchDetokenizer` produces the same text as
+/// `Detokenizer::Detokenize(message).BestString()`, but it avoids most of the
+/// per-message costs:
+///
+/// - Decoded text is appended to a caller-provided string, or to one owned by
+///   the `BatchDetokenizer`, instead of being allocated per message.
+/// - The database entries for recently seen tokens are cached per thread, so
+///   each thread looks up a token in the `Detokenizer` only once.
+/// - The text for messages without arguments is cached.
+/// - Large batches may be split across multiple threads.
+///
+/// A `BatchDetokenizer` must only be used by one thread at a time. The
+/// `Detokenizer` must outlive it.
+class BatchDetokenizer {
+ public:
+  struct Options {
+    /// The maximum number of threads to decode with, including the calling
+    /// thread. Threads are started for each batch, so use multiple threads
+    /// only for large batches.
+    unsigned threads = 1;
+
+    /// The minimum number of messages each thread decodes. Batches smaller
+    /// than this are decoded on the calling thread.
+    size_t min_messages_per_thread = 256;
+
+    /// The maximum number of tokens to cache per thread. The cache is cleared
+    /// when it fills.
+    size_t max_cached_tokens = 4096;
+  };
+
+  explicit BatchDetokenizer(const Detokenizer& detokenizer)
+      : BatchDetokenizer(detokenizer, Options()) {}
+
+  BatchDetokenizer(const Detokenizer& detokenizer, const Options& options);
+
+  BatchDetokenizer(const BatchDetokenizer&) = delete;
+  BatchDetokenizer& operator=(const BatchDetokenizer&) = delete;
+
+  /// Detokenizes each message in the batch and appends the text to `output`.
+  /// Reusing the same `output` for each batch avoids allocating once its
+  /// capacity is large enough.
+  ///
+  /// The calling thread writes directly into `output`. Other threads write into
+  /// their own scratch buffers, which are appended to `output` once they
+  /// finish.
+  ///
+  /// @returns The best string for each message, in order. The strings refer to
+  /// `output`, and are valid until `output` is modified. The span is valid
+  /// until the next call to `Detokenize` or `DetokenizeInto`.
+  span<const std::string_view> DetokenizeInto(
+      span<const span<const std::byte>> messages,
+      std::string& output,
+      std::string_view domain = kDefaultDomain);
+
+  /// Detokenizes each message in the batch into a buffer owned by the
+  /// `BatchDetokenizer`.
+  ///
+  /// @returns The best string for each message, in order. The strings are
+  /// valid until the next call to `Detokenize` or `DetokenizeInto`.
+  span<const std::string_view> Detokenize(
+      span<const span<const std::byte>> messages,
+      std::string_view domain = kDefaultDomain) {
+    text_.clear();
+    return DetokenizeInto(messages, text_, domain);
+  }
+
+  /// Returns the number of cache hits, for testing and tuning.
+  size_t cache_hits() const;
+
+ private:
+  // Decoding state for one thread. Each worker has its own cache and scratch
+  // buffer, so workers never synchronize.
+  class Worker {
+   public:
+    Worker(const Detokenizer& detokenizer, size_t max_cached_tokens)
+        : detokenizer_(&detokenizer), max_cached_tokens_(max_cached_tokens) {}
+
+    // Appends the text for each message to `text` and records where each
+    // message's text ends.
+    void Decode(span<const span<const std::byte>> messages,
+                std::string_view domain,
+                std::string& text,
+                span<size_t> ends);
+
+    // Buffer for text decoded on a helper thread.
+    std::string& scratch() { return scratch_; }
+
+    size_t cache_hits() const { return cache_hits_; }
+
+   private:
+    struct CachedToken {
+      // Points into the Detokenizer, which keeps its entries valid.
+      span<const TokenizedStringEntry> entries;
+
+      // The best string for a message with no arguments, if one was decoded.
+      std::string no_arguments;
+      bool has_no_arguments = false;
+    };
+
+    CachedToken& Lookup(uint32_t token, std::string_view domain);
+
+    void DecodeOne(span<const std::byte> message,
+                   std::string_view domain,
+                   std::string& text);
+
+    const Detokenizer* detokenizer_;
+    size_t max_cached_tokens_;
+    std::unordered_map<uint32_t, CachedToken> cache_;
+    std::string cache_domain_;
+    std::string scratch_;
+    size_t cache_hits_ = 0;
+  };
+
+  size_t ThreadsFor(size_t messages) const;
+
+  Options options_;
+  std::vector<Worker> workers_;
+  std::vector<size_t> ends_;
+  std::vector<std::string_view> results_;
+  std::string text_;
+};
+
+/// @}
+
+}  // namespace pw::tokenizer
@@ -26,6 +26,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -34,6 +35,9 @@
 #include "pw_result/result.h"
 #include "pw_span/span.h"
 #include "pw_stream/stream.h"
+#include "pw_sync/lock_annotations.h"
+#include "pw_sync/mutex.h"
+#include "pw_tokenizer/flat_token_database.h"
 #include "pw_tokenizer/internal/decode.h"
 #include "pw_tokenizer/token_database.h"
 #include "pw_tokenizer/tokenize.h"
@@ -100,6 +104,14 @@ class Detokenizer {
   explicit Detokenizer(DomainTokenEntriesMap&& database)
       : database_(std::move(database)) {}
 
+  /// Constructs a detokenizer that searches a `FlatTokenDatabase` in place.
+  /// Construction does not copy or parse the database, so the database's
+  /// memory must outlive the `Detokenizer`. Format strings are parsed the
+  /// first time their tokens are looked up, and kept for later lookups.
+  explicit Detokenizer(const FlatTokenDatabase& database)
+      : flat_database_(database),
+        flat_cache_(std::make_shared<FlatDatabaseCache>()) {}
+
   /// Constructs a detokenizer from the `.pw_tokenizer.entries` section of an
   /// ELF binary.
   static Result<Detokenizer> FromElfSection(span<const std::byte> elf_section);
@@ -207,8 +219,12 @@ class Detokenizer {
   std::string DecodeOptionallyTokenizedData(
       span<const std::byte> optionally_tokenized_data) const;
 
+  /// Returns the parsed database. Empty if the `Detokenizer` was constructed
+  /// from a `FlatTokenDatabase`.
   const DomainTokenEntriesMap& database() const { return database_; }
 
+  /// Returns the entries for a token in a domain. The entries remain valid for
+  /// the lifetime of the `Detokenizer`.
   span<const TokenizedStringEntry> DatabaseLookup(
       Token token, std::string_view domain) const;
 
@@ -227,7 +243,21 @@ class Detokenizer {
                                std::string_view domain,
                                bool recursion) const;
 
+  span<const TokenizedStringEntry> FlatDatabaseLookup(
+      Token token, std::string_view domain) const;
+
+  // Entries parsed from the flat database, keyed by canonical domain. Entries
+  // are never removed, so spans into them remain valid. Only tokens found in
+  // the database are added, so the cache is bounded by the database's size.
+  // This is shared so the Detokenizer stays copyable.
+  struct FlatDatabaseCache {
+    sync::Mutex mutex;
+    DomainTokenEntriesMap entries PW_GUARDED_BY(mutex);
+  };
+
   DomainTokenEntriesMap database_;
+  FlatTokenDatabase flat_database_;
+  std::shared_ptr<FlatDatabaseCache> flat_cache_;
 };
 
 /// @}
@@ -0,0 +1,210 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+#include "pw_tokenizer/token_database.h"
+#include "pw_tokenizer/tokenize.h"
+
+namespace pw::tokenizer {
+
+/// @submodule{pw_tokenizer,database}
+
+/// Reads entries from a flat binary token database. The flat format is sorted
+/// by domain and token, so it can be searched in place, for example directly
+/// from a memory-mapped file. This class does not copy or modify the contents
+/// of the database, and lookups do not allocate memory.
+///
+/// A flat token database is comprised of a 16-byte header, a table of 12-byte
+/// domain records, a table of 12-byte entry records, and a table of
+/// null-terminated strings. All fields are little-endian 32-bit integers, and
+/// all offsets are from the start of the database.
+///
+/// @code{.unparsed}
+///   ======  ====  =========================
+///   Header (16 bytes)
+///   ---------------------------------------
+///   Offset  Size  Field
+///   ======  ====  =========================
+///        0     6  Magic number (``TOKFLT``)
+///        6     2  Version (``00 00``)
+///        8     4  Domain count
+///       12     4  Entry count
+///   ======  ====  =========================
+///
+///   ======  ====  ==================================
+///   Domain (12 bytes)
+///   ------------------------------------------------
+///   Offset  Size  Field
+///   ======  ====  ==================================
+///        0     4  Offset of the domain name string
+///        4     4  Index of the domain's first entry
+///        8     4  Number of entries in the domain
+///   ======  ====  ==================================
+///
+///   ======  ====  ==================================
+///   Entry (12 bytes)
+///   ------------------------------------------------
+///   Offset  Size  Field
+///   ======  ====  ==================================
+///        0     4  Token
+///        4     4  Removal date (see TokenDatabase)
+///        8     4  Offset of the string
+///   ======  ====  ==================================
+/// @endcode
+///
+/// Domains are sorted by name. Each domain's entries are contiguous and sorted
+/// by token. Use `FlatTokenDatabaseBuilder` to create a flat database from
+/// other database formats.
+class FlatTokenDatabase {
+ public:
+  /// An entry in the token database. The string refers to the database's
+  /// memory.
+  struct Entry {
+    uint32_t token;
+    uint32_t date_removed;
+    std::string_view string;
+  };
+
+  /// The entries for a token, which are contiguous in the database.
+  class Entries {
+   public:
+    constexpr Entries() = default;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0u; }
+
+    Entry operator[](size_t index) const;
+
+   private:
+    friend class FlatTokenDatabase;
+
+    constexpr Entries(const FlatTokenDatabase& database,
+                      size_t first,
+                      size_t size)
+        : database_(&database), first_(first), size_(size) {}
+
+    const FlatTokenDatabase* database_ = nullptr;
+    size_t first_ = 0;
+    size_t size_ = 0;
+  };
+
+  static constexpr size_t kHeaderSize = 16;
+  static constexpr size_t kDomainSize = 12;
+  static constexpr size_t kEntrySize = 12;
+
+  /// Creates a `FlatTokenDatabase` from the provided data, which must outlive
+  /// the database. Checks that the header is valid and that every record is in
+  /// bounds. If the data is not valid, returns a default-constructed database
+  /// for which `ok()` is false.
+  static FlatTokenDatabase Create(span<const std::byte> data);
+
+  /// Creates a database with no data. `ok()` returns false.
+  constexpr FlatTokenDatabase() = default;
+
+  /// True if this database was constructed with valid data.
+  bool ok() const { return !data_.empty(); }
+
+  /// Returns the number of domains in the database.
+  size_t domain_count() const { return domain_count_; }
+
+  /// Returns the total number of entries in the database.
+  size_t size() const { return entry_count_; }
+
+  /// Returns the entries for a token in a domain. Whitespace in the domain is
+  /// ignored. Lookups are `O(log n)`.
+  Entries Find(std::string_view domain, uint32_t token) const;
+
+  /// Returns the entry at the provided index. Entries are in domain and token
+  /// order.
+  Entry entry(size_t index) const;
+
+ private:
+  struct DomainRecord {
+    std::string_view name;
+    size_t first_entry;
+    size_t entry_count;
+  };
+
+  uint32_t ReadUint32(size_t offset) const;
+
+  std::string_view ReadString(size_t offset) const;
+
+  DomainRecord domain(size_t index) const;
+
+  bool FindDomain(std::string_view domain, DomainRecord& result) const;
+
+  span<const std::byte> data_;
+  size_t domain_count_ = 0;
+  size_t entry_count_ = 0;
+};
+
+/// Builds a flat token database from entries in other database formats.
+///
+/// @code{.cpp}
+///
+///   FlatTokenDatabaseBuilder builder;
+///   builder.Add(TokenDatabase::Create(binary_database));
+///   PW_TRY(builder.AddCsv(csv_database));
+///   std::vector<std::byte> flat_database = builder.Build();
+///
+/// @endcode
+class FlatTokenDatabaseBuilder {
+ public:
+  /// Adds an entry. Whitespace in the domain is removed. Duplicate entries
+  /// with the same domain, token, and string are merged, keeping the latest
+  /// removal date.
+  void Add(std::string_view domain,
+           uint32_t token,
+           uint32_t date_removed,
+           std::string_view string);
+
+  /// Adds all entries in a binary token database to a domain.
+  void Add(const TokenDatabase& database,
+           std::string_view domain = kDefaultDomain);
+
+  /// Adds all entries in a CSV token database.
+  ///
+  /// @returns
+  /// * @OK: The entries were added.
+  /// * @DATA_LOSS: The CSV is corrupt. No entries were added.
+  Status AddCsv(std::string_view csv);
+
+  /// Returns the number of entries added, including duplicates.
+  size_t size() const { return entries_.size(); }
+
+  /// Encodes the entries as a flat token database.
+  std::vector<std::byte> Build() const;
+
+ private:
+  struct PendingEntry {
+    std::string domain;
+    uint32_t token;
+    uint32_t date_removed;
+    std::string string;
+  };
+
+  std::vector<PendingEntry> entries_;
+};
+
+/// @}
+
+}  // namespace pw::tokenizer
@@ -38,6 +38,26 @@
 #define PW_TRACE_QUEUE_SIZE_EVENTS 5
 #endif  // PW_TRACE_QUEUE_SIZE_EVENTS
 
+/// The number of per-thread event queues. When non-zero, each thread claims
+/// one of these queues the first time it traces an event, and then queues its
+/// events without taking a lock. Events are timestamped when they are queued,
+/// and events from all queues are merged by timestamp before they are passed to
+/// the sinks. Threads which are unable to claim a queue share a single queue
+/// which is protected by a lock.
+///
+/// This requires support for `thread_local` and `std::atomic`, and is intended
+/// for tracing multi-threaded host processes. When zero (the default), events
+/// from all threads are queued in a single queue of
+/// `PW_TRACE_QUEUE_SIZE_EVENTS` events protected by a lock.
+#ifndef PW_TRACE_CONFIG_THREAD_QUEUES
+#define PW_TRACE_CONFIG_THREAD_QUEUES 0
+#endif  // PW_TRACE_CONFIG_THREAD_QUEUES
+
+/// The number of events each per-thread queue can hold. Must be a power of two.
+#ifndef PW_TRACE_CONFIG_THREAD_QUEUE_SIZE_EVENTS
+#define PW_TRACE_CONFIG_THREAD_QUEUE_SIZE_EVENTS 16
+#endif  // PW_TRACE_CONFIG_THREAD_QUEUE_SIZE_EVENTS
+
 // --- Config options for time source ----
 
 /// The type for trace time.
@@ -28,6 +28,10 @@
 #endif  // __cplusplus
 #endif  // PW_TRACE_GET_TIME_DELTA
 
+#ifdef __cplusplus
+#include <atomic>
+#endif  // __cplusplus
+
 #include "pw_status/status.h"
 #include "pw_tokenizer/tokenize.h"
 #include "pw_trace_tokenized/config.h"
@@ -114,6 +118,83 @@ class TraceQueue {
       true;  // Used to distinquish if head==tail is empty or full
 };
 
+// Ring buffer with a single producer and a single consumer, which may be on
+// different threads. Neither side takes a lock; the producer publishes each
+// event by advancing `head_`, and the consumer releases it by advancing
+// `tail_`.
+template <size_t kSize>
+class ThreadTraceQueue {
+ public:
+  static_assert(kSize > 0 && (kSize & (kSize - 1)) == 0,
+                "The queue size must be a power of two");
+
+  struct QueueEventBlock {
+    uint32_t trace_token;
+    EventType event_type;
+    uint32_t trace_id;
+    uint32_t epoch;
+    PW_TRACE_TIME_TYPE trace_time;
+    size_t data_size;
+    std::byte data_buffer[PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES];
+  };
+
+  // Must only be called by the producer.
+  pw::Status TryPushBack(uint32_t trace_token,
+                         EventType event_type,
+                         uint32_t trace_id,
+                         uint32_t epoch,
+                         PW_TRACE_TIME_TYPE trace_time,
+                         const void* data_buffer,
+                         size_t data_size) {
+    if (data_size > PW_TRACE_BUFFER_MAX_DATA_SIZE_BYTES) {
+      return pw::Status::InvalidArgument();
+    }
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kSize) {
+      return pw::Status::ResourceExhausted();
+    }
+    QueueEventBlock& event = events_[head % kSize];
+    event.trace_token = trace_token;
+    event.event_type = event_type;
+    event.trace_id = trace_id;
+    event.epoch = epoch;
+    event.trace_time = trace_time;
+    event.data_size = data_size;
+    if (data_size > 0) {
+      memcpy(event.data_buffer, data_buffer, data_size);
+    }
+    head_.store(head + 1, std::memory_order_release);
+    return pw::OkStatus();
+  }
+
+  // Must only be called by the consumer.
+  const QueueEventBlock* PeekFront() const {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) {
+      return nullptr;
+    }
+    return &events_[tail % kSize];
+  }
+
+  // Must only be called by the consumer.
+  void PopFront() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) != tail) {
+      tail_.store(tail + 1, std::memory_order_release);
+    }
+  }
+
+  bool IsEmpty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::array<QueueEventBlock, kSize> events_;
+  std::atomic<size_t> head_ = 0;  // Number of events pushed
+  std::atomic<size_t> tail_ = 0;  // Number of events popped
+};
+
 }  // namespace internal
 
 /// @module{pw_trace_tokenized}
@@ -126,8 +207,14 @@ class TokenizedTracer {
   TokenizedTracer(Callbacks& callbacks) : callbacks_(callbacks) {}
   void Enable(bool enable) {
     if (enable != enabled_ && enable) {
+#if PW_TRACE_CONFIG_THREAD_QUEUES > 0
+      // The queues can't be cleared while other threads may be using them.
+      // Instead, events queued before this point are discarded when drained.
+      epoch_.fetch_add(1, std::memory_order_relaxed);
+#else
       event_queue_.Clear();
       last_trace_time_ = 0;
+#endif  // PW_TRACE_CONFIG_THREAD_QUEUES > 0
     }
     enabled_ = enable;
   }
@@ -145,11 +232,46 @@ class TokenizedTracer {
   using TraceQueue = internal::TraceQueue<PW_TRACE_QUEUE_SIZE_EVENTS>;
   PW_TRACE_TIME_TYPE last_trace_time_ = 0;
   bool enabled_ = false;
-  TraceQueue event_queue_;
   Callbacks& callbacks_;
 
+#if PW_TRACE_CONFIG_THREAD_QUEUES > 0
+  using ThreadQueue =
+      internal::ThreadTraceQueue<PW_TRACE_CONFIG_THREAD_QUEUE_SIZE_EVENTS>;
+
+  struct ThreadQueueSlot {
+    std::atomic<bool> claimed = false;
+    ThreadQueue queue;
+  };
+
+  // Returns the queue claimed by the calling thread, or null if every queue is
+  // claimed by another thread. Only the global tracer returned by
+  // GetTokenizedTracer() has per-thread queues; other tracers always return
+  // null and use the shared queue.
+  ThreadQueue* GetThreadQueue();
+
+  // Sends queued events to the sinks in timestamp order until every queue is
+  // empty. Must be called with the trace lock held.
+  void DrainThreadQueues();
+
+  std::array<ThreadQueueSlot, PW_TRACE_CONFIG_THREAD_QUEUES> thread_queues_;
+  // Used by threads which were unable to claim a queue. Only one of these
+  // threads may push to it at a time.
+  ThreadQueue shared_queue_;
+  std::atomic<uint32_t> epoch_ = 0;
+  uint32_t drained_epoch_ = 0;
+#else
+  TraceQueue event_queue_;
+
   void HandleNextItemInQueue(
       const volatile TraceQueue::QueueEventBlock* event_block);
+#endif  // PW_TRACE_CONFIG_THREAD_QUEUES > 0
+
+  void SendToSinks(uint32_t trace_token,
+                   EventType event_type,
+                   uint32_t trace_id,
+                   PW_TRACE_TIME_TYPE delta,
+                   const std::byte* data_buffer,
+                   size_t data_size);
 };
 
 /// @returns A reference of the global tokenized tracer
@@ -16,8 +16,10 @@
 
 #include "pw_trace/trace.h"
 
+#include <limits>
 #include <mutex>
 
+#include "pw_memory/no_destructor.h"
 #include "pw_preprocessor/util.h"
 #include "pw_trace_tokenized/internal/lock.h"
 #include "pw_trace_tokenized/trace_callback.h"
@@ -38,8 +40,10 @@ Callbacks& GetCallbacks() {
 }
 
 TokenizedTracer& GetTokenizedTracer() {
-  static TokenizedTracer tokenized_tracer(GetCallbacks());
-  return tokenized_tracer;
+  // Never destroyed, so threads that exit during or after static destruction
+  // can still release their per-thread queues.
+  static NoDestructor<TokenizedTracer> tokenized_tracer(GetCallbacks());
+  return *tokenized_tracer;
 }
 
 using TraceEvent = pw_trace_tokenized_TraceEvent;
@@ -85,6 +89,40 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     return;
   }
 
+#if PW_TRACE_CONFIG_THREAD_QUEUES > 0
+  const uint32_t epoch = epoch_.load(std::memory_order_relaxed);
+  const PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
+  // If the queue is full the sample is dropped.
+  if (ThreadQueue* queue = GetThreadQueue(); queue != nullptr) {
+    queue
+        ->TryPushBack(event.trace_token,
+                      event.event_type,
+                      event.trace_id,
+                      epoch,
+                      trace_time,
+                      event.data_buffer,
+                      event.data_size)
+        .IgnoreError();
+  } else {
+    std::lock_guard lock(trace_queue_lock);
+    shared_queue_
+        .TryPushBack(event.trace_token,
+                     event.event_type,
+                     event.trace_id,
+                     epoch,
+                     trace_time,
+                     event.data_buffer,
+                     event.data_size)
+        .IgnoreError();
+  }
+
+  // Try to empty the queues if they are not already being emptied. If another
+  // thread is emptying them, it sends this sample too.
+  if (trace_lock.try_lock()) {
+    DrainThreadQueues();
+    trace_lock.unlock();
+  }
+#else
   {
     std::lock_guard lock(trace_queue_lock);
     // Create trace event
@@ -112,6 +150,7 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
     }
     trace_lock.unlock();
   }
+#endif  // PW_TRACE_CONFIG_THREAD_QUEUES > 0
 
   // Disable after processing if an event callback had set the flag.
   if (PW_TRACE_EVENT_RETURN_FLAGS_DISABLE_AFTER_PROCESSING & ret_flags) {
@@ -119,16 +158,148 @@ void TokenizedTracer::HandleTraceEvent(uint32_t trace_token,
   }
 }
 
+#if PW_TRACE_CONFIG_THREAD_QUEUES > 0
+
+TokenizedTracer::ThreadQueue* TokenizedTracer::GetThreadQueue() {
+  // A thread's claim outlives any tracer except the global one, which is never
+  // destroyed, so other tracers only use the shared queue.
+  if (this != &GetTokenizedTracer()) {
+    return nullptr;
+  }
+
+  // Each thread tries to claim a queue the first time it traces an event, and
+  // releases it when the thread exits.
+  struct Claim {
+    ~Claim() {
+      if (claimed) {
+        GetTokenizedTracer().thread_queues_[index].claimed.store(
+            false, std::memory_order_release);
+      }
+    }
+
+    size_t index = 0;
+    bool claimed = false;
+    bool attempted = false;
+  };
+  static thread_local Claim claim;
+
+  if (claim.claimed) {
+    return &thread_queues_[claim.index].queue;
+  }
+  if (claim.attempted) {
+    return nullptr;
+  }
+  claim.attempted = true;
+  for (size_t i = 0; i < thread_queues_.size(); ++i) {
+    bool expected = false;
+    if (thread_queues_[i].claimed.compare_exchange_strong(
+            expected, true, std::memory_order_acquire)) {
+      claim.index = i;
+      claim.claimed = true;
+      return &thread_queues_[i].queue;
+    }
+  }
+  return nullptr;
+}
+
+void TokenizedTracer::DrainThreadQueues() {
+  const uint32_t epoch = epoch_.load(std::memory_order_relaxed);
+  if (epoch != drained_epoch_) {
+    drained_epoch_ = epoch;
+    last_trace_time_ = 0;
+  }
+
+  // Returns the time elapsed between the last event sent and `trace_time`. An
+  // event may be queued after an event with a later timestamp from another
+  // thread has already been sent; no time has elapsed for such an event.
+  auto time_since_last_event = [this](PW_TRACE_TIME_TYPE trace_time) {
+    if (last_trace_time_ == 0) {
+      return trace_time;
+    }
+    PW_TRACE_TIME_TYPE delta =
+        PW_TRACE_GET_TIME_DELTA(last_trace_time_, trace_time);
+    if (delta > std::numeric_limits<PW_TRACE_TIME_TYPE>::max() / 2) {
+      return PW_TRACE_TIME_TYPE{0};
+    }
+    return delta;
+  };
+
+  // Returns the next event from `queue` which was queued since tracing was
+  // last enabled.
+  auto peek_front = [epoch](ThreadQueue& queue) {
+    const ThreadQueue::QueueEventBlock* event = queue.PeekFront();
+    while (event != nullptr && event->epoch != epoch) {
+      queue.PopFront();
+      event = queue.PeekFront();
+    }
+    return event;
+  };
+
+  while (true) {
+    ThreadQueue* next_queue = nullptr;
+    const ThreadQueue::QueueEventBlock* next_event = nullptr;
+    PW_TRACE_TIME_TYPE next_delta = 0;
+    auto consider = [&](ThreadQueue& queue) {
+      const ThreadQueue::QueueEventBlock* event = peek_front(queue);
+      if (event == nullptr) {
+        return;
+      }
+      PW_TRACE_TIME_TYPE delta = time_since_last_event(event->trace_time);
+      if (next_event == nullptr || delta < next_delta) {
+        next_queue = &queue;
+        next_event = event;
+        next_delta = delta;
+      }
+    };
+    for (ThreadQueueSlot& slot : thread_queues_) {
+      consider(slot.queue);
+    }
+    consider(shared_queue_);
+
+    if (next_event == nullptr) {
+      return;
+    }
+    if (next_delta != 0) {
+      last_trace_time_ = next_event->trace_time;
+    }
+    SendToSinks(next_event->trace_token,
+                next_event->event_type,
+                next_event->trace_id,
+                next_delta,
+                next_event->data_buffer,
+                next_event->data_size);
+    next_queue->PopFront();
+  }
+}
+
+#else
+
 void TokenizedTracer::HandleNextItemInQueue(
     const volatile TraceQueue::QueueEventBlock* event_block) {
-  // Get next item in queue
-  uint32_t trace_token = event_block->trace_token;
-  EventType event_type = event_block->event_type;
-  uint32_t trace_id = event_block->trace_id;
-  const std::byte* data_buffer =
-      const_cast<const std::byte*>(event_block->data_buffer);
-  size_t data_size = event_block->data_size;
+  // Compute delta of time elapsed since last trace entry.
+  PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
+  PW_TRACE_TIME_TYPE delta =
+      (last_trace_time_ == 0)
+          ? trace_time
+          : PW_TRACE_GET_TIME_DELTA(last_trace_time_, trace_time);
+  last_trace_time_ = trace_time;
+
+  SendToSinks(event_block->trace_token,
+              event_block->event_type,
+              event_block->trace_id,
+              delta,
+              const_cast<const std::byte*>(event_block->data_buffer),
+              event_block->data_size);
+}
+
+#endif  // PW_TRACE_CONFIG_THREAD_QUEUES > 0
 
+void TokenizedTracer::SendToSinks(uint32_t trace_token,
+                                  EventType event_type,
+                                  uint32_t trace_id,
+                                  PW_TRACE_TIME_TYPE delta,
+                                  const std::byte* data_buffer,
+                                  size_t data_size) {
   // Create header to store trace info
   static constexpr size_t kMaxHeaderSize =
       sizeof(trace_token) + pw::varint::kMaxVarint64SizeBytes +  // time
@@ -137,16 +308,9 @@ void TokenizedTracer::HandleNextItemInQueue(
   memcpy(header, &trace_token, sizeof(trace_token));
   size_t header_size = sizeof(trace_token);
 
-  // Compute delta of time elapsed since last trace entry.
-  PW_TRACE_TIME_TYPE trace_time = pw_trace_GetTraceTime();
-  PW_TRACE_TIME_TYPE delta =
-      (last_trace_time_ == 0)
-          ? trace_time
-          : PW_TRACE_GET_TIME_DELTA(last_trace_time_, trace_time);
   header_size += pw::varint::Encode(
       delta,
       span<std::byte>(&header[header_size], kMaxHeaderSize - header_size));
-  last_trace_time_ = trace_time;
 
   // Calculate packet id if needed.
   if (PW_TRACE_HAS_TRACE_ID(event_type)) {
@@ -158,8 +322,7 @@ void TokenizedTracer::HandleNextItemInQueue(
   // Send encoded output to any registered trace sinks.
   callbacks_.CallSinks(
       span<const std::byte>(header, header_size),
-      span<const std::byte>(reinterpret_cast<const std::byte*>(data_buffer),
-                            data_size));
+      span<const std::byte>(data_buffer, data_size));
 }
 
 pw_trace_TraceEventReturnFlags Callbacks::CallEventCallbacks(
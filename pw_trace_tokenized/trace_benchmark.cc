@@ -0,0 +1,111 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Measures the overhead of tracing an event when one or more threads trace
+// events at the same time. The events are passed to a sink that discards them,
+// so the results include the cost of sending events to the sinks but not the
+// cost of storing them.
+
+#define PW_TRACE_MODULE_NAME "BENCH"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_chrono/system_clock.h"
+#include "pw_log/log.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_thread_stl/options.h"
+#include "pw_trace/trace.h"
+#include "pw_trace_tokenized/trace_callback.h"
+#include "pw_trace_tokenized/trace_tokenized.h"
+
+namespace pw::trace {
+namespace {
+
+constexpr size_t kMaxThreads = 8;
+constexpr size_t kEventsPerThread = 100000;
+
+// Counts the events passed to the sinks. Sinks are only called by one thread
+// at a time.
+size_t events_received = 0;
+
+void SinkStartBlock(void*, size_t) {}
+void SinkAddBytes(void*, const void*, size_t) {}
+void SinkEndBlock(void*) { ++events_received; }
+
+/// Traces `kEventsPerThread` instant events.
+class TracerThreadCore : public thread::ThreadCore {
+ private:
+  void Run() override {
+    for (size_t i = 0; i < kEventsPerThread; ++i) {
+      PW_TRACE_INSTANT("Event");
+    }
+  }
+};
+
+/// Traces events from `num_threads` threads at once, and logs the results.
+void MeasureEvents(size_t num_threads) {
+  std::array<TracerThreadCore, kMaxThreads> tracers;
+  events_received = 0;
+  auto begin = chrono::SystemClock::now();
+  {
+    std::array<Thread, kMaxThreads> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads[i] = Thread(thread::stl::Options(), tracers[i]);
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads[i].join();
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      chrono::SystemClock::now() - begin);
+
+  size_t num_events = num_threads * kEventsPerThread;
+  auto ns = static_cast<uint64_t>(elapsed.count());
+  PW_LOG_INFO("%u thread(s): %5u ns/event, %9u events/s, %u dropped",
+              static_cast<unsigned>(num_threads),
+              static_cast<unsigned>(ns / num_events),
+              static_cast<unsigned>((num_events * 1000000000ull) / ns),
+              static_cast<unsigned>(num_events - events_received));
+}
+
+void DoTraceBenchmark() {
+  PW_LOG_INFO("Per-thread queues: %u",
+              static_cast<unsigned>(PW_TRACE_CONFIG_THREAD_QUEUES));
+  Callbacks::SinkHandle sink;
+  if (!GetCallbacks()
+           .RegisterSink(
+               SinkStartBlock, SinkAddBytes, SinkEndBlock, nullptr, &sink)
+           .ok()) {
+    PW_LOG_ERROR("Failed to register the trace sink");
+    return;
+  }
+  PW_TRACE_SET_ENABLED(true);
+  for (size_t num_threads = 1; num_threads <= kMaxThreads; num_threads *= 2) {
+    MeasureEvents(num_threads);
+  }
+  PW_TRACE_SET_ENABLED(false);
+  GetCallbacks().UnregisterSink(sink).IgnoreError();
+}
+
+}  // namespace
+}  // namespace pw::trace
+
+int main() {
+  pw::trace::DoTraceBenchmark();
+  return 0;
+}
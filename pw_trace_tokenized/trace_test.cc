@@ -695,6 +695,63 @@ TEST(TokenizedTrace, Clear) {
   EXPECT_FALSE(queue.IsFull());
 }
 
+pw::Status PushThreadQueueEvent(
+    pw::trace::internal::ThreadTraceQueue<4>& queue, uint32_t num) {
+  return queue.TryPushBack(num,
+                           static_cast<pw_trace_EventType>(num % 10),
+                           /*trace_id=*/num,
+                           /*epoch=*/num,
+                           /*trace_time=*/num,
+                           kTestData,
+                           num % PW_ARRAY_SIZE(kTestData));
+}
+
+bool CheckThreadQueueEvent(
+    const pw::trace::internal::ThreadTraceQueue<4>::QueueEventBlock* event,
+    uint32_t num) {
+  return event != nullptr && event->trace_token == num &&
+         event->event_type == static_cast<pw_trace_EventType>(num % 10) &&
+         event->trace_id == num && event->epoch == num &&
+         event->trace_time == num &&
+         event->data_size == num % PW_ARRAY_SIZE(kTestData) &&
+         memcmp(event->data_buffer, kTestData, event->data_size) == 0;
+}
+
+TEST(TokenizedTrace, ThreadQueueSimple) {
+  pw::trace::internal::ThreadTraceQueue<4> queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  ASSERT_EQ(PushThreadQueueEvent(queue, 3), pw::OkStatus());
+  EXPECT_FALSE(queue.IsEmpty());
+  EXPECT_TRUE(CheckThreadQueueEvent(queue.PeekFront(), 3));
+  queue.PopFront();
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_TRUE(queue.PeekFront() == nullptr);
+}
+
+TEST(TokenizedTrace, ThreadQueueFullAndWrapsAround) {
+  pw::trace::internal::ThreadTraceQueue<4> queue;
+  uint32_t next_push = 0;
+  uint32_t next_pop = 0;
+  for (int round = 0; round < 3; round++) {
+    while (PushThreadQueueEvent(queue, next_push).ok()) {
+      next_push++;
+    }
+    EXPECT_EQ(next_push - next_pop, 4u);
+    // Free some space, then fill the queue again.
+    for (int i = 0; i < 3; i++) {
+      EXPECT_TRUE(CheckThreadQueueEvent(queue.PeekFront(), next_pop));
+      queue.PopFront();
+      next_pop++;
+    }
+  }
+  while (!queue.IsEmpty()) {
+    EXPECT_TRUE(CheckThreadQueueEvent(queue.PeekFront(), next_pop));
+    queue.PopFront();
+    next_pop++;
+  }
+  EXPECT_EQ(next_push, next_pop);
+}
+
 // Define these functions here so __LINE__ is accurate in the tests above.
 #line TRACE_LINE
 void TraceFunction() { PW_TRACE_FUNCTION(); }
@@ -0,0 +1,186 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Tests tracing from several threads at once. Built with
+// PW_TRACE_CONFIG_THREAD_QUEUES set to fewer queues than there are threads, so
+// that both the per-thread queues and the shared queue are used.
+
+#define PW_TRACE_MODULE_NAME "TST"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pw_thread/test_thread_context.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_thread/yield.h"
+#include "pw_trace/trace.h"
+#include "pw_trace_tokenized/trace_callback.h"
+#include "pw_trace_tokenized/trace_tokenized.h"
+#include "pw_unit_test/framework.h"
+#include "pw_varint/varint.h"
+
+namespace pw::trace {
+namespace {
+
+constexpr size_t kThreads = 4;
+constexpr uint32_t kEventsPerThread = 500;
+
+static_assert(kThreads > PW_TRACE_CONFIG_THREAD_QUEUES,
+              "Some threads must share a queue");
+
+// Decodes the events sent to the sink. Sinks are called by one thread at a
+// time, so no synchronization is needed.
+class EventRecorder {
+ public:
+  static constexpr uint32_t kNoTraceId = 0xFFFFFFFF;
+
+  struct Event {
+    uint32_t trace_id;
+    PW_TRACE_TIME_TYPE trace_time;
+  };
+
+  EventRecorder() {
+    EXPECT_EQ(OkStatus(),
+              GetCallbacks().RegisterSink(
+                  StartBlock, AddBytes, nullptr, this, &sink_handle_));
+  }
+
+  ~EventRecorder() {
+    EXPECT_EQ(OkStatus(), GetCallbacks().UnregisterSink(sink_handle_));
+  }
+
+  const std::vector<Event>& events() const { return events_; }
+
+ private:
+  static void StartBlock(void* user_data, size_t) {
+    static_cast<EventRecorder*>(user_data)->header_received_ = false;
+  }
+
+  // The header is passed first. It contains the token, the time since the
+  // previous event, and the trace ID if the event has one.
+  static void AddBytes(void* user_data, const void* bytes, size_t size) {
+    auto& recorder = *static_cast<EventRecorder*>(user_data);
+    if (recorder.header_received_) {
+      return;
+    }
+    recorder.header_received_ = true;
+
+    span<const std::byte> header(static_cast<const std::byte*>(bytes), size);
+    header = header.subspan(sizeof(uint32_t));
+    uint64_t delta;
+    size_t length = varint::Decode(header, &delta);
+    ASSERT_NE(length, 0u);
+    header = header.subspan(length);
+    uint64_t trace_id = kNoTraceId;
+    if (!header.empty()) {
+      ASSERT_NE(varint::Decode(header, &trace_id), 0u);
+    }
+
+    // The first event since tracing was enabled has an absolute time.
+    recorder.trace_time_ += static_cast<PW_TRACE_TIME_TYPE>(delta);
+    recorder.events_.push_back(
+        {static_cast<uint32_t>(trace_id), recorder.trace_time_});
+  }
+
+  Callbacks::SinkHandle sink_handle_;
+  bool header_received_ = false;
+  PW_TRACE_TIME_TYPE trace_time_ = 0;
+  std::vector<Event> events_;
+};
+
+// Traces kEventsPerThread events with IDs that identify the thread and the
+// order of the events.
+class TracingThread : public thread::ThreadCore {
+ public:
+  static constexpr uint32_t kIndexShift = 16;
+
+  void Initialize(uint32_t index, std::atomic<size_t>& started) {
+    index_ = index;
+    started_ = &started;
+  }
+
+ private:
+  void Run() override {
+    PW_TRACE_INSTANT("Thread event", "Threads", index_ << kIndexShift);
+
+    // Wait until every thread has traced an event, so that the threads hold
+    // their queues at the same time.
+    started_->fetch_add(1);
+    while (started_->load() < kThreads) {
+      this_thread::yield();
+    }
+
+    for (uint32_t i = 1; i < kEventsPerThread; ++i) {
+      PW_TRACE_INSTANT("Thread event", "Threads", (index_ << kIndexShift) | i);
+    }
+  }
+
+  uint32_t index_ = 0;
+  std::atomic<size_t>* started_ = nullptr;
+};
+
+TEST(TokenizedTraceThreadQueues, EventsFromEachThreadStayInOrder) {
+  PW_TRACE_SET_ENABLED(false);
+  EventRecorder recorder;
+  PW_TRACE_SET_ENABLED(true);
+  const PW_TRACE_TIME_TYPE start_time = pw_trace_GetTraceTime();
+
+  std::atomic<size_t> started = 0;
+  std::array<TracingThread, kThreads> cores;
+  std::array<thread::test::TestThreadContext, kThreads> contexts;
+  std::array<Thread, kThreads> threads;
+  for (uint32_t i = 0; i < kThreads; ++i) {
+    cores[i].Initialize(i, started);
+    threads[i] = Thread(contexts[i].options(), cores[i]);
+  }
+  for (Thread& thread : threads) {
+    thread.join();
+  }
+
+  // Events may remain queued if another thread was sending events when they
+  // were added. Tracing another event sends them.
+  PW_TRACE_INSTANT("Flush");
+  const PW_TRACE_TIME_TYPE end_time = pw_trace_GetTraceTime();
+  PW_TRACE_SET_ENABLED(false);
+
+  // Events may be dropped if a queue is full, but events from each thread must
+  // be sent in the order they were traced.
+  std::array<uint32_t, kThreads> next_event{};
+  PW_TRACE_TIME_TYPE last_time = start_time;
+  size_t thread_events = 0;
+  for (const EventRecorder::Event& event : recorder.events()) {
+    EXPECT_GE(event.trace_time, last_time);
+    EXPECT_LE(event.trace_time, end_time);
+    last_time = event.trace_time;
+
+    if (event.trace_id == EventRecorder::kNoTraceId) {
+      continue;  // The flush event.
+    }
+    const uint32_t index = event.trace_id >> TracingThread::kIndexShift;
+    ASSERT_LT(index, kThreads);
+    const uint32_t sequence =
+        event.trace_id & ((1u << TracingThread::kIndexShift) - 1);
+    EXPECT_GE(sequence, next_event[index]);
+    next_event[index] = sequence + 1;
+    thread_events += 1;
+  }
+  EXPECT_GT(thread_events, 0u);
+}
+
+}  // namespace
+}  // namespace pw::trace
@@ -201,6 +201,23 @@ constexpr size_t Decode(ConstByteSpan encoded, T* out_value);
 size_t Decode(ConstByteSpan encoded, uint64_t* out_value, Format format);
 /// @}
 
+/// Decodes consecutive varints, such as the contents of a packed repeated
+/// protobuf field, into `out_values`. If reading into signed integers, the
+/// values are ZigZag decoded.
+///
+/// Decoding stops when `encoded` is exhausted, when `out_values` is full, or at
+/// a varint that `Decode` cannot decode. `out_bytes_read` is set to the number
+/// of bytes decoded, so all of `encoded` was decoded if it equals
+/// `encoded.size()`.
+///
+/// Runs of single-byte varints are decoded eight bytes at a time.
+///
+/// @returns The number of values written to `out_values`.
+template <typename T>
+constexpr size_t DecodePacked(ConstByteSpan encoded,
+                              span<T> out_values,
+                              size_t* out_bytes_read);
+
 /// Decodes one byte of an LEB128-encoded integer to a `uint32_t`.
 /// @returns true if there is more data to decode (top bit is set).
 template <typename T>
@@ -308,10 +325,97 @@ namespace pw::varint {
 
 namespace internal {
 
+// Loads eight bytes as a little-endian word. Compilers merge the byte loads
+// into a single load, and unlike memcpy this works in constant expressions.
+constexpr uint64_t LoadWord(const std::byte* bytes) {
+  return static_cast<uint64_t>(bytes[0]) |
+         static_cast<uint64_t>(bytes[1]) << 8 |
+         static_cast<uint64_t>(bytes[2]) << 16 |
+         static_cast<uint64_t>(bytes[3]) << 24 |
+         static_cast<uint64_t>(bytes[4]) << 32 |
+         static_cast<uint64_t>(bytes[5]) << 40 |
+         static_cast<uint64_t>(bytes[6]) << 48 |
+         static_cast<uint64_t>(bytes[7]) << 56;
+}
+
+// Bits that are set in each byte of a word that continues a varint.
+inline constexpr uint64_t kContinuationBits = 0x8080808080808080u;
+
+// Packs the 7-bit groups of the first `count` (1-8) bytes of a word into an
+// integer, without looping over the bytes.
+constexpr uint64_t CompactWord(uint64_t word, size_t count) {
+  if (count < sizeof(word)) {
+    word &= (uint64_t{1} << (8 * count)) - 1;
+  }
+  word &= ~kContinuationBits;
+  // Merge adjacent groups: 7 bits per byte, 14 bits per 16-bit lane, 28 bits
+  // per 32-bit lane, then 56 bits.
+  word = ((word & 0x7f007f007f007f00u) >> 1) | (word & 0x007f007f007f007fu);
+  word = ((word & 0x3fff00003fff0000u) >> 2) | (word & 0x00003fff00003fffu);
+  word = ((word & 0x0fffffff00000000u) >> 4) | (word & 0x000000000fffffffu);
+  return word;
+}
+
+// Decodes a varint from the start of a word. Returns 0 if the varint does not
+// end within the word or is longer than max_count bytes.
+template <typename U>
+constexpr size_t DecodeFromWord(uint64_t word,
+                                U* out_uvalue,
+                                size_t max_count) {
+  const uint64_t last_bytes = ~word & kContinuationBits;
+  if (last_bytes == 0u) {
+    return 0;
+  }
+  const size_t count =
+      static_cast<size_t>(cpp20::countr_zero(last_bytes)) / 8 + 1;
+  if (count > max_count) {
+    return 0;
+  }
+  *out_uvalue = static_cast<U>(CompactWord(word, count));
+  return count;
+}
+
+// The unsigned type that a T is decoded to before it is converted.
+template <typename T>
+using DecodedUnsigned = std::conditional_t<sizeof(T) == sizeof(uint32_t),
+                                           uint_fast32_t,
+                                           uint_fast64_t>;
+
+template <typename T>
+inline constexpr size_t kMaxDecodedSizeBytes =
+    sizeof(T) <= sizeof(uint32_t) ? kMaxVarint32SizeBytes
+                                  : kMaxVarint64SizeBytes;
+
+template <typename T, typename U>
+constexpr T FromDecodedUnsigned(U uvalue) {
+  if constexpr (std::is_signed_v<T>) {
+    return static_cast<T>(ZigZagDecode(uvalue));
+  } else {
+    return static_cast<T>(uvalue);
+  }
+}
+
 template <typename U>
 constexpr size_t DecodeUnsigned(ConstByteSpan encoded,
                                 U* out_uvalue,
                                 size_t max_count) {
+  // Most varints are a single byte.
+  if (!encoded.empty() && (encoded[0] & std::byte{0x80}) == std::byte{0}) {
+    *out_uvalue = static_cast<U>(encoded[0]);
+    return 1;
+  }
+
+  // If eight bytes are available, find the end of the varint from the
+  // continuation bits of the whole word. This covers values up to 56 bits;
+  // larger ones are decoded one byte at a time.
+  if (encoded.size() >= sizeof(uint64_t)) {
+    const size_t count =
+        DecodeFromWord(LoadWord(encoded.data()), out_uvalue, max_count);
+    if (count != 0u) {
+      return count;
+    }
+  }
+
   max_count = std::min(encoded.size(), max_count);
   size_t count = 0;
   bool keep_going = true;
@@ -389,21 +493,63 @@ constexpr size_t EncodeLittleEndianBase128(uint64_t value,
 template <typename T>
 constexpr size_t Decode(ConstByteSpan encoded, T* out_value) {
   static_assert(sizeof(T) >= sizeof(uint32_t));
-  using U = std::conditional_t<sizeof(T) == sizeof(uint32_t),
-                               uint_fast32_t,
-                               uint_fast64_t>;
-  U uvalue = 0u;
-  size_t max_count = sizeof(T) <= sizeof(uint32_t) ? kMaxVarint32SizeBytes
-                                                   : kMaxVarint64SizeBytes;
-  size_t count = internal::DecodeUnsigned(encoded, &uvalue, max_count);
-  if constexpr (std::is_signed_v<T>) {
-    *out_value = static_cast<T>(ZigZagDecode(uvalue));
-  } else {
-    *out_value = static_cast<T>(uvalue);
-  }
+  internal::DecodedUnsigned<T> uvalue = 0u;
+  size_t count = internal::DecodeUnsigned(
+      encoded, &uvalue, internal::kMaxDecodedSizeBytes<T>);
+  *out_value = internal::FromDecodedUnsigned<T>(uvalue);
   return count;
 }
 
+template <typename T>
+constexpr size_t DecodePacked(ConstByteSpan encoded,
+                              span<T> out_values,
+                              size_t* out_bytes_read) {
+  static_assert(sizeof(T) >= sizeof(uint32_t));
+  using U = internal::DecodedUnsigned<T>;
+  size_t read = 0;
+  size_t written = 0;
+  while (read < encoded.size() && written < out_values.size()) {
+    const ConstByteSpan remaining = encoded.subspan(read);
+    if (remaining.size() >= sizeof(uint64_t)) {
+      const uint64_t word = internal::LoadWord(remaining.data());
+
+      // Eight single-byte varints can be copied out of a word without decoding.
+      if ((word & internal::kContinuationBits) == 0u &&
+          out_values.size() - written >= sizeof(word)) {
+        for (size_t i = 0; i < sizeof(word); ++i) {
+          out_values[written++] = internal::FromDecodedUnsigned<T>(
+              static_cast<U>((word >> (8 * i)) & 0xffu));
+        }
+        read += sizeof(word);
+        continue;
+      }
+
+      U uvalue = 0u;
+      size_t count = 1;
+      if ((word & 0x80u) == 0u) {
+        uvalue = static_cast<U>(word & 0x7fu);
+      } else {
+        count = internal::DecodeFromWord(
+            word, &uvalue, internal::kMaxDecodedSizeBytes<T>);
+      }
+      if (count != 0u) {
+        out_values[written++] = internal::FromDecodedUnsigned<T>(uvalue);
+        read += count;
+        continue;
+      }
+    }
+
+    const size_t count = Decode(remaining, &out_values[written]);
+    if (count == 0u) {
+      break;
+    }
+    read += count;
+    written += 1;
+  }
+  *out_bytes_read = read;
+  return written;
+}
+
 template <typename T>
 [[nodiscard]] constexpr bool DecodeOneByte(std::byte encoded,
                                            size_t count,
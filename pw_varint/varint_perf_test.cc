@@ -0,0 +1,136 @@
+// Copyright 2025 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_perf_test/perf_test.h"
+#include "pw_span/span.h"
+#include "pw_varint/varint.h"
+
+// Compares decoding a buffer of varints one byte at a time, one varint at a
+// time with Decode(), and in bulk with DecodePacked(), for several
+// distributions of value sizes.
+
+namespace pw::varint {
+namespace {
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__clang__) || defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  // Fallback if not GCC/Clang
+  static_cast<void>(value);
+#endif
+}
+
+constexpr size_t kValues = 256;
+
+struct EncodedValues {
+  std::array<std::byte, kValues * kMaxVarint64SizeBytes> buffer{};
+  size_t size = 0;
+
+  constexpr ConstByteSpan bytes() const { return span(buffer).first(size); }
+};
+
+// Encodes kValues pseudo-random values with up to max_bits significant bits.
+// The number of bits is chosen uniformly, so encoded sizes are spread evenly
+// from one byte to the maximum for max_bits.
+constexpr EncodedValues Generate(uint32_t max_bits) {
+  EncodedValues values;
+  uint64_t state = 0x9e3779b97f4a7c15u;
+  for (size_t i = 0; i < kValues; ++i) {
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    const uint32_t bits = static_cast<uint32_t>(state % (max_bits + 1));
+    const uint64_t value = bits == 0 ? 0 : state >> (64 - bits);
+    values.size += Encode(value, span(values.buffer).subspan(values.size));
+  }
+  return values;
+}
+
+// Single-byte values, such as small sensor readings or enums.
+constexpr EncodedValues kSmall = Generate(7);
+
+// Values of up to 32 bits, which encode to one to five bytes.
+constexpr EncodedValues kMixed32 = Generate(32);
+
+// Values of up to 64 bits, which encode to one to ten bytes.
+constexpr EncodedValues kMixed64 = Generate(64);
+
+// Decodes one byte per iteration, as Decode() did before it read whole words.
+size_t DecodeByteAtATime(ConstByteSpan encoded, uint64_t* out_value) {
+  uint64_t value = 0;
+  const size_t max_count = std::min(encoded.size(), kMaxVarint64SizeBytes);
+  for (size_t count = 0; count < max_count; ++count) {
+    if (!DecodeOneByte(encoded[count], count, &value)) {
+      *out_value = value;
+      return count + 1;
+    }
+  }
+  return 0;
+}
+
+void ByteAtATime(perf_test::State& state, const EncodedValues& values) {
+  std::array<uint64_t, kValues> decoded;
+  while (state.KeepRunning()) {
+    ConstByteSpan encoded = values.bytes();
+    for (uint64_t& value : decoded) {
+      encoded = encoded.subspan(DecodeByteAtATime(encoded, &value));
+    }
+    DoNotOptimize(decoded);
+  }
+}
+
+void DecodeEach(perf_test::State& state, const EncodedValues& values) {
+  std::array<uint64_t, kValues> decoded;
+  while (state.KeepRunning()) {
+    ConstByteSpan encoded = values.bytes();
+    for (uint64_t& value : decoded) {
+      encoded = encoded.subspan(Decode(encoded, &value));
+    }
+    DoNotOptimize(decoded);
+  }
+}
+
+void DecodeAll(perf_test::State& state, const EncodedValues& values) {
+  std::array<uint64_t, kValues> decoded;
+  while (state.KeepRunning()) {
+    size_t bytes_read;
+    DoNotOptimize(
+        DecodePacked(values.bytes(), span<uint64_t>(decoded), &bytes_read));
+    DoNotOptimize(decoded);
+  }
+}
+
+PW_PERF_TEST(ByteAtATimeSmall, ByteAtATime, kSmall);
+PW_PERF_TEST(DecodeSmall, DecodeEach, kSmall);
+PW_PERF_TEST(DecodePackedSmall, DecodeAll, kSmall);
+
+PW_PERF_TEST(ByteAtATimeMixed32, ByteAtATime, kMixed32);
+PW_PERF_TEST(DecodeMixed32, DecodeEach, kMixed32);
+PW_PERF_TEST(DecodePackedMixed32, DecodeAll, kMixed32);
+
+PW_PERF_TEST(ByteAtATimeMixed64, ByteAtATime, kMixed64);
+PW_PERF_TEST(DecodeMixed64, DecodeEach, kMixed64);
+PW_PERF_TEST(DecodePackedMixed64, DecodeAll, kMixed64);
+
+}  // namespace
+}  // namespace pw::varint
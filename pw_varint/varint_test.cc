@@ -19,6 +19,7 @@
 #include <cstring>
 #include <limits>
 
+#include "pw_bytes/array.h"
 #include "pw_fuzzer/fuzztest.h"
 #include "pw_unit_test/constexpr.h"
 #include "pw_unit_test/framework.h"
@@ -772,6 +773,93 @@ TEST(Varint, DecodeSigned64_MultiByte_C) {
   EXPECT_EQ(value, std::numeric_limits<int64_t>::max());
 }
 
+PW_CONSTEXPR_TEST(Varint, Decode_WordAtATime, {
+  // Decode from the whole buffer so at least eight bytes are available.
+  std::byte buffer[16] = {};
+  uint64_t value = 0;
+
+  Write("\x96\x01\xff", buffer);
+  PW_TEST_EXPECT_EQ(Decode(buffer, &value), 2u);
+  PW_TEST_EXPECT_EQ(value, 150u);
+
+  Write("\xff\xff\xff\xff\xff\xff\xff\x7f", buffer);
+  PW_TEST_EXPECT_EQ(Decode(buffer, &value), 8u);
+  PW_TEST_EXPECT_EQ(value, (uint64_t{1} << 56) - 1);
+
+  Write("\xff\xff\xff\xff\xff\xff\xff\xff\x7f", buffer);
+  PW_TEST_EXPECT_EQ(Decode(buffer, &value), 9u);
+  PW_TEST_EXPECT_EQ(value, uint64_t{std::numeric_limits<int64_t>::max()});
+
+  uint32_t value32 = 0;
+  Write("\xff\xff\xff\xff\x0f", buffer);
+  PW_TEST_EXPECT_EQ(Decode(buffer, &value32), 5u);
+  PW_TEST_EXPECT_EQ(value32, std::numeric_limits<uint32_t>::max());
+
+  // A 32-bit varint may not be longer than five bytes.
+  Write("\x80\x80\x80\x80\x80\x01", buffer);
+  PW_TEST_EXPECT_EQ(Decode(buffer, &value32), 0u);
+});
+
+PW_CONSTEXPR_TEST(Varint, DecodePacked, {
+  constexpr auto kEncoded =
+      bytes::Array<0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x96, 0x01,
+                   0x7f>();
+  const ConstByteSpan encoded(kEncoded);
+  uint32_t values[16] = {};
+  size_t bytes_read = 0;
+
+  PW_TEST_EXPECT_EQ(
+      DecodePacked(encoded, span<uint32_t>(values), &bytes_read), 10u);
+  PW_TEST_EXPECT_EQ(bytes_read, encoded.size());
+  for (uint32_t i = 0; i < 8; ++i) {
+    PW_TEST_EXPECT_EQ(values[i], i + 1);
+  }
+  PW_TEST_EXPECT_EQ(values[8], 150u);
+  PW_TEST_EXPECT_EQ(values[9], 127u);
+});
+
+PW_CONSTEXPR_TEST(Varint, DecodePacked_Signed, {
+  std::byte buffer[16] = {};
+  const ConstByteSpan encoded =
+      Write("\x01\x02\x03\x04\x05\x06\x07\x08\x81\x01", buffer);
+  int64_t values[16] = {};
+  size_t bytes_read = 0;
+
+  PW_TEST_EXPECT_EQ(DecodePacked(encoded, span<int64_t>(values), &bytes_read),
+                    9u);
+  PW_TEST_EXPECT_EQ(bytes_read, encoded.size());
+  PW_TEST_EXPECT_EQ(values[0], -1);
+  PW_TEST_EXPECT_EQ(values[1], 1);
+  PW_TEST_EXPECT_EQ(values[6], -4);
+  PW_TEST_EXPECT_EQ(values[7], 4);
+  PW_TEST_EXPECT_EQ(values[8], -65);
+});
+
+PW_CONSTEXPR_TEST(Varint, DecodePacked_OutputFull, {
+  std::byte buffer[16] = {};
+  const ConstByteSpan encoded =
+      Write("\x01\x02\x03\x04\x05\x06\x07\x08\x09", buffer);
+  uint64_t values[3] = {};
+  size_t bytes_read = 0;
+
+  PW_TEST_EXPECT_EQ(
+      DecodePacked(encoded, span<uint64_t>(values), &bytes_read), 3u);
+  PW_TEST_EXPECT_EQ(bytes_read, 3u);
+  PW_TEST_EXPECT_EQ(values[2], 3u);
+});
+
+PW_CONSTEXPR_TEST(Varint, DecodePacked_Truncated, {
+  std::byte buffer[16] = {};
+  const ConstByteSpan encoded = Write("\x01\x96", buffer);
+  uint64_t values[4] = {};
+  size_t bytes_read = 0;
+
+  PW_TEST_EXPECT_EQ(
+      DecodePacked(encoded, span<uint64_t>(values), &bytes_read), 1u);
+  PW_TEST_EXPECT_EQ(bytes_read, 1u);
+  PW_TEST_EXPECT_EQ(values[0], 1u);
+});
+
 PW_CONSTEXPR_TEST(Varint, ZigZagEncode_Int8, {
   PW_TEST_EXPECT_EQ(ZigZagEncode(int8_t(0)), uint8_t(0));
   PW_TEST_EXPECT_EQ(ZigZagEncode(int8_t(-1)), uint8_t(1));